@@ -0,0 +1,171 @@
+#include <stdatomic.h>
+#include "./bench.h"
+
+/* Private Types */
+
+/// @brief The latencies measured by the writer thread.
+typedef struct __writer_latency
+{
+    /// @brief How many writes were made.
+    int write_amount;
+
+    /// @brief The slowest write, in nanoseconds.
+    uint64_t max_ns;
+
+    /// @brief How long all writes took, in nanoseconds.
+    uint64_t total_ns;
+} __writer_latency;
+
+/* Private Variables */
+
+/// @brief The default amount of tasks in the database.
+static const int __default_row_amount = 200000;
+
+/// @brief The length of each task.
+static const int __task_length = 200;
+
+/// @brief The content of the tasks written while the backup runs.
+static const char* const __sample_task = "Buy milk, eggs and bread on the way back home.";
+
+/// @brief Whether the writer thread should stop.
+static atomic_bool __is_writer_stopping;
+
+/// @brief When the previous step of the backup finished, in nanoseconds.
+static uint64_t __last_step_ns;
+
+/// @brief The longest time between two steps of the backup, in nanoseconds.
+static uint64_t __longest_step_ns;
+
+/* Function Prototyping */
+
+/// @brief Backs up the database while another thread writes to it, then reports how long the writes took.
+/// @param db The database.
+/// @param backup_location The path of the backup file.
+/// @param name The name of the benchmark.
+/// @param pages_per_step How many pages each step copies. Zero or less copies everything in one step.
+static void __run_backup(const db_handle* db, const char* backup_location, const char* name, const int pages_per_step);
+
+/// @brief Progress callback that records the longest time between two steps.
+/// @param custom_state Unused.
+/// @param copied_pages How many pages were copied.
+/// @param total_pages How many pages there are.
+/// @return Always zero, so the backup is never cancelled.
+static int __record_step(void* custom_state, const int copied_pages, const int total_pages);
+
+/// @brief Inserts tasks until it's told to stop, measuring each insert.
+/// @param db The database.
+/// @return The latencies, which must be manually deallocated.
+static void* __run_writer(void* db);
+
+/* Public Functions */
+
+/// @brief Measures how much an online backup delays concurrent writes, copying everything at once against a few pages per step.
+/// @param argc The amount of command-line arguments.
+/// @param argv The command-line arguments. The first optional argument is the amount of tasks.
+/// @return The exit code of the benchmark.
+int main(int argc, char** argv)
+{
+    const int row_amount = (argc > 1 && atoi(argv[1]) > 0) ? atoi(argv[1]) : __default_row_amount;
+    const char* db_location = temp_db_create_path();
+    const char* backup_location = temp_db_create_path();
+    const db_handle* db = (db_location == NULL) ? NULL : create_sqlite_db(db_location);
+    sqlite3* raw_db = NULL;
+
+    if (db == NULL || backup_location == NULL || !temp_db_open_raw(db_location, &raw_db) || !bench_populate(raw_db, row_amount, __task_length))
+    {
+        sqlite3_close(raw_db);
+        close_sqlite_db(db);
+        temp_db_remove(db_location);
+        temp_db_remove(backup_location);
+
+        return EXIT_FAILURE;
+    }
+
+    printf("database: %d tasks, %d pages" NEWLINE, row_amount, temp_db_query_int(raw_db, "PRAGMA page_count;"));
+
+    __run_backup(db, backup_location, "single step", 0);
+    __run_backup(db, backup_location, "64 pages per step", 64);
+    __run_backup(db, backup_location, "16 pages per step", 16);
+
+    sqlite3_close(raw_db);
+    close_sqlite_db(db);
+    temp_db_remove(db_location);
+    temp_db_remove(backup_location);
+
+    return EXIT_SUCCESS;
+}
+
+/* Private Functions */
+
+static void __run_backup(const db_handle* db, const char* backup_location, const char* name, const int pages_per_step)
+{
+    pthread_t writer;
+
+    atomic_store(&__is_writer_stopping, false);
+
+    if (pthread_create(&writer, NULL, __run_writer, (void*)db) != 0)
+        return;
+
+    const uint64_t start = bench_now_ns();
+    __last_step_ns = start;
+    __longest_step_ns = 0;
+
+    const bool success = backup_sqlite_db(db, backup_location, pages_per_step, 1, __record_step, NULL);
+    const uint64_t elapsed_ns = bench_now_ns() - start;
+
+    void* result = NULL;
+    atomic_store(&__is_writer_stopping, true);
+    pthread_join(writer, &result);
+
+    const __writer_latency* latency = result;
+
+    printf("--- %s ---" NEWLINE, name);
+    printf("%-32s %10.1f ms%s" NEWLINE, "backup", elapsed_ns / 1e6, (success) ? "" : " (failed)");
+    printf("%-32s %10.1f ms" NEWLINE, "longest step (with pause)", __longest_step_ns / 1e6);
+
+    if (latency != NULL && latency->write_amount > 0)
+    {
+        printf("%-32s %10d" NEWLINE, "concurrent inserts", latency->write_amount);
+        printf("%-32s %10.1f us" NEWLINE, "mean insert latency", latency->total_ns / 1e3 / latency->write_amount);
+        printf("%-32s %10.1f us" NEWLINE, "max insert latency", latency->max_ns / 1e3);
+    }
+
+    free(result);
+}
+
+static int __record_step(void* custom_state, const int copied_pages, const int total_pages)
+{
+    UNUSED(custom_state, copied_pages, total_pages);
+
+    const uint64_t now = bench_now_ns();
+
+    if (now - __last_step_ns > __longest_step_ns)
+        __longest_step_ns = now - __last_step_ns;
+
+    __last_step_ns = now;
+
+    return 0;
+}
+
+static void* __run_writer(void* db)
+{
+    __writer_latency* latency = calloc(1, sizeof(__writer_latency));
+
+    if (latency == NULL)
+        return NULL;
+
+    while (!atomic_load(&__is_writer_stopping))
+    {
+        const uint64_t start = bench_now_ns();
+        insert_task(db, __sample_task);
+        const uint64_t elapsed_ns = bench_now_ns() - start;
+
+        latency->write_amount++;
+        latency->total_ns += elapsed_ns;
+
+        if (elapsed_ns > latency->max_ns)
+            latency->max_ns = elapsed_ns;
+    }
+
+    return latency;
+}
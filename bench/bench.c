@@ -0,0 +1,210 @@
+#include <fcntl.h>
+#include "./bench.h"
+
+/* Private Variables */
+
+/// @brief Words that fill synthetic tasks, so their text compresses like real notes instead of like repeated characters.
+static const char* const __filler_text =
+    "call the bank about the card, buy milk and eggs, book the dentist for next week, "
+    "finish the report before friday, water the plants, pay the electricity bill, "
+    "pick up the package at the post office, renew the passport, clean the garage, ";
+
+/* Function Prototyping */
+
+/// @brief Compares two latencies for "qsort()".
+/// @param x The first latency.
+/// @param y The second latency.
+/// @return Negative, zero or positive if the first latency is smaller, equal or greater.
+static int __compare_latencies(const void* x, const void* y);
+
+/* Public Functions */
+
+uint64_t bench_now_ns()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (uint64_t)now.tv_sec * 1000000000u + (uint64_t)now.tv_nsec;
+}
+
+bool bench_populate(sqlite3* raw_db, const int row_amount, const int task_length)
+{
+    char sql_query[512];
+
+    snprintf(sql_query, sizeof(sql_query),
+        "BEGIN;"
+        "WITH RECURSIVE counter(value) AS (SELECT 1 UNION ALL SELECT value + 1 FROM counter WHERE value < %d)"
+        "INSERT INTO tasks (task, created_at) SELECT substr(printf('Synthetic note number %%d. ', value) || hex(zeroblob(%d)), 1, %d), value * 60 FROM counter;"
+        "COMMIT;",
+        row_amount, task_length, task_length);
+
+    return sqlite3_exec(raw_db, sql_query, NULL, NULL, NULL) == SQLITE_OK;
+}
+
+bool bench_populate_distribution(sqlite3* raw_db, const int row_amount, const int mean_length,
+    const bench_length_distribution distribution, const uint64_t seed)
+{
+    uint64_t random_state = (seed == 0) ? 1 : seed;
+    sqlite3_stmt* stmt = NULL;
+    char* task = NULL;
+    size_t task_capacity = 0;
+    bool success = sqlite3_exec(raw_db, "BEGIN;", NULL, NULL, NULL) == SQLITE_OK
+        && sqlite3_prepare_v2(raw_db, "INSERT INTO tasks (task, created_at) VALUES (?, ?);", -1, &stmt, NULL) == SQLITE_OK;
+
+    for (int row = 1; success && row <= row_amount; row++)
+    {
+        const int length = bench_task_length(mean_length, distribution, &random_state);
+
+        if ((size_t)length + 1 > task_capacity)
+        {
+            char* new_task = realloc(task, length + 1);
+
+            if (new_task == NULL)
+            {
+                success = false;
+                break;
+            }
+
+            task = new_task;
+            task_capacity = length + 1;
+        }
+
+        bench_fill_task(task, length, row, &random_state);
+        sqlite3_bind_text(stmt, 1, task, length, SQLITE_STATIC);
+        sqlite3_bind_int64(stmt, 2, (sqlite3_int64)row * 60);
+        success = sqlite3_step(stmt) == SQLITE_DONE && sqlite3_reset(stmt) == SQLITE_OK;
+    }
+
+    sqlite3_finalize(stmt);
+    free(task);
+
+    return sqlite3_exec(raw_db, (success) ? "COMMIT;" : "ROLLBACK;", NULL, NULL, NULL) == SQLITE_OK && success;
+}
+
+int bench_task_length(const int mean_length, const bench_length_distribution distribution, uint64_t* random_state)
+{
+    const uint64_t random = bench_random(random_state);
+
+    switch (distribution)
+    {
+        case BENCH_LENGTH_UNIFORM:
+            return 1 + (int)(random % (2 * (uint64_t)max(1, mean_length)));
+        case BENCH_LENGTH_SKEWED:
+            // Nine in ten tasks are up to half the mean, the rest between the mean and eight times the mean.
+            return (random % 10 != 0)
+                ? 1 + (int)((random / 10) % (uint64_t)max(1, mean_length / 2))
+                : mean_length + (int)((random / 10) % (7 * (uint64_t)max(1, mean_length)));
+        default:
+            return max(1, mean_length);
+    }
+}
+
+void bench_fill_task(char* task, const int length, const int number, uint64_t* random_state)
+{
+    const size_t filler_length = strlen(__filler_text);
+    const int prefix_length = min(length, snprintf(task, length + 1, "Synthetic note number %d. ", number));
+    size_t filler_position = bench_random(random_state) % filler_length;
+
+    for (int index = prefix_length; index < length; index++, filler_position = (filler_position + 1) % filler_length)
+        task[index] = __filler_text[filler_position];
+
+    task[length] = '\0';
+}
+
+uint64_t bench_random(uint64_t* random_state)
+{
+    *random_state ^= *random_state >> 12;
+    *random_state ^= *random_state << 25;
+    *random_state ^= *random_state >> 27;
+
+    return *random_state * 2685821657736338717u;
+}
+
+void bench_drop_file_cache(const char* db_location)
+{
+    const char* wal_location = str_append(db_location, "-wal");
+    const char* locations[] = { db_location, wal_location };
+
+    for (size_t index = 0; index < sizeof(locations) / sizeof(locations[0]); index++)
+    {
+        const int fd = open(locations[index], O_RDONLY);
+
+        if (fd < 0)
+            continue;
+
+        // Only clean pages can be dropped.
+        fdatasync(fd);
+        posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+        close(fd);
+    }
+
+    free((char*)wal_location);
+}
+
+bench_latencies bench_create_latencies(const int capacity)
+{
+    uint64_t* samples_ns = malloc(max(1, capacity) * sizeof(uint64_t));
+
+    return (bench_latencies) {
+        .samples_ns = samples_ns,
+        .is_sorted = true,
+        .amount = 0,
+        .capacity = (samples_ns == NULL) ? 0 : capacity,
+        .total_ns = 0
+    };
+}
+
+void bench_record(bench_latencies* latencies, const uint64_t elapsed_ns)
+{
+    latencies->total_ns += elapsed_ns;
+
+    if (latencies->amount < latencies->capacity)
+    {
+        latencies->samples_ns[latencies->amount++] = elapsed_ns;
+        latencies->is_sorted = false;
+    }
+}
+
+uint64_t bench_percentile(bench_latencies* latencies, const double fraction)
+{
+    if (latencies->amount == 0)
+        return 0;
+
+    if (!latencies->is_sorted)
+    {
+        qsort(latencies->samples_ns, latencies->amount, sizeof(uint64_t), __compare_latencies);
+        latencies->is_sorted = true;
+    }
+
+    const int index = (int)(latencies->amount * fraction);
+
+    return latencies->samples_ns[min(index, latencies->amount - 1)];
+}
+
+void bench_free_latencies(bench_latencies* latencies)
+{
+    free(latencies->samples_ns);
+    latencies->samples_ns = NULL;
+    latencies->amount = latencies->capacity = 0;
+}
+
+int bench_max_id(sqlite3* raw_db)
+{
+    return temp_db_query_int(raw_db, "SELECT COALESCE(MAX(id), 0) FROM tasks;");
+}
+
+void bench_report(const char* name, const int operations, const uint64_t elapsed_ns)
+{
+    const double seconds = elapsed_ns / 1e9;
+
+    printf("%-32s %10d ops %12.0f ops/s %10.2f us/op" NEWLINE,
+        name, operations, (seconds > 0) ? operations / seconds : 0, (operations > 0) ? elapsed_ns / 1e3 / operations : 0);
+}
+
+/* Private Functions */
+
+static int __compare_latencies(const void* x, const void* y)
+{
+    const uint64_t first = *(const uint64_t*)x, second = *(const uint64_t*)y;
+    return (first > second) - (first < second);
+}
@@ -0,0 +1,118 @@
+#ifndef BENCH_H // Only include this header file if it hasn't been included in the calling file already
+    #define BENCH_H
+
+    #include <stdint.h>
+    #include "../database/sqlite_db.h"
+    #include "../fixtures/temp_db.h"
+    #include "../utilities/utilities.h"
+
+    /// @brief How the lengths of synthetic tasks are spread around their mean.
+    typedef enum bench_length_distribution
+    {
+        /// @brief Every task has the mean length.
+        BENCH_LENGTH_FIXED,
+
+        /// @brief Lengths are spread evenly between 1 and twice the mean.
+        BENCH_LENGTH_UNIFORM,
+
+        /// @brief Most tasks are short and one in ten is several times longer than the mean, like real notes.
+        BENCH_LENGTH_SKEWED
+    } bench_length_distribution;
+
+    /// @brief Latency samples of a benchmark, in nanoseconds.
+    /// @attention Must be manually deallocated with "bench_free_latencies()"!
+    typedef struct bench_latencies
+    {
+        /// @brief The samples, sorted once a percentile is requested.
+        uint64_t* samples_ns;
+
+        /// @brief Whether "samples_ns" is sorted.
+        bool is_sorted;
+
+        /// @brief How many samples were recorded.
+        int amount;
+
+        /// @brief How many samples fit in "samples_ns". Samples past it are dropped.
+        int capacity;
+
+        /// @brief How long the recorded operations took in total, in nanoseconds.
+        uint64_t total_ns;
+    } bench_latencies;
+
+    /// @brief Gets a monotonic timestamp.
+    /// @return The current time in nanoseconds.
+    extern uint64_t bench_now_ns();
+
+    /// @brief Fills the tasks table with synthetic tasks in a single transaction, created one minute apart from the epoch.
+    /// @param raw_db A plain SQLite connection to the database.
+    /// @param row_amount How many tasks to add.
+    /// @param task_length The length of each task.
+    /// @return True if the tasks were added, False otherwise.
+    extern bool bench_populate(sqlite3* raw_db, const int row_amount, const int task_length);
+
+    /// @brief Fills the tasks table with synthetic tasks of varying lengths in a single transaction, created one minute apart from the epoch.
+    /// @brief The same seed always produces the same tasks, so runs can be compared.
+    /// @param raw_db A plain SQLite connection to the database.
+    /// @param row_amount How many tasks to add.
+    /// @param mean_length The mean length of the tasks.
+    /// @param distribution How the lengths are spread around the mean.
+    /// @param seed The seed of the lengths.
+    /// @return True if the tasks were added, False otherwise.
+    extern bool bench_populate_distribution(sqlite3* raw_db, const int row_amount, const int mean_length,
+        const bench_length_distribution distribution, const uint64_t seed);
+
+    /// @brief Picks the length of a synthetic task.
+    /// @param mean_length The mean length of the tasks.
+    /// @param distribution How the lengths are spread around the mean.
+    /// @param random_state The state of the random generator. Updated on every call.
+    /// @return The length, at least 1.
+    extern int bench_task_length(const int mean_length, const bench_length_distribution distribution, uint64_t* random_state);
+
+    /// @brief Writes the text of a synthetic task: its number followed by everyday words from a random position.
+    /// @param task Receives the text and the null terminator.
+    /// @param length The length of the text.
+    /// @param number The number of the task, so tasks don't start the same way.
+    /// @param random_state The state of the random generator. Updated on every call.
+    extern void bench_fill_task(char* task, const int length, const int number, uint64_t* random_state);
+
+    /// @brief Gets the next number of a fast, seedable pseudo-random generator (xorshift64*).
+    /// @param random_state The state of the generator. Must not be zero. Updated on every call.
+    /// @return The random number.
+    extern uint64_t bench_random(uint64_t* random_state);
+
+    /// @brief Asks the kernel to drop the cached pages of a database file and its WAL, so the next reads come from the disk.
+    /// @attention The database must be closed first, or the pages may be read back right away.
+    /// @param db_location The path to the database file.
+    extern void bench_drop_file_cache(const char* db_location);
+
+    /// @brief Creates an empty set of latency samples.
+    /// @param capacity The most samples to record.
+    /// @return The samples. Recording fails silently if there was not enough memory.
+    extern bench_latencies bench_create_latencies(const int capacity);
+
+    /// @brief Records how long an operation took.
+    /// @param latencies The samples.
+    /// @param elapsed_ns How long the operation took, in nanoseconds.
+    extern void bench_record(bench_latencies* latencies, const uint64_t elapsed_ns);
+
+    /// @brief Gets a percentile of the recorded samples.
+    /// @param latencies The samples.
+    /// @param fraction The percentile, between 0 and 1, such as 0.99 for p99.
+    /// @return The latency in nanoseconds or zero if there are no samples.
+    extern uint64_t bench_percentile(bench_latencies* latencies, const double fraction);
+
+    /// @brief Deallocates latency samples.
+    /// @param latencies The samples.
+    extern void bench_free_latencies(bench_latencies* latencies);
+
+    /// @brief Gets the highest task ID in the database.
+    /// @param raw_db A plain SQLite connection to the database.
+    /// @return The highest ID or zero if the table is empty.
+    extern int bench_max_id(sqlite3* raw_db);
+
+    /// @brief Writes the result of a benchmark to stdout.
+    /// @param name The name of the benchmark.
+    /// @param operations How many operations were executed.
+    /// @param elapsed_ns How long the operations took, in nanoseconds.
+    extern void bench_report(const char* name, const int operations, const uint64_t elapsed_ns);
+#endif // BENCH_H
@@ -0,0 +1,218 @@
+#include "./bench.h"
+#include "../database/compression.h"
+
+/* Private Variables */
+
+/// @brief The default amount of notes in the corpus.
+static const int __default_note_amount = 200;
+
+/// @brief The approximate length of each note of the corpus.
+static const int __note_length = 64 * 1024;
+
+/// @brief Words used to build the prose notes of the corpus.
+static const char* const __words[] = {
+    "meeting", "project", "deadline", "review", "the", "and", "with", "for", "budget", "draft",
+    "customer", "release", "notes", "follow", "up", "on", "team", "schedule", "design", "a"
+};
+
+/* Function Prototyping */
+
+/// @brief Builds a note that looks like a pasted log (even indexes) or like prose (odd indexes).
+/// @attention Must be manually deallocated!
+/// @param index The position of the note in the corpus.
+/// @return The note.
+static char* __build_note(const int index);
+
+/// @brief Measures the codec on its own: compression ratio and throughput.
+/// @param notes The corpus.
+/// @param note_amount The amount of notes.
+/// @param corpus_bytes The total size of the corpus.
+static void __run_codec(char** notes, const int note_amount, const size_t corpus_bytes);
+
+/// @brief Writes and reads the corpus through the database layer with the specified compression threshold.
+/// @param notes The corpus.
+/// @param note_amount The amount of notes.
+/// @param corpus_bytes The total size of the corpus.
+/// @param threshold The compression threshold. Zero disables compression.
+static void __run_database(char** notes, const int note_amount, const size_t corpus_bytes, const size_t threshold);
+
+/// @brief Writes the throughput of a benchmark to stdout.
+/// @param name The name of the benchmark.
+/// @param bytes How many bytes were processed.
+/// @param elapsed_ns How long it took, in nanoseconds.
+static void __report_throughput(const char* name, const size_t bytes, const uint64_t elapsed_ns);
+
+/* Public Functions */
+
+/// @brief Measures the size ratio and read/write throughput of compressed note bodies.
+/// @param argc The amount of command-line arguments.
+/// @param argv The command-line arguments. The first optional argument is the amount of notes.
+/// @return The exit code of the benchmark.
+int main(int argc, char** argv)
+{
+    const int note_amount = (argc > 1 && atoi(argv[1]) > 0) ? atoi(argv[1]) : __default_note_amount;
+    char** notes = calloc(note_amount, sizeof(char*));
+    size_t corpus_bytes = 0;
+
+    if (notes == NULL)
+        return EXIT_FAILURE;
+
+    srand(42);
+
+    for (int index = 0; index < note_amount; index++)
+    {
+        notes[index] = __build_note(index);
+
+        if (notes[index] == NULL)
+            return EXIT_FAILURE;
+
+        corpus_bytes += strlen(notes[index]);
+    }
+
+    printf("corpus: %d notes, %.1f MiB" NEWLINE, note_amount, corpus_bytes / (1024.0 * 1024.0));
+
+    printf("--- Codec ---" NEWLINE);
+    __run_codec(notes, note_amount, corpus_bytes);
+
+    printf("--- Plain text (compression disabled) ---" NEWLINE);
+    __run_database(notes, note_amount, corpus_bytes, 0);
+
+    printf("--- Compressed (4 KiB threshold) ---" NEWLINE);
+    __run_database(notes, note_amount, corpus_bytes, 4096);
+
+    // Cleanup
+    for (int index = 0; index < note_amount; index++)
+        free(notes[index]);
+
+    free(notes);
+
+    return EXIT_SUCCESS;
+}
+
+/* Private Functions */
+
+static char* __build_note(const int index)
+{
+    char* note = malloc(__note_length + 256);
+    int length = 0;
+
+    if (note == NULL)
+        return NULL;
+
+    for (int line = 0; length < __note_length; line++)
+    {
+        if (index % 2 == 0)
+        {
+            length += sprintf(note + length, "2026-10-17 %02d:%02d:%02d.%03d %s [worker-%d] request %d took %d ms" NEWLINE,
+                line / 3600 % 24, line / 60 % 60, line % 60, rand() % 1000, (rand() % 10 == 0) ? "WARN" : "INFO",
+                rand() % 8, rand(), rand() % 500);
+        }
+        else
+        {
+            const int word_amount = sizeof(__words) / sizeof(__words[0]);
+
+            for (int word = 0; word < 12; word++)
+                length += sprintf(note + length, "%s ", __words[rand() % word_amount]);
+
+            length += sprintf(note + length, NEWLINE);
+        }
+    }
+
+    return note;
+}
+
+static void __run_codec(char** notes, const int note_amount, const size_t corpus_bytes)
+{
+    char* compressed = malloc(lz_compress_bound(__note_length + 256));
+    char* decompressed = malloc(__note_length + 256);
+    size_t compressed_bytes = 0;
+    uint64_t compress_ns = 0, decompress_ns = 0;
+
+    if (compressed == NULL || decompressed == NULL)
+    {
+        free(compressed);
+        free(decompressed);
+
+        return;
+    }
+
+    for (int index = 0; index < note_amount; index++)
+    {
+        const size_t note_length = strlen(notes[index]);
+
+        uint64_t start = bench_now_ns();
+        const size_t compressed_length = lz_compress(notes[index], note_length, compressed);
+        compress_ns += bench_now_ns() - start;
+
+        start = bench_now_ns();
+        lz_decompress(compressed, compressed_length, decompressed, note_length);
+        decompress_ns += bench_now_ns() - start;
+
+        compressed_bytes += compressed_length;
+    }
+
+    printf("%-32s %10.2fx" NEWLINE, "compression ratio", (double)corpus_bytes / compressed_bytes);
+    __report_throughput("lz_compress", corpus_bytes, compress_ns);
+    __report_throughput("lz_decompress", corpus_bytes, decompress_ns);
+
+    free(compressed);
+    free(decompressed);
+}
+
+static void __run_database(char** notes, const int note_amount, const size_t corpus_bytes, const size_t threshold)
+{
+    const char* db_location = temp_db_create_path();
+    const db_handle* db = (db_location == NULL) ? NULL : create_sqlite_db(db_location);
+    sqlite3* raw_db = NULL;
+
+    if (db == NULL || !temp_db_open_raw(db_location, &raw_db))
+    {
+        sqlite3_close(raw_db);
+        close_sqlite_db(db);
+        temp_db_remove(db_location);
+
+        return;
+    }
+
+    set_compression_threshold(db, threshold);
+
+    uint64_t start = bench_now_ns();
+    for (int index = 0; index < note_amount; index++)
+        insert_task(db, notes[index]);
+    const uint64_t write_ns = bench_now_ns() - start;
+
+    bench_report("insert_task", note_amount, write_ns);
+    __report_throughput("insert_task", corpus_bytes, write_ns);
+
+    const int first_id = bench_max_id(raw_db) - note_amount + 1;
+
+    start = bench_now_ns();
+    for (int index = 0; index < note_amount; index++)
+    {
+        db_task db_task = get_task(db, first_id + index);
+        free_db_task(&db_task);
+    }
+    const uint64_t read_ns = bench_now_ns() - start;
+
+    bench_report("get_task", note_amount, read_ns);
+    __report_throughput("get_task", corpus_bytes, read_ns);
+
+    // Move every page from the WAL into the database file before measuring it.
+    sqlite3_exec(raw_db, "PRAGMA wal_checkpoint(TRUNCATE);", NULL, NULL, NULL);
+
+    const int page_size = temp_db_query_int(raw_db, "PRAGMA page_size;");
+    const int page_count = temp_db_query_int(raw_db, "PRAGMA page_count;");
+    const double file_bytes = (double)page_size * page_count;
+
+    printf("%-32s %10.1f MiB (corpus / file = %.2fx)" NEWLINE, "database size",
+        file_bytes / (1024.0 * 1024.0), corpus_bytes / file_bytes);
+
+    sqlite3_close(raw_db);
+    close_sqlite_db(db);
+    temp_db_remove(db_location);
+}
+
+static void __report_throughput(const char* name, const size_t bytes, const uint64_t elapsed_ns)
+{
+    printf("%-32s %10.1f MiB/s" NEWLINE, name, (bytes / (1024.0 * 1024.0)) / (elapsed_ns / 1e9));
+}
@@ -0,0 +1,263 @@
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include "./bench.h"
+
+/* Private Types */
+
+/// @brief What a worker process measured, in memory shared with the parent.
+typedef struct __worker_result
+{
+    /// @brief How many operations succeeded.
+    int operation_amount;
+
+    /// @brief How many operations failed, mostly with SQLITE_BUSY.
+    int failure_amount;
+
+    /// @brief The latency of each successful operation, in nanoseconds. Holds up to "__max_samples" values.
+    uint64_t latencies_ns[];
+} __worker_result;
+
+/* Private Variables */
+
+/// @brief The default amount of writer processes.
+static const int __default_writer_amount = 4;
+
+/// @brief The default amount of reader processes.
+static const int __default_reader_amount = 4;
+
+/// @brief The default duration of each run, in milliseconds.
+static const int __default_duration_ms = 2000;
+
+/// @brief The amount of tasks in the database before the workers start.
+static const int __initial_row_amount = 10000;
+
+/// @brief The most latencies a worker records.
+static const int __max_samples = 200000;
+
+/// @brief The content of the tasks inserted by the writers.
+static const char* const __sample_task = "Buy milk, eggs and bread on the way back home.";
+
+/* Function Prototyping */
+
+/// @brief Runs N writer and M reader processes against the same database file for a while, then reports their throughput and latency.
+/// @param db_location The path of the database.
+/// @param name The name of the run.
+/// @param policy How each process waits for locks held by the others.
+/// @param writer_amount The amount of writer processes.
+/// @param reader_amount The amount of reader processes.
+/// @param duration_ms How long the workers run, in milliseconds.
+static void __run_contention(const char* db_location, const char* name, const db_busy_policy policy,
+    const int writer_amount, const int reader_amount, const int duration_ms);
+
+/// @brief Body of a worker process: opens its own handle, waits for the start signal, then writes or reads until the time is up.
+/// @param db_location The path of the database.
+/// @param policy How the process waits for locks held by the others.
+/// @param is_writer Whether the process inserts tasks or reads them.
+/// @param start_pipe The read end of the pipe that's closed to start every worker at once.
+/// @param duration_ms How long to run, in milliseconds.
+/// @param result Where to write the measurements.
+static void __run_worker(const char* db_location, const db_busy_policy policy, const bool is_writer,
+    const int start_pipe, const int duration_ms, __worker_result* result);
+
+/// @brief Visitor that accepts any task.
+/// @param custom_state Unused.
+/// @param id The ID of the task.
+/// @param task The content of the task.
+/// @param length The length of the task.
+/// @return Always zero.
+static int __visitor_ignore_task(void* custom_state, const int id, const char* task, const int length);
+
+/// @brief Reports the throughput and latency percentiles of a group of workers.
+/// @param label The name of the group.
+/// @param results The result of the first worker of the group.
+/// @param worker_amount The amount of workers in the group.
+/// @param result_size The size of each result.
+/// @param duration_ms How long the workers ran, in milliseconds.
+static void __report_group(const char* label, const unsigned char* results, const int worker_amount, const size_t result_size, const int duration_ms);
+
+/// @brief Compares two latencies for "qsort()".
+/// @param x The first latency.
+/// @param y The second latency.
+/// @return Negative, zero or positive if the first latency is smaller, equal or greater.
+static int __compare_latencies(const void* x, const void* y);
+
+/* Public Functions */
+
+/// @brief Measures how several TodoC processes sharing one database file behave with and without the busy handler.
+/// @param argc The amount of command-line arguments.
+/// @param argv The command-line arguments: the amount of writers, the amount of readers and the duration of each run in milliseconds, all optional.
+/// @return The exit code of the benchmark.
+int main(int argc, char** argv)
+{
+    const int writer_amount = (argc > 1 && atoi(argv[1]) >= 0) ? atoi(argv[1]) : __default_writer_amount;
+    const int reader_amount = (argc > 2 && atoi(argv[2]) >= 0) ? atoi(argv[2]) : __default_reader_amount;
+    const int duration_ms = (argc > 3 && atoi(argv[3]) > 0) ? atoi(argv[3]) : __default_duration_ms;
+    const char* db_location = temp_db_create_path();
+    const db_handle* db = (db_location == NULL) ? NULL : create_sqlite_db(db_location);
+    sqlite3* raw_db = NULL;
+
+    if (db == NULL || !temp_db_open_raw(db_location, &raw_db) || !bench_populate(raw_db, __initial_row_amount, 48))
+    {
+        sqlite3_close(raw_db);
+        close_sqlite_db(db);
+        temp_db_remove(db_location);
+
+        return EXIT_FAILURE;
+    }
+
+    // Every connection is closed before forking, so the workers don't inherit SQLite state.
+    sqlite3_close(raw_db);
+    close_sqlite_db(db);
+
+    printf("%d writers, %d readers, %d ms per run" NEWLINE, writer_amount, reader_amount, duration_ms);
+
+    const db_busy_policy no_retry = { .timeout_ms = 0, .initial_backoff_us = 0, .max_backoff_us = 0 };
+    const db_busy_policy backoff = { .timeout_ms = 5000, .initial_backoff_us = 100, .max_backoff_us = 20000 };
+
+    __run_contention(db_location, "No busy handler", no_retry, writer_amount, reader_amount, duration_ms);
+    __run_contention(db_location, "Exponential backoff with jitter", backoff, writer_amount, reader_amount, duration_ms);
+
+    temp_db_remove(db_location);
+
+    return EXIT_SUCCESS;
+}
+
+/* Private Functions */
+
+static void __run_contention(const char* db_location, const char* name, const db_busy_policy policy,
+    const int writer_amount, const int reader_amount, const int duration_ms)
+{
+    const int worker_amount = writer_amount + reader_amount;
+    const size_t result_size = sizeof(__worker_result) + (size_t)__max_samples * sizeof(uint64_t);
+    int start_pipe[2];
+
+    if (worker_amount == 0 || pipe(start_pipe) != 0)
+        return;
+
+    unsigned char* results = mmap(NULL, result_size * worker_amount, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+
+    if (results == MAP_FAILED)
+    {
+        close(start_pipe[0]);
+        close(start_pipe[1]);
+
+        return;
+    }
+
+    fflush(stdout);
+
+    for (int worker = 0; worker < worker_amount; worker++)
+    {
+        if (fork() == 0)
+        {
+            close(start_pipe[1]);
+            __run_worker(db_location, policy, worker < writer_amount, start_pipe[0], duration_ms, (__worker_result*)(results + result_size * worker));
+            _exit(EXIT_SUCCESS);
+        }
+    }
+
+    // Closing the pipe wakes every worker at the same time.
+    close(start_pipe[0]);
+    close(start_pipe[1]);
+
+    while (wait(NULL) > 0);
+
+    printf("--- %s ---" NEWLINE, name);
+    __report_group("writers", results, writer_amount, result_size, duration_ms);
+    __report_group("readers", results + result_size * writer_amount, reader_amount, result_size, duration_ms);
+
+    munmap(results, result_size * worker_amount);
+}
+
+static void __run_worker(const char* db_location, const db_busy_policy policy, const bool is_writer,
+    const int start_pipe, const int duration_ms, __worker_result* result)
+{
+    const db_handle* db = create_sqlite_db_pool(db_location, 1);
+    char signal_byte;
+
+    if (db == NULL)
+        return;
+
+    set_busy_policy(db, policy);
+    srand(getpid());
+
+    // Blocks until the parent closes the pipe.
+    if (read(start_pipe, &signal_byte, 1) < 0)
+        return;
+
+    const uint64_t deadline = bench_now_ns() + (uint64_t)duration_ms * 1000000u;
+
+    for (uint64_t now = bench_now_ns(); now < deadline; now = bench_now_ns())
+    {
+        const bool success = (is_writer)
+            ? insert_task(db, __sample_task)
+            : with_task(db, 1 + rand() % __initial_row_amount, __visitor_ignore_task, NULL);
+
+        if (!success)
+        {
+            result->failure_amount++;
+            continue;
+        }
+
+        if (result->operation_amount < __max_samples)
+            result->latencies_ns[result->operation_amount] = bench_now_ns() - now;
+
+        result->operation_amount++;
+    }
+
+    close_sqlite_db(db);
+}
+
+static int __visitor_ignore_task(void* custom_state, const int id, const char* task, const int length)
+{
+    UNUSED(custom_state, id, task, length);
+    return 0;
+}
+
+static void __report_group(const char* label, const unsigned char* results, const int worker_amount, const size_t result_size, const int duration_ms)
+{
+    int operation_amount = 0, failure_amount = 0, sample_amount = 0;
+
+    for (int worker = 0; worker < worker_amount; worker++)
+    {
+        const __worker_result* result = (const __worker_result*)(results + result_size * worker);
+
+        operation_amount += result->operation_amount;
+        failure_amount += result->failure_amount;
+        sample_amount += min(result->operation_amount, __max_samples);
+    }
+
+    if (worker_amount == 0)
+        return;
+
+    uint64_t* latencies = malloc(max(1, sample_amount) * sizeof(uint64_t));
+
+    if (latencies == NULL)
+        return;
+
+    for (int worker = 0, position = 0; worker < worker_amount; worker++)
+    {
+        const __worker_result* result = (const __worker_result*)(results + result_size * worker);
+        const int worker_samples = min(result->operation_amount, __max_samples);
+
+        memcpy(latencies + position, result->latencies_ns, worker_samples * sizeof(uint64_t));
+        position += worker_samples;
+    }
+
+    qsort(latencies, sample_amount, sizeof(uint64_t), __compare_latencies);
+
+    printf("%-10s %8.0f ops/s %8d failed   p50 %9.1f us   p99 %9.1f us   max %9.1f us" NEWLINE, label,
+        operation_amount / (duration_ms / 1000.0), failure_amount,
+        (sample_amount > 0) ? latencies[sample_amount / 2] / 1e3 : 0.0,
+        (sample_amount > 0) ? latencies[(int)(sample_amount * 0.99)] / 1e3 : 0.0,
+        (sample_amount > 0) ? latencies[sample_amount - 1] / 1e3 : 0.0);
+
+    free(latencies);
+}
+
+static int __compare_latencies(const void* x, const void* y)
+{
+    const uint64_t first = *(const uint64_t*)x, second = *(const uint64_t*)y;
+    return (first > second) - (first < second);
+}
@@ -0,0 +1,51 @@
+#include "./bench.h"
+
+/* Private Variables */
+
+/// @brief The database sizes to measure.
+static const int __row_amounts[] = { 1000, 100000, 1000000 };
+
+/// @brief How many times each count runs.
+static const int __iterations = 200;
+
+/* Public Functions */
+
+/// @brief Measures "count_tasks()", which reads a counter, against the table scan it replaced.
+/// @return The exit code of the benchmark.
+int main()
+{
+    for (size_t index = 0; index < sizeof(__row_amounts) / sizeof(__row_amounts[0]); index++)
+    {
+        const int row_amount = __row_amounts[index];
+        const char* db_location = temp_db_create_path();
+        const db_handle* db = (db_location == NULL) ? NULL : create_sqlite_db(db_location);
+        sqlite3* raw_db = NULL;
+
+        if (db == NULL || !temp_db_open_raw(db_location, &raw_db) || !bench_populate(raw_db, row_amount, 48))
+        {
+            sqlite3_close(raw_db);
+            close_sqlite_db(db);
+            temp_db_remove(db_location);
+
+            return EXIT_FAILURE;
+        }
+
+        printf("--- %d rows ---" NEWLINE, row_amount);
+
+        uint64_t start = bench_now_ns();
+        for (int count = 0; count < __iterations; count++)
+            temp_db_query_int(raw_db, "SELECT COUNT(*) FROM tasks;");
+        bench_report("SELECT COUNT(*)", __iterations, bench_now_ns() - start);
+
+        start = bench_now_ns();
+        for (int count = 0; count < __iterations; count++)
+            count_tasks(db);
+        bench_report("count_tasks", __iterations, bench_now_ns() - start);
+
+        sqlite3_close(raw_db);
+        close_sqlite_db(db);
+        temp_db_remove(db_location);
+    }
+
+    return EXIT_SUCCESS;
+}
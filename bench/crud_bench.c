@@ -0,0 +1,166 @@
+#include "./bench.h"
+
+/* Private Variables */
+
+/// @brief The default amount of operations per benchmark.
+static const int __default_iterations = 20000;
+
+/// @brief The content of the tasks written by the benchmarks.
+static const char* const __sample_task = "Buy milk, eggs and bread on the way back home.";
+
+/// @brief The byte budget of the task cache used by the cached pass.
+static const size_t __task_cache_budget = 4 * 1024 * 1024;
+
+/* Function Prototyping */
+
+/// @brief Runs one pass of every CRUD operation without the statement cache,
+/// @brief by compiling and finalizing every query like the database layer used to.
+/// @param raw_db A plain SQLite connection to the database.
+/// @param iterations How many times each operation should run.
+static void __run_uncached(sqlite3* raw_db, const int iterations);
+
+/// @brief Runs one pass of every CRUD operation through the public database API.
+/// @param db The database.
+/// @param raw_db A plain SQLite connection to the same database.
+/// @param iterations How many times each operation should run.
+static void __run_cached(const db_handle* db, sqlite3* raw_db, const int iterations);
+
+/// @brief Compiles, executes and finalizes a query with the specified parameters.
+/// @param raw_db A plain SQLite connection to the database.
+/// @param sql_query The SQL query to execute.
+/// @param id The ID to bind or zero to bind nothing.
+/// @param task The task to bind or NULL to bind nothing.
+static void __execute_uncached(sqlite3* raw_db, const char* sql_query, const int id, const char* task);
+
+/* Public Functions */
+
+/// @brief Measures the per-operation cost of the CRUD functions with and without the statement and task caches.
+/// @param argc The amount of command-line arguments.
+/// @param argv The command-line arguments. The first optional argument is the amount of iterations.
+/// @return The exit code of the benchmark.
+int main(int argc, char** argv)
+{
+    const int iterations = (argc > 1 && atoi(argv[1]) > 0) ? atoi(argv[1]) : __default_iterations;
+    const char* db_location = temp_db_create_path();
+    const db_handle* db = (db_location == NULL) ? NULL : create_sqlite_db(db_location);
+    sqlite3* raw_db = NULL;
+
+    if (db == NULL || !temp_db_open_raw(db_location, &raw_db))
+    {
+        sqlite3_close(raw_db);
+        close_sqlite_db(db);
+        temp_db_remove(db_location);
+
+        return EXIT_FAILURE;
+    }
+
+    printf("--- Before (prepare + finalize per call) ---" NEWLINE);
+    __run_uncached(raw_db, iterations);
+
+    printf("--- After (prepared-statement cache) ---" NEWLINE);
+    __run_cached(db, raw_db, iterations);
+
+    printf("--- With the task cache (%d KiB budget) ---" NEWLINE, (int)(__task_cache_budget / 1024));
+    set_task_cache_budget(db, __task_cache_budget);
+    __run_cached(db, raw_db, iterations);
+
+    const task_cache_stats stats = get_task_cache_stats(db);
+    printf("%-32s hits %lu | misses %lu | evictions %lu" NEWLINE, "task cache", stats.hits, stats.misses, stats.evictions);
+
+    sqlite3_close(raw_db);
+    close_sqlite_db(db);
+    temp_db_remove(db_location);
+
+    return EXIT_SUCCESS;
+}
+
+/* Private Functions */
+
+static void __run_uncached(sqlite3* raw_db, const int iterations)
+{
+    uint64_t start = bench_now_ns();
+    for (int count = 0; count < iterations; count++)
+        __execute_uncached(raw_db, "INSERT INTO tasks (task, created_at) VALUES (?, ?);", 0, __sample_task);
+    bench_report("insert_task", iterations, bench_now_ns() - start);
+
+    const int first_id = (int)sqlite3_last_insert_rowid(raw_db) - iterations + 1;
+
+    start = bench_now_ns();
+    for (int count = 0; count < iterations; count++)
+        __execute_uncached(raw_db, "SELECT 1 FROM tasks WHERE id = ? LIMIT 1;", first_id + count, NULL);
+    bench_report("task_exists", iterations, bench_now_ns() - start);
+
+    start = bench_now_ns();
+    for (int count = 0; count < iterations; count++)
+    {
+        __execute_uncached(raw_db, "SELECT 1 FROM tasks WHERE id = ? LIMIT 1;", first_id + count, NULL);
+        __execute_uncached(raw_db, "SELECT task FROM tasks WHERE id = ?;", first_id + count, NULL);
+    }
+    bench_report("get_task", iterations, bench_now_ns() - start);
+
+    start = bench_now_ns();
+    for (int count = 0; count < iterations; count++)
+        __execute_uncached(raw_db, "UPDATE tasks SET task = ? WHERE id = ?;", first_id + count, __sample_task);
+    bench_report("update_task", iterations, bench_now_ns() - start);
+
+    start = bench_now_ns();
+    for (int count = 0; count < iterations; count++)
+        __execute_uncached(raw_db, "DELETE FROM tasks WHERE id = ?;", first_id + count, NULL);
+    bench_report("delete_task", iterations, bench_now_ns() - start);
+}
+
+static void __run_cached(const db_handle* db, sqlite3* raw_db, const int iterations)
+{
+    uint64_t start = bench_now_ns();
+    for (int count = 0; count < iterations; count++)
+        insert_task(db, __sample_task);
+    bench_report("insert_task", iterations, bench_now_ns() - start);
+
+    const int first_id = bench_max_id(raw_db) - iterations + 1;
+
+    start = bench_now_ns();
+    for (int count = 0; count < iterations; count++)
+        task_exists(db, first_id + count);
+    bench_report("task_exists", iterations, bench_now_ns() - start);
+
+    start = bench_now_ns();
+    for (int count = 0; count < iterations; count++)
+    {
+        db_task db_task = get_task(db, first_id + count);
+        free_db_task(&db_task);
+    }
+    bench_report("get_task", iterations, bench_now_ns() - start);
+
+    start = bench_now_ns();
+    for (int count = 0; count < iterations; count++)
+        update_task(db, first_id + count, __sample_task);
+    bench_report("update_task", iterations, bench_now_ns() - start);
+
+    start = bench_now_ns();
+    for (int count = 0; count < iterations; count++)
+        delete_task(db, first_id + count);
+    bench_report("delete_task", iterations, bench_now_ns() - start);
+}
+
+static void __execute_uncached(sqlite3* raw_db, const char* sql_query, const int id, const char* task)
+{
+    sqlite3_stmt* stmt = NULL;
+
+    if (sqlite3_prepare_v2(raw_db, sql_query, -1, &stmt, NULL) != SQLITE_OK)
+        return;
+
+    int index = 1;
+
+    if (task != NULL)
+        sqlite3_bind_text(stmt, index++, task, -1, SQLITE_STATIC);
+
+    if (id != 0)
+        sqlite3_bind_int(stmt, index, id);
+    else if (task != NULL)
+        sqlite3_bind_int64(stmt, index, get_current_time());
+
+    while (sqlite3_step(stmt) == SQLITE_ROW)
+        sqlite3_column_text(stmt, 0);
+
+    sqlite3_finalize(stmt);
+}
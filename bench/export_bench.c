@@ -0,0 +1,105 @@
+#include <sys/stat.h>
+#include "./bench.h"
+#include "../database/export.h"
+
+/* Private Variables */
+
+/// @brief The default amount of tasks in the database.
+static const int __default_row_amount = 100000;
+
+/// @brief The length of each task.
+static const int __task_length = 200;
+
+/// @brief The amounts of worker threads that are measured.
+static const int __thread_amounts[] = { 1, 2, 4, 8 };
+
+/// @brief The formats that are measured, with their names.
+static const struct { db_export_format format; const char* name; } __formats[] = {
+    { DB_EXPORT_MARKDOWN, "markdown" },
+    { DB_EXPORT_JSONL, "jsonl" },
+    { DB_EXPORT_CSV, "csv" }
+};
+
+/* Function Prototyping */
+
+/// @brief Gets the size of a file.
+/// @param file_location The path of the file.
+/// @return The size in bytes or -1 if the file doesn't exist.
+static long long __get_file_size(const char* file_location);
+
+/* Public Functions */
+
+/// @brief Measures how the text export scales with the amount of worker threads, for each format.
+/// @param argc The amount of command-line arguments.
+/// @param argv The command-line arguments. The first optional argument is the amount of tasks.
+/// @return The exit code of the benchmark.
+int main(int argc, char** argv)
+{
+    const int row_amount = (argc > 1 && atoi(argv[1]) > 0) ? atoi(argv[1]) : __default_row_amount;
+    const int max_thread_amount = __thread_amounts[sizeof(__thread_amounts) / sizeof(__thread_amounts[0]) - 1];
+    const char* db_location = temp_db_create_path();
+    const char* export_location = (db_location == NULL) ? NULL : str_append(db_location, ".export");
+    const db_handle* db = (db_location == NULL) ? NULL : create_sqlite_db_pool(db_location, max_thread_amount);
+    sqlite3* raw_db = NULL;
+    bool success = true;
+
+    if (db == NULL || export_location == NULL || !temp_db_open_raw(db_location, &raw_db) || !bench_populate(raw_db, row_amount, __task_length))
+    {
+        sqlite3_close(raw_db);
+        close_sqlite_db(db);
+        temp_db_remove(db_location);
+        free((char*)export_location);
+
+        return EXIT_FAILURE;
+    }
+
+    for (size_t format_index = 0; format_index < sizeof(__formats) / sizeof(__formats[0]); format_index++)
+    {
+        long long expected_size = -1;
+
+        printf("--- %s (%d tasks) ---" NEWLINE, __formats[format_index].name, row_amount);
+
+        for (size_t index = 0; index < sizeof(__thread_amounts) / sizeof(__thread_amounts[0]); index++)
+        {
+            char name[64];
+            snprintf(name, sizeof(name), "export_tasks (%d threads)", __thread_amounts[index]);
+
+            // Replacing a file makes some filesystems flush the old one on rename, which isn't part of the export.
+            remove(export_location);
+
+            const uint64_t start = bench_now_ns();
+            const int task_amount = export_tasks(db, export_location, __formats[format_index].format, __thread_amounts[index]);
+            bench_report(name, row_amount, bench_now_ns() - start);
+
+            // Every amount of threads must produce the same file.
+            const long long file_size = __get_file_size(export_location);
+
+            if (expected_size < 0)
+                expected_size = file_size;
+
+            if (task_amount != row_amount || file_size != expected_size)
+            {
+                fprintf(stderr, "The export with %d threads wrote %d tasks and %lld bytes." NEWLINE, __thread_amounts[index], task_amount, file_size);
+                success = false;
+            }
+        }
+    }
+
+    // Cleanup
+    remove(export_location);
+    free((char*)export_location);
+    sqlite3_close(raw_db);
+    close_sqlite_db(db);
+    temp_db_remove(db_location);
+
+    return (success) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/* Private Functions */
+
+static long long __get_file_size(const char* file_location)
+{
+    struct stat file_stat;
+
+    return (stat(file_location, &file_stat) == 0) ? (long long)file_stat.st_size : -1;
+}
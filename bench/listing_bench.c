@@ -0,0 +1,189 @@
+#include "./bench.h"
+
+/* Private Types */
+
+/// @brief The tasks read by the per-row allocation strategy.
+typedef struct __legacy_tasks
+{
+    /// @brief The amount of tasks.
+    int amount;
+
+    /// @brief Position of the next row to be written.
+    int index;
+
+    /// @brief The IDs of the tasks.
+    int* task_ids;
+
+    /// @brief The tasks, each one in its own allocation.
+    char** tasks;
+} __legacy_tasks;
+
+/* Private Variables */
+
+/// @brief How many times the heap allocator was called.
+static unsigned long __allocation_count = 0;
+
+/// @brief The default table sizes to benchmark.
+static const int __default_row_amounts[] = { 100000, 1000000 };
+
+/* Function Prototyping */
+
+/// @brief Reads all tasks with one heap allocation per row, like "get_all_tasks()" used to.
+/// @param db The database.
+/// @param raw_db A plain SQLite connection to the same database.
+/// @return How many tasks were read.
+static int __read_legacy(const db_handle* db, sqlite3* raw_db);
+
+/// @brief Reads all tasks into the arena of a "db_tasks" object.
+/// @param db The database.
+/// @param raw_db A plain SQLite connection to the same database.
+/// @return How many tasks were read.
+static int __read_arena(const db_handle* db, sqlite3* raw_db);
+
+/// @brief Runs and reports one listing strategy.
+/// @param name The name of the strategy.
+/// @param reader The function that reads all tasks.
+/// @param db The database.
+/// @param raw_db A plain SQLite connection to the same database.
+static void __measure(const char* name, int (*reader)(const db_handle*, sqlite3*), const db_handle* db, sqlite3* raw_db);
+
+/// @brief Callback that writes one row into a "__legacy_tasks" object.
+static int __callback_legacy_row(void* custom_state, int column_amount, char** column_contents, char** column_names);
+
+/// @brief Callback that reads the result of a "COUNT(*)" query.
+static int __callback_legacy_count(void* custom_state, int column_amount, char** column_contents, char** column_names);
+
+/* Allocator Hooks */
+
+extern void* __libc_malloc(size_t size);
+extern void* __libc_calloc(size_t amount, size_t size);
+extern void* __libc_realloc(void* pointer, size_t size);
+
+void* malloc(size_t size)
+{
+    __allocation_count++;
+    return __libc_malloc(size);
+}
+
+void* calloc(size_t amount, size_t size)
+{
+    __allocation_count++;
+    return __libc_calloc(amount, size);
+}
+
+void* realloc(void* pointer, size_t size)
+{
+    __allocation_count++;
+    return __libc_realloc(pointer, size);
+}
+
+/* Public Functions */
+
+/// @brief Compares allocation counts and throughput of reading all tasks with per-row allocations and with an arena.
+/// @param argc The amount of command-line arguments.
+/// @param argv The command-line arguments. Each optional argument is a table size to benchmark.
+/// @return The exit code of the benchmark.
+int main(int argc, char** argv)
+{
+    const int size_amount = (argc > 1) ? argc - 1 : (int)(sizeof(__default_row_amounts) / sizeof(__default_row_amounts[0]));
+
+    for (int index = 0; index < size_amount; index++)
+    {
+        const int row_amount = (argc > 1) ? atoi(argv[index + 1]) : __default_row_amounts[index];
+        const char* db_location = temp_db_create_path();
+        const db_handle* db = (db_location == NULL) ? NULL : create_sqlite_db(db_location);
+        sqlite3* raw_db = NULL;
+
+        if (db == NULL || !temp_db_open_raw(db_location, &raw_db) || !bench_populate(raw_db, row_amount, 48))
+        {
+            sqlite3_close(raw_db);
+            close_sqlite_db(db);
+            temp_db_remove(db_location);
+
+            return EXIT_FAILURE;
+        }
+
+        // Open the pooled reader up front, so its allocations are not attributed to the first strategy.
+        count_tasks(db);
+
+        printf("--- %d rows ---" NEWLINE, row_amount);
+        __measure("per-row malloc", __read_legacy, db, raw_db);
+        __measure("arena", __read_arena, db, raw_db);
+
+        sqlite3_close(raw_db);
+        close_sqlite_db(db);
+        temp_db_remove(db_location);
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/* Private Functions */
+
+static int __read_legacy(const db_handle* db, sqlite3* raw_db)
+{
+    UNUSED(db);
+
+    __legacy_tasks legacy = { 0 };
+    sqlite3_exec(raw_db, "SELECT COUNT(*) FROM tasks;", __callback_legacy_count, &legacy.amount, NULL);
+
+    legacy.task_ids = calloc(legacy.amount, sizeof(int));
+    legacy.tasks = calloc(legacy.amount, sizeof(char*));
+
+    sqlite3_exec(raw_db, "SELECT id, task FROM tasks;", __callback_legacy_row, &legacy, NULL);
+
+    for (int index = 0; index < legacy.index; index++)
+        free(legacy.tasks[index]);
+
+    free(legacy.task_ids);
+    free(legacy.tasks);
+
+    return legacy.index;
+}
+
+static int __read_arena(const db_handle* db, sqlite3* raw_db)
+{
+    UNUSED(raw_db);
+
+    db_tasks db_tasks = get_all_tasks(db);
+    const int amount = db_tasks.amount;
+
+    free_db_tasks(&db_tasks);
+
+    return amount;
+}
+
+static void __measure(const char* name, int (*reader)(const db_handle*, sqlite3*), const db_handle* db, sqlite3* raw_db)
+{
+    const unsigned long allocations_before = __allocation_count;
+    const uint64_t start = bench_now_ns();
+    const int amount = reader(db, raw_db);
+    const uint64_t elapsed_ns = bench_now_ns() - start;
+
+    bench_report(name, amount, elapsed_ns);
+    printf("%-32s %10lu allocations" NEWLINE, "", __allocation_count - allocations_before);
+}
+
+static int __callback_legacy_row(void* custom_state, int column_amount, char** column_contents, char** column_names)
+{
+    UNUSED(column_amount, column_names);
+
+    __legacy_tasks* legacy = custom_state;
+    const int task_length = strlen(column_contents[1]) + 1;
+    char* content_copy = malloc(task_length);
+
+    strcpy(content_copy, column_contents[1]);
+
+    legacy->task_ids[legacy->index] = atoi(column_contents[0]);
+    legacy->tasks[legacy->index++] = content_copy;
+
+    return 0;
+}
+
+static int __callback_legacy_count(void* custom_state, int column_amount, char** column_contents, char** column_names)
+{
+    UNUSED(column_amount, column_names);
+
+    *((int*)custom_state) = atoi(column_contents[0]);
+    return 0;
+}
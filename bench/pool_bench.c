@@ -0,0 +1,174 @@
+#include <stdatomic.h>
+#include "./bench.h"
+
+/* Private Types */
+
+/// @brief The state shared by the threads of one round.
+typedef struct __round_state
+{
+    /// @brief The database.
+    const db_handle* db;
+
+    /// @brief The highest task ID that readers may request.
+    int max_id;
+
+    /// @brief Set when the threads must stop.
+    atomic_bool stop;
+
+    /// @brief How many reads all reader threads completed.
+    atomic_long reads;
+
+    /// @brief How many writes the writer thread completed.
+    atomic_long writes;
+} __round_state;
+
+/* Private Variables */
+
+/// @brief How long each round runs, in milliseconds.
+static const int __round_duration_ms = 1000;
+
+/// @brief How many tasks the database has before the rounds start.
+static const int __row_amount = 100000;
+
+/* Function Prototyping */
+
+/// @brief Reads random tasks until the round is stopped.
+/// @param custom_state The "__round_state" of the round.
+/// @return NULL.
+static void* __reader_thread(void* custom_state);
+
+/// @brief Inserts and deletes tasks until the round is stopped.
+/// @param custom_state The "__round_state" of the round.
+/// @return NULL.
+static void* __writer_thread(void* custom_state);
+
+/// @brief Runs one round with the specified amount of reader threads and one writer thread.
+/// @param db_location The path to the database file.
+/// @param reader_amount How many reader threads to run.
+/// @param max_id The highest task ID that readers may request.
+/// @return True if the round ran, False otherwise.
+static bool __run_round(const char* db_location, const int reader_amount, const int max_id);
+
+/* Public Functions */
+
+/// @brief Measures how read throughput scales with reader threads while a writer thread keeps writing.
+/// @param argc The amount of command-line arguments.
+/// @param argv The command-line arguments. The first optional argument is the maximum amount of reader threads.
+/// @return The exit code of the benchmark.
+int main(int argc, char** argv)
+{
+    const long processor_amount = sysconf(_SC_NPROCESSORS_ONLN);
+    const int max_readers = (argc > 1 && atoi(argv[1]) > 0) ? atoi(argv[1]) : max(2, (int)processor_amount);
+    const char* db_location = temp_db_create_path();
+    const db_handle* db = (db_location == NULL) ? NULL : create_sqlite_db(db_location);
+    sqlite3* raw_db = NULL;
+
+    // Create the schema through the database layer, then fill it through a plain connection.
+    const bool is_ready = db != NULL
+        && temp_db_open_raw(db_location, &raw_db)
+        && bench_populate(raw_db, __row_amount, 64);
+
+    sqlite3_close(raw_db);
+    close_sqlite_db(db);
+
+    if (!is_ready)
+    {
+        temp_db_remove(db_location);
+        return EXIT_FAILURE;
+    }
+
+    printf("%ld processors online" NEWLINE, processor_amount);
+
+    for (int reader_amount = 1; reader_amount <= max_readers; reader_amount *= 2)
+        __run_round(db_location, reader_amount, __row_amount);
+
+    temp_db_remove(db_location);
+
+    return EXIT_SUCCESS;
+}
+
+/* Private Functions */
+
+static bool __run_round(const char* db_location, const int reader_amount, const int max_id)
+{
+    __round_state state = { .db = create_sqlite_db_pool(db_location, reader_amount), .max_id = max_id };
+    pthread_t* readers = calloc(reader_amount, sizeof(pthread_t));
+    pthread_t writer;
+
+    if (state.db == NULL || readers == NULL)
+    {
+        close_sqlite_db(state.db);
+        free(readers);
+
+        return false;
+    }
+
+    atomic_init(&state.stop, false);
+    atomic_init(&state.reads, 0);
+    atomic_init(&state.writes, 0);
+
+    const uint64_t start = bench_now_ns();
+
+    pthread_create(&writer, NULL, __writer_thread, &state);
+
+    for (int index = 0; index < reader_amount; index++)
+        pthread_create(&readers[index], NULL, __reader_thread, &state);
+
+    usleep(__round_duration_ms * 1000);
+    atomic_store(&state.stop, true);
+
+    for (int index = 0; index < reader_amount; index++)
+        pthread_join(readers[index], NULL);
+
+    pthread_join(writer, NULL);
+
+    const uint64_t elapsed_ns = bench_now_ns() - start;
+    char name[64];
+
+    snprintf(name, sizeof(name), "%d readers: get_task", reader_amount);
+    bench_report(name, (int)atomic_load(&state.reads), elapsed_ns);
+
+    snprintf(name, sizeof(name), "%d readers: insert+delete", reader_amount);
+    bench_report(name, (int)atomic_load(&state.writes), elapsed_ns);
+
+    close_sqlite_db(state.db);
+    free(readers);
+
+    return true;
+}
+
+static void* __reader_thread(void* custom_state)
+{
+    __round_state* state = custom_state;
+    unsigned int seed = (unsigned int)(uintptr_t)pthread_self();
+    long reads = 0;
+
+    while (!atomic_load_explicit(&state->stop, memory_order_relaxed))
+    {
+        db_task db_task = get_task(state->db, 1 + rand_r(&seed) % state->max_id);
+        free_db_task(&db_task);
+        reads++;
+    }
+
+    atomic_fetch_add(&state->reads, reads);
+
+    return NULL;
+}
+
+static void* __writer_thread(void* custom_state)
+{
+    __round_state* state = custom_state;
+    long writes = 0;
+
+    while (!atomic_load_explicit(&state->stop, memory_order_relaxed))
+    {
+        // The new task always gets the ID after "max_id", which readers never request.
+        insert_task(state->db, "Task written while readers are running.");
+        delete_task(state->db, state->max_id + 1);
+        writes++;
+    }
+
+    atomic_fetch_add(&state->writes, writes);
+
+    return NULL;
+}
@@ -0,0 +1,99 @@
+#include "./bench.h"
+
+/* Private Variables */
+
+/// @brief The default amount of tasks in the database.
+static const int __default_row_amount = 100000;
+
+/// @brief How many time-range queries each pass runs.
+static const int __query_amount = 200;
+
+/// @brief The length of each queried range: one week, in seconds.
+static const time_t __range_length = 7 * 24 * 60 * 60;
+
+/* Function Prototyping */
+
+/// @brief Writes the query plan of the time-range query to stdout.
+/// @param raw_db A plain SQLite connection to the database.
+static void __print_query_plan(sqlite3* raw_db);
+
+/// @brief Runs one week-long time-range query at evenly spread offsets.
+/// @param db The database.
+/// @param row_amount How many tasks are in the database.
+/// @param name The name of the pass.
+static void __run_queries(const db_handle* db, const int row_amount, const char* name);
+
+/* Public Functions */
+
+/// @brief Measures "get_tasks_between()" with and without the index on the creation time of the tasks.
+/// @param argc The amount of command-line arguments.
+/// @param argv The command-line arguments. The first optional argument is the amount of tasks.
+/// @return The exit code of the benchmark.
+int main(int argc, char** argv)
+{
+    const int row_amount = (argc > 1 && atoi(argv[1]) > 0) ? atoi(argv[1]) : __default_row_amount;
+    const char* db_location = temp_db_create_path();
+    const db_handle* db = (db_location == NULL) ? NULL : create_sqlite_db(db_location);
+    sqlite3* raw_db = NULL;
+
+    if (db == NULL || !temp_db_open_raw(db_location, &raw_db) || !bench_populate(raw_db, row_amount, 64))
+    {
+        sqlite3_close(raw_db);
+        close_sqlite_db(db);
+        temp_db_remove(db_location);
+
+        return EXIT_FAILURE;
+    }
+
+    printf("--- With the created_at index ---" NEWLINE);
+    __print_query_plan(raw_db);
+    __run_queries(db, row_amount, "get_tasks_between (1 week)");
+
+    // Cached statements are recompiled by SQLite once the schema changes.
+    sqlite3_exec(raw_db, "DROP INDEX tasks_created_at;", NULL, NULL, NULL);
+
+    printf("--- Without the index (full scan) ---" NEWLINE);
+    __print_query_plan(raw_db);
+    __run_queries(db, row_amount, "get_tasks_between (1 week)");
+
+    sqlite3_close(raw_db);
+    close_sqlite_db(db);
+    temp_db_remove(db_location);
+
+    return EXIT_SUCCESS;
+}
+
+/* Private Functions */
+
+static void __print_query_plan(sqlite3* raw_db)
+{
+    sqlite3_stmt* stmt = NULL;
+    const char* sql_query = "EXPLAIN QUERY PLAN " DB_TASKS_BETWEEN_QUERY;
+
+    if (sqlite3_prepare_v2(raw_db, sql_query, -1, &stmt, NULL) != SQLITE_OK)
+        return;
+
+    while (sqlite3_step(stmt) == SQLITE_ROW)
+        printf("plan: %s" NEWLINE, (const char*)sqlite3_column_text(stmt, 3));
+
+    sqlite3_finalize(stmt);
+}
+
+static void __run_queries(const db_handle* db, const int row_amount, const char* name)
+{
+    const time_t last_created_at = (time_t)row_amount * 60;
+    long returned_amount = 0;
+
+    const uint64_t start = bench_now_ns();
+    for (int count = 0; count < __query_amount; count++)
+    {
+        const time_t from = (last_created_at - __range_length) * count / __query_amount;
+        db_tasks db_tasks = get_tasks_between(db, from, from + __range_length);
+
+        returned_amount += db_tasks.amount;
+        free_db_tasks(&db_tasks);
+    }
+    bench_report(name, __query_amount, bench_now_ns() - start);
+
+    printf("%-32s %10ld per query" NEWLINE, "tasks returned", returned_amount / __query_amount);
+}
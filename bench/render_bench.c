@@ -0,0 +1,179 @@
+#define _GNU_SOURCE // posix_openpt(), grantpt(), unlockpt() and ptsname()
+#include <fcntl.h>
+#include <pthread.h>
+#include "./bench.h"
+#include "../core/renderer.h"
+
+/* Private Variables */
+
+/// @brief The default amount of frames drawn by each renderer.
+static const int __default_frame_amount = 2000;
+
+/// @brief The amount of notes on each frame, like a page of "Read all notes".
+static const int __notes_per_frame = 10;
+
+/// @brief The amount of characters of each frame line.
+static const int __frame_char_amount = 25;
+
+/// @brief The content of the notes on each frame.
+static const char* const __sample_task = "Buy milk, eggs and bread on the way back home.";
+
+/// @brief The main menu, drawn at the top of each frame.
+static const char* const __menu =
+    "Welcome to TodoC!" NEWLINE
+    "Select one of the options below:" NEWLINE
+    "1. Create a new note." NEWLINE
+    "2. Edit a note." NEWLINE
+    "3. Delete a note." NEWLINE
+    "4. Read a specific note." NEWLINE
+    "5. Read all notes." NEWLINE
+    "6. Search notes." NEWLINE
+    "0. Exit." NEWLINE;
+
+/* Function Prototyping */
+
+/// @brief Draws a frame the way the menu used to: "clear" through a shell, then one "printf()" per frame character.
+/// @param terminal The line-buffered stream of the terminal.
+static void __draw_legacy_frame(FILE* terminal);
+
+/// @brief Draws a frame with a renderer and writes it at once.
+/// @param renderer The renderer.
+static void __draw_buffered_frame(renderer* renderer);
+
+/// @brief Reads and discards everything written to a pseudo-terminal, like a terminal emulator would.
+/// @param master_fd Pointer to the master side of the pseudo-terminal.
+/// @return Always NULL.
+static void* __drain_terminal(void* master_fd);
+
+/* Public Functions */
+
+/// @brief Measures how many frames per second the menu draws with "system(\"clear\")" and per-character "printf()",
+/// @brief against the buffered renderer on a pseudo-terminal and on a non-terminal output.
+/// @param argc The amount of command-line arguments.
+/// @param argv The command-line arguments. The first optional argument is the amount of frames.
+/// @return The exit code of the benchmark.
+int main(int argc, char** argv)
+{
+    const int frame_amount = (argc > 1 && atoi(argv[1]) > 0) ? atoi(argv[1]) : __default_frame_amount;
+    int master_fd = posix_openpt(O_RDWR | O_NOCTTY);
+
+    if (master_fd < 0 || grantpt(master_fd) != 0 || unlockpt(master_fd) != 0)
+    {
+        fprintf(stderr, "Could not open a pseudo-terminal." NEWLINE);
+        return EXIT_FAILURE;
+    }
+
+    const int terminal_fd = open(ptsname(master_fd), O_WRONLY | O_NOCTTY);
+    const int null_fd = open("/dev/null", O_WRONLY);
+    const int stdout_fd = dup(STDOUT_FILENO);
+    FILE* terminal = (terminal_fd < 0) ? NULL : fdopen(dup(terminal_fd), "w");
+    renderer* terminal_renderer = (terminal_fd < 0) ? NULL : create_renderer(terminal_fd);
+    renderer* null_renderer = (null_fd < 0) ? NULL : create_renderer(null_fd);
+    pthread_t drain;
+
+    if (terminal == NULL || terminal_renderer == NULL || null_renderer == NULL || stdout_fd < 0
+        || pthread_create(&drain, NULL, __drain_terminal, &master_fd) != 0)
+    {
+        fprintf(stderr, "Could not set up the benchmark." NEWLINE);
+        return EXIT_FAILURE;
+    }
+
+    // An interactive stdout is line-buffered and "clear" needs to know the terminal.
+    setvbuf(terminal, NULL, _IOLBF, BUFSIZ);
+    setenv("TERM", "xterm", false);
+
+    printf("%d notes per frame, terminal renderer: %s, /dev/null renderer: %s" NEWLINE, __notes_per_frame,
+        is_terminal_renderer(terminal_renderer) ? "clears" : "plain", is_terminal_renderer(null_renderer) ? "clears" : "plain");
+    fflush(stdout);
+
+    // "clear" runs as a child process and writes to stdout, so stdout points to the pseudo-terminal while it runs.
+    dup2(terminal_fd, STDOUT_FILENO);
+
+    uint64_t start = bench_now_ns();
+    for (int frame = 0; frame < frame_amount; frame++)
+        __draw_legacy_frame(terminal);
+    const uint64_t legacy_ns = bench_now_ns() - start;
+
+    dup2(stdout_fd, STDOUT_FILENO);
+
+    bench_report("system(clear) + printf (pty)", frame_amount, legacy_ns);
+
+    start = bench_now_ns();
+    for (int frame = 0; frame < frame_amount; frame++)
+        __draw_buffered_frame(terminal_renderer);
+    bench_report("renderer (pty)", frame_amount, bench_now_ns() - start);
+
+    start = bench_now_ns();
+    for (int frame = 0; frame < frame_amount; frame++)
+        __draw_buffered_frame(null_renderer);
+    bench_report("renderer (/dev/null)", frame_amount, bench_now_ns() - start);
+
+    // Closing every side of the pseudo-terminal stops the drain thread.
+    fclose(terminal);
+    free_renderer(terminal_renderer);
+    free_renderer(null_renderer);
+    close(terminal_fd);
+    close(null_fd);
+    close(stdout_fd);
+    pthread_join(drain, NULL);
+    close(master_fd);
+
+    return EXIT_SUCCESS;
+}
+
+/* Private Functions */
+
+static void __draw_legacy_frame(FILE* terminal)
+{
+    fflush(terminal);
+
+    if (system("clear") != 0)
+        return;
+
+    fprintf(terminal, "%s", __menu);
+
+    for (int count = 0; count < __frame_char_amount; count++)
+        fprintf(terminal, "%c", '=');
+    fprintf(terminal, NEWLINE);
+
+    for (int note = 0; note < __notes_per_frame; note++)
+    {
+        fprintf(terminal, "--- Note ID: %d ---" NEWLINE, note + 1);
+        fwrite(__sample_task, sizeof(char), strlen(__sample_task), terminal);
+        fprintf(terminal, NEWLINE);
+    }
+
+    for (int count = 0; count < __frame_char_amount; count++)
+        fprintf(terminal, "%c", '=');
+    fprintf(terminal, NEWLINE "> ");
+    fflush(terminal);
+}
+
+static void __draw_buffered_frame(renderer* renderer)
+{
+    begin_frame(renderer);
+    render_text(renderer, __menu, strlen(__menu));
+
+    render_char(renderer, '=', __frame_char_amount);
+    render_text(renderer, NEWLINE, strlen(NEWLINE));
+
+    for (int note = 0; note < __notes_per_frame; note++)
+    {
+        render_format(renderer, "--- Note ID: %d ---" NEWLINE, note + 1);
+        render_text(renderer, __sample_task, strlen(__sample_task));
+        render_text(renderer, NEWLINE, strlen(NEWLINE));
+    }
+
+    render_char(renderer, '=', __frame_char_amount);
+    render_text(renderer, NEWLINE "> ", strlen(NEWLINE "> "));
+    present_frame(renderer);
+}
+
+static void* __drain_terminal(void* master_fd)
+{
+    char buffer[4096];
+
+    while (read(*(int*)master_fd, buffer, sizeof(buffer)) > 0);
+
+    return NULL;
+}
@@ -0,0 +1,354 @@
+#include "./bench.h"
+
+/* Private Types */
+
+/// @brief How the results are written.
+typedef enum __output_format
+{
+    /// @brief Aligned columns for people.
+    __FORMAT_TEXT,
+
+    /// @brief Comma-separated values with a header row.
+    __FORMAT_CSV,
+
+    /// @brief One JSON object per line.
+    __FORMAT_JSONL
+} __output_format;
+
+/// @brief A length distribution and its name in the results.
+typedef struct __length_profile
+{
+    /// @brief The name of the distribution.
+    const char* name;
+
+    /// @brief The distribution.
+    bench_length_distribution distribution;
+} __length_profile;
+
+/// @brief What a result row describes.
+typedef struct __run_context
+{
+    /// @brief How the results are written.
+    __output_format format;
+
+    /// @brief The amount of tasks in the table before the run.
+    int row_amount;
+
+    /// @brief The name of the length distribution of the tasks.
+    const char* length_name;
+
+    /// @brief The mean length of the tasks.
+    int mean_length;
+} __run_context;
+
+/* Private Variables */
+
+/// @brief The default size of the largest table. The smaller ones are ten, a hundred... times smaller.
+static const int __default_max_row_amount = 100000;
+
+/// @brief The size of the smallest table.
+static const int __min_row_amount = 1000;
+
+/// @brief The default amount of operations of each single-task workload.
+static const int __default_operation_amount = 2000;
+
+/// @brief How many times "get_all_tasks()" runs in the warm workload.
+static const int __list_repetitions = 5;
+
+/// @brief The default mean length of the synthetic tasks.
+static const int __default_mean_length = 200;
+
+/// @brief The seed of the synthetic tasks and of the IDs each workload picks, so every run does the same work.
+static const uint64_t __seed = 0x7D0C;
+
+/// @brief The byte budget of the task cache in the warm workloads.
+static const size_t __task_cache_budget = 16 * 1024 * 1024;
+
+/// @brief The length distributions every table size runs with, unless one is picked.
+static const __length_profile __length_profiles[] = {
+    { "fixed", BENCH_LENGTH_FIXED },
+    { "uniform", BENCH_LENGTH_UNIFORM },
+    { "skewed", BENCH_LENGTH_SKEWED }
+};
+
+/* Function Prototyping */
+
+/// @brief Runs every workload on a new database with the specified size and task lengths.
+/// @param context The size and length distribution of the run.
+/// @param distribution The length distribution.
+/// @param operation_amount The amount of operations of each single-task workload.
+/// @return True if the database could be set up, False otherwise.
+static bool __run_table(const __run_context* context, const bench_length_distribution distribution, const int operation_amount);
+
+/// @brief Reads random tasks with "get_task()" and records the latency of each one.
+/// @param db The database.
+/// @param ids The IDs to read.
+/// @param operation_amount The amount of IDs.
+/// @param latencies Receives the latencies.
+static void __measure_get_task(const db_handle* db, const int* ids, const int operation_amount, bench_latencies* latencies);
+
+/// @brief Reads every task with "get_all_tasks()" and records the latency of each read.
+/// @param db The database.
+/// @param repetitions How many times every task is read.
+/// @param latencies Receives the latencies.
+static void __measure_get_all_tasks(const db_handle* db, const int repetitions, bench_latencies* latencies);
+
+/// @brief Closes a database, drops its file from the page cache of the kernel and opens it again with empty caches.
+/// @param db The database. Closed by this function.
+/// @param db_location The path to the database file.
+/// @return The reopened database or NULL if it could not be opened.
+static const db_handle* __reopen_cold(const db_handle* db, const char* db_location);
+
+/// @brief Writes the header of the results, if the format has one.
+/// @param format The format of the results.
+static void __print_header(const __output_format format);
+
+/// @brief Writes the throughput and latency percentiles of a workload.
+/// @param context The size and length distribution of the run.
+/// @param cache_state "cold" or "warm".
+/// @param operation The name of the measured function.
+/// @param latencies The latencies of the workload.
+static void __print_result(const __run_context* context, const char* cache_state, const char* operation, bench_latencies* latencies);
+
+/* Public Functions */
+
+/// @brief Measures how the CRUD functions scale with the size of the table and the length of the tasks, with cold and warm caches.
+/// @param argc The amount of command-line arguments.
+/// @param argv The command-line arguments, all optional: the size of the largest table, the amount of operations of each workload, the output format ("text", "csv" or "jsonl"), the mean length of the tasks and their length distribution ("fixed", "uniform", "skewed" or "all").
+/// @return The exit code of the benchmark.
+int main(int argc, char** argv)
+{
+    const int max_row_amount = (argc > 1 && atoi(argv[1]) > 0) ? atoi(argv[1]) : __default_max_row_amount;
+    const int operation_amount = (argc > 2 && atoi(argv[2]) > 0) ? atoi(argv[2]) : __default_operation_amount;
+    const char* length_name = (argc > 5 && strcmp(argv[5], "all") != 0) ? argv[5] : NULL;
+    __run_context context = {
+        .format = (argc > 3 && strcmp(argv[3], "csv") == 0) ? __FORMAT_CSV
+            : (argc > 3 && strcmp(argv[3], "jsonl") == 0) ? __FORMAT_JSONL
+            : __FORMAT_TEXT,
+        .mean_length = (argc > 4 && atoi(argv[4]) > 0) ? atoi(argv[4]) : __default_mean_length
+    };
+    bool is_known_length = length_name == NULL;
+
+    for (size_t index = 0; index < sizeof(__length_profiles) / sizeof(__length_profiles[0]); index++)
+        is_known_length = is_known_length || strcmp(length_name, __length_profiles[index].name) == 0;
+
+    if (!is_known_length)
+    {
+        fprintf(stderr, "Unknown length distribution \"%s\". Use \"fixed\", \"uniform\", \"skewed\" or \"all\"." NEWLINE, length_name);
+        return EXIT_FAILURE;
+    }
+
+    __print_header(context.format);
+
+    for (int row_amount = min(__min_row_amount, max_row_amount); row_amount <= max_row_amount; row_amount *= 10)
+    {
+        for (size_t index = 0; index < sizeof(__length_profiles) / sizeof(__length_profiles[0]); index++)
+        {
+            if (length_name != NULL && strcmp(length_name, __length_profiles[index].name) != 0)
+                continue;
+
+            context.row_amount = row_amount;
+            context.length_name = __length_profiles[index].name;
+
+            if (!__run_table(&context, __length_profiles[index].distribution, operation_amount))
+            {
+                fprintf(stderr, "Could not set up a database with %d tasks." NEWLINE, row_amount);
+                return EXIT_FAILURE;
+            }
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/* Private Functions */
+
+static bool __run_table(const __run_context* context, const bench_length_distribution distribution, const int operation_amount)
+{
+    const char* db_location = temp_db_create_path();
+    const db_handle* db = (db_location == NULL) ? NULL : create_sqlite_db(db_location);
+    sqlite3* raw_db = NULL;
+    int* ids = malloc(operation_amount * sizeof(int));
+    const char** tasks = calloc(operation_amount, sizeof(char*));
+    uint64_t random_state = __seed;
+
+    const bool is_ready = db != NULL && ids != NULL && tasks != NULL && temp_db_open_raw(db_location, &raw_db)
+        && bench_populate_distribution(raw_db, context->row_amount, context->mean_length, distribution, __seed);
+
+    sqlite3_close(raw_db);
+
+    if (!is_ready)
+    {
+        free(ids);
+        free(tasks);
+        close_sqlite_db(db);
+        temp_db_remove(db_location);
+
+        return false;
+    }
+
+    // The same IDs are read cold and warm, and the same tasks are written in every run.
+    for (int index = 0; index < operation_amount; index++)
+    {
+        const int length = bench_task_length(context->mean_length, distribution, &random_state);
+        char* task = malloc(length + 1);
+
+        ids[index] = 1 + (int)(bench_random(&random_state) % (uint64_t)context->row_amount);
+
+        if (task != NULL)
+            bench_fill_task(task, length, index + 1, &random_state);
+
+        tasks[index] = task;
+    }
+
+    bench_latencies latencies = bench_create_latencies(max(operation_amount, __list_repetitions));
+
+    // Cold: a new handle with empty SQLite, statement and task caches, reading a file the kernel doesn't have in memory.
+    db = __reopen_cold(db, db_location);
+    __measure_get_all_tasks(db, 1, &latencies);
+    __print_result(context, "cold", "get_all_tasks", &latencies);
+
+    db = __reopen_cold(db, db_location);
+    __measure_get_task(db, ids, operation_amount, &latencies);
+    __print_result(context, "cold", "get_task", &latencies);
+
+    // Warm: the task cache is on and every read was done once before it's measured.
+    set_task_cache_budget(db, __task_cache_budget);
+    __measure_get_task(db, ids, operation_amount, &latencies);
+    __measure_get_task(db, ids, operation_amount, &latencies);
+    __print_result(context, "warm", "get_task", &latencies);
+
+    __measure_get_all_tasks(db, 1, &latencies);
+    __measure_get_all_tasks(db, __list_repetitions, &latencies);
+    __print_result(context, "warm", "get_all_tasks", &latencies);
+
+    // Writes are measured on the warm handle. Each one commits, so they are bound by the disk.
+    latencies.amount = 0;
+    latencies.total_ns = 0;
+    const int first_id = count_tasks(db) + 1;
+
+    for (int index = 0; db != NULL && index < operation_amount; index++)
+    {
+        const uint64_t start = bench_now_ns();
+
+        if (tasks[index] != NULL && insert_task(db, tasks[index]))
+            bench_record(&latencies, bench_now_ns() - start);
+    }
+    __print_result(context, "warm", "insert_task", &latencies);
+
+    latencies.amount = 0;
+    latencies.total_ns = 0;
+
+    for (int index = 0; db != NULL && index < operation_amount; index++)
+    {
+        const uint64_t start = bench_now_ns();
+
+        if (tasks[operation_amount - index - 1] != NULL && update_task(db, ids[index], tasks[operation_amount - index - 1]))
+            bench_record(&latencies, bench_now_ns() - start);
+    }
+    __print_result(context, "warm", "update_task", &latencies);
+
+    latencies.amount = 0;
+    latencies.total_ns = 0;
+
+    for (int index = 0; db != NULL && index < operation_amount; index++)
+    {
+        const uint64_t start = bench_now_ns();
+
+        if (delete_task(db, first_id + index))
+            bench_record(&latencies, bench_now_ns() - start);
+    }
+    __print_result(context, "warm", "delete_task", &latencies);
+
+    for (int index = 0; index < operation_amount; index++)
+        free((char*)tasks[index]);
+
+    bench_free_latencies(&latencies);
+    free(tasks);
+    free(ids);
+    close_sqlite_db(db);
+    temp_db_remove(db_location);
+
+    return true;
+}
+
+static void __measure_get_task(const db_handle* db, const int* ids, const int operation_amount, bench_latencies* latencies)
+{
+    latencies->amount = 0;
+    latencies->total_ns = 0;
+
+    for (int index = 0; db != NULL && index < operation_amount; index++)
+    {
+        const uint64_t start = bench_now_ns();
+        db_task task = get_task(db, ids[index]);
+        const uint64_t elapsed_ns = bench_now_ns() - start;
+
+        if (task.task != NULL)
+            bench_record(latencies, elapsed_ns);
+
+        free_db_task(&task);
+    }
+}
+
+static void __measure_get_all_tasks(const db_handle* db, const int repetitions, bench_latencies* latencies)
+{
+    latencies->amount = 0;
+    latencies->total_ns = 0;
+
+    for (int repetition = 0; db != NULL && repetition < repetitions; repetition++)
+    {
+        const uint64_t start = bench_now_ns();
+        db_tasks tasks = get_all_tasks(db);
+        const uint64_t elapsed_ns = bench_now_ns() - start;
+
+        if (tasks.amount > 0)
+            bench_record(latencies, elapsed_ns);
+
+        free_db_tasks(&tasks);
+    }
+}
+
+static const db_handle* __reopen_cold(const db_handle* db, const char* db_location)
+{
+    close_sqlite_db(db);
+    bench_drop_file_cache(db_location);
+
+    return create_sqlite_db(db_location);
+}
+
+static void __print_header(const __output_format format)
+{
+    if (format == __FORMAT_CSV)
+        printf("operation,rows,lengths,mean_length,cache,ops,ops_per_s,p50_us,p99_us,p999_us,max_us" NEWLINE);
+    else if (format == __FORMAT_TEXT)
+        printf("%-14s %8s %-8s %6s %-5s %6s %12s %10s %10s %10s %10s" NEWLINE,
+            "operation", "rows", "lengths", "mean", "cache", "ops", "ops/s", "p50 us", "p99 us", "p999 us", "max us");
+}
+
+static void __print_result(const __run_context* context, const char* cache_state, const char* operation, bench_latencies* latencies)
+{
+    const double ops_per_second = (latencies->total_ns > 0) ? latencies->amount / (latencies->total_ns / 1e9) : 0;
+    const double p50_us = bench_percentile(latencies, 0.5) / 1e3;
+    const double p99_us = bench_percentile(latencies, 0.99) / 1e3;
+    const double p999_us = bench_percentile(latencies, 0.999) / 1e3;
+    const double max_us = bench_percentile(latencies, 1) / 1e3;
+
+    switch (context->format)
+    {
+        case __FORMAT_CSV:
+            printf("%s,%d,%s,%d,%s,%d,%.0f,%.2f,%.2f,%.2f,%.2f" NEWLINE, operation, context->row_amount, context->length_name,
+                context->mean_length, cache_state, latencies->amount, ops_per_second, p50_us, p99_us, p999_us, max_us);
+            break;
+        case __FORMAT_JSONL:
+            printf("{\"operation\":\"%s\",\"rows\":%d,\"lengths\":\"%s\",\"mean_length\":%d,\"cache\":\"%s\",\"ops\":%d,"
+                "\"ops_per_s\":%.0f,\"p50_us\":%.2f,\"p99_us\":%.2f,\"p999_us\":%.2f,\"max_us\":%.2f}" NEWLINE, operation,
+                context->row_amount, context->length_name, context->mean_length, cache_state, latencies->amount, ops_per_second, p50_us, p99_us, p999_us, max_us);
+            break;
+        default:
+            printf("%-14s %8d %-8s %6d %-5s %6d %12.0f %10.2f %10.2f %10.2f %10.2f" NEWLINE, operation, context->row_amount,
+                context->length_name, context->mean_length, cache_state, latencies->amount, ops_per_second, p50_us, p99_us, p999_us, max_us);
+            break;
+    }
+
+    fflush(stdout);
+}
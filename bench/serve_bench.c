@@ -0,0 +1,547 @@
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include "./bench.h"
+#include "../core/server.h"
+
+/* Private Types */
+
+/// @brief What a client process measured, in memory shared with the parent.
+typedef struct __client_result
+{
+    /// @brief How many requests were answered.
+    int request_amount;
+
+    /// @brief How many requests were answered with an error status.
+    int failure_amount;
+
+    /// @brief How many batches were sent.
+    int batch_amount;
+
+    /// @brief The round trip of each batch, in nanoseconds. Holds up to "__max_samples" values.
+    uint64_t latencies_ns[];
+} __client_result;
+
+/* Private Variables */
+
+/// @brief The default amount of client processes.
+static const int __default_client_amount = 4;
+
+/// @brief The default amount of requests each client sends before reading the responses.
+static const int __default_pipeline_depth = 32;
+
+/// @brief The default duration of each run, in milliseconds.
+static const int __default_duration_ms = 2000;
+
+/// @brief The amount of tasks in the database before the clients start.
+static const int __initial_row_amount = 10000;
+
+/// @brief The length of each initial task.
+static const int __initial_task_length = 48;
+
+/// @brief The most batch latencies a client records.
+static const int __max_samples = 200000;
+
+/// @brief Out of every 100 requests of the mixed run, how many add a task.
+static const int __add_percentage = 10;
+
+/// @brief The initial size of the buffer that receives the responses. Grows to fit larger tasks.
+static const size_t __response_buffer_size = 1024 * 1024;
+
+/// @brief How long to wait for the server to start listening, in milliseconds.
+static const int __startup_timeout_ms = 5000;
+
+/// @brief The content of the tasks added by the clients.
+static const char* const __sample_task = "Buy milk, eggs and bread on the way back home.";
+
+/* Function Prototyping */
+
+/// @brief Runs several clients against the server for a while, then reports the throughput and the batch latency.
+/// @param socket_location The path of the server socket.
+/// @param name The name of the run.
+/// @param client_amount The amount of client processes.
+/// @param pipeline_depth How many requests each client sends before reading the responses.
+/// @param add_percentage Out of every 100 requests, how many add a task. The others read a random task.
+/// @param max_id The highest ID the reads pick.
+/// @param duration_ms How long the clients run, in milliseconds.
+static void __run_load(const char* socket_location, const char* name, const int client_amount, const int pipeline_depth,
+    const int add_percentage, const int max_id, const int duration_ms);
+
+/// @brief Body of a client process: connects, waits for the start signal, then sends batches until the time is up.
+/// @param socket_location The path of the server socket.
+/// @param pipeline_depth How many requests each batch has.
+/// @param add_percentage Out of every 100 requests, how many add a task.
+/// @param max_id The highest ID the reads pick.
+/// @param start_pipe The read end of the pipe that's closed to start every client at once.
+/// @param duration_ms How long to run, in milliseconds.
+/// @param result Where to write the measurements.
+static void __run_client(const char* socket_location, const int pipeline_depth, const int add_percentage, const int max_id,
+    const int start_pipe, const int duration_ms, __client_result* result);
+
+/// @brief Connects to the server.
+/// @param socket_location The path of the server socket.
+/// @return The socket or -1 if the server isn't listening.
+static int __connect_server(const char* socket_location);
+
+/// @brief Sends a single request and waits for its response.
+/// @param fd The socket.
+/// @param operation The operation of the request.
+/// @param payload The payload of the request.
+/// @param payload_length The length of the payload.
+/// @param value Receives the integer the response starts with, if any.
+/// @return The status of the response or -1 if the connection failed.
+static int __call_server(const int fd, const unsigned char operation, const void* payload, const size_t payload_length, uint32_t* value);
+
+/// @brief Appends a request to a batch.
+/// @param batch The batch.
+/// @param position Where the request is written. Moved past it.
+/// @param operation The operation of the request.
+/// @param payload The payload of the request.
+/// @param payload_length The length of the payload.
+static void __append_request(unsigned char* batch, size_t* position, const unsigned char operation, const void* payload, const size_t payload_length);
+
+/// @brief Reads the responses of a batch.
+/// @param fd The socket.
+/// @param buffer The buffer that receives the responses. Grown if a response doesn't fit.
+/// @param capacity The size of the buffer.
+/// @param response_amount How many responses to read.
+/// @param failure_amount Incremented for each response with an error status.
+/// @return True if every response was read, False if the connection failed.
+static bool __read_responses(const int fd, unsigned char** buffer, size_t* capacity, const int response_amount, int* failure_amount);
+
+/// @brief Sends every byte of a buffer.
+/// @param fd The socket.
+/// @param data The bytes.
+/// @param length The amount of bytes.
+/// @return True if every byte was sent, False otherwise.
+static bool __send_all(const int fd, const void* data, const size_t length);
+
+/// @brief Reports the throughput and batch latency percentiles of the clients of a run.
+/// @param results The result of the first client.
+/// @param client_amount The amount of clients.
+/// @param result_size The size of each result.
+/// @param duration_ms How long the clients ran, in milliseconds.
+static void __report_clients(const unsigned char* results, const int client_amount, const size_t result_size, const int duration_ms);
+
+/// @brief Writes a 32-bit integer in little-endian order.
+/// @param bytes Where the integer is written.
+/// @param value The integer.
+static void __write_uint32(unsigned char* bytes, const uint32_t value);
+
+/// @brief Reads a 32-bit integer stored in little-endian order.
+/// @param bytes Where the integer is stored.
+/// @return The integer.
+static uint32_t __read_uint32(const unsigned char* bytes);
+
+/// @brief Compares two latencies for "qsort()".
+/// @param x The first latency.
+/// @param y The second latency.
+/// @return Negative, zero or positive if the first latency is smaller, equal or greater.
+static int __compare_latencies(const void* x, const void* y);
+
+/* Public Functions */
+
+/// @brief Measures how many requests per second the socket server answers, one request at a time and pipelined.
+/// @param argc The amount of command-line arguments.
+/// @param argv The command-line arguments: the amount of clients, the pipeline depth, the duration of each run in milliseconds
+/// and the socket of a running server, all optional. Without a socket, a server is started on a new database.
+/// @return The exit code of the benchmark.
+int main(int argc, char** argv)
+{
+    const int client_amount = (argc > 1 && atoi(argv[1]) > 0) ? atoi(argv[1]) : __default_client_amount;
+    const int pipeline_depth = (argc > 2 && atoi(argv[2]) > 0) ? atoi(argv[2]) : __default_pipeline_depth;
+    const int duration_ms = (argc > 3 && atoi(argv[3]) > 0) ? atoi(argv[3]) : __default_duration_ms;
+    const char* db_location = NULL;
+    char socket_location[sizeof(((struct sockaddr_un*)NULL)->sun_path)];
+    pid_t server_pid = -1;
+
+    if (argc > 4)
+        snprintf(socket_location, sizeof(socket_location), "%s", argv[4]);
+    else
+    {
+        const db_handle* db;
+        sqlite3* raw_db = NULL;
+
+        db_location = temp_db_create_path();
+        db = (db_location == NULL) ? NULL : create_sqlite_db(db_location);
+
+        if (db == NULL || !temp_db_open_raw(db_location, &raw_db) || !bench_populate(raw_db, __initial_row_amount, __initial_task_length))
+        {
+            sqlite3_close(raw_db);
+            close_sqlite_db(db);
+            temp_db_remove(db_location);
+
+            return EXIT_FAILURE;
+        }
+
+        // Every connection is closed before forking, so the server doesn't inherit SQLite state.
+        sqlite3_close(raw_db);
+        close_sqlite_db(db);
+        snprintf(socket_location, sizeof(socket_location), "%s.sock", db_location);
+        fflush(stdout);
+
+        server_pid = fork();
+
+        if (server_pid == 0)
+        {
+            const db_handle* server_db = create_sqlite_db(db_location);
+            const int exit_code = (server_db == NULL) ? EXIT_FAILURE : serve_socket(server_db, socket_location);
+
+            close_sqlite_db(server_db);
+            _exit(exit_code);
+        }
+    }
+
+    // Waits for the server to listen and asks how many tasks there are to read from.
+    int fd = -1;
+    uint32_t task_amount = 0;
+
+    for (uint64_t deadline = bench_now_ns() + (uint64_t)__startup_timeout_ms * 1000000u; fd < 0 && bench_now_ns() < deadline;)
+    {
+        fd = __connect_server(socket_location);
+
+        if (fd < 0)
+            usleep(10000);
+    }
+
+    if (fd < 0 || __call_server(fd, SERVER_OP_COUNT_TASKS, NULL, 0, &task_amount) != SERVER_STATUS_OK || task_amount == 0)
+    {
+        fprintf(stderr, "Could not query the server on \"%s\"." NEWLINE, socket_location);
+
+        if (server_pid > 0)
+            kill(server_pid, SIGTERM);
+    }
+    else
+    {
+        close(fd);
+
+        printf("%d clients, pipeline depth %d, %d ms per run, %u tasks" NEWLINE, client_amount, pipeline_depth, duration_ms, task_amount);
+
+        __run_load(socket_location, "GET, one request at a time", client_amount, 1, 0, task_amount, duration_ms);
+        __run_load(socket_location, "GET, pipelined", client_amount, pipeline_depth, 0, task_amount, duration_ms);
+        __run_load(socket_location, "GET + ADD, one request at a time", client_amount, 1, __add_percentage, task_amount, duration_ms);
+        __run_load(socket_location, "GET + ADD, pipelined", client_amount, pipeline_depth, __add_percentage, task_amount, duration_ms);
+
+        if (server_pid > 0)
+            kill(server_pid, SIGTERM);
+    }
+
+    if (server_pid > 0)
+        waitpid(server_pid, NULL, 0);
+
+    if (db_location != NULL)
+        temp_db_remove(db_location);
+
+    return EXIT_SUCCESS;
+}
+
+/* Private Functions */
+
+static void __run_load(const char* socket_location, const char* name, const int client_amount, const int pipeline_depth,
+    const int add_percentage, const int max_id, const int duration_ms)
+{
+    const size_t result_size = sizeof(__client_result) + (size_t)__max_samples * sizeof(uint64_t);
+    int start_pipe[2];
+
+    if (pipe(start_pipe) != 0)
+        return;
+
+    unsigned char* results = mmap(NULL, result_size * client_amount, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    pid_t* client_pids = malloc(client_amount * sizeof(pid_t));
+
+    if (results == MAP_FAILED || client_pids == NULL)
+    {
+        if (results != MAP_FAILED)
+            munmap(results, result_size * client_amount);
+
+        free(client_pids);
+        close(start_pipe[0]);
+        close(start_pipe[1]);
+
+        return;
+    }
+
+    fflush(stdout);
+
+    for (int client = 0; client < client_amount; client++)
+    {
+        client_pids[client] = fork();
+
+        if (client_pids[client] == 0)
+        {
+            close(start_pipe[1]);
+            __run_client(socket_location, pipeline_depth, add_percentage, max_id, start_pipe[0], duration_ms,
+                (__client_result*)(results + result_size * client));
+            _exit(EXIT_SUCCESS);
+        }
+    }
+
+    // Closing the pipe wakes every client at the same time.
+    close(start_pipe[0]);
+    close(start_pipe[1]);
+
+    // The server may be a child process too, so only the clients are waited for.
+    for (int client = 0; client < client_amount; client++)
+    {
+        if (client_pids[client] > 0)
+            waitpid(client_pids[client], NULL, 0);
+    }
+
+    printf("--- %s (depth %d) ---" NEWLINE, name, pipeline_depth);
+    __report_clients(results, client_amount, result_size, duration_ms);
+
+    munmap(results, result_size * client_amount);
+    free(client_pids);
+}
+
+static void __run_client(const char* socket_location, const int pipeline_depth, const int add_percentage, const int max_id,
+    const int start_pipe, const int duration_ms, __client_result* result)
+{
+    const size_t task_length = strlen(__sample_task);
+    const size_t request_size = SERVER_LENGTH_SIZE + 1 + max(4, task_length);
+    unsigned char* batch = malloc(request_size * pipeline_depth);
+    unsigned char* responses = malloc(__response_buffer_size);
+    size_t response_capacity = __response_buffer_size;
+    const int fd = __connect_server(socket_location);
+    char signal_byte;
+
+    if (batch == NULL || responses == NULL || fd < 0)
+    {
+        free(batch);
+        free(responses);
+
+        if (fd >= 0)
+            close(fd);
+
+        return;
+    }
+
+    srand(getpid());
+
+    // Blocks until the parent closes the pipe.
+    if (read(start_pipe, &signal_byte, 1) >= 0)
+    {
+        const uint64_t deadline = bench_now_ns() + (uint64_t)duration_ms * 1000000u;
+
+        for (uint64_t now = bench_now_ns(); now < deadline; now = bench_now_ns())
+        {
+            size_t batch_length = 0;
+
+            for (int request = 0; request < pipeline_depth; request++)
+            {
+                unsigned char id[4];
+
+                if (rand() % 100 < add_percentage)
+                    __append_request(batch, &batch_length, SERVER_OP_ADD_TASK, __sample_task, task_length);
+                else
+                {
+                    __write_uint32(id, 1 + rand() % max_id);
+                    __append_request(batch, &batch_length, SERVER_OP_GET_TASK, id, sizeof(id));
+                }
+            }
+
+            // The whole batch is written at once, and the server answers it in order.
+            if (!__send_all(fd, batch, batch_length) || !__read_responses(fd, &responses, &response_capacity, pipeline_depth, &result->failure_amount))
+                break;
+
+            if (result->batch_amount < __max_samples)
+                result->latencies_ns[result->batch_amount] = bench_now_ns() - now;
+
+            result->batch_amount++;
+            result->request_amount += pipeline_depth;
+        }
+    }
+
+    close(fd);
+    free(batch);
+    free(responses);
+}
+
+static int __connect_server(const char* socket_location)
+{
+    struct sockaddr_un address = { .sun_family = AF_UNIX };
+    const int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+
+    snprintf(address.sun_path, sizeof(address.sun_path), "%s", socket_location);
+
+    if (fd >= 0 && connect(fd, (struct sockaddr*)&address, sizeof(address)) == 0)
+        return fd;
+
+    if (fd >= 0)
+        close(fd);
+
+    return -1;
+}
+
+static int __call_server(const int fd, const unsigned char operation, const void* payload, const size_t payload_length, uint32_t* value)
+{
+    unsigned char request[SERVER_LENGTH_SIZE + 1 + 8];
+    unsigned char response[SERVER_LENGTH_SIZE + 1 + 4];
+    size_t request_length = 0, response_length = 0;
+
+    if (payload_length > 8)
+        return -1;
+
+    __append_request(request, &request_length, operation, payload, payload_length);
+
+    if (!__send_all(fd, request, request_length))
+        return -1;
+
+    // Only responses with an integer or nothing fit, which is all this is used for.
+    while (response_length < SERVER_LENGTH_SIZE || response_length < SERVER_LENGTH_SIZE + __read_uint32(response))
+    {
+        const ssize_t length = recv(fd, response + response_length, sizeof(response) - response_length, 0);
+
+        if (length <= 0)
+            return -1;
+
+        response_length += length;
+
+        if (response_length >= SERVER_LENGTH_SIZE && __read_uint32(response) > sizeof(response) - SERVER_LENGTH_SIZE)
+            return -1;
+    }
+
+    if (value != NULL && response_length >= sizeof(response))
+        *value = __read_uint32(response + SERVER_LENGTH_SIZE + 1);
+
+    return response[SERVER_LENGTH_SIZE];
+}
+
+static void __append_request(unsigned char* batch, size_t* position, const unsigned char operation, const void* payload, const size_t payload_length)
+{
+    __write_uint32(batch + *position, (uint32_t)(1 + payload_length));
+    batch[*position + SERVER_LENGTH_SIZE] = operation;
+
+    if (payload_length > 0)
+        memcpy(batch + *position + SERVER_LENGTH_SIZE + 1, payload, payload_length);
+
+    *position += SERVER_LENGTH_SIZE + 1 + payload_length;
+}
+
+static bool __read_responses(const int fd, unsigned char** buffer, size_t* capacity, const int response_amount, int* failure_amount)
+{
+    size_t buffer_length = 0, position = 0;
+
+    for (int response = 0; response < response_amount;)
+    {
+        // Handle every complete response in the buffer before reading more.
+        if (buffer_length - position >= SERVER_LENGTH_SIZE)
+        {
+            const size_t frame_length = __read_uint32(*buffer + position);
+
+            if (frame_length == 0)
+                return false;
+
+            if (buffer_length - position >= SERVER_LENGTH_SIZE + frame_length)
+            {
+                const unsigned char status = (*buffer)[position + SERVER_LENGTH_SIZE];
+
+                *failure_amount += status != SERVER_STATUS_OK && status != SERVER_STATUS_NOT_FOUND;
+                position += SERVER_LENGTH_SIZE + frame_length;
+                response++;
+                continue;
+            }
+
+            if (SERVER_LENGTH_SIZE + frame_length > *capacity)
+            {
+                unsigned char* new_buffer = realloc(*buffer, SERVER_LENGTH_SIZE + frame_length);
+
+                if (new_buffer == NULL)
+                    return false;
+
+                *buffer = new_buffer;
+                *capacity = SERVER_LENGTH_SIZE + frame_length;
+            }
+        }
+
+        memmove(*buffer, *buffer + position, buffer_length - position);
+        buffer_length -= position;
+        position = 0;
+
+        const ssize_t length = recv(fd, *buffer + buffer_length, *capacity - buffer_length, 0);
+
+        if (length <= 0)
+            return false;
+
+        buffer_length += length;
+    }
+
+    return true;
+}
+
+static bool __send_all(const int fd, const void* data, const size_t length)
+{
+    for (size_t sent = 0; sent < length;)
+    {
+        const ssize_t written = send(fd, (const char*)data + sent, length - sent, MSG_NOSIGNAL);
+
+        if (written <= 0)
+            return false;
+
+        sent += written;
+    }
+
+    return true;
+}
+
+static void __report_clients(const unsigned char* results, const int client_amount, const size_t result_size, const int duration_ms)
+{
+    int request_amount = 0, failure_amount = 0, sample_amount = 0;
+
+    for (int client = 0; client < client_amount; client++)
+    {
+        const __client_result* result = (const __client_result*)(results + result_size * client);
+
+        request_amount += result->request_amount;
+        failure_amount += result->failure_amount;
+        sample_amount += min(result->batch_amount, __max_samples);
+    }
+
+    uint64_t* latencies = malloc(max(1, sample_amount) * sizeof(uint64_t));
+
+    if (latencies == NULL)
+        return;
+
+    for (int client = 0, position = 0; client < client_amount; client++)
+    {
+        const __client_result* result = (const __client_result*)(results + result_size * client);
+        const int client_samples = min(result->batch_amount, __max_samples);
+
+        memcpy(latencies + position, result->latencies_ns, client_samples * sizeof(uint64_t));
+        position += client_samples;
+    }
+
+    qsort(latencies, sample_amount, sizeof(uint64_t), __compare_latencies);
+
+    printf("%10.0f req/s %8d failed   batch p50 %9.1f us   p99 %9.1f us   max %9.1f us" NEWLINE,
+        request_amount / (duration_ms / 1000.0), failure_amount,
+        (sample_amount > 0) ? latencies[sample_amount / 2] / 1e3 : 0.0,
+        (sample_amount > 0) ? latencies[(int)(sample_amount * 0.99)] / 1e3 : 0.0,
+        (sample_amount > 0) ? latencies[sample_amount - 1] / 1e3 : 0.0);
+
+    free(latencies);
+}
+
+static void __write_uint32(unsigned char* bytes, const uint32_t value)
+{
+    for (int index = 0; index < 4; index++)
+        bytes[index] = (unsigned char)(value >> (8 * index));
+}
+
+static uint32_t __read_uint32(const unsigned char* bytes)
+{
+    uint32_t value = 0;
+
+    for (int index = 0; index < 4; index++)
+        value |= (uint32_t)bytes[index] << (8 * index);
+
+    return value;
+}
+
+static int __compare_latencies(const void* x, const void* y)
+{
+    const uint64_t first = *(const uint64_t*)x, second = *(const uint64_t*)y;
+    return (first > second) - (first < second);
+}
@@ -0,0 +1,129 @@
+#include "./bench.h"
+#include "../database/snapshot.h"
+
+/* Private Variables */
+
+/// @brief The default amount of tasks in the database.
+static const int __default_row_amount = 100000;
+
+/// @brief The length of each task.
+static const int __task_length = 200;
+
+/// @brief How many random lookups each reader runs.
+static const int __lookup_amount = 100000;
+
+/* Function Prototyping */
+
+/// @brief Visitor that adds up the length of every task, so the listing can't be optimized away.
+/// @param custom_state Pointer to the running total.
+/// @param id The ID of the task.
+/// @param task The content of the task.
+/// @param length The length of the task.
+/// @return Always zero, so every task is visited.
+static int __visitor_sum_lengths(void* custom_state, const int id, const char* task, const int length);
+
+/* Public Functions */
+
+/// @brief Measures export, import and read-only access of binary snapshots against the SQLite database.
+/// @param argc The amount of command-line arguments.
+/// @param argv The command-line arguments. The first optional argument is the amount of tasks.
+/// @return The exit code of the benchmark.
+int main(int argc, char** argv)
+{
+    const int row_amount = (argc > 1 && atoi(argv[1]) > 0) ? atoi(argv[1]) : __default_row_amount;
+    const char* db_location = temp_db_create_path();
+    const char* import_location = temp_db_create_path();
+    const char* snapshot_location = (db_location == NULL) ? NULL : str_append(db_location, ".snapshot");
+    const db_handle* db = (db_location == NULL) ? NULL : create_sqlite_db(db_location);
+    const db_handle* import_db = (import_location == NULL) ? NULL : create_sqlite_db(import_location);
+    sqlite3* raw_db = NULL;
+
+    if (db == NULL || import_db == NULL || snapshot_location == NULL || !temp_db_open_raw(db_location, &raw_db) || !bench_populate(raw_db, row_amount, __task_length))
+    {
+        sqlite3_close(raw_db);
+        close_sqlite_db(db);
+        close_sqlite_db(import_db);
+        temp_db_remove(db_location);
+        temp_db_remove(import_location);
+        free((char*)snapshot_location);
+
+        return EXIT_FAILURE;
+    }
+
+    const int max_id = bench_max_id(raw_db);
+    long long length_sum = 0;
+
+    printf("--- Export / import (%d tasks) ---" NEWLINE, row_amount);
+
+    uint64_t start = bench_now_ns();
+    export_snapshot(db, snapshot_location);
+    bench_report("export_snapshot", row_amount, bench_now_ns() - start);
+
+    start = bench_now_ns();
+    import_snapshot(import_db, snapshot_location);
+    bench_report("import_snapshot", row_amount, bench_now_ns() - start);
+
+    start = bench_now_ns();
+    db_snapshot* snapshot = open_snapshot(snapshot_location);
+    bench_report("open_snapshot", 1, bench_now_ns() - start);
+
+    if (snapshot == NULL)
+    {
+        fprintf(stderr, "The snapshot could not be opened." NEWLINE);
+        length_sum = -1;
+    }
+    else
+    {
+        printf("--- SQLite ---" NEWLINE);
+
+        srand(42);
+        start = bench_now_ns();
+        for (int count = 0; count < __lookup_amount; count++)
+            with_task(db, 1 + rand() % max_id, __visitor_sum_lengths, &length_sum);
+        bench_report("with_task (random)", __lookup_amount, bench_now_ns() - start);
+
+        start = bench_now_ns();
+        for_each_task(db, 0, 0, __visitor_sum_lengths, &length_sum);
+        bench_report("for_each_task (all)", row_amount, bench_now_ns() - start);
+
+        printf("--- Snapshot (mmap) ---" NEWLINE);
+
+        srand(42);
+        start = bench_now_ns();
+        for (int count = 0; count < __lookup_amount; count++)
+        {
+            int length = 0;
+            snapshot_get_task(snapshot, 1 + rand() % max_id, &length);
+            length_sum += length;
+        }
+        bench_report("snapshot_get_task (random)", __lookup_amount, bench_now_ns() - start);
+
+        start = bench_now_ns();
+        snapshot_for_each_task(snapshot, 0, 0, __visitor_sum_lengths, &length_sum);
+        bench_report("snapshot_for_each_task (all)", row_amount, bench_now_ns() - start);
+
+        close_snapshot(snapshot);
+    }
+
+    // Cleanup
+    remove(snapshot_location);
+    free((char*)snapshot_location);
+    sqlite3_close(raw_db);
+    close_sqlite_db(db);
+    close_sqlite_db(import_db);
+    temp_db_remove(db_location);
+    temp_db_remove(import_location);
+
+    return (length_sum < 0) ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+/* Private Functions */
+
+static int __visitor_sum_lengths(void* custom_state, const int id, const char* task, const int length)
+{
+    UNUSED(id, task);
+
+    *(long long*)custom_state += length;
+
+    return 0;
+}
@@ -0,0 +1,131 @@
+#include <stdatomic.h>
+#include "./bench.h"
+
+/* Private Variables */
+
+/// @brief The default amount of writes per benchmark.
+static const int __default_iterations = 5000;
+
+/// @brief The content of the tasks written by the benchmarks.
+static const char* const __sample_task = "Buy milk, eggs and bread on the way back home.";
+
+/// @brief How many queued writes have been committed.
+static atomic_int __committed_amount;
+
+/* Function Prototyping */
+
+/// @brief Inserts, updates and deletes tasks, waiting for every write to be committed.
+/// @param db The database.
+/// @param raw_db A plain SQLite connection to the same database.
+/// @param iterations How many times each operation should run.
+static void __run_synchronous(const db_handle* db, sqlite3* raw_db, const int iterations);
+
+/// @brief Queues inserts, updates and deletes, measuring how long queueing takes and how long the writes take to be committed.
+/// @param db The database.
+/// @param raw_db A plain SQLite connection to the same database.
+/// @param iterations How many times each operation should run.
+static void __run_queued(const db_handle* db, sqlite3* raw_db, const int iterations);
+
+/// @brief Write callback that counts committed writes.
+/// @param custom_state Unused.
+/// @param success Whether the write was committed.
+/// @param id The ID of the task.
+static void __count_committed_write(void* custom_state, const bool success, const int id);
+
+/* Public Functions */
+
+/// @brief Measures the cost of writes made through the background writer against synchronous writes.
+/// @param argc The amount of command-line arguments.
+/// @param argv The command-line arguments. The first optional argument is the amount of iterations.
+/// @return The exit code of the benchmark.
+int main(int argc, char** argv)
+{
+    const int iterations = (argc > 1 && atoi(argv[1]) > 0) ? atoi(argv[1]) : __default_iterations;
+    const char* db_location = temp_db_create_path();
+    const db_handle* db = (db_location == NULL) ? NULL : create_sqlite_db(db_location);
+    sqlite3* raw_db = NULL;
+
+    if (db == NULL || !temp_db_open_raw(db_location, &raw_db))
+    {
+        sqlite3_close(raw_db);
+        close_sqlite_db(db);
+        temp_db_remove(db_location);
+
+        return EXIT_FAILURE;
+    }
+
+    printf("--- Synchronous (one transaction per write) ---" NEWLINE);
+    __run_synchronous(db, raw_db, iterations);
+
+    printf("--- Background writer (group commit) ---" NEWLINE);
+    __run_queued(db, raw_db, iterations);
+
+    sqlite3_close(raw_db);
+    close_sqlite_db(db);
+    temp_db_remove(db_location);
+
+    return EXIT_SUCCESS;
+}
+
+/* Private Functions */
+
+static void __run_synchronous(const db_handle* db, sqlite3* raw_db, const int iterations)
+{
+    uint64_t start = bench_now_ns();
+    for (int count = 0; count < iterations; count++)
+        insert_task(db, __sample_task);
+    bench_report("insert_task", iterations, bench_now_ns() - start);
+
+    const int first_id = bench_max_id(raw_db) - iterations + 1;
+
+    start = bench_now_ns();
+    for (int count = 0; count < iterations; count++)
+        update_task(db, first_id + count, __sample_task);
+    bench_report("update_task", iterations, bench_now_ns() - start);
+
+    start = bench_now_ns();
+    for (int count = 0; count < iterations; count++)
+        delete_task(db, first_id + count);
+    bench_report("delete_task", iterations, bench_now_ns() - start);
+}
+
+static void __run_queued(const db_handle* db, sqlite3* raw_db, const int iterations)
+{
+    atomic_store(&__committed_amount, 0);
+
+    uint64_t start = bench_now_ns();
+    for (int count = 0; count < iterations; count++)
+        insert_task_async(db, __sample_task, __count_committed_write, NULL);
+    bench_report("insert_task_async (queue)", iterations, bench_now_ns() - start);
+
+    flush_writes(db);
+    bench_report("insert_task_async (commit)", iterations, bench_now_ns() - start);
+
+    const int first_id = bench_max_id(raw_db) - iterations + 1;
+
+    start = bench_now_ns();
+    for (int count = 0; count < iterations; count++)
+        update_task_async(db, first_id + count, __sample_task, __count_committed_write, NULL);
+    bench_report("update_task_async (queue)", iterations, bench_now_ns() - start);
+
+    flush_writes(db);
+    bench_report("update_task_async (commit)", iterations, bench_now_ns() - start);
+
+    start = bench_now_ns();
+    for (int count = 0; count < iterations; count++)
+        delete_task_async(db, first_id + count, __count_committed_write, NULL);
+    bench_report("delete_task_async (queue)", iterations, bench_now_ns() - start);
+
+    flush_writes(db);
+    bench_report("delete_task_async (commit)", iterations, bench_now_ns() - start);
+
+    printf("%-32s %10d of %d" NEWLINE, "committed writes", atomic_load(&__committed_amount), iterations * 3);
+}
+
+static void __count_committed_write(void* custom_state, const bool success, const int id)
+{
+    UNUSED(custom_state, id);
+
+    if (success)
+        atomic_fetch_add(&__committed_amount, 1);
+}
@@ -0,0 +1,783 @@
+#include <fcntl.h>
+#include "./cli.h"
+#include "./core.h"
+
+/* Private Types */
+
+/// @brief A command that can be run from the command-line arguments.
+typedef struct __command
+{
+    /// @brief The name that selects the command.
+    const char* name;
+
+    /// @brief The arguments of the command, as shown by the usage text.
+    const char* arguments;
+
+    /// @brief What the command does, as shown by the usage text.
+    const char* description;
+
+    /// @brief The minimum amount of arguments after the name.
+    int min_argument_amount;
+
+    /// @brief The maximum amount of arguments after the name or -1 if there is no maximum.
+    int max_argument_amount;
+
+    /// @brief Whether the command needs the database to be opened.
+    bool uses_db;
+
+    /// @brief Runs the command.
+    /// @param db The database or NULL if the command doesn't use it.
+    /// @param argc The amount of arguments after the name.
+    /// @param argv The arguments after the name.
+    /// @return Exit code.
+    int (*run)(const db_handle* db, const int argc, char** argv);
+} __command;
+
+/* Private Variables */
+
+/// @brief How many database pages each step of a backup copies.
+static const int __backup_pages_per_step = 256;
+
+/// @brief How long to wait between the steps of a backup, in milliseconds.
+static const int __backup_step_pause_ms = 1;
+
+/// @brief The initial size of the buffer that reads the standard input.
+static const size_t __input_buffer_size = 4096;
+
+/* Function Prototypes */
+
+/// @brief Adds a task, from the arguments, the standard input or a file, and prints its ID.
+static int __add_command(const db_handle* db, const int argc, char** argv);
+
+/// @brief Prints the content of a task.
+static int __get_command(const db_handle* db, const int argc, char** argv);
+
+/// @brief Prints the tasks ordered by ID, one per line, as tab-separated ID and escaped content.
+static int __list_command(const db_handle* db, const int argc, char** argv);
+
+/// @brief Replaces the content of a task, from the arguments or from the standard input.
+static int __edit_command(const db_handle* db, const int argc, char** argv);
+
+/// @brief Removes one or more tasks in a single transaction.
+static int __remove_command(const db_handle* db, const int argc, char** argv);
+
+/// @brief Prints the amount of tasks.
+static int __count_command(const db_handle* db, const int argc, char** argv);
+
+/// @brief Writes every task of the database to a binary snapshot or a text file.
+static int __export_command(const db_handle* db, const int argc, char** argv);
+
+/// @brief Writes every task of a binary snapshot to the database.
+static int __import_command(const db_handle* db, const int argc, char** argv);
+
+/// @brief Prints one task or every task of a binary snapshot, straight from the mapped file.
+static int __view_command(const db_handle* db, const int argc, char** argv);
+
+/// @brief Copies the database to a backup file while reporting the progress.
+static int __backup_command(const db_handle* db, const int argc, char** argv);
+
+/// @brief Serves the database on a UNIX socket until the process is interrupted.
+static int __serve_command(const db_handle* db, const int argc, char** argv);
+
+/// @brief Issues the calls of a recorded trace against the database and prints their latencies.
+static int __replay_command(const db_handle* db, const int argc, char** argv);
+
+/// @brief Prints how the commands are used.
+/// @param program_name The name the program was invoked with.
+/// @return The exit code for invalid arguments.
+static int __print_usage(const char* program_name);
+
+/// @brief Parses the ID of a task.
+/// @param argument The text of the ID.
+/// @param id Receives the ID.
+/// @return True if the text is a valid ID, False otherwise.
+static bool __parse_id(const char* argument, int* id);
+
+/// @brief Finds where the text of a note starts in the arguments. A leading "--" is skipped, so notes can start with "--".
+/// @param argc The amount of arguments.
+/// @param argv The arguments.
+/// @return The index of the first argument of the text or -1 if the first argument is an option, like a mistyped flag.
+static int __find_text_start(const int argc, char** argv);
+
+/// @brief Checks if a note has no content, the same way the menu does.
+/// @param task The content of the note.
+/// @return True if the note is empty or only has line breaks, False otherwise.
+static bool __is_empty_note(const char* task);
+
+/// @brief Builds the content of a task from the arguments, joined by spaces, or from the standard input if there are none.
+/// @attention Must be manually deallocated!
+/// @param argc The amount of arguments.
+/// @param argv The arguments.
+/// @return The content, without the trailing newline of the standard input, or NULL if there was not enough memory.
+static char* __read_task_argument(const int argc, char** argv);
+
+/// @brief Reads the standard input until it's closed.
+/// @attention Must be manually deallocated!
+/// @param length Receives the amount of bytes read.
+/// @return The null-terminated input or NULL if there was not enough memory.
+static char* __read_stdin(size_t* length);
+
+/// @brief Progress callback that prints how much of a backup was copied.
+/// @param custom_state Unused.
+/// @param copied_pages How many pages were copied.
+/// @param total_pages How many pages there are.
+/// @return Always zero, so the backup is never cancelled.
+static int __print_backup_progress(void* custom_state, const int copied_pages, const int total_pages);
+
+/// @brief Visitor that prints a task.
+/// @param custom_state Unused.
+/// @param id The ID of the task.
+/// @param task The content of the task.
+/// @param length The length of the task.
+/// @return Always zero, so every task is visited.
+static int __visitor_print_task(void* custom_state, const int id, const char* task, const int length);
+
+/// @brief Visitor that writes the content of a task to the standard output, as is.
+/// @param custom_state Unused.
+/// @param id The ID of the task.
+/// @param task The content of the task.
+/// @param length The length of the task.
+/// @return Always zero.
+static int __visitor_write_task(void* custom_state, const int id, const char* task, const int length);
+
+/// @brief Visitor that prints a task as a line of "ID<tab>content", escaping the
+/// @brief backslashes, tabs and newlines of the content so each task stays on one line.
+/// @param custom_state Unused.
+/// @param id The ID of the task.
+/// @param task The content of the task.
+/// @param length The length of the task.
+/// @return Always zero, so every task is visited.
+static int __visitor_list_task(void* custom_state, const int id, const char* task, const int length);
+
+/// @brief The commands, in the order the usage text shows them.
+static const __command __commands[] = {
+    { "add", "[--] [TEXT...]", "Add a note from the arguments or stdin and print its ID.", 0, -1, true, __add_command },
+    { "add", "--lines", "Add each line of stdin as a note, in a single transaction.", 1, 1, true, __add_command },
+    { "add", "--file FILE", "Add a file (\"-\" for stdin) as is, reading it in chunks, and print its ID.", 2, 2, true, __add_command },
+    { "get", "ID", "Print a note.", 1, 1, true, __get_command },
+    { "list", "[--after ID] [--limit N]", "Print notes as \"ID<tab>text\" lines, text escaped.", 0, 4, true, __list_command },
+    { "edit", "ID [--] [TEXT...]", "Replace a note with the arguments or stdin.", 1, -1, true, __edit_command },
+    { "rm", "ID...", "Remove notes.", 1, -1, true, __remove_command },
+    { "count", "", "Print the amount of notes.", 0, 0, true, __count_command },
+    { "export", "--binary FILE", "Write every note to a binary snapshot.", 2, 2, true, __export_command },
+    { "export", "--markdown|--jsonl|--csv FILE [--threads N]", "Write every note as text (\"-\" for stdout), in parallel.", 2, 4, true, __export_command },
+    { "import", "FILE", "Restore the notes of a binary snapshot.", 1, 1, true, __import_command },
+    { "view", "FILE [ID]", "Read notes from a binary snapshot without the database.", 1, 2, false, __view_command },
+    { "backup", "FILE", "Copy the database to a file, even while it's in use.", 1, 1, true, __backup_command },
+    { "serve", "--socket PATH", "Serve the notes on a UNIX socket until interrupted.", 2, 2, true, __serve_command },
+    { "replay", "TRACE [--fast]", "Replay a trace with its original timing, or as fast as possible, and print the latencies.", 1, 2, true, __replay_command }
+};
+
+/* Public Functions */
+
+int run_command(const int argc, char** argv)
+{
+    char** arguments = calloc(argc, sizeof(char*));
+    const char* db_location = NULL;
+    int argument_amount = 0, status_code = EINVAL;
+
+    if (arguments == NULL)
+        return ENOMEM;
+
+    // "--db PATH" may appear anywhere, so it's taken out before the command is parsed.
+    for (int index = 1; index < argc; index++)
+    {
+        if (strcmp(argv[index], "--db") == 0 && index + 1 < argc)
+            db_location = argv[++index];
+        else if (strncmp(argv[index], "--db=", 5) == 0)
+            db_location = argv[index] + 5;
+        else if (strcmp(argv[index], "--db") == 0)
+            argument_amount = -1;
+        else if (argument_amount >= 0)
+            arguments[argument_amount++] = argv[index];
+    }
+
+    // Only the database was chosen, so open the interactive menu on it.
+    if (argument_amount == 0 && db_location != NULL)
+    {
+        free(arguments);
+        return app_loop(db_location);
+    }
+
+    const size_t command_amount = sizeof(__commands) / sizeof(__commands[0]);
+    const __command* command = NULL;
+
+    for (size_t index = 0; index < command_amount && argument_amount > 0 && command == NULL; index++)
+    {
+        const int command_argument_amount = argument_amount - 1;
+
+        if (strcmp(arguments[0], __commands[index].name) == 0
+            && command_argument_amount >= __commands[index].min_argument_amount
+            && (__commands[index].max_argument_amount < 0 || command_argument_amount <= __commands[index].max_argument_amount))
+            command = &__commands[index];
+    }
+
+    if (command == NULL)
+    {
+        free(arguments);
+        return __print_usage(argv[0]);
+    }
+
+    const db_handle* db = NULL;
+
+    if (command->uses_db)
+    {
+        db = (db_location == NULL) ? get_db() : create_sqlite_db(db_location);
+
+        if (db == NULL)
+        {
+            fprintf(stderr, "The database is corrupted or could not be created due to lack of write permissions." NEWLINE);
+            free(arguments);
+
+            return EPERM;
+        }
+
+        start_query_profiling(db);
+    }
+
+    status_code = command->run(db, argument_amount - 1, arguments + 1);
+
+    if (status_code == EINVAL)
+        __print_usage(argv[0]);
+
+    // Cleanup
+    if (db != NULL)
+        finish_query_profiling(db);
+
+    close_sqlite_db(db);
+    free(arguments);
+
+    return status_code;
+}
+
+/* Private Functions */
+
+static int __add_command(const db_handle* db, const int argc, char** argv)
+{
+    if (argc == 1 && strcmp(argv[0], "--lines") == 0)
+    {
+        size_t length;
+        char* input = __read_stdin(&length);
+        int line_amount = 0;
+
+        if (input == NULL)
+            return ENOMEM;
+
+        for (size_t index = 0; index < length; index++)
+            line_amount += input[index] == '\n';
+
+        const char** tasks = malloc(max(1, line_amount + 1) * sizeof(char*));
+        int task_amount = 0;
+
+        if (tasks == NULL)
+        {
+            free(input);
+            return ENOMEM;
+        }
+
+        // Split the input in place, skipping empty lines.
+        for (char* line = input; line < input + length;)
+        {
+            char* line_end = memchr(line, '\n', input + length - line);
+
+            if (line_end == NULL)
+                line_end = input + length;
+
+            *line_end = '\0';
+
+            if (line_end > line)
+                tasks[task_amount++] = line;
+
+            line = line_end + 1;
+        }
+
+        const int added_amount = insert_tasks(db, tasks, task_amount, NULL);
+
+        free(tasks);
+        free(input);
+
+        printf("%d" NEWLINE, added_amount);
+
+        return (added_amount == task_amount) ? EXIT_SUCCESS : EIO;
+    }
+
+    int id;
+
+    // Files are streamed into the database, so they're never held in memory as a whole.
+    if (argc == 2 && strcmp(argv[0], "--file") == 0)
+    {
+        const int fd = (strcmp(argv[1], "-") == 0) ? STDIN_FILENO : open(argv[1], O_RDONLY);
+
+        if (fd < 0)
+        {
+            fprintf(stderr, "Could not open \"%s\"." NEWLINE, argv[1]);
+            return ENOENT;
+        }
+
+        id = add_task_from_fd(db, fd);
+        const int error_code = errno;
+
+        if (fd != STDIN_FILENO)
+            close(fd);
+
+        if (id < 0)
+        {
+            if (error_code == ENODATA)
+                fprintf(stderr, "A note can't be empty." NEWLINE);
+            else if (error_code == EILSEQ)
+                fprintf(stderr, "A note can't contain null characters." NEWLINE);
+            else
+                fprintf(stderr, "Could not add the note from \"%s\": %s" NEWLINE, argv[1], strerror(error_code));
+
+            return error_code;
+        }
+    }
+    else
+    {
+        const int text_start = __find_text_start(argc, argv);
+
+        if (text_start < 0)
+            return EINVAL;
+
+        char* task = __read_task_argument(argc - text_start, argv + text_start);
+
+        if (task == NULL)
+            return ENOMEM;
+
+        if (__is_empty_note(task))
+        {
+            fprintf(stderr, "A note can't be empty." NEWLINE);
+            free(task);
+
+            return ENODATA;
+        }
+
+        id = add_task(db, task);
+        free(task);
+    }
+
+    if (id < 0)
+        return EIO;
+
+    printf("%d" NEWLINE, id);
+
+    return EXIT_SUCCESS;
+}
+
+static int __get_command(const db_handle* db, const int argc, char** argv)
+{
+    int id;
+
+    UNUSED(argc);
+
+    if (!__parse_id(argv[0], &id))
+        return EINVAL;
+
+    if (!with_task(db, id, __visitor_write_task, NULL))
+    {
+        fprintf(stderr, "Note with ID %d was not found." NEWLINE, id);
+        return ENOENT;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+static int __list_command(const db_handle* db, const int argc, char** argv)
+{
+    int after_id = 0, limit = 0;
+
+    for (int index = 0; index < argc; index += 2)
+    {
+        if (index + 1 >= argc)
+            return EINVAL;
+        else if (strcmp(argv[index], "--after") == 0 && (strcmp(argv[index + 1], "0") == 0 || __parse_id(argv[index + 1], &after_id)))
+            continue;
+        else if (strcmp(argv[index], "--limit") == 0 && __parse_id(argv[index + 1], &limit))
+            continue;
+        else
+            return EINVAL;
+    }
+
+    return (for_each_task(db, after_id, limit, __visitor_list_task, NULL) < 0) ? EIO : EXIT_SUCCESS;
+}
+
+static int __edit_command(const db_handle* db, const int argc, char** argv)
+{
+    int id;
+
+    const int text_start = 1 + __find_text_start(argc - 1, argv + 1);
+
+    if (!__parse_id(argv[0], &id) || text_start < 1)
+        return EINVAL;
+
+    char* task = __read_task_argument(argc - text_start, argv + text_start);
+
+    if (task == NULL)
+        return ENOMEM;
+
+    if (__is_empty_note(task))
+    {
+        fprintf(stderr, "A note can't be empty. Use \"rm\" to remove it." NEWLINE);
+        free(task);
+
+        return ENODATA;
+    }
+
+    // The batch version reports whether the ID existed.
+    const char* tasks[] = { task };
+    const int updated_amount = update_tasks(db, &id, tasks, 1, NULL);
+
+    free(task);
+
+    if (updated_amount == 0)
+    {
+        fprintf(stderr, "Note with ID %d was not found." NEWLINE, id);
+        return ENOENT;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+static int __remove_command(const db_handle* db, const int argc, char** argv)
+{
+    int* ids = malloc(argc * sizeof(int));
+    bool* results = malloc(argc * sizeof(bool));
+    int status_code = EXIT_SUCCESS;
+
+    if (ids == NULL || results == NULL)
+    {
+        free(ids);
+        free(results);
+
+        return ENOMEM;
+    }
+
+    for (int index = 0; index < argc && status_code == EXIT_SUCCESS; index++)
+    {
+        if (!__parse_id(argv[index], &ids[index]))
+            status_code = EINVAL;
+    }
+
+    if (status_code == EXIT_SUCCESS)
+    {
+        delete_tasks(db, ids, argc, results);
+
+        for (int index = 0; index < argc; index++)
+        {
+            if (!results[index])
+            {
+                fprintf(stderr, "Note with ID %d was not found." NEWLINE, ids[index]);
+                status_code = ENOENT;
+            }
+        }
+    }
+
+    free(ids);
+    free(results);
+
+    return status_code;
+}
+
+static int __count_command(const db_handle* db, const int argc, char** argv)
+{
+    UNUSED(argc, argv);
+
+    const int task_amount = count_tasks(db);
+
+    if (task_amount < 0)
+        return EIO;
+
+    printf("%d" NEWLINE, task_amount);
+
+    return EXIT_SUCCESS;
+}
+
+static int __export_command(const db_handle* db, const int argc, char** argv)
+{
+    const char* export_location = argv[1];
+    int thread_amount = 0, task_amount;
+
+    if (argc == 3 || (argc == 4 && (strcmp(argv[2], "--threads") != 0 || !__parse_id(argv[3], &thread_amount))))
+        return EINVAL;
+
+    if (strcmp(argv[0], "--binary") == 0 && argc == 2)
+        task_amount = export_snapshot(db, export_location);
+    else if (strcmp(argv[0], "--markdown") == 0)
+        task_amount = export_tasks(db, export_location, DB_EXPORT_MARKDOWN, thread_amount);
+    else if (strcmp(argv[0], "--jsonl") == 0)
+        task_amount = export_tasks(db, export_location, DB_EXPORT_JSONL, thread_amount);
+    else if (strcmp(argv[0], "--csv") == 0)
+        task_amount = export_tasks(db, export_location, DB_EXPORT_CSV, thread_amount);
+    else
+        return EINVAL;
+
+    if (task_amount < 0)
+    {
+        fprintf(stderr, "Could not write the notes to \"%s\"." NEWLINE, export_location);
+        return EIO;
+    }
+
+    fprintf(stderr, "Exported %d notes to \"%s\"." NEWLINE, task_amount, export_location);
+
+    return EXIT_SUCCESS;
+}
+
+static int __import_command(const db_handle* db, const int argc, char** argv)
+{
+    UNUSED(argc);
+
+    const char* snapshot_location = argv[0];
+    const int task_amount = import_snapshot(db, snapshot_location);
+
+    if (task_amount < 0)
+    {
+        fprintf(stderr, "\"%s\" is not a valid snapshot or could not be imported." NEWLINE, snapshot_location);
+        return EIO;
+    }
+
+    fprintf(stderr, "Imported %d notes from \"%s\"." NEWLINE, task_amount, snapshot_location);
+
+    return EXIT_SUCCESS;
+}
+
+static int __view_command(const db_handle* db, const int argc, char** argv)
+{
+    const char* snapshot_location = argv[0];
+    int status_code = EXIT_SUCCESS, id = 0;
+
+    UNUSED(db);
+
+    if (argc == 2 && !__parse_id(argv[1], &id))
+        return EINVAL;
+
+    db_snapshot* snapshot = open_snapshot(snapshot_location);
+
+    if (snapshot == NULL)
+    {
+        fprintf(stderr, "\"%s\" is not a valid snapshot." NEWLINE, snapshot_location);
+        return EIO;
+    }
+
+    if (argc == 1)
+        snapshot_for_each_task(snapshot, 0, 0, __visitor_print_task, NULL);
+    else
+    {
+        int length;
+        const char* task = snapshot_get_task(snapshot, id, &length);
+
+        if (task == NULL)
+        {
+            fprintf(stderr, "Note with ID %d was not found." NEWLINE, id);
+            status_code = ENOENT;
+        }
+        else
+            __visitor_print_task(NULL, id, task, length);
+    }
+
+    close_snapshot(snapshot);
+
+    return status_code;
+}
+
+static int __backup_command(const db_handle* db, const int argc, char** argv)
+{
+    UNUSED(argc);
+
+    const char* backup_location = argv[0];
+    const bool success = backup_sqlite_db(db, backup_location, __backup_pages_per_step, __backup_step_pause_ms, __print_backup_progress, NULL);
+
+    fprintf(stderr, NEWLINE);
+
+    if (!success)
+    {
+        fprintf(stderr, "Could not back up the database to \"%s\"." NEWLINE, backup_location);
+        return EIO;
+    }
+
+    fprintf(stderr, "Backed up the database to \"%s\"." NEWLINE, backup_location);
+
+    return EXIT_SUCCESS;
+}
+
+static int __serve_command(const db_handle* db, const int argc, char** argv)
+{
+    UNUSED(argc);
+
+    if (strcmp(argv[0], "--socket") != 0)
+        return EINVAL;
+
+    return serve_socket(db, argv[1]);
+}
+
+static int __replay_command(const db_handle* db, const int argc, char** argv)
+{
+    if (argc == 2 && strcmp(argv[1], "--fast") != 0)
+        return EINVAL;
+
+    return replay_trace(db, argv[0], argc == 1);
+}
+
+static int __print_usage(const char* program_name)
+{
+    fprintf(stderr, "Usage:" NEWLINE "  %s [--db PATH]" NEWLINE "      Open the interactive menu." NEWLINE, program_name);
+
+    for (size_t index = 0; index < sizeof(__commands) / sizeof(__commands[0]); index++)
+    {
+        fprintf(stderr, "  %s [--db PATH] %s%s%s" NEWLINE "      %s" NEWLINE, program_name, __commands[index].name,
+            (__commands[index].arguments[0] == '\0') ? "" : " ", __commands[index].arguments, __commands[index].description);
+    }
+
+    return EINVAL;
+}
+
+static bool __parse_id(const char* argument, int* id)
+{
+    char* end;
+    errno = 0;
+    const long value = strtol(argument, &end, 10);
+
+    if (errno != 0 || end == argument || *end != '\0' || value <= 0 || value > INT_MAX)
+        return false;
+
+    *id = (int)value;
+
+    return true;
+}
+
+static int __find_text_start(const int argc, char** argv)
+{
+    if (argc == 0 || strncmp(argv[0], "--", 2) != 0)
+        return 0;
+
+    return (strcmp(argv[0], "--") == 0) ? 1 : -1;
+}
+
+static bool __is_empty_note(const char* task)
+{
+    return strspn(task, NEWLINE) == strlen(task);
+}
+
+static char* __read_task_argument(const int argc, char** argv)
+{
+    if (argc == 0)
+    {
+        size_t length;
+        char* input = __read_stdin(&length);
+
+        // "echo text | todoc add" shouldn't store the newline added by echo.
+        if (input != NULL && length > 0 && input[length - 1] == '\n')
+            input[length - 1] = '\0';
+
+        return input;
+    }
+
+    size_t length = 0;
+
+    for (int index = 0; index < argc; index++)
+        length += strlen(argv[index]) + 1;
+
+    char* task = malloc(length);
+
+    if (task == NULL)
+        return NULL;
+
+    char* position = task;
+
+    for (int index = 0; index < argc; index++)
+    {
+        if (index > 0)
+            *position++ = ' ';
+
+        const size_t argument_length = strlen(argv[index]);
+        memcpy(position, argv[index], argument_length);
+        position += argument_length;
+    }
+
+    *position = '\0';
+
+    return task;
+}
+
+static char* __read_stdin(size_t* length)
+{
+    size_t capacity = __input_buffer_size;
+    char* input = malloc(capacity);
+
+    *length = 0;
+
+    if (input == NULL)
+        return NULL;
+
+    for (size_t read_amount; (read_amount = fread(input + *length, 1, capacity - *length - 1, stdin)) > 0;)
+    {
+        *length += read_amount;
+
+        if (capacity - *length - 1 == 0)
+        {
+            char* new_input = realloc(input, capacity * 2);
+
+            if (new_input == NULL)
+            {
+                free(input);
+                return NULL;
+            }
+
+            input = new_input;
+            capacity *= 2;
+        }
+    }
+
+    input[*length] = '\0';
+
+    return input;
+}
+
+static int __print_backup_progress(void* custom_state, const int copied_pages, const int total_pages)
+{
+    UNUSED(custom_state);
+
+    fprintf(stderr, "\rCopied %d of %d pages (%d%%)", copied_pages, total_pages, (total_pages > 0) ? copied_pages * 100 / total_pages : 100);
+
+    return 0;
+}
+
+static int __visitor_print_task(void* custom_state, const int id, const char* task, const int length)
+{
+    UNUSED(custom_state);
+
+    printf("%d: %.*s" NEWLINE, id, length, task);
+
+    return 0;
+}
+
+static int __visitor_write_task(void* custom_state, const int id, const char* task, const int length)
+{
+    UNUSED(custom_state, id);
+
+    fwrite(task, 1, length, stdout);
+    fputs(NEWLINE, stdout);
+
+    return 0;
+}
+
+static int __visitor_list_task(void* custom_state, const int id, const char* task, const int length)
+{
+    UNUSED(custom_state);
+
+    printf("%d\t", id);
+
+    for (int index = 0; index < length; index++)
+    {
+        switch (task[index])
+        {
+            case '\\': fputs("\\\\", stdout); break;
+            case '\t': fputs("\\t", stdout); break;
+            case '\n': fputs("\\n", stdout); break;
+            default: putchar(task[index]); break;
+        }
+    }
+
+    fputs(NEWLINE, stdout);
+
+    return 0;
+}
@@ -0,0 +1,21 @@
+#ifndef CLI_H // Only include this header file if it hasn't been included in the calling file already
+    #define CLI_H
+
+    #include <stdio.h>
+    #include <errno.h>
+    #include "../database/sqlite_db.h"
+    #include "../database/snapshot.h"
+    #include "../database/export.h"
+    #include "./server.h"
+    #include "./replay.h"
+    #include "./core.h"
+    #include "../utilities/utilities.h"
+
+    /// @brief Runs a single command from the command-line arguments, without the interactive menu or any terminal control,
+    /// @brief so it can be used from scripts: "add", "get", "list", "edit", "rm", "count", "export", "import", "view", "backup", "serve" and "replay".
+    /// @brief Data is written to stdout and messages to stderr. "--db PATH" uses another database file.
+    /// @param argc The amount of command-line arguments.
+    /// @param argv The command-line arguments, starting with the name of the program.
+    /// @return Exit code.
+    extern int run_command(const int argc, char** argv);
+#endif // CLI_H
@@ -1,10 +1,44 @@
+#include <poll.h>
 #include "./core.h"
 
+/* Private Types */
+
+/// @brief The IDs at the edges of the page being displayed.
+typedef struct __page_bounds
+{
+    /// @brief The ID of the first note of the page.
+    int first_id;
+
+    /// @brief The ID of the last note of the page.
+    int last_id;
+} __page_bounds;
+
 /* Private Variables */
 
 /// @brief The amount of characters a frame must have.
 static const int __frame_char_amount = 25;
 
+/// @brief The maximum amount of notes shown by a search.
+static const int __search_result_limit = 20;
+
+/// @brief The amount of notes shown per page when reading all notes.
+static const int __page_size = 10;
+
+/// @brief The maximum amount of memory used to cache recently read notes.
+static const size_t __task_cache_budget = 1024 * 1024;
+
+/// @brief How often the database is backed up in the background, in minutes, unless "BACKUP_MINUTES_VARIABLE" is set.
+static const int __default_backup_minutes = 10;
+
+/// @brief How many database pages each step of a background backup copies.
+static const int __backup_pages_per_step = 64;
+
+/// @brief How often the statistics screen is refreshed, in milliseconds.
+static const int __stats_refresh_ms = 1000;
+
+/// @brief Builds each screen of the menu and writes it to stdout at once.
+static renderer* __screen = NULL;
+
 /* Function Prototypes */
 
 /// @brief Prints the main menu of the program.
@@ -25,6 +59,13 @@ static int __get_user_int_input(int min, int max);
 /// @return The integer input by the user.
 static int __get_valid_user_int_input(int min, int max, const char* message);
 
+/// @brief Gets a single-line string input from the user.
+/// @param message The message to be displayed to the user.
+/// @param buffer The buffer to write the input to, without the trailing newline.
+/// @param buffer_length The size of the buffer.
+/// @return True if a line was read, False if stdin was closed.
+static bool __get_user_line_input(const char* message, char* buffer, const int buffer_length);
+
 /// @brief Gets a multi-line string input from the user.
 /// @attention Requires the usert o press Ctrl + Z to get out of the input loop.
 /// @param optional_message An optional message to be printed to the user.
@@ -37,14 +78,14 @@ static const char* get_user_text_input(const char* optional_message);
 /// @param message The message returned by the operation. May be NULL.
 /// @return Zero if the operation executed successfuly or failed in a non-critical way,
 /// @return non-zero if a critical error occurred and the program must be terminated.
-static int __dispatcher(const sqlite3* db, const int input, char* message);
+static int __dispatcher(const db_handle* db, const int input, char* message);
 
 /// @brief Creates a new task.
 /// @param db The database.
 /// @param task The content of the task.
 /// @param message The message returned by the operation. May be NULL.
 /// @return True if the task was created, False otherwise.
-static bool __create_task(const sqlite3* db, const char* task, char* message);
+static bool __create_task(const db_handle* db, const char* task, char* message);
 
 /// @brief Updates the specified task with new content.
 /// @param db The database.
@@ -52,44 +93,91 @@ static bool __create_task(const sqlite3* db, const char* task, char* message);
 /// @param task The new content of the task.
 /// @param message The message returned by the operation. May be NULL.
 /// @return True if the task was updated, False otherwise.
-static bool __edit_task(const sqlite3* db, const int task_id, const char* task, char* message);
+static bool __edit_task(const db_handle* db, const int task_id, const char* task, char* message);
 
 /// @brief Deletes the specified task from the database.
 /// @param db The database.
 /// @param task_id The Id of the task.
 /// @param message The message returned by the operation. May be NULL.
 /// @return True if the task was deleted, False otherwise.
-static bool __delete_task(const sqlite3* db, const int task_id, char* message);
+static bool __delete_task(const db_handle* db, const int task_id, char* message);
 
-/// @brief Writes the task of the specified ID to stdout.
+/// @brief Waits for a queued write to be committed, so its result can be reported.
+/// @param db The database.
+/// @param is_queued Whether the write was queued.
+/// @param is_applied The result stored by "__callback_store_write_result()".
+/// @return True if the write was committed and changed a task, False otherwise.
+static bool __wait_for_write(const db_handle* db, const bool is_queued, const bool* is_applied);
+
+/// @brief Callback of a queued write that stores whether it was committed and changed a task.
+/// @param custom_state bool* to write the result to.
+/// @param success Whether the write was applied.
+/// @param id The ID of the task.
+static void __callback_store_write_result(void* custom_state, const bool success, const int id);
+
+/// @brief Adds the task of the specified ID to the screen.
 /// @param db The database.
 /// @param task_id The ID of the task.
 /// @param message The message returned by the operation. May be NULL.
 /// @return True if the task was printed, False otherwise.
-static bool __print_task(const sqlite3* db, const int task_id, char* message);
+static bool __print_task(const db_handle* db, const int task_id, char* message);
 
-/// @brief Writes all tasks to stdout.
+/// @brief Shows all tasks in the pager or, when the input isn't a terminal, one page at a time.
 /// @param db The database.
 /// @param message The message returned by the operation. May be NULL.
 /// @return True if at least one task was printed out, False if no tasks were found.
-static bool __print_all_tasks(const sqlite3* db, char* message);
+static bool __print_all_tasks(const db_handle* db, char* message);
+
+/// @brief Adds one page of tasks to the screen.
+/// @param page The tasks of the page.
+static void __print_page(const db_tasks* page);
+
+/// @brief Visitor that adds the content of a task to the screen, inside a frame.
+/// @param custom_state Unused.
+/// @param id The ID of the task.
+/// @param task The content of the task.
+/// @param length The length of the task.
+/// @return Zero, so the iteration continues.
+static int __visitor_print_task(void* custom_state, const int id, const char* task, const int length);
+
+/// @brief Visitor that adds a task of a page to the screen and keeps track of the edges of the page.
+/// @param custom_state __page_bounds* with the edges of the page.
+/// @param id The ID of the task.
+/// @param task The content of the task.
+/// @param length The length of the task.
+/// @return Zero, so the iteration continues.
+static int __visitor_print_page_task(void* custom_state, const int id, const char* task, const int length);
+
+/// @brief Adds the notes that best match the specified words to the screen.
+/// @param db The database.
+/// @param query The words to look for.
+/// @param message The message returned by the operation. May be NULL.
+/// @return True if at least one note was printed out, False if no notes matched.
+static bool __print_search_results(const db_handle* db, const char* query, char* message);
+
+/// @brief Shows the query statistics, refreshing them every second until the user presses Enter.
+/// @param db The database.
+static void __show_query_stats(const db_handle* db);
+
+/// @brief Adds a table with the query statistics and the task cache statistics to the screen.
+/// @param db The database.
+static void __print_query_stats(const db_handle* db);
 
 /// @brief Prompts the user to press Enter.
 /// @param message The message to be shown to the user.
 static void __prompt_and_wait(char* message);
 
-/// @brief Writes the specified character to stdout by the specified amount.
-/// @param character The character to be printed.
-/// @param amount How many times the character should be printed.
-static void __print_char(const char character, const int amount);
+/// @brief Adds a message to the current screen and shows it.
+/// @param message The message to be shown to the user.
+static void __present_prompt(const char* message);
 
 /* Public Functions */
 
-int app_loop()
+int app_loop(const char* db_location)
 {
     int status_code = 0, input = 0;
     char message[64] = { 0 };
-    const sqlite3* db = get_db();
+    const db_handle* db = (db_location == NULL) ? get_db() : create_sqlite_db(db_location);
 
     if (db == NULL)
     {
@@ -97,43 +185,103 @@ int app_loop()
         return EPERM;
     }
 
+    __screen = create_renderer(STDOUT_FILENO);
+
+    if (__screen == NULL)
+    {
+        fprintf(stderr, "There is not enough memory to draw the menu. Aborting...");
+        close_sqlite_db(db);
+
+        return ENOMEM;
+    }
+
+    // The cache is optional, so the app still works without it.
+    set_task_cache_budget(db, __task_cache_budget);
+
+    // Backups are opt-in, and the app still works if they can't be scheduled.
+    const char* backup_location = getenv(BACKUP_FILE_VARIABLE);
+    const char* backup_minutes = getenv(BACKUP_MINUTES_VARIABLE);
+    const int backup_interval = 60 * ((backup_minutes != NULL && atoi(backup_minutes) > 0) ? atoi(backup_minutes) : __default_backup_minutes);
+    db_backup_schedule* backup_schedule = (backup_location == NULL || backup_location[0] == '\0')
+        ? NULL
+        : start_backup_schedule(db, backup_location, backup_interval, __backup_pages_per_step);
+
+    start_query_profiling(db);
+
     do
     {
-        clear_console();
+        begin_frame(__screen);
         __print_menu(message);
-        printf("> ");
+        __present_prompt("> ");
+
+        input = __get_user_int_input(0, 7);
+        begin_frame(__screen);
 
-        input = __get_user_int_input(0, 5);
-        clear_console();
+        // Each change waits for its own commit, so its result is always reported by the action that made it.
         status_code = __dispatcher(db, input, message);
 
         if (status_code != EXIT_SUCCESS)
         {
             fprintf(stderr, message);
-            sqlite3_close((sqlite3*)db);
+            finish_query_profiling(db);
+            stop_backup_schedule(backup_schedule);
+            close_sqlite_db(db);
+            free_renderer(__screen);
 
             return status_code;
         }
 
     } while (input != APP_EXIT);
 
-    clear_console();
-    sqlite3_close((sqlite3*)db);
+    begin_frame(__screen);
+    present_frame(__screen);
+
+    if (!flush_writes(db))
+        fprintf(stderr, "An error occurred when attempting to save your last changes." NEWLINE);
+
+    finish_query_profiling(db);
+    stop_backup_schedule(backup_schedule);
+    close_sqlite_db(db);
+    free_renderer(__screen);
 
     return status_code;
 }
 
+void start_query_profiling(const db_handle* db)
+{
+    const char* threshold = getenv(SLOW_QUERY_VARIABLE);
+
+    if (threshold != NULL && threshold[0] != '\0')
+        set_slow_query_threshold(db, atoi(threshold));
+
+    const char* trace_location = getenv(TRACE_FILE_VARIABLE);
+
+    if (trace_location != NULL && trace_location[0] != '\0' && !start_trace_recording(db, trace_location))
+        fprintf(stderr, "Could not record a trace to \"%s\"." NEWLINE, trace_location);
+}
+
+void finish_query_profiling(const db_handle* db)
+{
+    const char* stats_location = getenv(STATS_FILE_VARIABLE);
+
+    if (stats_location != NULL && stats_location[0] != '\0' && !save_query_stats(db, stats_location))
+        fprintf(stderr, "Could not save the query statistics to \"%s\"." NEWLINE, stats_location);
+
+    if (!stop_trace_recording(db))
+        fprintf(stderr, "Some calls could not be written to the trace." NEWLINE);
+}
+
 /* Private Functions */
 
 static void __print_menu(char* optional_message)
 {
     if (optional_message != NULL && optional_message[0] != '\0')
     {
-        printf("%s" NEWLINE NEWLINE, optional_message);
+        render_format(__screen, "%s" NEWLINE NEWLINE, optional_message);
         optional_message[0] = '\0';
     }
 
-    printf(
+    render_format(__screen,
         "Welcome to TodoC!" NEWLINE
         "Select one of the options below:" NEWLINE
         "%d. Create a new note." NEWLINE
@@ -141,8 +289,10 @@ static void __print_menu(char* optional_message)
         "%d. Delete a note." NEWLINE
         "%d. Read a specific note." NEWLINE
         "%d. Read all notes." NEWLINE
+        "%d. Search notes." NEWLINE
+        "%d. Show query statistics." NEWLINE
         "%d. Exit." NEWLINE,
-        CREATE_TASK, EDIT_TASK, DELETE_TASK, READ_TASK, READ_ALL_TASKS, APP_EXIT
+        CREATE_TASK, EDIT_TASK, DELETE_TASK, READ_TASK, READ_ALL_TASKS, SEARCH_TASKS, SHOW_STATS, APP_EXIT
     );
 }
 
@@ -166,22 +316,43 @@ static int __get_valid_user_int_input(int min, int max, const char* message)
 
     do
     {
-        printf(message);
+        __present_prompt(message);
         input = __get_user_int_input(min, max);
     } while (input == fail_code);
 
     return input;
 }
 
+static bool __get_user_line_input(const char* message, char* buffer, const int buffer_length)
+{
+    __present_prompt(message);
+
+    if (fgets(buffer, buffer_length, stdin) == NULL)
+    {
+        buffer[0] = '\0';
+        return false;
+    }
+
+    const size_t input_length = strlen(buffer);
+
+    // Discard the rest of the line if it didn't fit in the buffer.
+    if (input_length > 0 && buffer[input_length - 1] == '\n')
+        buffer[input_length - 1] = '\0';
+    else
+        flush(stdin);
+
+    return true;
+}
+
 static const char* get_user_text_input(const char* optional_message)
 {
     // Print the instructions header.
     if (optional_message != NULL)
-        printf(optional_message);
+        render_text(__screen, optional_message, strlen(optional_message));
 
-    printf(NEWLINE "Press \"Enter + Ctrl + Z + Enter\" to save your note." NEWLINE);
-    __print_char('=', __frame_char_amount);
-    printf(NEWLINE);
+    render_format(__screen, NEWLINE "Press \"Enter + Ctrl + Z + Enter\" to save your note." NEWLINE);
+    render_char(__screen, '=', __frame_char_amount);
+    __present_prompt(NEWLINE);
 
     // Set the variables.
     char current_char = '\0';
@@ -215,7 +386,7 @@ static const char* get_user_text_input(const char* optional_message)
     return buffer;
 }
 
-static int __dispatcher(const sqlite3* db, const int menu_selection, char* message)
+static int __dispatcher(const db_handle* db, const int menu_selection, char* message)
 {
     switch (menu_selection)
     {
@@ -234,7 +405,7 @@ static int __dispatcher(const sqlite3* db, const int menu_selection, char* messa
         case EDIT_TASK:
         {
             int task_id = __get_valid_user_int_input(1, INT_MAX, "Type the ID of the note: ");
-            clear_console();
+            begin_frame(__screen);
 
             if (!__print_task(db, task_id, message))
                 break;
@@ -252,12 +423,14 @@ static int __dispatcher(const sqlite3* db, const int menu_selection, char* messa
         case DELETE_TASK:
         {
             int task_id = __get_valid_user_int_input(1, INT_MAX, "Type the ID of the note: ");
-            clear_console();
+            begin_frame(__screen);
 
             if (!__print_task(db, task_id, message))
                 break;
 
-            printf("Are you sure you want to delete this note? Type %d to confirm: ", task_id);
+            render_format(__screen, "Are you sure you want to delete this note? Type %d to confirm: ", task_id);
+            present_frame(__screen);
+
             int input = __get_user_int_input(task_id, task_id);
 
             if (input == task_id)
@@ -267,16 +440,28 @@ static int __dispatcher(const sqlite3* db, const int menu_selection, char* messa
         case READ_TASK:
         {
             int task_id = __get_valid_user_int_input(1, INT_MAX, "Type the ID of the note: ");
-            clear_console();
+            begin_frame(__screen);
 
             if (__print_task(db, task_id, message))
                 __prompt_and_wait("Press Enter to continue.");
             break;
         }
         case READ_ALL_TASKS:
-            if (__print_all_tasks(db, message))
+            __print_all_tasks(db, message);
+            break;
+        case SEARCH_TASKS:
+        {
+            char query[256];
+            __get_user_line_input("Type the words to search for: ", query, sizeof(query));
+            begin_frame(__screen);
+
+            if (__print_search_results(db, query, message))
                 __prompt_and_wait("Press Enter to continue.");
             break;
+        }
+        case SHOW_STATS:
+            __show_query_stats(db);
+            break;
         default:
             strcpy(message, "Please, enter a valid option.");
             break;
@@ -285,9 +470,10 @@ static int __dispatcher(const sqlite3* db, const int menu_selection, char* messa
     return EXIT_SUCCESS;
 }
 
-static bool __create_task(const sqlite3* db, const char* task, char* message)
+static bool __create_task(const db_handle* db, const char* task, char* message)
 {
-    bool inserted = insert_task(db, task);
+    bool is_applied = false;
+    const bool inserted = __wait_for_write(db, insert_task_async(db, task, __callback_store_write_result, &is_applied), &is_applied);
     const char* returning_message = (inserted)
         ? "Note created successfully."
         : "An error occurred when attempting to create a note.";
@@ -297,9 +483,10 @@ static bool __create_task(const sqlite3* db, const char* task, char* message)
     return inserted;
 }
 
-static bool __edit_task(const sqlite3* db, const int task_id, const char* task, char* message)
+static bool __edit_task(const db_handle* db, const int task_id, const char* task, char* message)
 {
-    bool updated = update_task(db, task_id, task);
+    bool is_applied = false;
+    const bool updated = __wait_for_write(db, update_task_async(db, task_id, task, __callback_store_write_result, &is_applied), &is_applied);
     const char* returning_message = (updated)
         ? "Note updated successfully."
         : "An error occurred when attempting to update a note.";
@@ -309,9 +496,10 @@ static bool __edit_task(const sqlite3* db, const int task_id, const char* task,
     return updated;
 }
 
-static bool __delete_task(const sqlite3* db, const int task_id, char* message)
+static bool __delete_task(const db_handle* db, const int task_id, char* message)
 {
-    bool deleted = delete_task(db, task_id);
+    bool is_applied = false;
+    const bool deleted = __wait_for_write(db, delete_task_async(db, task_id, __callback_store_write_result, &is_applied), &is_applied);
     const char* returning_message = (deleted)
         ? "Note of ID %d has been successfully deleted."
         : "An error occurred when attempting to delete note of ID %d. Entry most likely was not found.";
@@ -321,48 +509,110 @@ static bool __delete_task(const sqlite3* db, const int task_id, char* message)
     return deleted;
 }
 
-static bool __print_task(const sqlite3* db, const int task_id, char* message)
+static bool __wait_for_write(const db_handle* db, const bool is_queued, const bool* is_applied)
 {
-    db_task db_task = get_task(db, task_id);
+    // The write is only reported once it's committed, so a failure or a missing note is never shown as a success.
+    // The flush waits for every queued write, so the callback has run by the time it returns.
+    return is_queued && flush_writes(db) && *is_applied;
+}
 
-    if (db_task.task == NULL)
+static void __callback_store_write_result(void* custom_state, const bool success, const int id)
+{
+    UNUSED(id);
+
+    *(bool*)custom_state = success;
+}
+
+static bool __print_task(const db_handle* db, const int task_id, char* message)
+{
+    // The task is printed straight from the database row, without being copied.
+    if (with_task(db, task_id, __visitor_print_task, NULL))
+        return true;
+
+    sprintf(message, "Note of ID %d was not found.", task_id);
+
+    return false;
+}
+
+static bool __print_all_tasks(const db_handle* db, char* message)
+{
+    // The counter is read instead of the first task, which could be as long as a whole file.
+    if (count_tasks(db) <= 0)
     {
-        sprintf(message, "Note of ID %d was not found.", task_id);
+        strcpy(message, "No notes were found.");
         return false;
     }
 
-    __print_char('=', __frame_char_amount);
-    printf(NEWLINE);
+    // The pager needs raw keys, so it only runs when both ends are a terminal.
+    if (is_terminal_renderer(__screen) && run_pager(db, __screen, STDIN_FILENO))
+        return true;
 
-    printf("%s" NEWLINE, db_task.task);
+    __page_bounds page = { .first_id = 0, .last_id = 0 };
+    int after_id = 0;
+    char input[16];
 
-    __print_char('=', __frame_char_amount);
-    printf(NEWLINE);
+    while (true)
+    {
+        begin_frame(__screen);
 
-    // Cleanup
-    free_db_task(&db_task);
+        render_char(__screen, '=', __frame_char_amount);
+        render_text(__screen, NEWLINE, strlen(NEWLINE));
+
+        page.first_id = 0;
+        for_each_task(db, after_id, __page_size, __visitor_print_page_task, &page);
+
+        render_char(__screen, '=', __frame_char_amount);
+        render_text(__screen, NEWLINE, strlen(NEWLINE));
+
+        const bool has_input = __get_user_line_input("Press Enter for the next page, \"p\" for the previous page or \"q\" to return: ", input, sizeof(input));
+
+        if (!has_input || input[0] == 'q' || input[0] == 'Q')
+            break;
+
+        // Nothing is kept in memory between pages: each page is found from the IDs at the edges of the current one.
+        if (input[0] == 'p' || input[0] == 'P')
+        {
+            const int previous_after_id = find_previous_page(db, page.first_id, __page_size);
+
+            if (previous_after_id >= 0)
+                after_id = previous_after_id;
+        }
+        else
+        {
+            // The index gives the highest ID without reading a note, so a long next note isn't loaded just to be skipped.
+            int first_id, last_id;
+
+            if (get_task_id_bounds(db, &first_id, &last_id) && page.last_id < last_id)
+                after_id = page.last_id;
+        }
+    }
 
     return true;
 }
 
-static bool __print_all_tasks(const sqlite3* db, char* message)
+static void __print_page(const db_tasks* page)
+{
+    render_char(__screen, '=', __frame_char_amount);
+    render_text(__screen, NEWLINE, strlen(NEWLINE));
+
+    for (int index = 0; index < page->amount; index++)
+        render_format(__screen, "--- Note ID: %d ---" NEWLINE "%s" NEWLINE, page->entries[index].id, db_tasks_get(page, index));
+
+    render_char(__screen, '=', __frame_char_amount);
+    render_text(__screen, NEWLINE, strlen(NEWLINE));
+}
+
+static bool __print_search_results(const db_handle* db, const char* query, char* message)
 {
-    db_tasks db_tasks = get_all_tasks(db);
+    db_tasks db_tasks = search_tasks(db, query, __search_result_limit);
 
     if (db_tasks.amount <= 0)
     {
-        strcpy(message, "No notes were found.");
+        strcpy(message, "No notes matched your search.");
         return false;
     }
 
-    __print_char('=', __frame_char_amount);
-    printf(NEWLINE);
-
-    for (int index = 0; index < db_tasks.amount; index++)
-        printf("--- Note ID: %d ---" NEWLINE "%s" NEWLINE, db_tasks.task_ids[index], db_tasks.tasks[index]);
-
-    __print_char('=', __frame_char_amount);
-    printf(NEWLINE);
+    __print_page(&db_tasks);
 
     // Cleanup
     free_db_tasks(&db_tasks);
@@ -370,14 +620,91 @@ static bool __print_all_tasks(const sqlite3* db, char* message)
     return true;
 }
 
+static void __show_query_stats(const db_handle* db)
+{
+    struct pollfd input = { .fd = STDIN_FILENO, .events = POLLIN };
+
+    // Redraw until a line arrives. Closed or redirected input is readable right away, so the screen is only shown once.
+    do
+    {
+        begin_frame(__screen);
+        __print_query_stats(db);
+        __present_prompt(NEWLINE "Refreshing every second. Press Enter to return.");
+    } while (poll(&input, 1, __stats_refresh_ms) == 0);
+
+    flush(stdin);
+}
+
+static void __print_query_stats(const db_handle* db)
+{
+    const db_query_stats stats = get_query_stats(db);
+    const task_cache_stats cache_stats = get_task_cache_stats(db);
+
+    render_format(__screen, "%-22s %9s %9s %11s %10s %10s %9s" NEWLINE,
+        "Query", "Calls", "Rows", "Bytes", "Mean (us)", "Max (us)", "Prepares");
+    render_char(__screen, '=', 86);
+    render_text(__screen, NEWLINE, strlen(NEWLINE));
+
+    for (int kind = 0; kind < DB_QUERY_KIND_AMOUNT; kind++)
+    {
+        const db_query_counters* counters = &stats.queries[kind];
+
+        if (counters->calls == 0 && counters->prepares == 0)
+            continue;
+
+        render_format(__screen, "%-22s %9lu %9lu %11lu %10.1f %10.1f %9lu" NEWLINE,
+            counters->name, counters->calls, counters->rows, counters->bytes,
+            (counters->calls == 0) ? 0.0 : counters->total_ns / 1000.0 / counters->calls,
+            counters->max_ns / 1000.0, counters->prepares);
+    }
+
+    render_char(__screen, '=', 86);
+    render_format(__screen, NEWLINE "Note cache: %lu hits, %lu misses, %lu evictions, %zu of %zu bytes used." NEWLINE,
+        cache_stats.hits, cache_stats.misses, cache_stats.evictions, cache_stats.used_bytes, cache_stats.byte_budget);
+}
+
 static void __prompt_and_wait(char* message)
 {
-    printf("%s" NEWLINE, message);
+    render_format(__screen, "%s" NEWLINE, message);
+    present_frame(__screen);
     flush(stdin);
 }
 
-static void __print_char(const char character, const int amount)
+static void __present_prompt(const char* message)
+{
+    render_text(__screen, message, strlen(message));
+    present_frame(__screen);
+}
+
+static int __visitor_print_task(void* custom_state, const int id, const char* task, const int length)
+{
+    UNUSED(custom_state, id);
+
+    render_char(__screen, '=', __frame_char_amount);
+    render_text(__screen, NEWLINE, strlen(NEWLINE));
+
+    render_text(__screen, task, length);
+    render_text(__screen, NEWLINE, strlen(NEWLINE));
+
+    render_char(__screen, '=', __frame_char_amount);
+    render_text(__screen, NEWLINE, strlen(NEWLINE));
+
+    return 0;
+}
+
+static int __visitor_print_page_task(void* custom_state, const int id, const char* task, const int length)
 {
-    for (int count = 0; count < amount; count++)
-        printf("%c", character);
+    __page_bounds* page = custom_state;
+
+    // IDs start at 1, so zero means this is the first task of the page.
+    if (page->first_id == 0)
+        page->first_id = id;
+
+    render_format(__screen, "--- Note ID: %d ---" NEWLINE, id);
+    render_text(__screen, task, length);
+    render_text(__screen, NEWLINE, strlen(NEWLINE));
+
+    page->last_id = id;
+
+    return 0;
 }
\ No newline at end of file
@@ -4,7 +4,10 @@
     #include <stdio.h>
     #include <errno.h>
     #include "../database/sqlite_db.h"
+    #include "../database/backup.h"
     #include "../handlers/signal_handlers.h"
+    #include "./pager.h"
+    #include "./renderer.h"
     #include "../utilities/utilities.h"
 
     /// @brief Represents the command to close the program.
@@ -25,7 +28,37 @@
     /// @brief Represents the command to read all tasks.
     #define READ_ALL_TASKS 5
 
+    /// @brief Represents the command to search tasks by their content.
+    #define SEARCH_TASKS 6
+
+    /// @brief Represents the command to show the query statistics.
+    #define SHOW_STATS 7
+
+    /// @brief Environment variable with the path of a file the query statistics are written to as JSON on exit.
+    #define STATS_FILE_VARIABLE "TODOC_STATS_FILE"
+
+    /// @brief Environment variable with the threshold, in milliseconds, above which queries are logged to stderr.
+    #define SLOW_QUERY_VARIABLE "TODOC_SLOW_QUERY_MS"
+
+    /// @brief Environment variable with the path of a file every call to the database is recorded to, for "replay".
+    #define TRACE_FILE_VARIABLE "TODOC_TRACE_FILE"
+
+    /// @brief Environment variable with the path of a file the menu backs the database up to in the background. Unset disables backups.
+    #define BACKUP_FILE_VARIABLE "TODOC_BACKUP_FILE"
+
+    /// @brief Environment variable with how often, in minutes, the menu backs the database up. Defaults to 10.
+    #define BACKUP_MINUTES_VARIABLE "TODOC_BACKUP_MINUTES"
+
     /// @brief The main loop of the program.
+    /// @param db_location The path of the database file or NULL to use the one next to the executable.
     /// @return Exit code.
-    extern int app_loop();
+    extern int app_loop(const char* db_location);
+
+    /// @brief Starts logging slow queries if "TODOC_SLOW_QUERY_MS" is set and recording a trace if "TODOC_TRACE_FILE" is set.
+    /// @param db The database.
+    extern void start_query_profiling(const db_handle* db);
+
+    /// @brief Writes the query statistics to the file in "TODOC_STATS_FILE", if it's set, and finishes the trace.
+    /// @param db The database.
+    extern void finish_query_profiling(const db_handle* db);
 #endif // CORE_H
\ No newline at end of file
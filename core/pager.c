@@ -0,0 +1,581 @@
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <termios.h>
+#include "./pager.h"
+
+/* Private Types */
+
+/// @brief The actions the user can take in the pager.
+typedef enum __pager_key
+{
+    __KEY_NONE,
+    __KEY_UP,
+    __KEY_DOWN,
+    __KEY_PAGE_UP,
+    __KEY_PAGE_DOWN,
+    __KEY_FIRST,
+    __KEY_LAST,
+    __KEY_JUMP,
+    __KEY_QUIT
+} __pager_key;
+
+/// @brief The row at the top of the screen: the first task shown and where its row starts.
+typedef struct __pager_position
+{
+    /// @brief The first task shown is the first one with a higher ID.
+    int after_id;
+
+    /// @brief The byte of the first task the row starts at, or -1 if the row is the header of the task.
+    long offset;
+} __pager_position;
+
+/// @brief A task that's read a part at a time, so no more than one part of it is ever in memory.
+typedef struct __pager_task
+{
+    /// @brief The database.
+    const db_handle* db;
+
+    /// @brief The ID of the task.
+    int id;
+
+    /// @brief The length of the whole task.
+    long length;
+
+    /// @brief The part of the task that was read last. Holds "__part_size" bytes.
+    char* part;
+
+    /// @brief The byte of the task the part starts at.
+    long part_offset;
+
+    /// @brief The size of the part.
+    int part_length;
+} __pager_task;
+
+/* Private Variables */
+
+/// @brief The size used when the terminal doesn't report its own.
+static const struct winsize __default_screen_size = { .ws_row = 24, .ws_col = 80 };
+
+/// @brief How long to wait for the rest of an escape sequence after an Esc, in milliseconds.
+static const int __escape_timeout_ms = 25;
+
+/// @brief The most digits the ID typed after ":" can have.
+static const int __max_id_digits = 9;
+
+/// @brief How much of a task is read at a time.
+static const int __part_size = 64 * 1024;
+
+/// @brief The help shown at the bottom of the screen.
+static const char* const __help_text = "j/k: scroll  Space/b: page  g/G: first/last  :: go to ID  q: return";
+
+/* Function Prototyping */
+
+/// @brief Draws the rows that fit on the screen from the specified position, followed by a status line.
+/// @param task The task reader, which is left on the last task drawn.
+/// @param screen The renderer of the terminal.
+/// @param position The row at the top of the screen.
+/// @param size The size of the screen.
+/// @param status The text of the status line.
+/// @return True if the last row was drawn, False if there's more to scroll to.
+static bool __draw_screen(__pager_task* task, renderer* screen, const __pager_position position, const struct winsize size, const char* status);
+
+/// @brief Moves the position one row down, unless it's at the last row of the last task.
+/// @param task The task reader.
+/// @param position The position.
+/// @param columns The width of the screen, in characters.
+/// @return True if the position moved, False otherwise.
+static bool __scroll_down(__pager_task* task, __pager_position* position, const int columns);
+
+/// @brief Moves the position one row up, unless it's at the header of the first task.
+/// @param task The task reader.
+/// @param position The position.
+/// @param columns The width of the screen, in characters.
+/// @return True if the position moved, False otherwise.
+static bool __scroll_up(__pager_task* task, __pager_position* position, const int columns);
+
+/// @brief Lets the user type the ID to jump to.
+/// @param task The task reader.
+/// @param screen The renderer of the terminal.
+/// @param input_fd The file descriptor of the keyboard.
+/// @param position The position, moved to the task if the ID was confirmed.
+/// @param size The size of the screen.
+/// @param message Receives a message for the status line if no task was found.
+/// @param message_length The size of the message buffer.
+static void __jump_to_id(__pager_task* task, renderer* screen, const int input_fd, __pager_position* position,
+    const struct winsize size, char* message, const size_t message_length);
+
+/// @brief Waits for a key and translates it into an action.
+/// @param input_fd The file descriptor of the keyboard.
+/// @param character Receives the character that was pressed or zero for special keys. May be NULL.
+/// @return The action of the key.
+static __pager_key __read_key(const int input_fd, char* character);
+
+/// @brief Gets the size of the terminal.
+/// @param input_fd A file descriptor of the terminal.
+/// @return The size of the terminal.
+static struct winsize __get_screen_size(const int input_fd);
+
+/// @brief Points the task reader at the first task after an ID and reads its first part.
+/// @param task The task reader.
+/// @param after_id The task is the first one with a higher ID.
+/// @return True if there's a task after the ID, False otherwise.
+static bool __open_task(__pager_task* task, const int after_id);
+
+/// @brief Gets a byte of the task, reading the part around it if it's not in memory.
+/// @param task The task reader.
+/// @param position The byte. Parts are read forwards from it, unless it comes before the part in memory.
+/// @return The byte or -1 if it's past the end of the task or could not be read.
+static int __get_byte(__pager_task* task, const long position);
+
+/// @brief Finds where a row ends. Rows end at a newline, at the end of the task, or before the character
+/// @brief that doesn't fit on the screen. Continuation bytes of UTF-8 characters don't take a column.
+/// @param task The task reader.
+/// @param row_start The byte the row starts at.
+/// @param columns The width of the screen, in characters.
+/// @param next_row_start Receives the byte the next row starts at or -1 if it's the last row of the task.
+/// @return The byte right after the row.
+static long __find_row_end(__pager_task* task, const long row_start, const int columns, long* next_row_start);
+
+/// @brief Finds the start of the row that holds a byte, by counting the characters back to the start of its line.
+/// @param task The task reader.
+/// @param position The byte, or the length of the task for its last row.
+/// @param columns The width of the screen, in characters.
+/// @return The byte the row starts at.
+static long __find_row_start(__pager_task* task, const long position, const int columns);
+
+/// @brief Finds the start of the row above another one of the same task.
+/// @param task The task reader.
+/// @param row_start The byte the row starts at.
+/// @param columns The width of the screen, in characters.
+/// @return The byte the previous row starts at or -1 if the previous row is the header of the task.
+static long __find_previous_row(__pager_task* task, const long row_start, const int columns);
+
+/// @brief Draws the bytes of a row, a part at a time.
+/// @param task The task reader.
+/// @param screen The renderer of the terminal.
+/// @param row_start The byte the row starts at.
+/// @param row_end The byte right after the row.
+static void __render_row(__pager_task* task, renderer* screen, const long row_start, const long row_end);
+
+/* Public Functions */
+
+bool run_pager(const db_handle* db, renderer* screen, const int input_fd)
+{
+    struct termios original_mode, raw_mode;
+
+    if (!isatty(input_fd) || tcgetattr(input_fd, &original_mode) != 0)
+        return false;
+
+    __pager_task task = { .db = db, .part = malloc(__part_size) };
+
+    if (task.part == NULL)
+        return false;
+
+    // Keys are read as they're pressed, without echo and without turning Ctrl + C or Ctrl + Z into signals.
+    raw_mode = original_mode;
+    raw_mode.c_lflag &= ~(ICANON | ECHO | ISIG | IEXTEN);
+    raw_mode.c_iflag &= ~(IXON | ICRNL);
+    raw_mode.c_cc[VMIN] = 1;
+    raw_mode.c_cc[VTIME] = 0;
+
+    if (tcsetattr(input_fd, TCSAFLUSH, &raw_mode) != 0)
+    {
+        free(task.part);
+        return false;
+    }
+
+    __pager_position position = { .after_id = 0, .offset = -1 };
+    char message[64] = { 0 };
+    int columns = __get_screen_size(input_fd).ws_col;
+    bool is_running = true;
+
+    while (is_running)
+    {
+        const struct winsize size = __get_screen_size(input_fd);
+        const int body_rows = size.ws_row - 1;
+
+        // Rows start somewhere else once the width changes, so the top row moves to the start of the row that holds it.
+        if (size.ws_col != columns && position.offset > 0 && __open_task(&task, position.after_id))
+            position.offset = __find_row_start(&task, position.offset, size.ws_col);
+
+        columns = size.ws_col;
+
+        const bool is_at_end = __draw_screen(&task, screen, position, size, (message[0] != '\0') ? message : __help_text);
+
+        message[0] = '\0';
+
+        switch (__read_key(input_fd, NULL))
+        {
+            case __KEY_DOWN:
+                if (!is_at_end)
+                    __scroll_down(&task, &position, columns);
+                break;
+            case __KEY_UP:
+                __scroll_up(&task, &position, columns);
+                break;
+            case __KEY_PAGE_DOWN:
+                // The last row of the screen becomes the first one, so the user keeps their place.
+                for (int row = 1; !is_at_end && row < body_rows && __scroll_down(&task, &position, columns); row++);
+                break;
+            case __KEY_PAGE_UP:
+                for (int row = 1; row < body_rows && __scroll_up(&task, &position, columns); row++);
+                break;
+            case __KEY_FIRST:
+                position = (__pager_position){ .after_id = 0, .offset = -1 };
+                break;
+            case __KEY_LAST:
+            {
+                // Start at the last row of the last task, then fill the screen upwards.
+                const int last_after_id = find_previous_page(db, INT_MAX, 1);
+
+                if (last_after_id < 0 || !__open_task(&task, last_after_id))
+                    break;
+
+                position = (__pager_position){ .after_id = last_after_id, .offset = __find_row_start(&task, task.length, columns) };
+
+                for (int row = 1; row < body_rows && __scroll_up(&task, &position, columns); row++);
+                break;
+            }
+            case __KEY_JUMP:
+                __jump_to_id(&task, screen, input_fd, &position, size, message, sizeof(message));
+                break;
+            case __KEY_QUIT:
+                is_running = false;
+                break;
+            default:
+                break;
+        }
+    }
+
+    tcsetattr(input_fd, TCSAFLUSH, &original_mode);
+    free(task.part);
+
+    return true;
+}
+
+/* Private Functions */
+
+static bool __draw_screen(__pager_task* task, renderer* screen, const __pager_position position, const struct winsize size, const char* status)
+{
+    int free_rows = size.ws_row - 1;
+    long row_start = position.offset;
+    bool has_task = __open_task(task, position.after_id);
+    char header[32];
+
+    begin_frame(screen);
+
+    // Only the parts of the tasks that fit on the screen are read, however long the tasks are.
+    while (has_task && free_rows > 0)
+    {
+        long next_row_start = 0;
+
+        if (row_start < 0)
+        {
+            // The header is ASCII, so each of its bytes takes a column.
+            const int header_length = snprintf(header, sizeof(header), "--- Note ID: %d ---", task->id);
+            render_text(screen, header, min(header_length, size.ws_col));
+        }
+        else
+            __render_row(task, screen, row_start, __find_row_end(task, row_start, size.ws_col, &next_row_start));
+
+        render_text(screen, NEWLINE, strlen(NEWLINE));
+        free_rows--;
+
+        // After the last row of a task comes the header of the next one.
+        row_start = next_row_start;
+
+        if (row_start < 0)
+            has_task = __open_task(task, task->id);
+    }
+
+    // The status line goes on the last row, even if the tasks didn't fill the screen.
+    render_format(screen, "\033[%d;1H", size.ws_row);
+    render_text(screen, status, min((int)strlen(status), size.ws_col - 1));
+    present_frame(screen);
+
+    return !has_task;
+}
+
+static bool __scroll_down(__pager_task* task, __pager_position* position, const int columns)
+{
+    long next_row_start = 0;
+
+    if (!__open_task(task, position->after_id))
+        return false;
+
+    if (position->offset >= 0)
+        __find_row_end(task, position->offset, columns, &next_row_start);
+
+    if (next_row_start >= 0)
+    {
+        position->offset = next_row_start;
+        return true;
+    }
+
+    const int id = task->id;
+
+    if (!__open_task(task, id))
+        return false;
+
+    *position = (__pager_position){ .after_id = id, .offset = -1 };
+
+    return true;
+}
+
+static bool __scroll_up(__pager_task* task, __pager_position* position, const int columns)
+{
+    // Past the last task, the previous one is the last task.
+    const bool has_task = __open_task(task, position->after_id);
+
+    if (has_task && position->offset >= 0)
+    {
+        position->offset = __find_previous_row(task, position->offset, columns);
+        return true;
+    }
+
+    const int previous_after_id = find_previous_page(task->db, (has_task) ? task->id : INT_MAX, 1);
+
+    if (previous_after_id < 0 || !__open_task(task, previous_after_id))
+        return false;
+
+    *position = (__pager_position){ .after_id = previous_after_id, .offset = __find_row_start(task, task->length, columns) };
+
+    return true;
+}
+
+static void __jump_to_id(__pager_task* task, renderer* screen, const int input_fd, __pager_position* position,
+    const struct winsize size, char* message, const size_t message_length)
+{
+    char digits[16] = { 0 }, prompt[32];
+    int digit_amount = 0;
+
+    while (true)
+    {
+        char character = '\0';
+
+        snprintf(prompt, sizeof(prompt), "Go to note ID: %s", digits);
+        __draw_screen(task, screen, *position, size, prompt);
+
+        const __pager_key key = __read_key(input_fd, &character);
+
+        if (key == __KEY_QUIT)
+            return;
+
+        if (character >= '0' && character <= '9' && digit_amount < __max_id_digits)
+            digits[digit_amount++] = character;
+        else if ((character == '\b' || character == 127) && digit_amount > 0)
+            digits[--digit_amount] = '\0';
+        else if (character == '\r' || character == '\n')
+            break;
+    }
+
+    const int id = atoi(digits);
+
+    if (id <= 0)
+        return;
+
+    // The ID may have been deleted, so the pager goes to the closest task after it.
+    if (__open_task(task, id - 1))
+        *position = (__pager_position){ .after_id = id - 1, .offset = -1 };
+    else
+        snprintf(message, message_length, "No notes from ID %d onwards.", id);
+}
+
+static __pager_key __read_key(const int input_fd, char* character)
+{
+    char sequence[8] = { 0 };
+    struct pollfd input = { .fd = input_fd, .events = POLLIN };
+
+    // Keys are read one byte at a time, so typing ahead or pasting doesn't lose any of them.
+    if (read(input_fd, sequence, 1) != 1)
+        return __KEY_QUIT;
+
+    // The rest of an escape sequence arrives right after the Esc, while a lone Esc is the key itself.
+    const bool is_sequence = sequence[0] == '\033' && poll(&input, 1, __escape_timeout_ms) > 0
+        && read(input_fd, sequence + 1, sizeof(sequence) - 2) > 0;
+
+    if (character != NULL)
+        *character = (is_sequence) ? '\0' : sequence[0];
+
+    if (is_sequence)
+    {
+        if (strcmp(sequence, "\033[A") == 0 || strcmp(sequence, "\033OA") == 0)
+            return __KEY_UP;
+        if (strcmp(sequence, "\033[B") == 0 || strcmp(sequence, "\033OB") == 0)
+            return __KEY_DOWN;
+        if (strcmp(sequence, "\033[5~") == 0)
+            return __KEY_PAGE_UP;
+        if (strcmp(sequence, "\033[6~") == 0)
+            return __KEY_PAGE_DOWN;
+        if (strcmp(sequence, "\033[H") == 0 || strcmp(sequence, "\033OH") == 0 || strcmp(sequence, "\033[1~") == 0)
+            return __KEY_FIRST;
+        if (strcmp(sequence, "\033[F") == 0 || strcmp(sequence, "\033OF") == 0 || strcmp(sequence, "\033[4~") == 0)
+            return __KEY_LAST;
+
+        return __KEY_NONE;
+    }
+
+    switch (sequence[0])
+    {
+        case 'j': case '\r': case '\n':
+            return __KEY_DOWN;
+        case 'k':
+            return __KEY_UP;
+        case ' ': case 'f':
+            return __KEY_PAGE_DOWN;
+        case 'b':
+            return __KEY_PAGE_UP;
+        case 'g':
+            return __KEY_FIRST;
+        case 'G':
+            return __KEY_LAST;
+        case ':':
+            return __KEY_JUMP;
+        case 'q': case 'Q': case '\033': case 3:    // 3 is Ctrl + C in raw mode.
+            return __KEY_QUIT;
+        default:
+            return __KEY_NONE;
+    }
+}
+
+static struct winsize __get_screen_size(const int input_fd)
+{
+    struct winsize size;
+
+    if (ioctl(input_fd, TIOCGWINSZ, &size) != 0 || size.ws_row < 2 || size.ws_col < 2)
+        return __default_screen_size;
+
+    return size;
+}
+
+static bool __open_task(__pager_task* task, const int after_id)
+{
+    task->part_offset = 0;
+    task->part_length = read_task_part(task->db, after_id, 0, task->part, __part_size, &task->id, &task->length);
+
+    return task->part_length >= 0;
+}
+
+static int __get_byte(__pager_task* task, const long position)
+{
+    if (position < 0 || position >= task->length)
+        return -1;
+
+    if (position < task->part_offset || position >= task->part_offset + task->part_length)
+    {
+        long part_offset = position;
+
+        // Scanning backwards keeps the byte at the end of the part, so the bytes before it are read along with it.
+        if (position < task->part_offset)
+            part_offset = (position < __part_size) ? 0 : position + 1 - __part_size;
+        int id = 0;
+        long length = 0;
+
+        const int part_length = read_task_part(task->db, task->id - 1, part_offset, task->part, __part_size, &id, &length);
+
+        // The task was deleted or edited since it was opened, so it ends here.
+        if (part_length <= 0 || id != task->id || length != task->length)
+        {
+            task->length = position;
+            task->part_length = 0;
+
+            return -1;
+        }
+
+        task->part_offset = part_offset;
+        task->part_length = part_length;
+    }
+
+    return (unsigned char)task->part[position - task->part_offset];
+}
+
+static long __find_row_end(__pager_task* task, const long row_start, const int columns, long* next_row_start)
+{
+    int column = 0;
+
+    for (long position = row_start; ; position++)
+    {
+        const int byte = __get_byte(task, position);
+
+        if (byte < 0 || byte == '\n')
+        {
+            *next_row_start = (byte < 0) ? -1 : position + 1;
+            return position;
+        }
+
+        const bool is_character_start = (byte & 0xC0) != 0x80;
+
+        // A character that doesn't fit starts the next row, so characters are never split between rows.
+        if (is_character_start && column == columns)
+        {
+            *next_row_start = position;
+            return position;
+        }
+
+        column += is_character_start;
+    }
+}
+
+static long __find_row_start(__pager_task* task, const long position, const int columns)
+{
+    const int byte = __get_byte(task, position);
+    long line_start = position;
+    long character_amount = 0;
+
+    // Only the characters before the byte on its line are counted, never the rest of the task.
+    for (int previous_byte; (previous_byte = __get_byte(task, line_start - 1)) >= 0 && previous_byte != '\n'; line_start--)
+        character_amount += (previous_byte & 0xC0) != 0x80;
+
+    // Every row but the last one of a line is exactly as wide as the screen. A newline, the end of
+    // the task and a continuation byte belong to the character before them.
+    const bool is_character_start = byte >= 0 && byte != '\n' && (byte & 0xC0) != 0x80;
+    const long character_index = (is_character_start || character_amount == 0) ? character_amount : character_amount - 1;
+    long skipped_amount = character_amount - (character_index / columns) * columns;
+
+    if (character_index < columns)
+        return line_start;
+
+    long row_start = position;
+
+    for (; skipped_amount > 0; row_start--)
+        skipped_amount -= (__get_byte(task, row_start - 1) & 0xC0) != 0x80;
+
+    return row_start;
+}
+
+static long __find_previous_row(__pager_task* task, const long row_start, const int columns)
+{
+    if (row_start <= 0)
+        return -1;
+
+    // Above the start of a line is the last row of the previous line, which depends on the whole line.
+    if (__get_byte(task, row_start - 1) == '\n')
+        return __find_row_start(task, row_start - 1, columns);
+
+    // Otherwise the row above is a full one, so it starts as many characters back as the screen is wide.
+    long previous_row_start = row_start;
+
+    for (int skipped_amount = columns; skipped_amount > 0 && previous_row_start > 0; previous_row_start--)
+        skipped_amount -= (__get_byte(task, previous_row_start - 1) & 0xC0) != 0x80;
+
+    // Continuation bytes at the start of a line still belong to its first row.
+    long line_start = previous_row_start;
+
+    while (line_start > 0 && (__get_byte(task, line_start - 1) & 0xC0) == 0x80)
+        line_start--;
+
+    const int byte_before_line = __get_byte(task, line_start - 1);
+
+    return (byte_before_line < 0 || byte_before_line == '\n') ? line_start : previous_row_start;
+}
+
+static void __render_row(__pager_task* task, renderer* screen, const long row_start, const long row_end)
+{
+    for (long position = row_start; position < row_end && __get_byte(task, position) >= 0; )
+    {
+        const long part_end = (row_end < task->part_offset + task->part_length) ? row_end : task->part_offset + task->part_length;
+
+        render_text(screen, task->part + (position - task->part_offset), (int)(part_end - position));
+        position = part_end;
+    }
+}
@@ -0,0 +1,17 @@
+#ifndef PAGER_H // Only include this header file if it hasn't been included in the calling file already
+    #define PAGER_H
+
+    #include "./renderer.h"
+    #include "../database/sqlite_db.h"
+    #include "../utilities/utilities.h"
+
+    /// @brief Lets the user scroll through every task with the keyboard, reading only the parts of the tasks that fit on the screen.
+    /// @brief Arrows or j/k scroll by one row, Space/PgDn/b/PgUp by one screen, g/G or Home/End jump to the first or
+    /// @brief last tasks, ":" jumps to an ID and q/Esc returns.
+    /// @attention The keyboard and the screen must be terminals, because keys are read in raw mode.
+    /// @param db The database.
+    /// @param screen The renderer of the terminal.
+    /// @param input_fd The file descriptor of the keyboard.
+    /// @return True if the pager ran, False if the terminal could not be switched to raw mode or there was not enough memory.
+    extern bool run_pager(const db_handle* db, renderer* screen, const int input_fd);
+#endif // PAGER_H
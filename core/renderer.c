@@ -0,0 +1,190 @@
+#include <errno.h>
+#include "./renderer.h"
+
+/* Private Types */
+
+/// @brief Builds each screen in memory and writes it to a file descriptor all at once.
+struct renderer
+{
+    /// @brief The file descriptor the frames are written to.
+    int fd;
+
+    /// @brief Whether the file descriptor is a terminal.
+    bool is_terminal;
+
+    /// @brief Whether part of the current frame was lost because the buffer could not grow.
+    bool is_truncated;
+
+    /// @brief The current frame.
+    char* buffer;
+
+    /// @brief The length of the current frame.
+    size_t length;
+
+    /// @brief The size of the buffer.
+    size_t capacity;
+};
+
+/* Private Variables */
+
+/// @brief The initial size of the frame buffer, enough for a menu or a page of notes.
+static const size_t __initial_capacity = 4096;
+
+/// @brief Moves the cursor to the top-left corner and clears the screen and the scrollback, like "clear" does.
+static const char __clear_sequence[] = "\033[H\033[2J\033[3J";
+
+/* Function Prototyping */
+
+/// @brief Makes sure the frame buffer fits the specified amount of additional characters.
+/// @param renderer The renderer.
+/// @param length The amount of characters about to be added.
+/// @return True if they fit, False if the buffer could not grow.
+static bool __reserve(renderer* renderer, const size_t length);
+
+/* Public Functions */
+
+renderer* create_renderer(const int fd)
+{
+    renderer* new_renderer = calloc(1, sizeof(renderer));
+
+    if (new_renderer == NULL)
+        return NULL;
+
+    new_renderer->buffer = malloc(__initial_capacity);
+
+    if (new_renderer->buffer == NULL)
+    {
+        free(new_renderer);
+        return NULL;
+    }
+
+    new_renderer->fd = fd;
+    new_renderer->is_terminal = isatty(fd);
+    new_renderer->capacity = __initial_capacity;
+
+    return new_renderer;
+}
+
+bool is_terminal_renderer(const renderer* renderer)
+{
+    return renderer->is_terminal;
+}
+
+void begin_frame(renderer* renderer)
+{
+    renderer->length = 0;
+    renderer->is_truncated = false;
+
+    // Files and pipes get the content only, without escape sequences.
+    if (renderer->is_terminal)
+        render_text(renderer, __clear_sequence, sizeof(__clear_sequence) - 1);
+}
+
+void render_text(renderer* renderer, const char* text, const size_t length)
+{
+    if (!__reserve(renderer, length))
+        return;
+
+    memcpy(renderer->buffer + renderer->length, text, length);
+    renderer->length += length;
+}
+
+void render_format(renderer* renderer, const char* format, ...)
+{
+    va_list arguments;
+
+    va_start(arguments, format);
+    const int length = vsnprintf(renderer->buffer + renderer->length, renderer->capacity - renderer->length, format, arguments);
+    va_end(arguments);
+
+    if (length < 0)
+    {
+        renderer->is_truncated = true;
+        return;
+    }
+
+    // The text didn't fit, so it's formatted again once the buffer has grown.
+    if ((size_t)length >= renderer->capacity - renderer->length)
+    {
+        if (!__reserve(renderer, length + 1))
+            return;
+
+        va_start(arguments, format);
+        vsnprintf(renderer->buffer + renderer->length, renderer->capacity - renderer->length, format, arguments);
+        va_end(arguments);
+    }
+
+    renderer->length += length;
+}
+
+void render_char(renderer* renderer, const char character, const int amount)
+{
+    if (amount <= 0 || !__reserve(renderer, amount))
+        return;
+
+    memset(renderer->buffer + renderer->length, character, amount);
+    renderer->length += amount;
+}
+
+bool present_frame(renderer* renderer)
+{
+    bool success = !renderer->is_truncated;
+    size_t written = 0;
+
+    // The frame is written at once, so the terminal never shows a half-drawn screen.
+    while (written < renderer->length)
+    {
+        const ssize_t result = write(renderer->fd, renderer->buffer + written, renderer->length - written);
+
+        if (result < 0 && errno == EINTR)
+            continue;
+
+        if (result <= 0)
+        {
+            success = false;
+            break;
+        }
+
+        written += result;
+    }
+
+    renderer->length = 0;
+    renderer->is_truncated = false;
+
+    return success;
+}
+
+void free_renderer(renderer* renderer)
+{
+    if (renderer == NULL)
+        return;
+
+    free(renderer->buffer);
+    free(renderer);
+}
+
+/* Private Functions */
+
+static bool __reserve(renderer* renderer, const size_t length)
+{
+    if (renderer->length + length <= renderer->capacity)
+        return true;
+
+    size_t new_capacity = renderer->capacity;
+
+    while (new_capacity < renderer->length + length)
+        new_capacity *= 2;
+
+    char* new_buffer = realloc(renderer->buffer, new_capacity);
+
+    if (new_buffer == NULL)
+    {
+        renderer->is_truncated = true;
+        return false;
+    }
+
+    renderer->buffer = new_buffer;
+    renderer->capacity = new_capacity;
+
+    return true;
+}
@@ -0,0 +1,52 @@
+#ifndef RENDERER_H // Only include this header file if it hasn't been included in the calling file already
+    #define RENDERER_H
+
+    #include <stdarg.h>
+    #include "../utilities/utilities.h"
+
+    /// @brief Builds each screen in memory and writes it to a file descriptor all at once.
+    /// @attention Must be manually deallocated with "free_renderer()"!
+    typedef struct renderer renderer;
+
+    /// @brief Creates a renderer for the specified file descriptor.
+    /// @param fd The file descriptor the frames are written to.
+    /// @return The renderer or NULL if it could not be allocated.
+    extern renderer* create_renderer(const int fd);
+
+    /// @brief Checks if a renderer writes to a terminal, in which case frames start by clearing the screen.
+    /// @param renderer The renderer.
+    /// @return True if the output is a terminal, False if it's a file or a pipe.
+    extern bool is_terminal_renderer(const renderer* renderer);
+
+    /// @brief Starts a new frame, discarding anything that wasn't presented. On a terminal, the frame clears the screen.
+    /// @param renderer The renderer.
+    extern void begin_frame(renderer* renderer);
+
+    /// @brief Adds text to the current frame.
+    /// @param renderer The renderer.
+    /// @param text The text.
+    /// @param length The length of the text.
+    extern void render_text(renderer* renderer, const char* text, const size_t length);
+
+    /// @brief Adds formatted text to the current frame.
+    /// @param renderer The renderer.
+    /// @param format The "printf()" format of the text.
+    /// @param ... The arguments of the format.
+    extern void render_format(renderer* renderer, const char* format, ...) __attribute__((format(printf, 2, 3)));
+
+    /// @brief Adds a character to the current frame by the specified amount.
+    /// @param renderer The renderer.
+    /// @param character The character.
+    /// @param amount How many times the character is added.
+    extern void render_char(renderer* renderer, const char character, const int amount);
+
+    /// @brief Writes the current frame and starts an empty one that doesn't clear the screen.
+    /// @attention Must be called before waiting for user input, so prompts are visible.
+    /// @param renderer The renderer.
+    /// @return True if the whole frame was written, False otherwise.
+    extern bool present_frame(renderer* renderer);
+
+    /// @brief Frees the memory allocated for a renderer, without presenting the current frame.
+    /// @param renderer The renderer. May be NULL.
+    extern void free_renderer(renderer* renderer);
+#endif // RENDERER_H
@@ -0,0 +1,695 @@
+#include <stdint.h>
+#include "./replay.h"
+
+/* Private Types */
+
+/// @brief What a first pass over a trace found out, to prepare the replay.
+typedef struct __replay_plan
+{
+    /// @brief The amount of valid records, up to the first truncated or invalid one.
+    long record_amount;
+
+    /// @brief The longest text any call wrote or searched for.
+    int64_t max_size;
+
+    /// @brief The sum of the lengths of the texts the calls wrote.
+    int64_t written_size;
+
+    /// @brief The amount of texts the calls wrote.
+    long written_amount;
+
+    /// @brief The highest ID of any record.
+    int max_id;
+
+    /// @brief The first ID the trace created or zero if it created none.
+    int first_created_id;
+
+    /// @brief The highest ID read, written or deleted that existed before the trace created any.
+    int max_existing_id;
+
+    /// @brief The highest number of an insert queued with "insert_task_async()".
+    int max_insert_number;
+} __replay_plan;
+
+/// @brief The latencies of one kind of call.
+typedef struct __replay_latencies
+{
+    /// @brief The latency of each call, in nanoseconds.
+    uint64_t* samples_ns;
+
+    /// @brief The amount of calls.
+    size_t amount;
+
+    /// @brief How many latencies fit in "samples_ns".
+    size_t capacity;
+
+    /// @brief The sum of every latency, in nanoseconds.
+    uint64_t total_ns;
+} __replay_latencies;
+
+/// @brief State of a replay.
+typedef struct __replay_state
+{
+    /// @brief The database.
+    const db_handle* db;
+
+    /// @brief Generated text, null-terminated. A text of length N is its last N characters.
+    char* payload;
+
+    /// @brief The length of "payload".
+    int64_t payload_length;
+
+    /// @brief The ID the replay created for each ID the trace created, indexed by the recorded ID. Zero if there is none.
+    int* id_map;
+
+    /// @brief How many IDs fit in "id_map".
+    int id_map_length;
+
+    /// @brief The ID each async insert of the replay was given, indexed by the number the trace gave the insert.
+    /// @brief Zero while it's queued and -1 if it failed. Set atomically by the background writer.
+    int* async_ids;
+
+    /// @brief How many numbers fit in "async_ids".
+    int async_ids_length;
+
+    /// @brief The latencies of each kind of call, indexed by "db_trace_operation".
+    __replay_latencies latencies[DB_TRACE_OPERATION_AMOUNT];
+} __replay_state;
+
+/* Private Variables */
+
+/// @brief The words generated texts are made of.
+static const char* const __payload_words[] = {
+    "note", "meeting", "buy", "call", "review", "deadline", "project", "idea", "draft", "send",
+    "report", "fix", "plan", "check", "update", "tomorrow", "week", "team", "budget", "follow"
+};
+
+/// @brief How many tasks each transaction adds when filling an empty database.
+static const int __seed_batch_size = 1000;
+
+/// @brief The length of the tasks that fill an empty database when the trace wrote none.
+static const int64_t __default_seed_length = 64;
+
+/* Function Prototypes */
+
+/// @brief Reads a trace once to find how many records are valid, the longest text, the highest IDs and the first ID it created.
+/// @param trace_location The path of the trace file.
+/// @param plan Receives what was found.
+/// @return True if the trace could be opened and has a valid header, False otherwise.
+static bool __plan_replay(const char* trace_location, __replay_plan* plan);
+
+/// @brief Fills an empty database with tasks, so the IDs a trace expects to exist do.
+/// @param state The state of the replay.
+/// @param plan What the first pass found.
+/// @return True if the tasks were added, False otherwise.
+static bool __seed_database(__replay_state* state, const __replay_plan* plan);
+
+/// @brief Issues a recorded call and records its latency.
+/// @param state The state of the replay.
+/// @param reader The trace, positioned after the record. Batches read their items from it.
+/// @param record The record.
+/// @return True if the call was issued, False if the trace is invalid or there was not enough memory.
+static bool __replay_record(__replay_state* state, db_trace_reader* reader, const db_trace_record* record);
+
+/// @brief Issues a recorded batch call, after reading its items.
+/// @param state The state of the replay.
+/// @param reader The trace, positioned after the record of the batch.
+/// @param record The record of the batch.
+/// @return True if the call was issued, False if the trace is invalid or there was not enough memory.
+static bool __replay_batch(__replay_state* state, db_trace_reader* reader, const db_trace_record* record);
+
+/// @brief Maps the ID the recording gave an async insert to the one the replay's insert was given, once it's committed.
+/// @param state The state of the replay.
+/// @param record The commit of the insert.
+static void __map_async_insert(__replay_state* state, const db_trace_record* record);
+
+/// @brief Callback of "insert_task_async()" that keeps the ID the task was given.
+/// @param custom_state The int* of the insert in "async_ids".
+/// @param success Whether the task was added.
+/// @param id The ID of the task.
+static void __callback_keep_async_id(void* custom_state, const bool success, const int id);
+
+/// @brief Gets a generated text of a length.
+/// @param state The state of the replay.
+/// @param size The length, clamped to the generated text.
+/// @return The null-terminated text.
+static const char* __get_payload(const __replay_state* state, const int64_t size);
+
+/// @brief Gets the ID the replay uses for a recorded ID.
+/// @param state The state of the replay.
+/// @param id The recorded ID.
+/// @return The ID the replay created for it or the recorded ID if it didn't create one.
+static int __map_id(const __replay_state* state, const int64_t id);
+
+/// @brief Converts a recorded ID, limit or length to an int.
+/// @param value The recorded value.
+/// @return The value, clamped between zero and INT_MAX.
+static int __clamp_to_int(const int64_t value);
+
+/// @brief Adds a latency to a kind of call.
+/// @param state The state of the replay.
+/// @param operation The kind of call.
+/// @param latency_ns The latency, in nanoseconds.
+/// @return True if the latency was added, False if there was not enough memory.
+static bool __add_latency(__replay_state* state, const db_trace_operation operation, const uint64_t latency_ns);
+
+/// @brief Prints the amount of calls and the mean, median, 99th percentile and maximum latency of each kind of call.
+/// @param state The state of the replay.
+static void __print_report(__replay_state* state);
+
+/// @brief Compares two latencies, for "qsort()".
+/// @param left The first latency.
+/// @param right The second latency.
+/// @return Negative, zero or positive if the first latency is lower, equal or higher.
+static int __compare_latencies(const void* left, const void* right);
+
+/// @brief Visitor that ignores the task, so reads cost the same as in the recorded program without printing anything.
+/// @param custom_state Unused.
+/// @param id The ID of the task.
+/// @param task The content of the task.
+/// @param length The length of the task.
+/// @return Zero, so the iteration continues.
+static int __visitor_ignore_task(void* custom_state, const int id, const char* task, const int length);
+
+/// @brief Gets a monotonic timestamp.
+/// @return The current time in nanoseconds.
+static uint64_t __get_time_ns();
+
+/* Public Functions */
+
+int replay_trace(const db_handle* db, const char* trace_location, const bool keeps_timing)
+{
+    __replay_plan plan = { 0 };
+
+    if (!__plan_replay(trace_location, &plan))
+    {
+        fprintf(stderr, "\"%s\" is not a valid trace." NEWLINE, trace_location);
+        return EIO;
+    }
+
+    __replay_state state = {
+        .db = db,
+        .payload_length = max(1, __clamp_to_int(plan.max_size)),
+        .id_map_length = (plan.max_id == INT_MAX) ? INT_MAX : plan.max_id + 1,
+        .async_ids_length = (plan.max_insert_number == INT_MAX) ? INT_MAX : plan.max_insert_number + 1
+    };
+
+    state.payload = malloc(state.payload_length + 1);
+    state.id_map = calloc(state.id_map_length, sizeof(int));
+    state.async_ids = calloc(state.async_ids_length, sizeof(int));
+
+    db_trace_reader* reader = (state.payload == NULL || state.id_map == NULL || state.async_ids == NULL)
+        ? NULL
+        : open_trace_reader(trace_location);
+    int status_code = (reader == NULL) ? ENOMEM : EXIT_SUCCESS;
+
+    // The text is generated the same way every time, so replays of the same trace write the same tasks.
+    for (int64_t position = 0, seed = 1; reader != NULL && position < state.payload_length;)
+    {
+        seed = (seed * 1103515245 + 12345) & 0x7FFFFFFF;
+
+        const char* word = __payload_words[seed % (sizeof(__payload_words) / sizeof(__payload_words[0]))];
+
+        for (size_t index = 0; word[index] != '\0' && position < state.payload_length; index++)
+            state.payload[position++] = word[index];
+
+        if (position < state.payload_length)
+            state.payload[position++] = ' ';
+    }
+
+    if (reader != NULL)
+        state.payload[state.payload_length] = '\0';
+
+    if (status_code == EXIT_SUCCESS && !__seed_database(&state, &plan))
+        status_code = EIO;
+
+    db_trace_record record;
+    uint64_t first_timestamp_us = 0, max_lag_ns = 0;
+    const uint64_t started_at_ns = __get_time_ns();
+    long replayed_amount = 0;
+
+    // A recording that was cut short ends in the middle of a record, so only the complete ones are replayed.
+    while (status_code == EXIT_SUCCESS && replayed_amount < plan.record_amount && trace_reader_next(reader, &record))
+    {
+        if (replayed_amount == 0)
+            first_timestamp_us = record.timestamp_us;
+
+        // Each call starts when it started in the recording, relative to the first one, unless the replay fell behind.
+        if (keeps_timing)
+        {
+            const uint64_t due_at_ns = started_at_ns + (record.timestamp_us - first_timestamp_us) * 1000;
+            const uint64_t now_ns = __get_time_ns();
+
+            if (now_ns < due_at_ns)
+            {
+                const struct timespec due_at = { .tv_sec = due_at_ns / 1000000000ull, .tv_nsec = due_at_ns % 1000000000ull };
+                clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &due_at, NULL);
+            }
+            else
+                max_lag_ns = (now_ns - due_at_ns > max_lag_ns) ? now_ns - due_at_ns : max_lag_ns;
+        }
+
+        if (!__replay_record(&state, reader, &record))
+            status_code = ENOMEM;
+
+        replayed_amount++;
+    }
+
+    // The first pass already validated these records, so a failure here means the file changed in between.
+    if (status_code == EXIT_SUCCESS && trace_reader_failed(reader))
+        status_code = EIO;
+
+    // The queue is drained even after a failure, since its callbacks still write into "async_ids".
+    if (!flush_writes(db) && status_code == EXIT_SUCCESS)
+        fprintf(stderr, "Some of the queued writes of the trace failed." NEWLINE);
+
+    if (status_code == EXIT_SUCCESS)
+    {
+        printf("Replayed %ld calls in %.3f s (%s)." NEWLINE, replayed_amount, (__get_time_ns() - started_at_ns) / 1e9,
+            (keeps_timing) ? "original timing" : "maximum speed");
+
+        if (keeps_timing)
+            printf("The replay fell behind the recording by up to %.3f ms." NEWLINE, max_lag_ns / 1e6);
+
+        __print_report(&state);
+    }
+    else
+        fprintf(stderr, "Could not replay \"%s\": %s" NEWLINE, trace_location, strerror(status_code));
+
+    // Cleanup
+    for (int operation = 0; operation < DB_TRACE_OPERATION_AMOUNT; operation++)
+        free(state.latencies[operation].samples_ns);
+
+    close_trace_reader(reader);
+    free(state.payload);
+    free(state.id_map);
+    free(state.async_ids);
+
+    return status_code;
+}
+
+/* Private Functions */
+
+static bool __plan_replay(const char* trace_location, __replay_plan* plan)
+{
+    db_trace_reader* reader = open_trace_reader(trace_location);
+    db_trace_record record;
+    db_trace_operation batch_operation = 0;
+    long batch_item_amount = 0;
+    bool is_damaged = false;
+
+    if (reader == NULL)
+        return false;
+
+    while (!is_damaged && trace_reader_next(reader, &record))
+    {
+        // A batch is only complete once all of its items are read, so a cut inside it drops the whole batch.
+        const bool is_batch = record.operation >= DB_TRACE_INSERT_TASKS && record.operation <= DB_TRACE_RESTORE_TASKS;
+
+        // Batches are recorded with their items at once, so an item outside of one or a call inside of one is damage.
+        is_damaged = (record.operation == DB_TRACE_BATCH_ITEM) != (batch_item_amount > 0);
+
+        if (is_damaged)
+            break;
+
+        if (is_batch)
+            batch_item_amount = __clamp_to_int(record.id);
+        else if (record.operation == DB_TRACE_BATCH_ITEM)
+            batch_item_amount--;
+
+        const bool is_writing = record.operation == DB_TRACE_ADD_TASK || record.operation == DB_TRACE_UPDATE_TASK
+            || record.operation == DB_TRACE_INSERT_TASK_ASYNC || record.operation == DB_TRACE_UPDATE_TASK_ASYNC
+            || (record.operation == DB_TRACE_BATCH_ITEM && batch_operation != DB_TRACE_DELETE_TASKS);
+
+        // Only these calls carry an ID, the rest carry a limit or a time there.
+        const bool uses_id = record.operation == DB_TRACE_TASK_EXISTS || record.operation == DB_TRACE_GET_TASK
+            || record.operation == DB_TRACE_WITH_TASK || record.operation == DB_TRACE_DELETE_TASK
+            || record.operation == DB_TRACE_UPDATE_TASK || record.operation == DB_TRACE_DELETE_TASK_ASYNC
+            || record.operation == DB_TRACE_UPDATE_TASK_ASYNC
+            || (record.operation == DB_TRACE_BATCH_ITEM && batch_operation != DB_TRACE_INSERT_TASKS);
+
+        if (is_batch)
+            batch_operation = record.operation;
+
+        if (record.size > 0 && (is_writing || record.operation == DB_TRACE_SEARCH_TASKS))
+            plan->max_size = (record.size > plan->max_size) ? record.size : plan->max_size;
+
+        if (record.size > 0 && is_writing)
+        {
+            plan->written_size += record.size;
+            plan->written_amount++;
+        }
+
+        // Async inserts only get their ID when they're committed, which is recorded after the call.
+        const bool creates_id = record.operation == DB_TRACE_ADD_TASK || record.operation == DB_TRACE_ASYNC_INSERT_COMMITTED;
+
+        if (record.id > 0 && record.id <= INT_MAX && (uses_id || creates_id))
+            plan->max_id = max(plan->max_id, (int)record.id);
+
+        if (creates_id && record.id > 0 && plan->first_created_id == 0)
+            plan->first_created_id = (int)record.id;
+
+        if (record.operation == DB_TRACE_INSERT_TASK_ASYNC && record.id > 0 && record.id <= INT_MAX)
+            plan->max_insert_number = max(plan->max_insert_number, (int)record.id);
+
+        // Restored tasks keep their IDs, so they never need to exist beforehand.
+        const bool expects_existing = uses_id && batch_operation != DB_TRACE_RESTORE_TASKS
+            && (plan->first_created_id == 0 || record.id < plan->first_created_id);
+
+        if (expects_existing && record.id > 0 && record.id <= INT_MAX)
+            plan->max_existing_id = max(plan->max_existing_id, (int)record.id);
+
+        if (batch_item_amount <= 0)
+            plan->record_amount++;
+    }
+
+    if (is_damaged || trace_reader_failed(reader))
+        fprintf(stderr, "The trace is cut short or damaged, so only its first %ld calls are replayed." NEWLINE, plan->record_amount);
+
+    close_trace_reader(reader);
+
+    return true;
+}
+
+static bool __seed_database(__replay_state* state, const __replay_plan* plan)
+{
+    if (plan->max_existing_id == 0 || count_tasks(state->db) != 0)
+        return true;
+
+    const int64_t seed_length = (plan->written_amount == 0) ? __default_seed_length : plan->written_size / plan->written_amount;
+    const char** tasks = malloc(__seed_batch_size * sizeof(char*));
+
+    if (tasks == NULL)
+        return false;
+
+    for (int index = 0; index < __seed_batch_size; index++)
+        tasks[index] = __get_payload(state, seed_length);
+
+    // A new database numbers its tasks from 1, so these take the IDs the trace read before it created any.
+    int seeded_amount = 0;
+
+    while (seeded_amount < plan->max_existing_id)
+    {
+        const int amount = min(__seed_batch_size, plan->max_existing_id - seeded_amount);
+
+        if (insert_tasks(state->db, tasks, amount, NULL) != amount)
+            break;
+
+        seeded_amount += amount;
+    }
+
+    free(tasks);
+
+    if (seeded_amount == plan->max_existing_id)
+        fprintf(stderr, "The database was empty, so %d notes were added for the trace to read." NEWLINE, seeded_amount);
+
+    return seeded_amount == plan->max_existing_id;
+}
+
+static bool __replay_record(__replay_state* state, db_trace_reader* reader, const db_trace_record* record)
+{
+    const db_handle* db = state->db;
+    const int id = __map_id(state, record->id);
+    const int limit = __clamp_to_int(record->size);
+    const uint64_t started_at_ns = __get_time_ns();
+
+    switch (record->operation)
+    {
+        case DB_TRACE_COUNT_TASKS:
+            count_tasks(db);
+            break;
+        case DB_TRACE_TASK_EXISTS:
+            task_exists(db, id);
+            break;
+        case DB_TRACE_GET_TASK_ID_BOUNDS:
+        {
+            int first_id, last_id;
+            get_task_id_bounds(db, &first_id, &last_id);
+            break;
+        }
+        case DB_TRACE_GET_TASK:
+        {
+            db_task db_task = get_task(db, id);
+            free_db_task(&db_task);
+            break;
+        }
+        case DB_TRACE_WITH_TASK:
+            with_task(db, id, __visitor_ignore_task, NULL);
+            break;
+        case DB_TRACE_FOR_EACH_TASK:
+            for_each_task(db, id, limit, __visitor_ignore_task, NULL);
+            break;
+        case DB_TRACE_READ_TASK_PART:
+        {
+            // Only the size of the buffer is recorded, so the part is read from the start of the task.
+            char* part = malloc(max(1, limit));
+            int part_id;
+            long length;
+
+            if (part != NULL)
+                read_task_part(db, id, 0, part, limit, &part_id, &length);
+
+            free(part);
+            break;
+        }
+        case DB_TRACE_FIND_PREVIOUS_PAGE:
+            find_previous_page(db, id, limit);
+            break;
+        case DB_TRACE_GET_ALL_TASKS:
+        {
+            db_tasks db_tasks = get_all_tasks(db);
+            free_db_tasks(&db_tasks);
+            break;
+        }
+        case DB_TRACE_GET_TASKS_PAGE:
+        {
+            db_tasks db_tasks = get_tasks_page(db, id, limit);
+            free_db_tasks(&db_tasks);
+            break;
+        }
+        case DB_TRACE_GET_TASKS_PAGE_BEFORE:
+        {
+            db_tasks db_tasks = get_tasks_page_before(db, id, limit);
+            free_db_tasks(&db_tasks);
+            break;
+        }
+        case DB_TRACE_GET_TASKS_BETWEEN:
+        {
+            // The range is kept as recorded, since the replayed tasks are all created now.
+            db_tasks db_tasks = get_tasks_between(db, (time_t)record->id, (time_t)(record->id + record->size));
+            free_db_tasks(&db_tasks);
+            break;
+        }
+        case DB_TRACE_SEARCH_TASKS:
+        {
+            db_tasks db_tasks = search_tasks(db, __get_payload(state, record->size), __clamp_to_int(record->id));
+            free_db_tasks(&db_tasks);
+            break;
+        }
+        case DB_TRACE_OPEN_CURSOR:
+        {
+            // Callers read cursors to the end, so the replay does too.
+            db_tasks_cursor cursor = db_tasks_open(db);
+
+            while (db_tasks_next(&cursor));
+
+            db_tasks_close(&cursor);
+            break;
+        }
+        case DB_TRACE_ADD_TASK:
+        {
+            const int created_id = add_task(db, __get_payload(state, record->size));
+
+            if (created_id > 0 && record->id > 0 && record->id < state->id_map_length)
+                state->id_map[record->id] = created_id;
+            break;
+        }
+        case DB_TRACE_DELETE_TASK:
+            delete_task(db, id);
+            break;
+        case DB_TRACE_UPDATE_TASK:
+            update_task(db, id, __get_payload(state, record->size));
+            break;
+        case DB_TRACE_INSERT_TASK_ASYNC:
+        {
+            // Traces from before inserts were numbered have no number, so their IDs can't be mapped.
+            int* async_id = (record->id > 0 && record->id < state->async_ids_length) ? &state->async_ids[record->id] : NULL;
+
+            insert_task_async(db, __get_payload(state, record->size), (async_id == NULL) ? NULL : __callback_keep_async_id, async_id);
+            break;
+        }
+        case DB_TRACE_DELETE_TASK_ASYNC:
+            delete_task_async(db, id, NULL, NULL);
+            break;
+        case DB_TRACE_UPDATE_TASK_ASYNC:
+            update_task_async(db, id, __get_payload(state, record->size), NULL, NULL);
+            break;
+        case DB_TRACE_FLUSH_WRITES:
+            flush_writes(db);
+            break;
+        case DB_TRACE_ASYNC_INSERT_COMMITTED:
+            // The background writer recorded it, not a caller, so it has no latency of its own.
+            __map_async_insert(state, record);
+            return true;
+        case DB_TRACE_INSERT_TASKS:
+        case DB_TRACE_DELETE_TASKS:
+        case DB_TRACE_UPDATE_TASKS:
+        case DB_TRACE_RESTORE_TASKS:
+            return __replay_batch(state, reader, record);
+        default:
+            // Items are read by their batch, so one on its own means the trace is invalid.
+            return false;
+    }
+
+    return __add_latency(state, record->operation, __get_time_ns() - started_at_ns);
+}
+
+static bool __replay_batch(__replay_state* state, db_trace_reader* reader, const db_trace_record* record)
+{
+    const int amount = __clamp_to_int(record->id);
+    int* ids = malloc(max(1, amount) * sizeof(int));
+    const char** tasks = malloc(max(1, amount) * sizeof(char*));
+    time_t* created_at = malloc(max(1, amount) * sizeof(time_t));
+    bool success = ids != NULL && tasks != NULL && created_at != NULL;
+    db_trace_record item;
+
+    for (int index = 0; success && index < amount; index++)
+    {
+        success = trace_reader_next(reader, &item) && item.operation == DB_TRACE_BATCH_ITEM;
+
+        // Restored tasks keep the IDs they were recorded with.
+        ids[index] = (record->operation == DB_TRACE_RESTORE_TASKS) ? (int)item.id : __map_id(state, item.id);
+        tasks[index] = __get_payload(state, item.size);
+        created_at[index] = get_current_time();
+    }
+
+    if (success)
+    {
+        const uint64_t started_at_ns = __get_time_ns();
+
+        if (record->operation == DB_TRACE_INSERT_TASKS)
+            insert_tasks(state->db, tasks, amount, NULL);
+        else if (record->operation == DB_TRACE_DELETE_TASKS)
+            delete_tasks(state->db, ids, amount, NULL);
+        else if (record->operation == DB_TRACE_UPDATE_TASKS)
+            update_tasks(state->db, ids, tasks, amount, NULL);
+        else
+            restore_tasks(state->db, ids, tasks, created_at, amount, NULL);
+
+        success = __add_latency(state, record->operation, __get_time_ns() - started_at_ns);
+    }
+
+    free(ids);
+    free(tasks);
+    free(created_at);
+
+    return success;
+}
+
+static void __map_async_insert(__replay_state* state, const db_trace_record* record)
+{
+    if (record->id <= 0 || record->id >= state->id_map_length || record->size <= 0 || record->size >= state->async_ids_length)
+        return;
+
+    int* async_id = &state->async_ids[record->size];
+
+    // The recorded program only used the ID after the commit, so the replay waits for its own insert to be committed too.
+    if (__atomic_load_n(async_id, __ATOMIC_ACQUIRE) == 0)
+        flush_writes(state->db);
+
+    const int created_id = __atomic_load_n(async_id, __ATOMIC_ACQUIRE);
+
+    if (created_id > 0)
+        state->id_map[record->id] = created_id;
+}
+
+static void __callback_keep_async_id(void* custom_state, const bool success, const int id)
+{
+    __atomic_store_n((int*)custom_state, (success) ? id : -1, __ATOMIC_RELEASE);
+}
+
+static const char* __get_payload(const __replay_state* state, const int64_t size)
+{
+    const int64_t length = (size < 0) ? 0 : (size > state->payload_length) ? state->payload_length : size;
+
+    return state->payload + (state->payload_length - length);
+}
+
+static int __map_id(const __replay_state* state, const int64_t id)
+{
+    const int recorded_id = __clamp_to_int(id);
+
+    return (recorded_id < state->id_map_length && state->id_map[recorded_id] != 0) ? state->id_map[recorded_id] : recorded_id;
+}
+
+static int __clamp_to_int(const int64_t value)
+{
+    return (value < 0) ? 0 : (value > INT_MAX) ? INT_MAX : (int)value;
+}
+
+static bool __add_latency(__replay_state* state, const db_trace_operation operation, const uint64_t latency_ns)
+{
+    __replay_latencies* latencies = &state->latencies[operation];
+
+    if (latencies->amount == latencies->capacity)
+    {
+        const size_t new_capacity = (latencies->capacity == 0) ? 256 : latencies->capacity * 2;
+        uint64_t* new_samples = realloc(latencies->samples_ns, new_capacity * sizeof(uint64_t));
+
+        if (new_samples == NULL)
+            return false;
+
+        latencies->samples_ns = new_samples;
+        latencies->capacity = new_capacity;
+    }
+
+    latencies->samples_ns[latencies->amount++] = latency_ns;
+    latencies->total_ns += latency_ns;
+
+    return true;
+}
+
+static void __print_report(__replay_state* state)
+{
+    printf("%-22s %9s %11s %11s %11s %11s" NEWLINE, "Operation", "Calls", "Mean (us)", "p50 (us)", "p99 (us)", "Max (us)");
+
+    for (int operation = 0; operation < DB_TRACE_OPERATION_AMOUNT; operation++)
+    {
+        __replay_latencies* latencies = &state->latencies[operation];
+
+        if (latencies->amount == 0)
+            continue;
+
+        qsort(latencies->samples_ns, latencies->amount, sizeof(uint64_t), __compare_latencies);
+
+        const uint64_t* samples = latencies->samples_ns;
+        const size_t last = latencies->amount - 1;
+
+        printf("%-22s %9zu %11.1f %11.1f %11.1f %11.1f" NEWLINE, trace_operation_name(operation), latencies->amount,
+            latencies->total_ns / 1000.0 / latencies->amount, samples[last / 2] / 1000.0,
+            samples[(size_t)(last * 0.99)] / 1000.0, samples[last] / 1000.0);
+    }
+}
+
+static int __compare_latencies(const void* left, const void* right)
+{
+    const uint64_t left_latency = *(const uint64_t*)left;
+    const uint64_t right_latency = *(const uint64_t*)right;
+
+    return (left_latency > right_latency) - (left_latency < right_latency);
+}
+
+static int __visitor_ignore_task(void* custom_state, const int id, const char* task, const int length)
+{
+    UNUSED(custom_state, id, task, length);
+
+    return 0;
+}
+
+static uint64_t __get_time_ns()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (uint64_t)now.tv_sec * 1000000000ull + (uint64_t)now.tv_nsec;
+}
@@ -0,0 +1,19 @@
+#ifndef REPLAY_H // Only include this header file if it hasn't been included in the calling file already
+    #define REPLAY_H
+
+    #include <stdio.h>
+    #include <errno.h>
+    #include "../database/sqlite_db.h"
+    #include "../database/trace.h"
+    #include "../utilities/utilities.h"
+
+    /// @brief Issues the calls of a trace recorded by "start_trace_recording()" against a database, in order, from a
+    /// @brief single thread, and prints the latency of each kind of call to stdout. Tasks are filled with generated text
+    /// @brief of the recorded length. IDs created by the trace are matched to the ones the replay creates, and an empty
+    /// @brief database is first filled with enough tasks for the IDs the trace reads before creating any.
+    /// @param db The database, ideally a copy of the one the trace was recorded on or an empty one.
+    /// @param trace_location The path of the trace file.
+    /// @param keeps_timing True to wait between calls as long as the recording did, False to issue them as fast as possible.
+    /// @return Exit code.
+    extern int replay_trace(const db_handle* db, const char* trace_location, const bool keeps_timing);
+#endif // REPLAY_H
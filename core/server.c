@@ -0,0 +1,753 @@
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/epoll.h>
+#include <sys/signalfd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include "./server.h"
+
+/* Private Types */
+
+/// @brief A connected client and the bytes waiting to be handled or sent.
+typedef struct __client
+{
+    /// @brief The socket of the client.
+    int fd;
+
+    /// @brief Bytes received but not handled yet, starting at a frame boundary.
+    char* input;
+
+    /// @brief How many bytes "input" holds.
+    size_t input_length;
+
+    /// @brief The size of "input".
+    size_t input_capacity;
+
+    /// @brief Responses that were not sent yet, starting at "output_offset".
+    char* output;
+
+    /// @brief How many bytes "output" holds, including the ones already sent.
+    size_t output_length;
+
+    /// @brief The size of "output".
+    size_t output_capacity;
+
+    /// @brief How many bytes of "output" were sent.
+    size_t output_offset;
+
+    /// @brief The events epoll watches for the client.
+    uint32_t watched_events;
+
+    /// @brief Whether the client stopped sending, so the connection closes once every response is sent.
+    bool is_closing;
+
+    /// @brief Whether the connection must be closed right away, after a protocol or socket error.
+    bool is_broken;
+
+    /// @brief The previous client in the list of the server.
+    struct __client* previous;
+
+    /// @brief The next client in the list of the server.
+    struct __client* next;
+} __client;
+
+/// @brief The state of a running server.
+typedef struct __server
+{
+    /// @brief The database.
+    const db_handle* db;
+
+    /// @brief The epoll instance.
+    int epoll_fd;
+
+    /// @brief The listening socket.
+    int listen_fd;
+
+    /// @brief Every connected client.
+    __client* clients;
+
+    /// @brief Reusable buffer for the null-terminated text of a request.
+    char* scratch;
+
+    /// @brief The size of "scratch".
+    size_t scratch_capacity;
+} __server;
+
+/* Private Variables */
+
+/// @brief How many events a single call to "epoll_wait()" returns at most.
+#define __MAX_EVENTS 64
+
+/// @brief How many bytes are read from a client at a time.
+static const size_t __read_size = 64 * 1024;
+
+/// @brief Clients with this many unsent bytes aren't read from until they receive them.
+static const size_t __max_pending_output = 4 * 1024 * 1024;
+
+/// @brief How many connections may wait to be accepted.
+static const int __listen_backlog = 128;
+
+/// @brief The maximum amount of memory used to cache recently read tasks.
+static const size_t __task_cache_budget = 16 * 1024 * 1024;
+
+/// @brief The size of the status that starts every response.
+static const size_t __status_size = 1;
+
+/// @brief Marks the epoll events of the listening socket.
+static char __listener_tag;
+
+/// @brief Marks the epoll events of the signal file descriptor.
+static char __signal_tag;
+
+/* Function Prototyping */
+
+/// @brief Accepts every client waiting on the listening socket.
+/// @param server The server.
+static void __accept_clients(__server* server);
+
+/// @brief Reads, handles and answers the requests of a client after epoll reported it.
+/// @param server The server.
+/// @param client The client.
+/// @param events The events reported by epoll.
+static void __serve_client(__server* server, __client* client, const uint32_t events);
+
+/// @brief Reads what a client sent, once.
+/// @param client The client.
+static void __read_requests(__client* client);
+
+/// @brief Handles every complete request a client sent, until its unsent responses reach the limit.
+/// @param server The server.
+/// @param client The client.
+/// @return True if requests are left because the limit was reached, False otherwise.
+static bool __handle_requests(__server* server, __client* client);
+
+/// @brief Runs a single request and appends its response to the output of the client.
+/// @param server The server.
+/// @param client The client.
+/// @param request The operation and the payload of the request.
+/// @param request_length The length of the request.
+static void __handle_request(__server* server, __client* client, const unsigned char* request, const size_t request_length);
+
+/// @brief Sends as much of the output of a client as the socket takes.
+/// @param client The client.
+/// @return True if the output was sent or the socket is full, False if the connection failed.
+static bool __write_responses(__client* client);
+
+/// @brief Makes epoll watch the events a client is ready for.
+/// @param server The server.
+/// @param client The client.
+/// @return True if the events were updated, False otherwise.
+static bool __watch_client(__server* server, __client* client);
+
+/// @brief Disconnects a client and frees its memory.
+/// @param server The server.
+/// @param client The client.
+static void __close_client(__server* server, __client* client);
+
+/// @brief Copies the text of a request into the scratch buffer of the server, adding the null terminator.
+/// @param server The server.
+/// @param text The text.
+/// @param length The length of the text.
+/// @return The null-terminated text or NULL if the text contains null characters or there's not enough memory.
+static const char* __terminate_text(__server* server, const unsigned char* text, const size_t length);
+
+/// @brief Appends a response with the specified payload to the output of a client.
+/// @param client The client.
+/// @param status The status of the response.
+/// @param payload The payload. May be NULL if the length is zero.
+/// @param payload_length The length of the payload.
+static void __add_response(__client* client, const unsigned char status, const void* payload, const size_t payload_length);
+
+/// @brief Appends a response with a 32-bit integer as its payload to the output of a client.
+/// @param client The client.
+/// @param value The integer.
+static void __add_integer_response(__client* client, const uint32_t value);
+
+/// @brief Starts a successful response whose payload is appended afterwards.
+/// @param client The client.
+/// @return Where the response starts in the output of the client.
+static size_t __begin_response(__client* client);
+
+/// @brief Writes the length of a response started by "__begin_response()", now that its payload was appended.
+/// @param client The client.
+/// @param response_start Where the response starts in the output of the client.
+static void __end_response(__client* client, const size_t response_start);
+
+/// @brief Appends bytes to the output of a client, marking the client as broken if there's not enough memory.
+/// @param client The client.
+/// @param data The bytes.
+/// @param length The amount of bytes.
+/// @return True if the bytes were appended, False otherwise.
+static bool __append_output(__client* client, const void* data, const size_t length);
+
+/// @brief Grows a buffer to fit at least the specified amount of bytes.
+/// @param buffer The buffer.
+/// @param capacity The size of the buffer.
+/// @param required_capacity The amount of bytes the buffer must fit.
+/// @return True if the buffer fits them, False if there's not enough memory.
+static bool __reserve(char** buffer, size_t* capacity, const size_t required_capacity);
+
+/// @brief Visitor that appends the text of a task to a response.
+/// @param custom_state The client.
+/// @param id The ID of the task.
+/// @param task The content of the task.
+/// @param length The length of the task.
+/// @return Zero.
+static int __visitor_append_task(void* custom_state, const int id, const char* task, const int length);
+
+/// @brief Visitor that appends the ID, the length and the text of a task to a response.
+/// @param custom_state The client.
+/// @param id The ID of the task.
+/// @param task The content of the task.
+/// @param length The length of the task.
+/// @return Non-zero if the client ran out of memory, so the iteration stops.
+static int __visitor_append_list_entry(void* custom_state, const int id, const char* task, const int length);
+
+/// @brief Connects to a socket to find out whether a server is listening on it.
+/// @param address The address of the socket.
+/// @return Zero if a server accepted the connection, the reason the connection failed otherwise.
+static int __probe_socket(const struct sockaddr_un* address);
+
+/// @brief Writes a 32-bit integer in little-endian order.
+/// @param bytes Where the integer is written.
+/// @param value The integer.
+static void __write_uint32(unsigned char* bytes, const uint32_t value);
+
+/// @brief Reads a 32-bit integer stored in little-endian order.
+/// @param bytes Where the integer is stored.
+/// @return The integer.
+static uint32_t __read_uint32(const unsigned char* bytes);
+
+/// @brief Reads the task ID at the start of a payload.
+/// @param payload The payload.
+/// @return The ID or zero if it's out of range, which never matches a task.
+static int __read_id(const unsigned char* payload);
+
+/* Public Functions */
+
+int serve_socket(const db_handle* db, const char* socket_location)
+{
+    struct sockaddr_un address = { .sun_family = AF_UNIX };
+    struct stat file_status;
+    sigset_t stop_signals, previous_signals;
+
+    if (strlen(socket_location) >= sizeof(address.sun_path))
+    {
+        fprintf(stderr, "The socket path \"%s\" is too long." NEWLINE, socket_location);
+        return EINVAL;
+    }
+
+    strcpy(address.sun_path, socket_location);
+
+    // A socket left behind by a server that crashed refuses connections and is replaced, but a live one or any other file is kept.
+    if (lstat(socket_location, &file_status) == 0 && S_ISSOCK(file_status.st_mode))
+    {
+        const int probe_code = __probe_socket(&address);
+
+        if (probe_code == EXIT_SUCCESS)
+        {
+            fprintf(stderr, "Another server is already serving on \"%s\"." NEWLINE, socket_location);
+            return EADDRINUSE;
+        }
+
+        if (probe_code == ECONNREFUSED)
+            unlink(socket_location);
+    }
+
+    // The signals are read from a file descriptor, so stopping the server is just another event of the loop.
+    sigemptyset(&stop_signals);
+    sigaddset(&stop_signals, SIGINT);
+    sigaddset(&stop_signals, SIGTERM);
+    sigprocmask(SIG_BLOCK, &stop_signals, &previous_signals);
+
+    __server server = {
+        .db = db,
+        .epoll_fd = epoll_create1(EPOLL_CLOEXEC),
+        .listen_fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0),
+        .clients = NULL
+    };
+    const int signal_fd = signalfd(-1, &stop_signals, SFD_NONBLOCK | SFD_CLOEXEC);
+    struct epoll_event listener_event = { .events = EPOLLIN, .data.ptr = &__listener_tag };
+    struct epoll_event signal_event = { .events = EPOLLIN, .data.ptr = &__signal_tag };
+
+    const bool is_listening = server.epoll_fd >= 0 && server.listen_fd >= 0 && signal_fd >= 0
+        && bind(server.listen_fd, (struct sockaddr*)&address, sizeof(address)) == 0
+        && listen(server.listen_fd, __listen_backlog) == 0
+        && epoll_ctl(server.epoll_fd, EPOLL_CTL_ADD, server.listen_fd, &listener_event) == 0
+        && epoll_ctl(server.epoll_fd, EPOLL_CTL_ADD, signal_fd, &signal_event) == 0;
+
+    if (is_listening)
+    {
+        // The cache is optional, so the server still works without it.
+        set_task_cache_budget(db, __task_cache_budget);
+        fprintf(stderr, "Serving on \"%s\". Press Ctrl + C to stop." NEWLINE, socket_location);
+    }
+    else
+        fprintf(stderr, "Could not listen on \"%s\": %s" NEWLINE, socket_location, strerror(errno));
+
+    bool is_running = is_listening;
+
+    while (is_running)
+    {
+        struct epoll_event events[__MAX_EVENTS];
+        const int event_amount = epoll_wait(server.epoll_fd, events, __MAX_EVENTS, -1);
+
+        if (event_amount < 0 && errno != EINTR)
+            break;
+
+        for (int index = 0; index < event_amount; index++)
+        {
+            if (events[index].data.ptr == &__signal_tag)
+            {
+                // The signal must be consumed, or it's delivered again once the mask is restored and kills the process.
+                struct signalfd_siginfo signal_info;
+                is_running = read(signal_fd, &signal_info, sizeof(signal_info)) != sizeof(signal_info);
+            }
+            else if (events[index].data.ptr == &__listener_tag)
+                __accept_clients(&server);
+            else
+                __serve_client(&server, events[index].data.ptr, events[index].events);
+        }
+    }
+
+    // Cleanup
+    while (server.clients != NULL)
+        __close_client(&server, server.clients);
+
+    if (is_listening)
+        unlink(socket_location);
+
+    free(server.scratch);
+    close(signal_fd);
+    close(server.listen_fd);
+    close(server.epoll_fd);
+    sigprocmask(SIG_SETMASK, &previous_signals, NULL);
+
+    return (is_listening) ? EXIT_SUCCESS : EIO;
+}
+
+/* Private Functions */
+
+static void __accept_clients(__server* server)
+{
+    int fd;
+
+    while ((fd = accept(server->listen_fd, NULL, NULL)) >= 0)
+    {
+        __client* client = calloc(1, sizeof(__client));
+        struct epoll_event event = { .events = EPOLLIN, .data.ptr = client };
+
+        if (client == NULL || fcntl(fd, F_SETFL, O_NONBLOCK) != 0 || fcntl(fd, F_SETFD, FD_CLOEXEC) != 0
+            || epoll_ctl(server->epoll_fd, EPOLL_CTL_ADD, fd, &event) != 0)
+        {
+            free(client);
+            close(fd);
+            continue;
+        }
+
+        client->fd = fd;
+        client->watched_events = EPOLLIN;
+        client->next = server->clients;
+
+        if (server->clients != NULL)
+            server->clients->previous = client;
+
+        server->clients = client;
+    }
+}
+
+static void __serve_client(__server* server, __client* client, const uint32_t events)
+{
+    if ((events & (EPOLLIN | EPOLLHUP | EPOLLERR)) != 0 && (client->watched_events & EPOLLIN) != 0)
+        __read_requests(client);
+
+    // Requests are answered in order. Once the responses are sent, the ones held back by the limit are handled too.
+    while (!client->is_broken)
+    {
+        const bool has_more_requests = __handle_requests(server, client);
+
+        if (!__write_responses(client))
+            client->is_broken = true;
+
+        if (!has_more_requests || client->output_offset < client->output_length)
+            break;
+    }
+
+    const bool is_done = client->is_closing && client->output_offset == client->output_length;
+
+    if (client->is_broken || is_done || !__watch_client(server, client))
+        __close_client(server, client);
+}
+
+static void __read_requests(__client* client)
+{
+    if (!__reserve(&client->input, &client->input_capacity, client->input_length + __read_size))
+    {
+        client->is_broken = true;
+        return;
+    }
+
+    // A single read per event keeps a busy client from starving the others. Epoll reports the rest again.
+    const ssize_t length = recv(client->fd, client->input + client->input_length, client->input_capacity - client->input_length, 0);
+
+    if (length > 0)
+        client->input_length += length;
+    else if (length == 0)
+        client->is_closing = true;
+    else if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
+        client->is_broken = true;
+}
+
+static bool __handle_requests(__server* server, __client* client)
+{
+    size_t position = 0;
+    bool is_limited = false;
+
+    while (!client->is_broken && client->input_length - position >= SERVER_LENGTH_SIZE)
+    {
+        const uint32_t frame_length = __read_uint32((unsigned char*)client->input + position);
+
+        if (frame_length == 0 || frame_length > SERVER_MAX_FRAME_LENGTH)
+        {
+            client->is_broken = true;
+            break;
+        }
+
+        if (client->input_length - position - SERVER_LENGTH_SIZE < frame_length)
+            break;
+
+        if (client->output_length - client->output_offset >= __max_pending_output)
+        {
+            is_limited = true;
+            break;
+        }
+
+        __handle_request(server, client, (unsigned char*)client->input + position + SERVER_LENGTH_SIZE, frame_length);
+        position += SERVER_LENGTH_SIZE + frame_length;
+    }
+
+    // Keep the incomplete frame at the start of the buffer.
+    memmove(client->input, client->input + position, client->input_length - position);
+    client->input_length -= position;
+
+    return is_limited;
+}
+
+static void __handle_request(__server* server, __client* client, const unsigned char* request, const size_t request_length)
+{
+    const db_handle* db = server->db;
+    const unsigned char* payload = request + 1;
+    const size_t payload_length = request_length - 1;
+
+    switch (request[0])
+    {
+        case SERVER_OP_PING:
+            __add_response(client, (payload_length == 0) ? SERVER_STATUS_OK : SERVER_STATUS_BAD_REQUEST, NULL, 0);
+            break;
+        case SERVER_OP_ADD_TASK:
+        {
+            const char* task = __terminate_text(server, payload, payload_length);
+            const int id = (task == NULL) ? -1 : add_task(db, task);
+
+            if (task == NULL)
+                __add_response(client, SERVER_STATUS_BAD_REQUEST, NULL, 0);
+            else if (id < 0)
+                __add_response(client, SERVER_STATUS_ERROR, NULL, 0);
+            else
+                __add_integer_response(client, id);
+            break;
+        }
+        case SERVER_OP_GET_TASK:
+        {
+            if (payload_length != 4)
+            {
+                __add_response(client, SERVER_STATUS_BAD_REQUEST, NULL, 0);
+                break;
+            }
+
+            // The task is copied straight from the row into the response.
+            const size_t response_start = __begin_response(client);
+
+            if (with_task(db, __read_id(payload), __visitor_append_task, client))
+                __end_response(client, response_start);
+            else
+            {
+                client->output_length = response_start;
+                __add_response(client, SERVER_STATUS_NOT_FOUND, NULL, 0);
+            }
+            break;
+        }
+        case SERVER_OP_UPDATE_TASK:
+        {
+            const int id = (payload_length < 4) ? 0 : __read_id(payload);
+            const char* task = (payload_length < 4) ? NULL : __terminate_text(server, payload + 4, payload_length - 4);
+
+            if (task == NULL)
+                __add_response(client, SERVER_STATUS_BAD_REQUEST, NULL, 0);
+            else if (update_tasks(db, &id, &task, 1, NULL) == 1)
+                __add_response(client, SERVER_STATUS_OK, NULL, 0);
+            else
+                __add_response(client, (task_exists(db, id)) ? SERVER_STATUS_ERROR : SERVER_STATUS_NOT_FOUND, NULL, 0);
+            break;
+        }
+        case SERVER_OP_DELETE_TASK:
+        {
+            const int id = (payload_length != 4) ? 0 : __read_id(payload);
+
+            if (payload_length != 4)
+                __add_response(client, SERVER_STATUS_BAD_REQUEST, NULL, 0);
+            else if (delete_tasks(db, &id, 1, NULL) == 1)
+                __add_response(client, SERVER_STATUS_OK, NULL, 0);
+            else
+                __add_response(client, (task_exists(db, id)) ? SERVER_STATUS_ERROR : SERVER_STATUS_NOT_FOUND, NULL, 0);
+            break;
+        }
+        case SERVER_OP_COUNT_TASKS:
+        {
+            const int task_amount = (payload_length != 0) ? -1 : count_tasks(db);
+
+            if (payload_length != 0)
+                __add_response(client, SERVER_STATUS_BAD_REQUEST, NULL, 0);
+            else if (task_amount < 0)
+                __add_response(client, SERVER_STATUS_ERROR, NULL, 0);
+            else
+                __add_integer_response(client, task_amount);
+            break;
+        }
+        case SERVER_OP_LIST_TASKS:
+        {
+            if (payload_length != 8)
+            {
+                __add_response(client, SERVER_STATUS_BAD_REQUEST, NULL, 0);
+                break;
+            }
+
+            const uint32_t after_id = __read_uint32(payload), limit = __read_uint32(payload + 4);
+            const size_t response_start = __begin_response(client);
+
+            // IDs past the range of a task ID have no tasks after them.
+            const int visited_amount = (after_id > INT_MAX) ? 0 : for_each_task(db, (int)after_id,
+                (limit == 0 || limit > SERVER_MAX_LIST_LIMIT) ? SERVER_MAX_LIST_LIMIT : (int)limit, __visitor_append_list_entry, client);
+
+            if (visited_amount >= 0)
+                __end_response(client, response_start);
+            else
+            {
+                client->output_length = response_start;
+                __add_response(client, SERVER_STATUS_ERROR, NULL, 0);
+            }
+            break;
+        }
+        default:
+            __add_response(client, SERVER_STATUS_BAD_REQUEST, NULL, 0);
+            break;
+    }
+}
+
+static bool __write_responses(__client* client)
+{
+    while (client->output_offset < client->output_length)
+    {
+        const ssize_t length = send(client->fd, client->output + client->output_offset, client->output_length - client->output_offset, MSG_NOSIGNAL);
+
+        if (length > 0)
+            client->output_offset += length;
+        else if (length < 0 && errno == EINTR)
+            continue;
+        else if (length < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+            break;
+        else
+            return false;
+    }
+
+    // Move the unsent bytes to the start once most of the buffer was sent, so it doesn't keep growing.
+    if (client->output_offset == client->output_length)
+        client->output_offset = client->output_length = 0;
+    else if (client->output_offset >= client->output_length / 2)
+    {
+        memmove(client->output, client->output + client->output_offset, client->output_length - client->output_offset);
+        client->output_length -= client->output_offset;
+        client->output_offset = 0;
+    }
+
+    return true;
+}
+
+static bool __watch_client(__server* server, __client* client)
+{
+    const size_t pending_output = client->output_length - client->output_offset;
+    uint32_t events = 0;
+
+    // Clients that don't read their responses aren't read from either, so their output stays bounded.
+    if (!client->is_closing && pending_output < __max_pending_output)
+        events |= EPOLLIN;
+
+    if (pending_output > 0)
+        events |= EPOLLOUT;
+
+    if (events == client->watched_events)
+        return true;
+
+    struct epoll_event event = { .events = events, .data.ptr = client };
+    client->watched_events = events;
+
+    return epoll_ctl(server->epoll_fd, EPOLL_CTL_MOD, client->fd, &event) == 0;
+}
+
+static void __close_client(__server* server, __client* client)
+{
+    if (client->previous != NULL)
+        client->previous->next = client->next;
+    else
+        server->clients = client->next;
+
+    if (client->next != NULL)
+        client->next->previous = client->previous;
+
+    // Closing the socket also removes it from epoll.
+    close(client->fd);
+    free(client->input);
+    free(client->output);
+    free(client);
+}
+
+static const char* __terminate_text(__server* server, const unsigned char* text, const size_t length)
+{
+    if (memchr(text, '\0', length) != NULL || !__reserve(&server->scratch, &server->scratch_capacity, length + 1))
+        return NULL;
+
+    memcpy(server->scratch, text, length);
+    server->scratch[length] = '\0';
+
+    return server->scratch;
+}
+
+static void __add_response(__client* client, const unsigned char status, const void* payload, const size_t payload_length)
+{
+    unsigned char header[SERVER_LENGTH_SIZE + 1];
+
+    __write_uint32(header, (uint32_t)(__status_size + payload_length));
+    header[SERVER_LENGTH_SIZE] = status;
+
+    if (__append_output(client, header, sizeof(header)) && payload_length > 0)
+        __append_output(client, payload, payload_length);
+}
+
+static void __add_integer_response(__client* client, const uint32_t value)
+{
+    unsigned char payload[4];
+
+    __write_uint32(payload, value);
+    __add_response(client, SERVER_STATUS_OK, payload, sizeof(payload));
+}
+
+static size_t __begin_response(__client* client)
+{
+    const size_t response_start = client->output_length;
+
+    // The length is written once the payload is known.
+    __add_response(client, SERVER_STATUS_OK, NULL, 0);
+
+    return response_start;
+}
+
+static void __end_response(__client* client, const size_t response_start)
+{
+    if (client->is_broken)
+        return;
+
+    __write_uint32((unsigned char*)client->output + response_start, (uint32_t)(client->output_length - response_start - SERVER_LENGTH_SIZE));
+}
+
+static bool __append_output(__client* client, const void* data, const size_t length)
+{
+    if (client->is_broken || !__reserve(&client->output, &client->output_capacity, client->output_length + length))
+    {
+        client->is_broken = true;
+        return false;
+    }
+
+    memcpy(client->output + client->output_length, data, length);
+    client->output_length += length;
+
+    return true;
+}
+
+static bool __reserve(char** buffer, size_t* capacity, const size_t required_capacity)
+{
+    if (required_capacity <= *capacity)
+        return true;
+
+    size_t new_capacity = (*capacity == 0) ? 4096 : *capacity;
+
+    while (new_capacity < required_capacity)
+        new_capacity *= 2;
+
+    char* new_buffer = realloc(*buffer, new_capacity);
+
+    if (new_buffer == NULL)
+        return false;
+
+    *buffer = new_buffer;
+    *capacity = new_capacity;
+
+    return true;
+}
+
+static int __visitor_append_task(void* custom_state, const int id, const char* task, const int length)
+{
+    UNUSED(id);
+
+    __append_output(custom_state, task, length);
+
+    return 0;
+}
+
+static int __visitor_append_list_entry(void* custom_state, const int id, const char* task, const int length)
+{
+    unsigned char entry_header[8];
+
+    __write_uint32(entry_header, id);
+    __write_uint32(entry_header + 4, length);
+
+    return !__append_output(custom_state, entry_header, sizeof(entry_header))
+        || !__append_output(custom_state, task, length);
+}
+
+static int __probe_socket(const struct sockaddr_un* address)
+{
+    const int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+
+    if (fd < 0)
+        return errno;
+
+    const int probe_code = (connect(fd, (const struct sockaddr*)address, sizeof(*address)) == 0) ? EXIT_SUCCESS : errno;
+    close(fd);
+
+    return probe_code;
+}
+
+static void __write_uint32(unsigned char* bytes, const uint32_t value)
+{
+    for (int index = 0; index < 4; index++)
+        bytes[index] = (unsigned char)(value >> (8 * index));
+}
+
+static uint32_t __read_uint32(const unsigned char* bytes)
+{
+    uint32_t value = 0;
+
+    for (int index = 0; index < 4; index++)
+        value |= (uint32_t)bytes[index] << (8 * index);
+
+    return value;
+}
+
+static int __read_id(const unsigned char* payload)
+{
+    const uint32_t id = __read_uint32(payload);
+
+    return (id > INT_MAX) ? 0 : (int)id;
+}
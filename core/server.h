@@ -0,0 +1,61 @@
+#ifndef SERVER_H // Only include this header file if it hasn't been included in the calling file already
+    #define SERVER_H
+
+    #include <stdint.h>
+    #include "../database/sqlite_db.h"
+    #include "../utilities/utilities.h"
+
+    // Every request and response is a frame: its length as 32-bit little-endian, not counting the length itself,
+    // followed by an operation (requests) or a status (responses) byte and its payload. Integers are 32-bit little-endian.
+    // Clients may send many requests without waiting: the responses come back in the same order.
+
+    /// @brief Request with no payload, answered with an empty response.
+    #define SERVER_OP_PING 0
+
+    /// @brief Request with the text of a new task, answered with its ID.
+    #define SERVER_OP_ADD_TASK 1
+
+    /// @brief Request with the ID of a task, answered with its text.
+    #define SERVER_OP_GET_TASK 2
+
+    /// @brief Request with the ID of a task followed by its new text, answered with an empty response.
+    #define SERVER_OP_UPDATE_TASK 3
+
+    /// @brief Request with the ID of a task, answered with an empty response.
+    #define SERVER_OP_DELETE_TASK 4
+
+    /// @brief Request with no payload, answered with the amount of tasks.
+    #define SERVER_OP_COUNT_TASKS 5
+
+    /// @brief Request with an ID and a limit, answered with the tasks after the ID, ordered by ID,
+    /// @brief each one as its ID, the length of its text and the text.
+    #define SERVER_OP_LIST_TASKS 6
+
+    /// @brief The request succeeded.
+    #define SERVER_STATUS_OK 0
+
+    /// @brief The task of the request doesn't exist.
+    #define SERVER_STATUS_NOT_FOUND 1
+
+    /// @brief The request is malformed or has an unknown operation.
+    #define SERVER_STATUS_BAD_REQUEST 2
+
+    /// @brief The database could not run the request.
+    #define SERVER_STATUS_ERROR 3
+
+    /// @brief The size of the length that starts every frame.
+    #define SERVER_LENGTH_SIZE 4
+
+    /// @brief The largest frame a client may send. Larger frames close the connection.
+    #define SERVER_MAX_FRAME_LENGTH (16 * 1024 * 1024)
+
+    /// @brief The most tasks a single list request returns.
+    #define SERVER_MAX_LIST_LIMIT 1000
+
+    /// @brief Serves the database on a UNIX socket until SIGINT or SIGTERM is received. A single thread
+    /// @brief multiplexes every client with epoll, so they all share the connections and statements of the handle.
+    /// @param db The database.
+    /// @param socket_location The path of the socket. A stale socket at that path is replaced, but not one a server still listens on.
+    /// @return Exit code, EADDRINUSE if another server already listens on the socket.
+    extern int serve_socket(const db_handle* db, const char* socket_location);
+#endif // SERVER_H
@@ -0,0 +1,175 @@
+#include <errno.h>
+#include "./backup.h"
+
+/* Private Types */
+
+/// @brief Background thread that backs up a database periodically.
+struct db_backup_schedule
+{
+    /// @brief The database.
+    const db_handle* db;
+
+    /// @brief The path of the backup file.
+    char* location;
+
+    /// @brief How long to wait between backups, in seconds.
+    int interval_seconds;
+
+    /// @brief How many pages each step of a backup copies.
+    int pages_per_step;
+
+    /// @brief Whether the schedule is being stopped.
+    bool is_stopping;
+
+    /// @brief The progress and results of the backups.
+    db_backup_status status;
+
+    /// @brief The thread that runs the backups.
+    pthread_t thread;
+
+    /// @brief Guards the state of the schedule.
+    pthread_mutex_t lock;
+
+    /// @brief Signalled when the schedule is being stopped.
+    pthread_cond_t stopped;
+};
+
+/* Private Variables */
+
+/// @brief How long to wait between the steps of a scheduled backup, in milliseconds.
+static const int __step_pause_ms = 5;
+
+/* Function Prototyping */
+
+/// @brief Runs the backups of a schedule until it's stopped.
+/// @param schedule The schedule.
+/// @return Always NULL.
+static void* __run_backup_thread(void* schedule);
+
+/// @brief Progress callback that records the progress of a scheduled backup.
+/// @param custom_state The schedule.
+/// @param copied_pages How many pages were copied.
+/// @param total_pages How many pages there are.
+/// @return Non-zero if the schedule is being stopped, which cancels the backup.
+static int __record_progress(void* custom_state, const int copied_pages, const int total_pages);
+
+/* Public Functions */
+
+db_backup_schedule* start_backup_schedule(const db_handle* db, const char* backup_location, const int interval_seconds, const int pages_per_step)
+{
+    db_backup_schedule* schedule = calloc(1, sizeof(db_backup_schedule));
+
+    if (schedule == NULL)
+        return NULL;
+
+    schedule->db = db;
+    schedule->location = (char*)str_append(backup_location, "");
+    schedule->interval_seconds = max(1, interval_seconds);
+    schedule->pages_per_step = pages_per_step;
+
+    pthread_mutex_init(&schedule->lock, NULL);
+    pthread_cond_init(&schedule->stopped, NULL);
+
+    if (pthread_create(&schedule->thread, NULL, __run_backup_thread, schedule) != 0)
+    {
+        pthread_cond_destroy(&schedule->stopped);
+        pthread_mutex_destroy(&schedule->lock);
+        free(schedule->location);
+        free(schedule);
+
+        return NULL;
+    }
+
+    return schedule;
+}
+
+db_backup_status get_backup_status(const db_backup_schedule* schedule)
+{
+    db_backup_schedule* mutable_schedule = (db_backup_schedule*)schedule;
+
+    pthread_mutex_lock(&mutable_schedule->lock);
+    const db_backup_status status = schedule->status;
+    pthread_mutex_unlock(&mutable_schedule->lock);
+
+    return status;
+}
+
+void stop_backup_schedule(db_backup_schedule* schedule)
+{
+    if (schedule == NULL)
+        return;
+
+    pthread_mutex_lock(&schedule->lock);
+    schedule->is_stopping = true;
+    pthread_cond_signal(&schedule->stopped);
+    pthread_mutex_unlock(&schedule->lock);
+
+    pthread_join(schedule->thread, NULL);
+
+    // Cleanup
+    pthread_cond_destroy(&schedule->stopped);
+    pthread_mutex_destroy(&schedule->lock);
+    free(schedule->location);
+    free(schedule);
+}
+
+/* Private Functions */
+
+static void* __run_backup_thread(void* schedule)
+{
+    db_backup_schedule* backup_schedule = schedule;
+
+    pthread_mutex_lock(&backup_schedule->lock);
+
+    while (!backup_schedule->is_stopping)
+    {
+        struct timespec deadline;
+        clock_gettime(CLOCK_REALTIME, &deadline);
+        deadline.tv_sec += backup_schedule->interval_seconds;
+
+        int wait_status = 0;
+
+        while (!backup_schedule->is_stopping && wait_status != ETIMEDOUT)
+            wait_status = pthread_cond_timedwait(&backup_schedule->stopped, &backup_schedule->lock, &deadline);
+
+        if (backup_schedule->is_stopping)
+            break;
+
+        backup_schedule->status.is_running = true;
+        backup_schedule->status.copied_pages = 0;
+        pthread_mutex_unlock(&backup_schedule->lock);
+
+        const bool success = backup_sqlite_db(backup_schedule->db, backup_schedule->location, backup_schedule->pages_per_step,
+            __step_pause_ms, __record_progress, backup_schedule);
+
+        pthread_mutex_lock(&backup_schedule->lock);
+        backup_schedule->status.is_running = false;
+
+        if (success)
+        {
+            backup_schedule->status.completed_amount++;
+            backup_schedule->status.last_completed_at = get_current_time();
+        }
+        else if (!backup_schedule->is_stopping)
+            backup_schedule->status.failed_amount++;
+    }
+
+    pthread_mutex_unlock(&backup_schedule->lock);
+
+    return NULL;
+}
+
+static int __record_progress(void* custom_state, const int copied_pages, const int total_pages)
+{
+    db_backup_schedule* schedule = custom_state;
+
+    pthread_mutex_lock(&schedule->lock);
+
+    schedule->status.copied_pages = copied_pages;
+    schedule->status.total_pages = total_pages;
+    const bool is_stopping = schedule->is_stopping;
+
+    pthread_mutex_unlock(&schedule->lock);
+
+    return is_stopping;
+}
@@ -0,0 +1,50 @@
+#ifndef BACKUP_H // Only include this header file if it hasn't been included in the calling file already
+    #define BACKUP_H
+
+    #include <pthread.h>
+    #include "./sqlite_db.h"
+    #include "../utilities/utilities.h"
+
+    /// @brief Background thread that backs up a database periodically with "backup_sqlite_db()".
+    /// @attention Must be manually stopped with "stop_backup_schedule()" before the database is closed!
+    typedef struct db_backup_schedule db_backup_schedule;
+
+    /// @brief The state of a backup schedule.
+    typedef struct db_backup_status
+    {
+        /// @brief Whether a backup is being copied right now.
+        bool is_running;
+
+        /// @brief How many pages the current or last backup has copied.
+        int copied_pages;
+
+        /// @brief How many pages the current or last backup has to copy.
+        int total_pages;
+
+        /// @brief How many backups were completed.
+        int completed_amount;
+
+        /// @brief How many backups failed.
+        int failed_amount;
+
+        /// @brief When the last backup was completed or zero if none was.
+        time_t last_completed_at;
+    } db_backup_status;
+
+    /// @brief Starts backing up a database in the background, every time the specified interval passes.
+    /// @param db The database.
+    /// @param backup_location The path of the backup file. Each backup replaces the previous one.
+    /// @param interval_seconds How long to wait between backups, in seconds. The first backup happens after the first interval.
+    /// @param pages_per_step How many pages each step of a backup copies.
+    /// @return The schedule or NULL if it could not be started.
+    extern db_backup_schedule* start_backup_schedule(const db_handle* db, const char* backup_location, const int interval_seconds, const int pages_per_step);
+
+    /// @brief Gets the progress and results of a backup schedule.
+    /// @param schedule The schedule.
+    /// @return The status of the schedule.
+    extern db_backup_status get_backup_status(const db_backup_schedule* schedule);
+
+    /// @brief Stops a backup schedule, cancelling the backup that's being copied, if any.
+    /// @param schedule The schedule. May be NULL.
+    extern void stop_backup_schedule(db_backup_schedule* schedule);
+#endif // BACKUP_H
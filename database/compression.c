@@ -0,0 +1,224 @@
+#include <stdint.h>
+#include "./compression.h"
+
+/* Private Types */
+
+/// @brief Sizes of the hash table used to find matches.
+enum __hash_table_size
+{
+    /// @brief How many bits of a hash index the table.
+    __HASH_BITS = 12,
+
+    /// @brief The amount of slots in the table.
+    __HASH_TABLE_SIZE = 1 << __HASH_BITS
+};
+
+/* Private Variables */
+
+/// @brief The shortest match worth encoding.
+static const size_t __min_match = 4;
+
+/// @brief How many bytes at the end of the input are always literals.
+static const size_t __last_literals = 5;
+
+/// @brief No match may start within this many bytes of the end of the input.
+static const size_t __match_find_limit = 12;
+
+/// @brief The farthest back a match can be.
+static const size_t __max_offset = 65535;
+
+/* Function Prototyping */
+
+/// @brief Reads four bytes from an unaligned position.
+/// @param source The position.
+/// @return The four bytes.
+static uint32_t __read32(const char* source);
+
+/// @brief Hashes the four bytes at a position of the input.
+/// @param sequence The four bytes.
+/// @return The slot of the hash table.
+static uint32_t __hash(const uint32_t sequence);
+
+/// @brief Writes the bytes that extend a length that didn't fit in its token.
+/// @param destination Where to write the bytes.
+/// @param length The rest of the length.
+/// @return The position after the last written byte.
+static char* __write_length(char* destination, size_t length);
+
+/// @brief Reads the bytes that extend a length that didn't fit in its token.
+/// @param source The compressed data.
+/// @param source_length The size of the compressed data.
+/// @param position The position to read from, which is moved past the bytes.
+/// @param length The length to extend.
+/// @return True if the length was read, False if the data ended.
+static bool __read_length(const char* source, const size_t source_length, size_t* position, size_t* length);
+
+/// @brief Writes one sequence: a run of literals followed by a match.
+/// @param destination Where to write the sequence.
+/// @param literals The literals.
+/// @param literal_length The amount of literals.
+/// @param offset How far back the match is.
+/// @param match_length The length of the match or zero for the last sequence, which has no match.
+/// @return The position after the sequence.
+static char* __write_sequence(char* destination, const char* literals, const size_t literal_length, const size_t offset, const size_t match_length);
+
+/* Public Functions */
+
+size_t lz_compress_bound(const size_t source_length)
+{
+    return source_length + source_length / 255 + 16;
+}
+
+size_t lz_compress(const char* source, const size_t source_length, char* destination)
+{
+    uint32_t positions[__HASH_TABLE_SIZE] = { 0 };
+    char* output = destination;
+    size_t position = 0, anchor = 0;
+
+    while (source_length >= __match_find_limit && position <= source_length - __match_find_limit)
+    {
+        const uint32_t sequence = __read32(source + position);
+        const uint32_t slot = __hash(sequence);
+        const size_t candidate = positions[slot];
+
+        positions[slot] = (uint32_t)position;
+
+        if (candidate >= position || position - candidate > __max_offset || __read32(source + candidate) != sequence)
+        {
+            // Skip ahead faster the longer no match is found, so incompressible data stays cheap.
+            position += 1 + ((position - anchor) >> 6);
+            continue;
+        }
+
+        size_t match_length = __min_match;
+
+        while (position + match_length < source_length - __last_literals && source[candidate + match_length] == source[position + match_length])
+            match_length++;
+
+        output = __write_sequence(output, source + anchor, position - anchor, position - candidate, match_length);
+        position += match_length;
+        anchor = position;
+    }
+
+    output = __write_sequence(output, source + anchor, source_length - anchor, 0, 0);
+
+    return output - destination;
+}
+
+bool lz_decompress(const char* source, const size_t source_length, char* destination, const size_t destination_length)
+{
+    size_t input = 0, output = 0;
+
+    while (input < source_length)
+    {
+        const unsigned char token = source[input++];
+        size_t literal_length = token >> 4;
+
+        if (literal_length == 15 && !__read_length(source, source_length, &input, &literal_length))
+            return false;
+
+        if (literal_length > source_length - input || literal_length > destination_length - output)
+            return false;
+
+        memcpy(destination + output, source + input, literal_length);
+        input += literal_length;
+        output += literal_length;
+
+        // The last sequence has no match.
+        if (input == source_length)
+            break;
+
+        if (source_length - input < 2)
+            return false;
+
+        const size_t offset = (unsigned char)source[input] | ((unsigned char)source[input + 1] << 8);
+        size_t match_length = token & 15;
+        input += 2;
+
+        if (match_length == 15 && !__read_length(source, source_length, &input, &match_length))
+            return false;
+
+        match_length += __min_match;
+
+        if (offset == 0 || offset > output || match_length > destination_length - output)
+            return false;
+
+        // A match that overlaps its own output repeats a pattern, so it must be copied one byte at a time.
+        if (offset >= match_length)
+            memcpy(destination + output, destination + output - offset, match_length);
+        else
+        {
+            for (size_t index = 0; index < match_length; index++)
+                destination[output + index] = destination[output + index - offset];
+        }
+
+        output += match_length;
+    }
+
+    return output == destination_length;
+}
+
+/* Private Functions */
+
+static uint32_t __read32(const char* source)
+{
+    uint32_t value;
+    memcpy(&value, source, sizeof(value));
+
+    return value;
+}
+
+static uint32_t __hash(const uint32_t sequence)
+{
+    return (sequence * 2654435761u) >> (32 - __HASH_BITS);
+}
+
+static char* __write_length(char* destination, size_t length)
+{
+    for (; length >= 255; length -= 255)
+        *destination++ = (char)255;
+
+    *destination++ = (char)length;
+
+    return destination;
+}
+
+static bool __read_length(const char* source, const size_t source_length, size_t* position, size_t* length)
+{
+    unsigned char byte;
+
+    do
+    {
+        if (*position >= source_length)
+            return false;
+
+        byte = source[(*position)++];
+        *length += byte;
+    } while (byte == 255);
+
+    return true;
+}
+
+static char* __write_sequence(char* destination, const char* literals, const size_t literal_length, const size_t offset, const size_t match_length)
+{
+    const size_t match_code = (match_length == 0) ? 0 : match_length - __min_match;
+    const size_t literal_code = (literal_length < 15) ? literal_length : 15;
+    *destination++ = (char)((literal_code << 4) | ((match_code < 15) ? match_code : 15));
+
+    if (literal_length >= 15)
+        destination = __write_length(destination, literal_length - 15);
+
+    memcpy(destination, literals, literal_length);
+    destination += literal_length;
+
+    if (match_length == 0)
+        return destination;
+
+    *destination++ = (char)(offset & 0xFF);
+    *destination++ = (char)(offset >> 8);
+
+    if (match_code >= 15)
+        destination = __write_length(destination, match_code - 15);
+
+    return destination;
+}
@@ -0,0 +1,26 @@
+#ifndef COMPRESSION_H // Only include this header file if it hasn't been included in the calling file already
+    #define COMPRESSION_H
+
+    #include <stddef.h>
+    #include "../utilities/utilities.h"
+
+    /// @brief Gets the largest size "lz_compress()" can produce for an input of the specified size.
+    /// @param source_length The size of the input.
+    /// @return The size the output buffer must have.
+    extern size_t lz_compress_bound(const size_t source_length);
+
+    /// @brief Compresses a buffer with a byte-oriented LZ77 codec (LZ4 block format), which favors speed over ratio.
+    /// @param source The data to compress.
+    /// @param source_length The size of the data.
+    /// @param destination The buffer that receives the compressed data. Must hold "lz_compress_bound(source_length)" bytes.
+    /// @return The size of the compressed data.
+    extern size_t lz_compress(const char* source, const size_t source_length, char* destination);
+
+    /// @brief Decompresses a buffer produced by "lz_compress()".
+    /// @param source The compressed data.
+    /// @param source_length The size of the compressed data.
+    /// @param destination The buffer that receives the original data.
+    /// @param destination_length The size of the original data.
+    /// @return True if exactly "destination_length" bytes were decompressed, False if the data is corrupted.
+    extern bool lz_decompress(const char* source, const size_t source_length, char* destination, const size_t destination_length);
+#endif // COMPRESSION_H
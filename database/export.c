@@ -0,0 +1,540 @@
+#include <stdint.h>
+#include <pthread.h>
+#include "./export.h"
+
+/* Private Types */
+
+/// @brief A range of IDs, formatted by a worker and written by the calling thread.
+typedef struct __export_chunk
+{
+    /// @brief The first ID of the range.
+    int first_id;
+
+    /// @brief The last ID of the range, included.
+    int last_id;
+
+    /// @brief The formatted tasks of the range that weren't written yet.
+    char* text;
+
+    /// @brief The length of the formatted tasks that weren't written yet.
+    size_t length;
+
+    /// @brief The allocated size of the text.
+    size_t capacity;
+
+    /// @brief How many tasks the range had.
+    int task_amount;
+
+    /// @brief Whether a worker finished the range.
+    bool is_ready;
+
+    /// @brief Whether the range could not be read or formatted.
+    bool has_failed;
+} __export_chunk;
+
+/// @brief The ranges of an export, shared by the workers and the calling thread.
+typedef struct __export_job
+{
+    /// @brief The database.
+    const db_handle* db;
+
+    /// @brief The format of the file.
+    db_export_format format;
+
+    /// @brief The file the ranges are written to.
+    FILE* file;
+
+    /// @brief The ranges, ordered by ID.
+    __export_chunk* chunks;
+
+    /// @brief The amount of ranges.
+    int chunk_amount;
+
+    /// @brief The next range a worker takes.
+    int next_chunk;
+
+    /// @brief How many ranges were written.
+    int written_amount;
+
+    /// @brief How many ranges may be taken ahead of the writer.
+    int max_pending_amount;
+
+    /// @brief Whether a write failed, so the workers must stop taking ranges.
+    bool is_cancelled;
+
+    /// @brief Guards every field that changes after the workers start.
+    pthread_mutex_t lock;
+
+    /// @brief Signaled when a worker finishes a range.
+    pthread_cond_t chunk_formatted;
+
+    /// @brief Signaled when the calling thread finishes writing a range.
+    pthread_cond_t chunk_written;
+} __export_job;
+
+/// @brief The state of "__visitor_format_task()".
+typedef struct __format_state
+{
+    /// @brief The export the range belongs to.
+    __export_job* job;
+
+    /// @brief The range being formatted.
+    __export_chunk* chunk;
+
+    /// @brief The format of the file.
+    db_export_format format;
+} __format_state;
+
+/* Private Variables */
+
+/// @brief How many ranges each worker gets, so a range with longer tasks doesn't leave the others idle.
+static const int __chunks_per_thread = 8;
+
+/// @brief How many ranges each worker may format ahead of the writer.
+static const int __pending_chunks_per_thread = 2;
+
+/// @brief How much formatted text a range holds before its worker waits for its turn to write it,
+/// @brief so the memory of an export doesn't grow with the database.
+static const size_t __max_buffered_length = 1024 * 1024;
+
+/// @brief The most workers an export starts.
+static const int __max_thread_amount = 64;
+
+/// @brief The first line of a CSV file.
+static const char __csv_header[] = "id,task\r\n";
+
+/* Function Prototyping */
+
+/// @brief Writes the tasks between two IDs, spread over workers, in order.
+/// @param job The export, with its database, format and file set.
+/// @param first_id The lowest ID.
+/// @param last_id The highest ID.
+/// @param thread_amount The amount of workers.
+/// @return How many tasks were written or -1 if an error occurred.
+static int __write_chunks(__export_job* job, const int first_id, const int last_id, const int thread_amount);
+
+/// @brief Takes ranges and formats them until there are none left or the export is cancelled.
+/// @param custom_state __export_job* to take the ranges from.
+/// @return NULL.
+static void* __run_export_worker(void* custom_state);
+
+/// @brief Callback that appends a task to the text of a range and stops past its last ID.
+/// @param custom_state __format_state* with the range and the format.
+/// @param id The ID of the task.
+/// @param task The content of the task.
+/// @param length The length of the task, without the null terminator.
+/// @return Zero to continue, non-zero once the range is complete or the text could not grow.
+static int __visitor_format_task(void* custom_state, const int id, const char* task, const int length);
+
+/// @brief Writes the text a range has so far, once every range before it was written, and empties it.
+/// @param job The export.
+/// @param chunk The range.
+/// @return True if the text was written, False if the export was cancelled or the text could not be written.
+static bool __flush_chunk(__export_job* job, __export_chunk* chunk);
+
+/// @brief Makes room for more text in a range.
+/// @param chunk The range.
+/// @param extra_length How many more bytes the text needs.
+/// @return True if there is room, False if the memory could not be allocated.
+static bool __reserve(__export_chunk* chunk, const size_t extra_length);
+
+/// @brief Appends bytes to the text of a range, which must have room for them.
+/// @param chunk The range.
+/// @param data The bytes.
+/// @param length The amount of bytes.
+static void __append(__export_chunk* chunk, const char* data, const size_t length);
+
+/// @brief Measures a task once escaped as a JSON string, without the quotes.
+/// @param task The content of the task.
+/// @param length The length of the task.
+/// @return The escaped length.
+static size_t __get_json_length(const char* task, const int length);
+
+/// @brief Appends a task escaped as a JSON string, without the quotes.
+/// @param chunk The range, which must have room for the escaped task.
+/// @param task The content of the task.
+/// @param length The length of the task.
+static void __append_json(__export_chunk* chunk, const char* task, const int length);
+
+/// @brief Appends a task as the content of a quoted CSV field, doubling its quotes.
+/// @param chunk The range, which must have room for the escaped task.
+/// @param task The content of the task.
+/// @param length The length of the task.
+static void __append_csv(__export_chunk* chunk, const char* task, const int length);
+
+/* Public Functions */
+
+int export_tasks(const db_handle* db, const char* export_location, const db_export_format format, const int thread_amount)
+{
+    // Write to a temporary file first, so an existing export is only replaced by a complete one.
+    const bool uses_stdout = strcmp(export_location, "-") == 0;
+    const char* temporary_location = (uses_stdout) ? NULL : str_append(export_location, ".tmp");
+    FILE* file = (uses_stdout) ? stdout : fopen(temporary_location, "wb");
+    const long processor_amount = sysconf(_SC_NPROCESSORS_ONLN);
+    int first_id = 0, last_id = 0, task_amount = 0;
+    bool success = (file != NULL);
+
+    __export_job job = {
+        .db = db,
+        .format = format,
+        .file = file
+    };
+
+    if (success && format == DB_EXPORT_CSV)
+        success = fwrite(__csv_header, 1, sizeof(__csv_header) - 1, file) == sizeof(__csv_header) - 1;
+
+    if (success)
+        success = get_task_id_bounds(db, &first_id, &last_id);
+
+    // An empty database still produces a valid, empty file.
+    if (success && last_id > 0)
+    {
+        const int worker_amount = (thread_amount > 0) ? thread_amount : (processor_amount > 0) ? (int)processor_amount : 1;
+
+        // A worker waiting for its turn to write still holds its reader, so each one needs a reader of its own.
+        task_amount = __write_chunks(&job, first_id, last_id, min(min(worker_amount, __max_thread_amount), get_reader_capacity(db)));
+        success = task_amount >= 0;
+    }
+
+    if (success)
+        success = fflush(file) == 0 && (uses_stdout || fsync(fileno(file)) == 0);
+
+    if (!uses_stdout)
+    {
+        if (file != NULL && fclose(file) != 0)
+            success = false;
+
+        if (success)
+            success = rename(temporary_location, export_location) == 0;
+
+        if (!success && file != NULL)
+            remove(temporary_location);
+    }
+
+    // Cleanup
+    free((char*)temporary_location);
+
+    return (success) ? task_amount : -1;
+}
+
+/* Private Functions */
+
+static int __write_chunks(__export_job* job, const int first_id, const int last_id, const int thread_amount)
+{
+    // IDs are split evenly, so gaps left by deleted tasks make some ranges lighter than others.
+    const int64_t id_span = (int64_t)last_id - first_id + 1;
+    const int64_t chunk_span = (id_span + (int64_t)thread_amount * __chunks_per_thread - 1) / ((int64_t)thread_amount * __chunks_per_thread);
+    const int chunk_amount = (int)((id_span + chunk_span - 1) / chunk_span);
+    pthread_t* threads = malloc(min(thread_amount, chunk_amount) * sizeof(pthread_t));
+    int thread_count = 0, task_amount = 0;
+
+    job->chunks = calloc(chunk_amount, sizeof(__export_chunk));
+    job->chunk_amount = chunk_amount;
+    job->max_pending_amount = thread_amount * __pending_chunks_per_thread;
+
+    if (threads == NULL || job->chunks == NULL)
+    {
+        free(threads);
+        free(job->chunks);
+
+        return -1;
+    }
+
+    for (int index = 0; index < chunk_amount; index++)
+    {
+        job->chunks[index].first_id = (int)(first_id + index * chunk_span);
+        job->chunks[index].last_id = (index == chunk_amount - 1) ? last_id : (int)(first_id + (index + 1) * chunk_span - 1);
+    }
+
+    pthread_mutex_init(&job->lock, NULL);
+    pthread_cond_init(&job->chunk_formatted, NULL);
+    pthread_cond_init(&job->chunk_written, NULL);
+
+    // Workers that could not be started are simply missing, since the others take every range left.
+    while (thread_count < min(thread_amount, chunk_amount) && pthread_create(&threads[thread_count], NULL, __run_export_worker, job) == 0)
+        thread_count++;
+
+    bool success = thread_count > 0;
+
+    // Write the ranges in order, as soon as each one is ready, while the workers format the next ones.
+    // A worker whose range filled up has already written the start of it, so only the rest is left here.
+    for (int index = 0; success && index < chunk_amount; index++)
+    {
+        __export_chunk* chunk = &job->chunks[index];
+
+        pthread_mutex_lock(&job->lock);
+
+        while (!chunk->is_ready)
+            pthread_cond_wait(&job->chunk_formatted, &job->lock);
+
+        pthread_mutex_unlock(&job->lock);
+
+        success = !chunk->has_failed && (chunk->length == 0 || fwrite(chunk->text, 1, chunk->length, job->file) == chunk->length);
+        task_amount += chunk->task_amount;
+
+        free(chunk->text);
+        chunk->text = NULL;
+
+        pthread_mutex_lock(&job->lock);
+        job->written_amount++;
+        job->is_cancelled = !success;
+        pthread_cond_broadcast(&job->chunk_written);
+        pthread_mutex_unlock(&job->lock);
+    }
+
+    if (thread_count == 0)
+        fprintf(stderr, "Could not start the export threads." NEWLINE);
+
+    for (int index = 0; index < thread_count; index++)
+        pthread_join(threads[index], NULL);
+
+    // Cleanup
+    for (int index = 0; index < chunk_amount; index++)
+        free(job->chunks[index].text);
+
+    pthread_cond_destroy(&job->chunk_written);
+    pthread_cond_destroy(&job->chunk_formatted);
+    pthread_mutex_destroy(&job->lock);
+    free(job->chunks);
+    free(threads);
+
+    return (success) ? task_amount : -1;
+}
+
+static void* __run_export_worker(void* custom_state)
+{
+    __export_job* job = custom_state;
+
+    pthread_mutex_lock(&job->lock);
+
+    while (true)
+    {
+        while (!job->is_cancelled && job->next_chunk < job->chunk_amount
+            && job->next_chunk >= job->written_amount + job->max_pending_amount)
+            pthread_cond_wait(&job->chunk_written, &job->lock);
+
+        if (job->is_cancelled || job->next_chunk >= job->chunk_amount)
+            break;
+
+        __export_chunk* chunk = &job->chunks[job->next_chunk++];
+        __format_state state = {
+            .job = job,
+            .chunk = chunk,
+            .format = job->format
+        };
+
+        pthread_mutex_unlock(&job->lock);
+
+        // Each call takes its own pooled reader, so the ranges are read in parallel.
+        const bool success = for_each_task(job->db, chunk->first_id - 1, 0, __visitor_format_task, &state) >= 0;
+
+        pthread_mutex_lock(&job->lock);
+
+        chunk->has_failed = chunk->has_failed || !success;
+        chunk->is_ready = true;
+        pthread_cond_signal(&job->chunk_formatted);
+    }
+
+    pthread_mutex_unlock(&job->lock);
+
+    return NULL;
+}
+
+static int __visitor_format_task(void* custom_state, const int id, const char* task, const int length)
+{
+    __format_state* state = custom_state;
+    __export_chunk* chunk = state->chunk;
+    char id_text[16];
+
+    if (id > chunk->last_id)
+        return 1;
+
+    const size_t id_length = (size_t)snprintf(id_text, sizeof(id_text), "%d", id);
+
+    switch (state->format)
+    {
+        case DB_EXPORT_MARKDOWN:
+            if (!__reserve(chunk, id_length + length + 13))
+                return 1;
+
+            __append(chunk, "## Note ", 8);
+            __append(chunk, id_text, id_length);
+            __append(chunk, "\n\n", 2);
+            __append(chunk, task, length);
+
+            // End the text with a blank line, so the next heading starts its own block.
+            if (length == 0 || task[length - 1] != '\n')
+                __append(chunk, "\n", 1);
+
+            __append(chunk, "\n", 1);
+            break;
+        case DB_EXPORT_JSONL:
+            if (!__reserve(chunk, id_length + __get_json_length(task, length) + 18))
+                return 1;
+
+            __append(chunk, "{\"id\":", 6);
+            __append(chunk, id_text, id_length);
+            __append(chunk, ",\"task\":\"", 9);
+            __append_json(chunk, task, length);
+            __append(chunk, "\"}\n", 3);
+            break;
+        case DB_EXPORT_CSV:
+        default:
+        {
+            size_t quote_amount = 0;
+
+            for (int index = 0; index < length; index++)
+                quote_amount += task[index] == '"';
+
+            if (!__reserve(chunk, id_length + length + quote_amount + 5))
+                return 1;
+
+            __append(chunk, id_text, id_length);
+            __append(chunk, ",\"", 2);
+            __append_csv(chunk, task, length);
+            __append(chunk, "\"\r\n", 3);
+            break;
+        }
+    }
+
+    chunk->task_amount++;
+
+    // A full range is written as soon as it's its turn, instead of growing.
+    if (chunk->length >= __max_buffered_length && !__flush_chunk(state->job, chunk))
+        return 1;
+
+    return 0;
+}
+
+static bool __flush_chunk(__export_job* job, __export_chunk* chunk)
+{
+    const int index = (int)(chunk - job->chunks);
+
+    pthread_mutex_lock(&job->lock);
+
+    while (!job->is_cancelled && job->written_amount < index)
+        pthread_cond_wait(&job->chunk_written, &job->lock);
+
+    const bool is_cancelled = job->is_cancelled;
+
+    pthread_mutex_unlock(&job->lock);
+
+    // Every range before this one is written, and the calling thread waits for this one to be ready, so the file is free.
+    if (is_cancelled || fwrite(chunk->text, 1, chunk->length, job->file) != chunk->length)
+    {
+        chunk->has_failed = true;
+        return false;
+    }
+
+    chunk->length = 0;
+
+    return true;
+}
+
+static bool __reserve(__export_chunk* chunk, const size_t extra_length)
+{
+    if (chunk->length + extra_length <= chunk->capacity)
+        return true;
+
+    size_t new_capacity = (chunk->capacity == 0) ? 64 * 1024 : chunk->capacity * 2;
+
+    while (new_capacity < chunk->length + extra_length)
+        new_capacity *= 2;
+
+    char* new_text = realloc(chunk->text, new_capacity);
+
+    if (new_text == NULL)
+    {
+        chunk->has_failed = true;
+        return false;
+    }
+
+    chunk->text = new_text;
+    chunk->capacity = new_capacity;
+
+    return true;
+}
+
+static void __append(__export_chunk* chunk, const char* data, const size_t length)
+{
+    memcpy(chunk->text + chunk->length, data, length);
+    chunk->length += length;
+}
+
+static size_t __get_json_length(const char* task, const int length)
+{
+    size_t escaped_length = 0;
+
+    for (int index = 0; index < length; index++)
+    {
+        const unsigned char character = task[index];
+
+        if (character == '"' || character == '\\' || character == '\b' || character == '\f'
+            || character == '\n' || character == '\r' || character == '\t')
+            escaped_length += 2;
+        else if (character < 0x20)
+            escaped_length += 6;
+        else
+            escaped_length++;
+    }
+
+    return escaped_length;
+}
+
+static void __append_json(__export_chunk* chunk, const char* task, const int length)
+{
+    static const char hex_digits[] = "0123456789abcdef";
+    int run_start = 0;
+
+    for (int index = 0; index < length; index++)
+    {
+        const unsigned char character = task[index];
+        char escape[6] = { '\\', 0, '0', '0', 0, 0 };
+        size_t escape_length = 2;
+
+        switch (character)
+        {
+            case '"': escape[1] = '"'; break;
+            case '\\': escape[1] = '\\'; break;
+            case '\b': escape[1] = 'b'; break;
+            case '\f': escape[1] = 'f'; break;
+            case '\n': escape[1] = 'n'; break;
+            case '\r': escape[1] = 'r'; break;
+            case '\t': escape[1] = 't'; break;
+            default:
+                // Text is stored as UTF-8, so only the control characters need a code point escape.
+                if (character >= 0x20)
+                    continue;
+
+                escape[1] = 'u';
+                escape[4] = hex_digits[character >> 4];
+                escape[5] = hex_digits[character & 0xF];
+                escape_length = 6;
+                break;
+        }
+
+        // Copy the characters before the escape at once.
+        __append(chunk, task + run_start, index - run_start);
+        __append(chunk, escape, escape_length);
+        run_start = index + 1;
+    }
+
+    __append(chunk, task + run_start, length - run_start);
+}
+
+static void __append_csv(__export_chunk* chunk, const char* task, const int length)
+{
+    int run_start = 0;
+
+    for (int index = 0; index < length; index++)
+    {
+        if (task[index] != '"')
+            continue;
+
+        // Copy up to and including the quote, then start the next run at it, so it's written twice.
+        __append(chunk, task + run_start, index + 1 - run_start);
+        run_start = index;
+    }
+
+    __append(chunk, task + run_start, length - run_start);
+}
@@ -0,0 +1,35 @@
+#ifndef EXPORT_H // Only include this header file if it hasn't been included in the calling file already
+    #define EXPORT_H
+
+    #include <stddef.h>
+    #include <stdint.h>
+    #include <pthread.h>
+    #include "./sqlite_db.h"
+    #include "../utilities/utilities.h"
+
+    /// @brief The text formats "export_tasks()" can write.
+    typedef enum db_export_format
+    {
+        /// @brief A "## Note ID" heading per task, followed by its text.
+        DB_EXPORT_MARKDOWN,
+
+        /// @brief One {"id":ID,"task":"TEXT"} object per line.
+        DB_EXPORT_JSONL,
+
+        /// @brief An "id,task" header and one CRLF-terminated row per task, with the text always quoted (RFC 4180).
+        DB_EXPORT_CSV
+    } db_export_format;
+
+    /// @brief Writes every task of the database to a text file, ordered by ID. The ID space is split into
+    /// @brief ranges that worker threads read through their own pooled connection and format into separate
+    /// @brief buffers, while the calling thread writes the finished ranges in order. A buffer that reaches 1 MiB
+    /// @brief is written by its worker once every range before it is, so the memory doesn't grow with the database.
+    /// @attention Each range is read in its own transaction, so writes made during the export may show up
+    /// @attention in some ranges and not in others. Use "export_snapshot()" for a single consistent read.
+    /// @param db The database.
+    /// @param export_location The path of the file, which is replaced if it exists, or "-" to write to stdout.
+    /// @param format The format of the file.
+    /// @param thread_amount How many worker threads read and format the tasks, up to one per reader. Zero or less uses one per processor.
+    /// @return How many tasks were exported or -1 if an error occurred.
+    extern int export_tasks(const db_handle* db, const char* export_location, const db_export_format format, const int thread_amount);
+#endif // EXPORT_H
@@ -0,0 +1,472 @@
+#include <stdint.h>
+#include <errno.h>
+#include <pthread.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "./snapshot.h"
+
+/* Private Types */
+
+/// @brief Sizes of the parts of a snapshot file.
+enum __snapshot_layout
+{
+    /// @brief The size of the header, which is also where the text region starts.
+    __HEADER_SIZE = 64,
+
+    /// @brief The size of each entry of the index.
+    __INDEX_ENTRY_SIZE = 24
+};
+
+/// @brief Positions of the fields of the header.
+enum __header_field
+{
+    __HEADER_MAGIC = 0,
+    __HEADER_VERSION = 8,
+    __HEADER_TASK_AMOUNT = 12,
+    __HEADER_TEXT_OFFSET = 16,
+    __HEADER_TEXT_LENGTH = 24,
+    __HEADER_INDEX_OFFSET = 32,
+    __HEADER_INDEX_LENGTH = 40,
+    __HEADER_CHECKSUM = 48
+};
+
+/// @brief Positions of the fields of an index entry.
+enum __index_field
+{
+    __INDEX_ID = 0,
+    __INDEX_LENGTH = 4,
+    __INDEX_OFFSET = 8,
+    __INDEX_CREATED_AT = 16
+};
+
+/// @brief Read-only view of a binary snapshot file, mapped into memory.
+struct db_snapshot
+{
+    /// @brief The mapped file.
+    const unsigned char* mapping;
+
+    /// @brief The size of the mapped file.
+    size_t mapping_length;
+
+    /// @brief The null-terminated text of every task.
+    const char* text;
+
+    /// @brief The index, with one entry per task sorted by ID.
+    const unsigned char* index;
+
+    /// @brief The amount of tasks.
+    int task_amount;
+};
+
+/* Private Variables */
+
+/// @brief The first bytes of every snapshot file.
+static const char __snapshot_magic[8] = { 'T', 'O', 'D', 'O', 'C', 'S', 'N', 'P' };
+
+/// @brief The CRC-32 (IEEE) of every possible byte.
+static uint32_t __crc_table[256];
+
+/// @brief Makes sure the CRC-32 table is only built once.
+static pthread_once_t __crc_table_once = PTHREAD_ONCE_INIT;
+
+/* Function Prototyping */
+
+/// @brief Fills the CRC-32 table.
+static void __build_crc_table();
+
+/// @brief Adds bytes to a running CRC-32.
+/// @param crc The CRC-32 of the previous bytes or zero for the first bytes.
+/// @param data The bytes.
+/// @param length The amount of bytes.
+/// @return The CRC-32 of the previous bytes followed by the new bytes.
+static uint32_t __update_crc(uint32_t crc, const void* data, const size_t length);
+
+/// @brief Writes an unsigned integer in little-endian byte order.
+/// @param destination Where to write the integer.
+/// @param value The integer.
+/// @param size How many bytes the integer has.
+static void __write_le(unsigned char* destination, uint64_t value, const size_t size);
+
+/// @brief Reads an unsigned integer stored in little-endian byte order.
+/// @param source Where to read the integer from.
+/// @param size How many bytes the integer has.
+/// @return The integer.
+static uint64_t __read_le(const unsigned char* source, const size_t size);
+
+/// @brief Writes a buffer to a snapshot file and adds it to the running checksum.
+/// @param file The snapshot file.
+/// @param data The buffer.
+/// @param length The size of the buffer.
+/// @param crc The running checksum.
+/// @return True if the buffer was written, False otherwise.
+static bool __write_checked(FILE* file, const void* data, const size_t length, uint32_t* crc);
+
+/// @brief Checks that the tasks referenced by the index are null-terminated, inside the text region and sorted by ID.
+/// @param snapshot The snapshot.
+/// @param text_length The size of the text region.
+/// @return True if the index is valid, False otherwise.
+static bool __is_index_valid(const db_snapshot* snapshot, const uint64_t text_length);
+
+/// @brief Gets the ID of an index entry.
+/// @param snapshot The snapshot.
+/// @param position The position of the entry.
+/// @return The ID.
+static int __entry_id(const db_snapshot* snapshot, const int position);
+
+/// @brief Gets the task of an index entry.
+/// @param snapshot The snapshot.
+/// @param position The position of the entry.
+/// @param length Receives the length of the task. May be NULL.
+/// @return The null-terminated task.
+static const char* __entry_task(const db_snapshot* snapshot, const int position, int* length);
+
+/// @brief Finds the position of the first index entry whose ID is greater than or equal to the specified ID.
+/// @param snapshot The snapshot.
+/// @param id The ID.
+/// @return The position of the entry or the amount of tasks if there is none.
+static int __lower_bound(const db_snapshot* snapshot, const int id);
+
+/* Public Functions */
+
+int export_snapshot(const db_handle* db, const char* snapshot_location)
+{
+    // Write to a temporary file first, so an existing snapshot is only replaced by a complete one.
+    const char* temporary_location = str_append(snapshot_location, ".tmp");
+    FILE* file = fopen(temporary_location, "wb");
+    unsigned char header[__HEADER_SIZE] = { 0 };
+    unsigned char* index = NULL;
+    size_t index_capacity = 0;
+    uint64_t text_length = 0;
+    uint32_t crc = 0;
+    int task_amount = 0;
+    bool success = (file != NULL);
+
+    // The header is written last, once the sizes and the checksum are known.
+    if (success)
+        success = fwrite(header, 1, __HEADER_SIZE, file) == __HEADER_SIZE;
+
+    // The cursor holds a single reader for the whole export, so every task comes from the same consistent read.
+    db_tasks_cursor cursor = db_tasks_open(db);
+
+    while (success && db_tasks_next(&cursor))
+    {
+        if ((size_t)(task_amount + 1) * __INDEX_ENTRY_SIZE > index_capacity)
+        {
+            const size_t new_capacity = (index_capacity == 0) ? 64 * __INDEX_ENTRY_SIZE : index_capacity * 2;
+            unsigned char* new_index = realloc(index, new_capacity);
+
+            if (new_index == NULL)
+            {
+                success = false;
+                break;
+            }
+
+            index = new_index;
+            index_capacity = new_capacity;
+        }
+
+        unsigned char* entry = index + (size_t)task_amount * __INDEX_ENTRY_SIZE;
+        __write_le(entry + __INDEX_ID, (uint32_t)cursor.id, 4);
+        __write_le(entry + __INDEX_LENGTH, (uint32_t)cursor.length, 4);
+        __write_le(entry + __INDEX_OFFSET, text_length, 8);
+        __write_le(entry + __INDEX_CREATED_AT, (uint64_t)(int64_t)cursor.created_at, 8);
+
+        // Write the null terminator too, so tasks can be served straight from the mapping.
+        success = __write_checked(file, cursor.task, (size_t)cursor.length + 1, &crc);
+        text_length += (uint64_t)cursor.length + 1;
+        task_amount++;
+    }
+
+    success = success && !cursor.failed;
+    db_tasks_close(&cursor);
+
+    if (success)
+        success = __write_checked(file, index, (size_t)task_amount * __INDEX_ENTRY_SIZE, &crc);
+
+    if (success)
+    {
+        memcpy(header + __HEADER_MAGIC, __snapshot_magic, sizeof(__snapshot_magic));
+        __write_le(header + __HEADER_VERSION, SNAPSHOT_FORMAT_VERSION, 4);
+        __write_le(header + __HEADER_TASK_AMOUNT, (uint32_t)task_amount, 4);
+        __write_le(header + __HEADER_TEXT_OFFSET, __HEADER_SIZE, 8);
+        __write_le(header + __HEADER_TEXT_LENGTH, text_length, 8);
+        __write_le(header + __HEADER_INDEX_OFFSET, __HEADER_SIZE + text_length, 8);
+        __write_le(header + __HEADER_INDEX_LENGTH, (uint64_t)task_amount * __INDEX_ENTRY_SIZE, 8);
+        __write_le(header + __HEADER_CHECKSUM, crc, 4);
+
+        success = fseek(file, 0, SEEK_SET) == 0
+            && fwrite(header, 1, __HEADER_SIZE, file) == __HEADER_SIZE
+            && fflush(file) == 0
+            && fsync(fileno(file)) == 0;
+    }
+
+    if (file != NULL && fclose(file) != 0)
+        success = false;
+
+    if (success)
+        success = rename(temporary_location, snapshot_location) == 0;
+
+    if (!success && file != NULL)
+        remove(temporary_location);
+
+    // Cleanup
+    free(index);
+    free((char*)temporary_location);
+
+    return (success) ? task_amount : -1;
+}
+
+int import_snapshot(const db_handle* db, const char* snapshot_location)
+{
+    db_snapshot* snapshot = open_snapshot(snapshot_location);
+
+    if (snapshot == NULL)
+        return -1;
+
+    const int task_amount = snapshot->task_amount;
+    int* ids = malloc(max(1, task_amount) * sizeof(int));
+    const char** tasks = malloc(max(1, task_amount) * sizeof(char*));
+    time_t* created_at = malloc(max(1, task_amount) * sizeof(time_t));
+    int imported_amount = -1;
+
+    if (ids != NULL && tasks != NULL && created_at != NULL)
+    {
+        // The tasks point straight into the mapping, which stays open until they're written.
+        for (int position = 0; position < task_amount; position++)
+        {
+            const unsigned char* entry = snapshot->index + (size_t)position * __INDEX_ENTRY_SIZE;
+
+            ids[position] = __entry_id(snapshot, position);
+            tasks[position] = __entry_task(snapshot, position, NULL);
+            created_at[position] = (time_t)(int64_t)__read_le(entry + __INDEX_CREATED_AT, 8);
+        }
+
+        imported_amount = restore_tasks(db, ids, tasks, created_at, task_amount, NULL);
+
+        if (imported_amount != task_amount)
+            imported_amount = -1;
+    }
+
+    // Cleanup
+    free(ids);
+    free(tasks);
+    free(created_at);
+    close_snapshot(snapshot);
+
+    return imported_amount;
+}
+
+db_snapshot* open_snapshot(const char* snapshot_location)
+{
+    const int file_descriptor = open(snapshot_location, O_RDONLY);
+    struct stat file_status;
+
+    if (file_descriptor < 0)
+        return NULL;
+
+    if (fstat(file_descriptor, &file_status) != 0 || file_status.st_size < __HEADER_SIZE)
+    {
+        close(file_descriptor);
+        return NULL;
+    }
+
+    const size_t mapping_length = (size_t)file_status.st_size;
+    void* mapping = mmap(NULL, mapping_length, PROT_READ, MAP_PRIVATE, file_descriptor, 0);
+
+    // The mapping keeps its own reference to the file.
+    close(file_descriptor);
+
+    if (mapping == MAP_FAILED)
+        return NULL;
+
+    const unsigned char* header = mapping;
+    const uint64_t task_amount = __read_le(header + __HEADER_TASK_AMOUNT, 4);
+    const uint64_t text_offset = __read_le(header + __HEADER_TEXT_OFFSET, 8);
+    const uint64_t text_length = __read_le(header + __HEADER_TEXT_LENGTH, 8);
+    const uint64_t index_offset = __read_le(header + __HEADER_INDEX_OFFSET, 8);
+    const uint64_t index_length = __read_le(header + __HEADER_INDEX_LENGTH, 8);
+
+    // Compare sizes against what is left of the file, so corrupted sizes can't overflow.
+    bool is_valid = memcmp(header + __HEADER_MAGIC, __snapshot_magic, sizeof(__snapshot_magic)) == 0
+        && __read_le(header + __HEADER_VERSION, 4) == SNAPSHOT_FORMAT_VERSION
+        && task_amount <= INT_MAX
+        && text_offset == __HEADER_SIZE
+        && text_length <= mapping_length - text_offset
+        && index_offset == text_offset + text_length
+        && index_length == task_amount * __INDEX_ENTRY_SIZE
+        && index_length == mapping_length - index_offset
+        && __update_crc(0, header + __HEADER_SIZE, mapping_length - __HEADER_SIZE) == __read_le(header + __HEADER_CHECKSUM, 4);
+
+    db_snapshot* snapshot = (is_valid) ? malloc(sizeof(db_snapshot)) : NULL;
+
+    if (snapshot != NULL)
+    {
+        snapshot->mapping = mapping;
+        snapshot->mapping_length = mapping_length;
+        snapshot->text = (const char*)header + text_offset;
+        snapshot->index = header + index_offset;
+        snapshot->task_amount = (int)task_amount;
+
+        // A valid checksum doesn't rule out a file written by something else, so never trust the offsets blindly.
+        if (__is_index_valid(snapshot, text_length))
+        {
+            madvise(mapping, mapping_length, MADV_RANDOM);
+            return snapshot;
+        }
+    }
+
+    free(snapshot);
+    munmap(mapping, mapping_length);
+
+    return NULL;
+}
+
+void close_snapshot(db_snapshot* snapshot)
+{
+    if (snapshot == NULL)
+        return;
+
+    munmap((void*)snapshot->mapping, snapshot->mapping_length);
+    free(snapshot);
+}
+
+int snapshot_count_tasks(const db_snapshot* snapshot)
+{
+    return snapshot->task_amount;
+}
+
+const char* snapshot_get_task(const db_snapshot* snapshot, const int id, int* length)
+{
+    const int position = __lower_bound(snapshot, id);
+
+    if (position == snapshot->task_amount || __entry_id(snapshot, position) != id)
+        return NULL;
+
+    return __entry_task(snapshot, position, length);
+}
+
+int snapshot_for_each_task(const db_snapshot* snapshot, const int after_id, const int limit,
+    int (*visitor)(void*, const int, const char*, const int), void* custom_state)
+{
+    // The ID right after "after_id" can't overflow, since no task can have an ID greater than INT_MAX.
+    int position = (after_id == INT_MAX) ? snapshot->task_amount : __lower_bound(snapshot, after_id + 1);
+    int visited_amount = 0;
+
+    for (; position < snapshot->task_amount && (limit <= 0 || visited_amount < limit); position++)
+    {
+        int length;
+        const char* task = __entry_task(snapshot, position, &length);
+
+        visited_amount++;
+
+        if (visitor(custom_state, __entry_id(snapshot, position), task, length) != 0)
+            break;
+    }
+
+    return visited_amount;
+}
+
+/* Private Functions */
+
+static void __build_crc_table()
+{
+    for (uint32_t byte = 0; byte < 256; byte++)
+    {
+        uint32_t crc = byte;
+
+        for (int bit = 0; bit < 8; bit++)
+            crc = (crc & 1) ? (crc >> 1) ^ 0xEDB88320u : crc >> 1;
+
+        __crc_table[byte] = crc;
+    }
+}
+
+static uint32_t __update_crc(uint32_t crc, const void* data, const size_t length)
+{
+    const unsigned char* bytes = data;
+
+    pthread_once(&__crc_table_once, __build_crc_table);
+    crc = ~crc;
+
+    for (size_t index = 0; index < length; index++)
+        crc = __crc_table[(crc ^ bytes[index]) & 0xFF] ^ (crc >> 8);
+
+    return ~crc;
+}
+
+static void __write_le(unsigned char* destination, uint64_t value, const size_t size)
+{
+    for (size_t index = 0; index < size; index++, value >>= 8)
+        destination[index] = (unsigned char)(value & 0xFF);
+}
+
+static uint64_t __read_le(const unsigned char* source, const size_t size)
+{
+    uint64_t value = 0;
+
+    for (size_t index = size; index > 0; index--)
+        value = (value << 8) | source[index - 1];
+
+    return value;
+}
+
+static bool __write_checked(FILE* file, const void* data, const size_t length, uint32_t* crc)
+{
+    if (length == 0)
+        return true;
+
+    *crc = __update_crc(*crc, data, length);
+
+    return fwrite(data, 1, length, file) == length;
+}
+
+static bool __is_index_valid(const db_snapshot* snapshot, const uint64_t text_length)
+{
+    for (int position = 0; position < snapshot->task_amount; position++)
+    {
+        const unsigned char* entry = snapshot->index + (size_t)position * __INDEX_ENTRY_SIZE;
+        const uint64_t length = __read_le(entry + __INDEX_LENGTH, 4);
+        const uint64_t offset = __read_le(entry + __INDEX_OFFSET, 8);
+
+        if (length > INT_MAX || offset >= text_length || length >= text_length - offset || snapshot->text[offset + length] != '\0')
+            return false;
+
+        if (__entry_id(snapshot, position) <= 0 || (position > 0 && __entry_id(snapshot, position - 1) >= __entry_id(snapshot, position)))
+            return false;
+    }
+
+    return true;
+}
+
+static int __entry_id(const db_snapshot* snapshot, const int position)
+{
+    return (int)(int32_t)__read_le(snapshot->index + (size_t)position * __INDEX_ENTRY_SIZE + __INDEX_ID, 4);
+}
+
+static const char* __entry_task(const db_snapshot* snapshot, const int position, int* length)
+{
+    const unsigned char* entry = snapshot->index + (size_t)position * __INDEX_ENTRY_SIZE;
+
+    if (length != NULL)
+        *length = (int)__read_le(entry + __INDEX_LENGTH, 4);
+
+    return snapshot->text + __read_le(entry + __INDEX_OFFSET, 8);
+}
+
+static int __lower_bound(const db_snapshot* snapshot, const int id)
+{
+    int low = 0, high = snapshot->task_amount;
+
+    while (low < high)
+    {
+        const int middle = low + (high - low) / 2;
+
+        if (__entry_id(snapshot, middle) < id)
+            low = middle + 1;
+        else
+            high = middle;
+    }
+
+    return low;
+}
@@ -0,0 +1,63 @@
+#ifndef SNAPSHOT_H // Only include this header file if it hasn't been included in the calling file already
+    #define SNAPSHOT_H
+
+    #include <stddef.h>
+    #include <stdint.h>
+    #include "./sqlite_db.h"
+    #include "../utilities/utilities.h"
+
+    /// @brief The version of the snapshot format written by "export_snapshot()".
+    #define SNAPSHOT_FORMAT_VERSION 1
+
+    /// @brief Read-only view of a binary snapshot file, mapped into memory.
+    /// @brief Every task it serves points straight into the mapping, so nothing is copied.
+    /// @attention Must be manually closed with "close_snapshot()"!
+    typedef struct db_snapshot db_snapshot;
+
+    /// @brief Writes every task of the database to a binary snapshot file, from a single consistent read.
+    /// @brief The file has a header, a contiguous region with the null-terminated text of every task and
+    /// @brief an index with the ID, creation time, offset and length of each task, sorted by ID. All
+    /// @brief integers are little-endian and everything after the header is covered by a CRC-32.
+    /// @param db The database.
+    /// @param snapshot_location The path of the snapshot file. It's replaced if it exists.
+    /// @return How many tasks were exported or -1 if an error occurred.
+    extern int export_snapshot(const db_handle* db, const char* snapshot_location);
+
+    /// @brief Writes every task of a binary snapshot file to the database through "restore_tasks()",
+    /// @brief keeping their IDs and creation times and replacing the tasks that already have those IDs.
+    /// @param db The database.
+    /// @param snapshot_location The path of the snapshot file.
+    /// @return How many tasks were imported or -1 if the snapshot is invalid or could not be written.
+    extern int import_snapshot(const db_handle* db, const char* snapshot_location);
+
+    /// @brief Maps a binary snapshot file into memory, after checking its header, checksum and index.
+    /// @param snapshot_location The path of the snapshot file.
+    /// @return The snapshot or NULL if the file could not be read or is not a valid snapshot.
+    extern db_snapshot* open_snapshot(const char* snapshot_location);
+
+    /// @brief Unmaps a snapshot. Every task it served becomes invalid.
+    /// @param snapshot The snapshot. May be NULL.
+    extern void close_snapshot(db_snapshot* snapshot);
+
+    /// @brief Gets the amount of tasks in a snapshot.
+    /// @param snapshot The snapshot.
+    /// @return The amount of tasks.
+    extern int snapshot_count_tasks(const db_snapshot* snapshot);
+
+    /// @brief Gets a task from a snapshot, through a binary search of its index.
+    /// @param snapshot The snapshot.
+    /// @param id The ID of the task.
+    /// @param length Receives the length of the task, without the null terminator. May be NULL.
+    /// @return The null-terminated task, valid until the snapshot is closed, or NULL if it's not found.
+    extern const char* snapshot_get_task(const db_snapshot* snapshot, const int id, int* length);
+
+    /// @brief Lends the tasks of a snapshot that come after the specified ID to a visitor, in ascending ID order.
+    /// @param snapshot The snapshot.
+    /// @param after_id Only tasks with a greater ID are visited. Zero starts from the first task.
+    /// @param limit The maximum amount of tasks to visit. Zero or less visits every remaining task.
+    /// @param visitor The function that receives the ID, content and length of each task. Returning non-zero stops the iteration.
+    /// @param custom_state Pointer to an object that's being passed into the visitor.
+    /// @return How many tasks were visited.
+    extern int snapshot_for_each_task(const db_snapshot* snapshot, const int after_id, const int limit,
+        int (*visitor)(void*, const int, const char*, const int), void* custom_state);
+#endif // SNAPSHOT_H
@@ -1,35 +1,892 @@
+#include <stdint.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/stat.h>
 #include "./sqlite_db.h"
+#include "./compression.h"
+#include "./trace.h"
+
+/* Private Types */
+
+/// @brief Identifies a parameterized query in the prepared-statement cache.
+typedef enum __statement_id
+{
+    __STMT_TASK_EXISTS,
+    __STMT_SELECT_TASK,
+    __STMT_SELECT_ALL_TASKS,
+    __STMT_SELECT_PAGE_AFTER,
+    __STMT_SELECT_PAGE_BEFORE,
+    __STMT_SELECT_PREVIOUS_PAGE,
+    __STMT_INSERT_TASK,
+    __STMT_DELETE_TASK,
+    __STMT_UPDATE_TASK,
+    __STMT_SEARCH_TASKS,
+    __STMT_SELECT_TASKS_BETWEEN,
+    __STMT_RESTORE_TASK,
+    __STMT_COUNT_TASKS,
+    __STMT_INSERT_STREAMED_TASK,
+    __STMT_UNINDEX_STREAMED_TASK,
+    __STMT_INDEX_STREAMED_TASK,
+    __STMT_SELECT_ID_BOUNDS,
+    __STMT_SELECT_NEXT_TASK_TYPE,
+
+    /// @brief The amount of cacheable statements. Must be the last entry.
+    __STMT_AMOUNT
+} __statement_id;
+
+/// @brief Identifies a kind of query in the statistics: the cacheable statements, followed by the kinds of queries run by "__execute_query()".
+typedef enum __query_kind
+{
+    __QUERY_BEGIN = __STMT_AMOUNT,
+    __QUERY_COMMIT,
+    __QUERY_ROLLBACK,
+    __QUERY_OTHER,
+
+    /// @brief The amount of kinds of queries. Must be the last entry.
+    __QUERY_KIND_AMOUNT
+} __query_kind;
+
+/// @brief The counters of one kind of query on one connection.
+/// @attention Only the thread using the connection writes them, with relaxed atomic stores, so any thread can read them without locking.
+typedef struct __query_counters
+{
+    /// @brief How many times the query ran.
+    uint64_t calls;
+
+    /// @brief How many rows the query returned.
+    uint64_t rows;
+
+    /// @brief How many bytes the returned rows had.
+    uint64_t bytes;
+
+    /// @brief How long every run took, in nanoseconds.
+    uint64_t total_ns;
+
+    /// @brief How long the slowest run took, in nanoseconds.
+    uint64_t max_ns;
+
+    /// @brief How many times the query was compiled.
+    uint64_t prepares;
+
+    /// @brief How long compiling took, in nanoseconds.
+    uint64_t prepare_ns;
+
+    /// @brief How long the current run has taken so far. Only read by the thread using the connection.
+    uint64_t running_ns;
+} __query_counters;
+
+/// @brief A single SQLite connection and its prepared statements.
+struct db_connection
+{
+    /// @brief The SQLite connection.
+    sqlite3* sqlite;
+
+    /// @brief The compiled statements, indexed by "__statement_id". NULL if not compiled yet.
+    sqlite3_stmt* statements[__STMT_AMOUNT];
+
+    /// @brief The next idle reader in the pool or NULL if this is the last one.
+    struct db_connection* next_idle;
+
+    /// @brief Reusable buffer for compressing and decompressing tasks. Its content is only valid until the next use.
+    char* scratch;
+
+    /// @brief How many bytes fit in "scratch".
+    size_t scratch_capacity;
+
+    /// @brief How the connection waits for locks held by other processes. Owned by the handle.
+    const db_busy_policy* busy_policy;
+
+    /// @brief When the connection started waiting for the lock it's retrying, in nanoseconds.
+    uint64_t busy_since_ns;
+
+    /// @brief The state of the random numbers that spread out the retries.
+    unsigned int busy_seed;
+
+    /// @brief The statistics of each kind of query, indexed by "__query_kind" or "__statement_id".
+    __query_counters query_counters[__QUERY_KIND_AMOUNT];
+
+    /// @brief The slow query threshold the connection is profiling with, in milliseconds. Zero or less if it isn't.
+    int slow_query_ms;
+};
+
+/// @brief A write waiting in the queue of the background writer.
+typedef struct __queued_write
+{
+    /// @brief The query of the write: insert, update or delete.
+    __statement_id statement_id;
+
+    /// @brief The ID of the task. Set by the writer for inserts.
+    int id;
+
+    /// @brief The number the trace gave an insert, or zero for other writes.
+    int64_t insert_number;
+
+    /// @brief Whether the write changed the database.
+    bool applied;
+
+    /// @brief The creation time of an inserted task.
+    time_t created_at;
+
+    /// @brief Called once the write is committed or has failed. May be NULL.
+    void (*callback)(void*, const bool, const int);
+
+    /// @brief The state passed into "callback".
+    void* custom_state;
+
+    /// @brief The next write in the queue.
+    struct __queued_write* next;
+
+    /// @brief The null-terminated content of the task. Empty for deletes.
+    char task[];
+} __queued_write;
+
+/// @brief Owns every connection to a database file.
+struct db_handle
+{
+    /// @brief The only connection allowed to write to the database.
+    db_connection writer;
+
+    /// @brief Serializes access to "writer".
+    pthread_mutex_t writer_lock;
+
+    /// @brief The read-only connections. Only the first "reader_amount" are open.
+    db_connection* readers;
+
+    /// @brief The maximum amount of read-only connections.
+    int reader_capacity;
+
+    /// @brief How many read-only connections have been opened so far.
+    int reader_amount;
+
+    /// @brief Stack of open readers that are not in use.
+    db_connection* idle_readers;
+
+    /// @brief Protects the reader pool.
+    pthread_mutex_t readers_lock;
+
+    /// @brief Signaled whenever a reader is returned to the pool.
+    pthread_cond_t reader_released;
+
+    /// @brief How many operations a batch commits per transaction. Zero or less means the whole batch.
+    int batch_chunk_size;
+
+    /// @brief Tasks at least this long are stored compressed. Zero disables compression.
+    size_t compression_threshold;
+
+    /// @brief How every connection waits for locks held by other processes.
+    db_busy_policy busy_policy;
+
+    /// @brief Statements slower than this are written to stderr, in milliseconds. Zero or less disables profiling.
+    int slow_query_ms;
+
+    /// @brief Records every public call or NULL if no trace is being recorded. Set and read atomically.
+    db_trace_recorder* trace_recorder;
+
+    /// @brief The amount of inserts queued so far, which numbers them in the trace. Incremented atomically.
+    int64_t queued_insert_amount;
+
+    /// @brief The absolute path to the database file.
+    char* location;
+
+    /// @brief Cache of recently read tasks or NULL if caching is disabled.
+    task_cache* cache;
+
+    /// @brief The background writer. Only valid if "is_write_thread_running" is true.
+    pthread_t write_thread;
+
+    /// @brief Whether the background writer was started.
+    bool is_write_thread_running;
+
+    /// @brief Tells the background writer to stop once the queue is empty.
+    bool is_closing;
+
+    /// @brief The oldest queued write or NULL if the queue is empty.
+    __queued_write* write_queue_head;
+
+    /// @brief The newest queued write.
+    __queued_write* write_queue_tail;
+
+    /// @brief How many writes were queued and haven't finished yet.
+    int pending_write_amount;
+
+    /// @brief How many queued writes failed since the last flush.
+    int failed_write_amount;
+
+    /// @brief Protects the write queue and its counters.
+    pthread_mutex_t write_queue_lock;
+
+    /// @brief Signaled whenever a write is queued or the handle is closing.
+    pthread_cond_t write_queued;
+
+    /// @brief Signaled whenever every pending write has finished.
+    pthread_cond_t writes_finished;
+};
+
+/// @brief Growable storage used to build a "db_tasks" object.
+typedef struct __tasks_arena
+{
+    /// @brief The amount of tasks in the arena.
+    int amount;
+
+    /// @brief How many entries fit in "entries" before it has to grow.
+    int entry_capacity;
+
+    /// @brief The location of every task.
+    db_tasks_entry* entries;
+
+    /// @brief How many bytes of "strings" are in use.
+    size_t strings_length;
+
+    /// @brief How many bytes fit in "strings" before it has to grow.
+    size_t strings_capacity;
+
+    /// @brief The null-terminated contents of all tasks stored back to back.
+    char* strings;
+} __tasks_arena;
+
+/// @brief The bytes stored in the "task" column for a task.
+typedef struct __encoded_task
+{
+    /// @brief The task itself or its compressed body.
+    const void* data;
+
+    /// @brief The amount of bytes in "data".
+    int length;
+
+    /// @brief Whether "data" is a compressed body, which is stored as a BLOB instead of TEXT.
+    bool is_compressed;
+} __encoded_task;
+
+/// @brief The arguments of a batch operation.
+typedef struct __batch_arguments
+{
+    /// @brief The database the batch runs on.
+    const db_handle* db;
+
+    /// @brief The IDs of the tasks or NULL if the operation doesn't take IDs.
+    const int* ids;
+
+    /// @brief The contents of the tasks or NULL if the operation doesn't take contents.
+    const char** tasks;
+
+    /// @brief The creation time of inserted tasks.
+    time_t created_at;
+
+    /// @brief The creation time of each restored task or NULL if the operation doesn't restore tasks.
+    const time_t* restored_created_at;
+} __batch_arguments;
+
+/// @brief State of a visitor that caches the task before passing it on.
+typedef struct __caching_visitor_state
+{
+    /// @brief The cache the task goes into.
+    task_cache* cache;
+
+    /// @brief The generation of the cache before the task was read.
+    unsigned long generation;
+
+    /// @brief The visitor the task is passed on to.
+    int (*visitor)(void*, const int, const char*, const int);
+
+    /// @brief The state of "visitor".
+    void* custom_state;
+} __caching_visitor_state;
+
+/// @brief State of a query run by "__execute_query()", to count its rows.
+typedef struct __counted_query_state
+{
+    /// @brief The counters of the query.
+    __query_counters* counters;
+
+    /// @brief The callback of the query or NULL if it has none.
+    int (*callback)(void*, int, char**, char**);
+
+    /// @brief The state of "callback".
+    void* custom_state;
+} __counted_query_state;
+
+/// @brief Where the frames of a streamed task are written as they're encoded.
+typedef struct __streamed_body
+{
+    /// @brief The unlinked temporary file that stages the frames or NULL if they're not staged.
+    FILE* staging;
+
+    /// @brief The blob of the task the frames are written into or NULL if they're only measured or staged.
+    sqlite3_blob* blob;
+
+    /// @brief The length of the body so far, including its header.
+    uint64_t length;
+
+    /// @brief Whether any chunk so far had more than line breaks.
+    bool has_text;
+
+    /// @brief Why the input was rejected: EILSEQ for null characters, ENODATA for nothing but line breaks, zero otherwise.
+    int rejection_code;
+} __streamed_body;
 
 /* Private Variables */
 
-/// @brief Used to keep track of iterations of "__callback_select_tasks()".
-static int __select_tasks_current_index = 0;
+/// @brief The SQL text of each cacheable statement, indexed by "__statement_id".
+static const char* const __statement_queries[__STMT_AMOUNT] = {
+    [__STMT_TASK_EXISTS] = "SELECT 1 FROM tasks WHERE id = ? LIMIT 1;",
+    [__STMT_SELECT_TASK] = "SELECT id, task FROM tasks WHERE id = ?;",
+    [__STMT_SELECT_ALL_TASKS] = "SELECT id, task, created_at FROM tasks ORDER BY id;",
+    [__STMT_SELECT_PAGE_AFTER] = "SELECT id, task FROM tasks WHERE id > ? ORDER BY id LIMIT ?;",
+    [__STMT_SELECT_PAGE_BEFORE] = "SELECT id, task FROM tasks WHERE id < ? ORDER BY id DESC LIMIT ?;",
+    [__STMT_SELECT_PREVIOUS_PAGE] = "SELECT MIN(id) - 1 FROM (SELECT id FROM tasks WHERE id < ? ORDER BY id DESC LIMIT ?);",
+    [__STMT_INSERT_TASK] = "INSERT INTO tasks (task, created_at) VALUES (?, ?);",
+    [__STMT_DELETE_TASK] = "DELETE FROM tasks WHERE id = ?;",
+    [__STMT_UPDATE_TASK] = "UPDATE tasks SET task = ? WHERE id = ?;",
+    [__STMT_SEARCH_TASKS] = "SELECT rowid, snippet(tasks_fts, 0, '[', ']', '...', 16) FROM tasks_fts WHERE tasks_fts MATCH ? ORDER BY rank LIMIT ?;",
+    [__STMT_SELECT_TASKS_BETWEEN] = DB_TASKS_BETWEEN_QUERY,
+
+    // An upsert instead of "INSERT OR REPLACE", so replaced tasks go through the update trigger of the full-text index.
+    [__STMT_RESTORE_TASK] = "INSERT INTO tasks (id, task, created_at) VALUES (?, ?, ?) ON CONFLICT (id) DO UPDATE SET task = excluded.task, created_at = excluded.created_at;",
+    [__STMT_COUNT_TASKS] = "SELECT value FROM tasks_meta WHERE key = 'task_count';",
+
+    // Streamed tasks are zero-filled until they're written, so the insert trigger indexes them as empty text,
+    // and the beginning of their text is indexed once they're complete.
+    [__STMT_INSERT_STREAMED_TASK] = "INSERT INTO tasks (task, created_at) VALUES (zeroblob(?), ?);",
+    [__STMT_UNINDEX_STREAMED_TASK] = "INSERT INTO tasks_fts (tasks_fts, rowid, task) VALUES ('delete', ?, '');",
+    [__STMT_INDEX_STREAMED_TASK] = "INSERT INTO tasks_fts (task, rowid) VALUES (?, ?);",
+    [__STMT_SELECT_ID_BOUNDS] = "SELECT MIN(id), MAX(id) FROM tasks;",
+
+    // "typeof()" only reads the header of the row, so the task itself isn't loaded.
+    [__STMT_SELECT_NEXT_TASK_TYPE] = "SELECT id, typeof(task) = 'blob' FROM tasks WHERE id > ? ORDER BY id LIMIT 1;"
+};
+
+/// @brief The name of each kind of query in the statistics, indexed by "__query_kind" or "__statement_id".
+static const char* const __query_names[__QUERY_KIND_AMOUNT] = {
+    [__STMT_TASK_EXISTS] = "task exists",
+    [__STMT_SELECT_TASK] = "select task",
+    [__STMT_SELECT_ALL_TASKS] = "select all tasks",
+    [__STMT_SELECT_PAGE_AFTER] = "select page after",
+    [__STMT_SELECT_PAGE_BEFORE] = "select page before",
+    [__STMT_SELECT_PREVIOUS_PAGE] = "find previous page",
+    [__STMT_INSERT_TASK] = "insert task",
+    [__STMT_DELETE_TASK] = "delete task",
+    [__STMT_UPDATE_TASK] = "update task",
+    [__STMT_SEARCH_TASKS] = "search tasks",
+    [__STMT_SELECT_TASKS_BETWEEN] = "select tasks between",
+    [__STMT_RESTORE_TASK] = "restore task",
+    [__STMT_COUNT_TASKS] = "count tasks",
+    [__STMT_INSERT_STREAMED_TASK] = "insert streamed task",
+    [__STMT_UNINDEX_STREAMED_TASK] = "unindex streamed task",
+    [__STMT_INDEX_STREAMED_TASK] = "index streamed task",
+    [__STMT_SELECT_ID_BOUNDS] = "select id bounds",
+    [__STMT_SELECT_NEXT_TASK_TYPE] = "select next task type",
+    [__QUERY_BEGIN] = "begin",
+    [__QUERY_COMMIT] = "commit",
+    [__QUERY_ROLLBACK] = "rollback",
+    [__QUERY_OTHER] = "other"
+};
+
+_Static_assert(__QUERY_KIND_AMOUNT == DB_QUERY_KIND_AMOUNT, "DB_QUERY_KIND_AMOUNT must match the kinds of queries.");
+
+/// @brief The schema migrations, in order. Migration "N" upgrades a database from "PRAGMA user_version = N" to "N + 1".
+/// @attention Migrations must never be edited or reordered once released. Change the schema by appending a new one.
+static const char* const __migrations[] = {
+    // 1: The tasks table.
+    "CREATE TABLE IF NOT EXISTS tasks (             \
+        id INTEGER PRIMARY KEY,                     \
+        task TEXT NOT NULL,                         \
+        created_at INTEGER NOT NULL                 \
+    );",
+
+    // 2: The full-text index, which reads the content of the tasks from the "tasks" table, so the text is not stored twice.
+    "CREATE VIRTUAL TABLE IF NOT EXISTS tasks_fts USING fts5(task, content = 'tasks', content_rowid = 'id'); \
+    CREATE TRIGGER IF NOT EXISTS tasks_fts_insert AFTER INSERT ON tasks BEGIN                               \
+        INSERT INTO tasks_fts (rowid, task) VALUES (new.id, new.task);                                      \
+    END;                                                                                                    \
+    CREATE TRIGGER IF NOT EXISTS tasks_fts_delete AFTER DELETE ON tasks BEGIN                               \
+        INSERT INTO tasks_fts (tasks_fts, rowid, task) VALUES ('delete', old.id, old.task);                 \
+    END;                                                                                                    \
+    CREATE TRIGGER IF NOT EXISTS tasks_fts_update AFTER UPDATE OF task ON tasks BEGIN                       \
+        INSERT INTO tasks_fts (tasks_fts, rowid, task) VALUES ('delete', old.id, old.task);                 \
+        INSERT INTO tasks_fts (rowid, task) VALUES (new.id, new.task);                                      \
+    END;                                                                                                    \
+    INSERT INTO tasks_fts (tasks_fts) VALUES ('rebuild');",
+
+    // 3: Time-range queries.
+    "CREATE INDEX IF NOT EXISTS tasks_created_at ON tasks (created_at);",
+
+    // 4: Compressed tasks. The full-text index reads the plain text of the tasks through a view.
+    "DROP TRIGGER IF EXISTS tasks_fts_insert;                                                               \
+    DROP TRIGGER IF EXISTS tasks_fts_delete;                                                                \
+    DROP TRIGGER IF EXISTS tasks_fts_update;                                                                \
+    DROP TABLE IF EXISTS tasks_fts;                                                                         \
+    CREATE VIEW IF NOT EXISTS tasks_content AS SELECT id, task_text(task) AS task FROM tasks;               \
+    CREATE VIRTUAL TABLE tasks_fts USING fts5(task, content = 'tasks_content', content_rowid = 'id');       \
+    CREATE TRIGGER tasks_fts_insert AFTER INSERT ON tasks BEGIN                                             \
+        INSERT INTO tasks_fts (rowid, task) VALUES (new.id, task_text(new.task));                           \
+    END;                                                                                                    \
+    CREATE TRIGGER tasks_fts_delete AFTER DELETE ON tasks BEGIN                                             \
+        INSERT INTO tasks_fts (tasks_fts, rowid, task) VALUES ('delete', old.id, task_text(old.task));      \
+    END;                                                                                                    \
+    CREATE TRIGGER tasks_fts_update AFTER UPDATE OF task ON tasks BEGIN                                     \
+        INSERT INTO tasks_fts (tasks_fts, rowid, task) VALUES ('delete', old.id, task_text(old.task));      \
+        INSERT INTO tasks_fts (rowid, task) VALUES (new.id, task_text(new.task));                           \
+    END;                                                                                                    \
+    INSERT INTO tasks_fts (tasks_fts) VALUES ('rebuild');",
+
+    // 5: The amount of tasks, kept up to date by triggers so counting doesn't scan the table.
+    // Upserts only fire the update trigger, so restoring a task that already exists doesn't change the count.
+    "CREATE TABLE IF NOT EXISTS tasks_meta (key TEXT PRIMARY KEY, value INTEGER NOT NULL) WITHOUT ROWID;    \
+    INSERT OR REPLACE INTO tasks_meta (key, value) SELECT 'task_count', COUNT(*) FROM tasks;                \
+    CREATE TRIGGER IF NOT EXISTS tasks_count_insert AFTER INSERT ON tasks BEGIN                             \
+        UPDATE tasks_meta SET value = value + 1 WHERE key = 'task_count';                                   \
+    END;                                                                                                    \
+    CREATE TRIGGER IF NOT EXISTS tasks_count_delete AFTER DELETE ON tasks BEGIN                             \
+        UPDATE tasks_meta SET value = value - 1 WHERE key = 'task_count';                                   \
+    END;",
+
+    // 6: Streamed tasks. The task moves to the last column, so a zero-filled one is written to disk without being built in memory,
+    // and the full-text index only reads the beginning of each task.
+    // Dropping the table drops its index and triggers, but the view has to go first or the table can't be renamed.
+    "DROP VIEW IF EXISTS tasks_content;                                                                     \
+    CREATE TABLE tasks_new (                                                                                \
+        id INTEGER PRIMARY KEY,                                                                             \
+        created_at INTEGER NOT NULL,                                                                        \
+        task TEXT NOT NULL                                                                                  \
+    );                                                                                                      \
+    INSERT INTO tasks_new (id, created_at, task) SELECT id, created_at, task FROM tasks;                    \
+    DROP TABLE tasks;                                                                                       \
+    ALTER TABLE tasks_new RENAME TO tasks;                                                                  \
+    CREATE INDEX tasks_created_at ON tasks (created_at);                                                    \
+    CREATE VIEW tasks_content AS SELECT id, task_index_text(task) AS task FROM tasks;                       \
+    CREATE TRIGGER tasks_fts_insert AFTER INSERT ON tasks BEGIN                                             \
+        INSERT INTO tasks_fts (rowid, task) VALUES (new.id, task_index_text(new.task));                     \
+    END;                                                                                                    \
+    CREATE TRIGGER tasks_fts_delete AFTER DELETE ON tasks BEGIN                                             \
+        INSERT INTO tasks_fts (tasks_fts, rowid, task) VALUES ('delete', old.id, task_index_text(old.task)); \
+    END;                                                                                                    \
+    CREATE TRIGGER tasks_fts_update AFTER UPDATE OF task ON tasks BEGIN                                     \
+        INSERT INTO tasks_fts (tasks_fts, rowid, task) VALUES ('delete', old.id, task_index_text(old.task)); \
+        INSERT INTO tasks_fts (rowid, task) VALUES (new.id, task_index_text(new.task));                     \
+    END;                                                                                                    \
+    CREATE TRIGGER tasks_count_insert AFTER INSERT ON tasks BEGIN                                           \
+        UPDATE tasks_meta SET value = value + 1 WHERE key = 'task_count';                                   \
+    END;                                                                                                    \
+    CREATE TRIGGER tasks_count_delete AFTER DELETE ON tasks BEGIN                                           \
+        UPDATE tasks_meta SET value = value - 1 WHERE key = 'task_count';                                   \
+    END;                                                                                                    \
+    INSERT INTO tasks_fts (tasks_fts) VALUES ('rebuild');"
+};
+
+/// @brief The codec tag that starts a compressed body, followed by the length of the task as 32-bit little-endian.
+static const unsigned char __codec_lz = 0x01;
+
+/// @brief The codec tag of a body compressed one chunk at a time, followed by the length of the task as 32-bit little-endian
+/// @brief and by frames made of the 32-bit little-endian original and stored lengths of a chunk and its data.
+/// @brief Chunks that didn't shrink are stored as they are, with both lengths equal.
+static const unsigned char __codec_lz_framed = 0x02;
+
+/// @brief The first byte of a body that is still being streamed in, which reads as empty text.
+static const unsigned char __codec_pending = 0x00;
+
+/// @brief The size of the lengths that precede each frame of a framed body.
+static const int __frame_header_length = 8;
+
+/// @brief How much of a streamed task is read, compressed and written at a time.
+static const size_t __stream_chunk_size = 256 * 1024;
+
+/// @brief The size of the tag and the length that precede the compressed data.
+static const int __compressed_header_length = 5;
+
+/// @brief How many bytes from the start of a task the full-text index holds. Matches the size of a chunk,
+/// @brief so indexing a framed task only decompresses its first frame.
+static const int __max_indexed_length = 256 * 1024;
+
+/// @brief Whether the writer of this thread is inserting a zero-filled streamed task, which the full-text index must not read.
+/// @brief Reading it would make SQLite build the whole zero-filled body in memory.
+static _Thread_local bool __is_inserting_streamed_task = false;
+
+/// @brief Tasks at least this long are compressed by default.
+static const size_t __default_compression_threshold = 4096;
+
+/// @brief The schema version this program works with.
+static const int __schema_version = sizeof(__migrations) / sizeof(__migrations[0]);
+
+/// @brief The maximum amount of queued writes committed in a single transaction.
+static const int __max_write_group_size = 256;
+
+/// @brief How connections wait for locks held by other processes, unless told otherwise.
+static const db_busy_policy __default_busy_policy = {
+    .timeout_ms = 5000,
+    .initial_backoff_us = 100,
+    .max_backoff_us = 20000
+};
 
 /* Function Prototyping */
 
-/// @brief Initializes a SQLite database at the specified location.
+/// @brief Brings the schema of the database up to date by applying every migration newer than its
+/// @brief "PRAGMA user_version", each one in its own transaction together with the version bump.
+/// @param connection The connection to the database.
+/// @return True if the database was successfully initialized, False otherwise.
+static bool __initialize_database(db_connection* connection);
+
+/// @brief Applies a single migration and sets the schema version it leads to, in one transaction.
+/// @param connection The connection to the database.
+/// @param version The version the database is at. "__migrations[version]" is applied.
+/// @return True if the migration was applied or another connection applied it first, False otherwise.
+static bool __apply_migration(db_connection* connection, const int version);
+
+/// @brief Converts words typed by the user into an FTS5 query that matches every word as a prefix.
+/// @attention Must be manually deallocated!
+/// @param query The words to look for.
+/// @return The FTS5 query or NULL if there are no words to look for.
+static char* __build_match_query(const char* query);
+
+/// @brief Grows the scratch buffer of a connection, if needed.
+/// @param connection The connection.
+/// @param capacity The minimum amount of bytes the buffer must hold.
+/// @return The buffer or NULL if there was not enough memory.
+static char* __reserve_scratch(db_connection* connection, const size_t capacity);
+
+/// @brief Compresses a task that is at least as long as the compression threshold, if that makes it smaller.
+/// @attention Must be called with the writer locked. The result is only valid until the next call.
+/// @param db The database.
+/// @param task The task.
+/// @return The bytes to store for the task.
+static __encoded_task __encode_task(const db_handle* db, const char* task);
+
+/// @brief Binds the bytes of an encoded task to a statement: compressed bodies as BLOBs and plain tasks as TEXT.
+/// @param stmt The compiled SQL statement.
+/// @param index The index of the parameter.
+/// @param encoded_task The encoded task.
+/// @return Zero if the operation succeeded, non-zero otherwise.
+static int __bind_encoded_task(sqlite3_stmt* stmt, const int index, const __encoded_task* encoded_task);
+
+/// @brief Decompresses a body of either codec into a buffer.
+/// @param body The content of the "task" column.
+/// @param body_length The size of the content.
+/// @param task The buffer that receives the task.
+/// @param task_length The length of the task, as returned by "__compressed_task_length()".
+/// @return True if exactly "task_length" bytes were decompressed, False if the body is corrupted.
+static bool __decompress_task(const unsigned char* body, const int body_length, char* task, const long task_length);
+
+/// @brief Adds a task that's larger than a chunk by compressing it a chunk at a time and writing the frames into
+/// @brief a zero-filled row with incremental blob writes, so no more than a chunk of it is ever in memory.
+/// @brief Files are read twice, first to measure the body and then to write it. Pipes stage their frames in a temporary file instead.
+/// @brief Either way the input is read before the writer is taken, so a slow producer never holds up other writes.
+/// @param db The database.
+/// @param fd The file descriptor the rest of the task is read from.
+/// @param chunk The first chunk of the task. Reused as the buffer for the following ones.
+/// @param chunk_length The length of the first chunk.
+/// @param frame A buffer that holds a compressed chunk and its lengths.
+/// @param error_code Receives why the task could not be added.
+/// @return The ID of the new task or -1 if it could not be read or written to the database.
+static int __add_streamed_task(const db_handle* db, const int fd, char* chunk, size_t chunk_length, unsigned char* frame, int* error_code);
+
+/// @brief Reads from a file descriptor until a buffer is full or the input ends.
+/// @param fd The file descriptor.
+/// @param buffer The buffer.
+/// @param capacity The size of the buffer.
+/// @param length Receives how many bytes were read. Less than "capacity" means the input ended.
+/// @return True if the input was read, False if an error occurred.
+static bool __read_chunk(const int fd, char* buffer, const size_t capacity, size_t* length);
+
+/// @brief Encodes a task read from a file descriptor into frames, one chunk at a time, until the input ends.
+/// @param db The database.
+/// @param fd The file descriptor the rest of the task is read from.
+/// @param chunk The first chunk of the task. Reused as the buffer for the following ones.
+/// @param chunk_length The length of the first chunk.
+/// @param frame A buffer that holds a compressed chunk and its lengths.
+/// @param body Where the frames are written.
+/// @param task_length Receives the length of the task.
+/// @return True if every frame was written, False if the input could not be read, is too large, or was rejected as in "body".
+static bool __encode_stream(const db_handle* db, const int fd, char* chunk, size_t chunk_length, unsigned char* frame,
+    __streamed_body* body, uint64_t* task_length);
+
+/// @brief Writes a frame into the blob of a streamed task or stages it, and adds it to the length of the body.
+/// @param body Where the frame is written.
+/// @param frame The frame.
+/// @param frame_length The size of the frame.
+/// @return True if the frame was written, False otherwise.
+static bool __write_frame(__streamed_body* body, const unsigned char* frame, const size_t frame_length);
+
+/// @brief Copies the staged frames into the blob of a streamed task, in order, a buffer at a time.
+/// @param staging The file the frames were staged in.
+/// @param blob The blob of the task.
+/// @param buffer The buffer the frames are copied through.
+/// @param capacity The size of the buffer.
+/// @return True if the frames filled the blob exactly, False otherwise.
+static bool __copy_staged_frames(FILE* staging, sqlite3_blob* blob, char* buffer, const size_t capacity);
+
+/// @brief Checks whether a text has nothing but line breaks, which makes it an empty note.
+/// @param text The text.
+/// @param length The length of the text.
+/// @return True if the text is empty or only has line breaks, False otherwise.
+static bool __is_blank(const char* text, const size_t length);
+
+/// @brief Writes a 32-bit integer in little-endian order.
+/// @param bytes Where the integer is written.
+/// @param value The integer.
+static void __write_uint32(unsigned char* bytes, const uint32_t value);
+
+/// @brief Reads a 32-bit integer stored in little-endian order.
+/// @param bytes Where the integer is stored.
+/// @return The integer.
+static uint32_t __read_uint32(const unsigned char* bytes);
+
+/// @brief Gets the length of the task stored in a compressed body.
+/// @param body The content of the "task" column.
+/// @param body_length The size of the content.
+/// @return The length of the task or -1 if the content is not a valid compressed body.
+static long __compressed_task_length(const unsigned char* body, const int body_length);
+
+/// @brief Reads part of a task from its open blob, decompressing only the frames the part overlaps.
+/// @param connection The connection the blob belongs to. Its scratch buffer holds the frames being decompressed.
+/// @param blob The blob of the "task" column.
+/// @param is_compressed Whether the column holds a blob, as opposed to plain text.
+/// @param offset The byte of the task the part starts at.
+/// @param buffer Receives the part.
+/// @param capacity The maximum size of the part.
+/// @param length Receives the length of the whole task.
+/// @return The size of the part or -1 if the task is corrupted or could not be read.
+static int __read_blob_part(db_connection* connection, sqlite3_blob* blob, const bool is_compressed, const long offset,
+    char* buffer, const int capacity, long* length);
+
+/// @brief Compresses a chunk of a task into a frame, or copies it if compressing doesn't make it smaller.
+/// @param chunk The chunk.
+/// @param chunk_length The size of the chunk. Must not exceed "__stream_chunk_size".
+/// @param frame Receives the frame. Must hold "__frame_header_length + lz_compress_bound(chunk_length)" bytes.
+/// @param should_compress Whether the chunk is compressed. If not, it's always copied.
+/// @return The size of the frame.
+static size_t __encode_frame(const char* chunk, const size_t chunk_length, unsigned char* frame, const bool should_compress);
+
+/// @brief Gets how much of the start of a task the full-text index holds: up to "__max_indexed_length" bytes,
+/// @brief cut before a character that doesn't fit whole.
+/// @param text The text of the task.
+/// @param length The length of the text.
+/// @return The length of the indexed text.
+static int __get_indexed_length(const char* text, const int length);
+
+/// @brief Reads the plain text of a task from a statement, decompressing it into the scratch buffer of the connection if needed.
+/// @param connection The connection the statement belongs to.
+/// @param stmt The statement, positioned on a row.
+/// @param column The column of the task.
+/// @param length Receives the length of the task, without the null terminator.
+/// @return The null-terminated task, only valid until the next step or the next read on the connection, or NULL if it's corrupted.
+static const char* __read_task_column(db_connection* connection, sqlite3_stmt* stmt, const int column, int* length);
+
+/// @brief SQL function "task_text(task)" that returns the plain text of a task, whether it's compressed or not.
+/// @param context The context of the SQL function.
+/// @param argc The amount of arguments.
+/// @param argv The arguments.
+static void __sql_task_text(sqlite3_context* context, int argc, sqlite3_value** argv);
+
+/// @brief SQL function "task_index_text(task)" that returns the text of a task that the full-text index holds,
+/// @brief decompressing only the frames it needs. Returns empty text while a streamed task is being inserted.
+/// @param context The context of the SQL function.
+/// @param argc The amount of arguments.
+/// @param argv The arguments.
+static void __sql_task_index_text(sqlite3_context* context, int argc, sqlite3_value** argv);
+
+/// @brief Busy handler that retries with an exponential backoff and random jitter, until the timeout of the policy.
+/// @param connection db_connection* that's waiting for the lock.
+/// @param attempt How many times the handler was already called for this lock.
+/// @return Non-zero to retry, zero to give up with SQLITE_BUSY.
+static int __busy_handler(void* connection, int attempt);
+
+/// @brief Opens a SQLite connection to the specified database file.
+/// @param connection The connection to be opened.
 /// @param db_location The absolute path to the database file.
-/// @return True if the database was successfully created, False otherwise.
-static bool __initialize_database(const char* db_location);
-
-/// @brief Executes a SQL query.
-/// @param db The SQLite database.
+/// @param flags The SQLITE_OPEN_* flags of the connection.
+/// @param busy_policy How the connection waits for locks held by other processes.
+/// @return True if the connection was opened, False otherwise.
+static bool __open_connection(db_connection* connection, const char* db_location, const int flags, const db_busy_policy* busy_policy);
+
+/// @brief Finalizes all cached statements of the specified connection and closes it.
+/// @param connection The connection to be closed.
+static void __close_connection(db_connection* connection);
+
+/// @brief Takes a read-only connection from the pool, opening a new one or waiting for one to be released if needed.
+/// @attention Must be given back with "__release_reader()"!
+/// @param db The database.
+/// @return The connection or NULL if no connection could be opened.
+static db_connection* __acquire_reader(const db_handle* db);
+
+/// @brief Returns a read-only connection to the pool.
+/// @param db The database.
+/// @param connection The connection returned by "__acquire_reader()".
+static void __release_reader(const db_handle* db, db_connection* connection);
+
+/// @brief Takes exclusive ownership of the writer connection.
+/// @attention Must be given back with "__release_writer()"!
+/// @param db The database.
+/// @return The writer connection.
+static db_connection* __acquire_writer(const db_handle* db);
+
+/// @brief Gives back the ownership of the writer connection.
+/// @param db The database.
+static void __release_writer(const db_handle* db);
+
+/// @brief Executes a SQL query and adds it to the statistics of the connection.
+/// @param connection The connection to run the query on.
 /// @param sql_query The SQL query to execute.
 /// @param callback The function to execute when the database returns data.
 /// @param custom_state Pointer to an object that's being passed into the callback function.
 /// @return True if the query completed successfully, False otherwise.
-static bool __execute_query(const sqlite3* db, const char* sql_query, int (*callback)(void*, int, char**, char**), void* custom_state);
-
-/// @brief Executes a parameterized SQL query.
-/// @param db The SQLite database.
-/// @param sql_query The SQL query to execute.
+static bool __execute_query(db_connection* connection, const char* sql_query, int (*callback)(void*, int, char**, char**), void* custom_state);
+
+/// @brief Callback of "sqlite3_exec()" that counts the rows and bytes of a query before passing the row on.
+/// @param custom_state The __counted_query_state of the query.
+/// @param column_amount The amount of columns.
+/// @param column_contents The contents of the columns.
+/// @param column_names The names of the columns.
+/// @return The result of the callback of the query, or zero if it has none.
+static int __callback_count_row(void* custom_state, int column_amount, char** column_contents, char** column_names);
+
+/// @brief Steps a cached statement and adds the step to the statistics of the connection.
+/// @param connection The connection that owns the statement.
+/// @param stmt The statement.
+/// @return The result of "sqlite3_step()".
+static int __step_statement(db_connection* connection, sqlite3_stmt* stmt);
+
+/// @brief Gets the counters of a statement.
+/// @param connection The connection that owns the statement.
+/// @param stmt The statement.
+/// @return The counters of the statement, or of the "other" kind if it isn't cached.
+static __query_counters* __get_statement_counters(db_connection* connection, const sqlite3_stmt* stmt);
+
+/// @brief Gets the size of the current row of a statement.
+/// @param stmt The statement.
+/// @return The amount of bytes of the text and blob columns, plus 8 for each number.
+static uint64_t __get_row_size(sqlite3_stmt* stmt);
+
+/// @brief Tells which kind of query a SQL query run by "__execute_query()" is.
+/// @param sql_query The SQL query.
+/// @return The kind of query.
+static __query_kind __classify_query(const char* sql_query);
+
+/// @brief Adds an amount to a counter read by other threads.
+/// @param counter The counter.
+/// @param amount The amount to add.
+static void __add_to_counter(uint64_t* counter, const uint64_t amount);
+
+/// @brief Raises a counter read by other threads to a value, if the value is higher.
+/// @param counter The counter.
+/// @param value The value.
+static void __raise_counter(uint64_t* counter, const uint64_t value);
+
+/// @brief Gets a monotonic timestamp.
+/// @return The current time in nanoseconds.
+static uint64_t __get_time_ns();
+
+/// @brief Makes a connection profile its statements with the slow query threshold of the handle, if it changed.
+/// @attention The connection must be owned by the calling thread.
+/// @param db The database.
+/// @param connection The connection.
+static void __update_slow_query_profiling(const db_handle* db, db_connection* connection);
+
+/// @brief Profile callback of "sqlite3_trace_v2()" that writes statements slower than the threshold to stderr.
+/// @param event The event, always SQLITE_TRACE_PROFILE.
+/// @param connection The db_connection the statement ran on.
+/// @param stmt The statement.
+/// @param elapsed_ns Pointer to how long the statement took, in nanoseconds.
+/// @return Always zero.
+static int __trace_slow_query(unsigned int event, void* connection, void* stmt, void* elapsed_ns);
+
+/// @brief Adds the counters of a connection to the statistics of a handle.
+/// @param stats The statistics.
+/// @param connection The connection.
+static void __sum_query_counters(db_query_stats* stats, const db_connection* connection);
+
+/// @brief Gets the compiled statement for the specified query, compiling and caching it on first use.
+/// @param connection The connection that owns the statement.
+/// @param statement_id The query to get the statement for.
+/// @return The compiled statement or NULL if it could not be compiled.
+static sqlite3_stmt* __get_cached_statement(db_connection* connection, __statement_id statement_id);
+
+/// @brief Executes a parameterized SQL query through the prepared-statement cache.
+/// @param connection The connection to run the query on.
+/// @param statement_id The query to execute.
 /// @param custom_state Pointer to an object that's being passed into the db_callback function.
 /// @param db_callback The function to execute when a row is read from the database.
 /// @param query_callback The function to execute to add the parameters to the query.
 /// @param arg_count The amount of parameters in the query.
 /// @param ... The parameters to be added to the query.
 /// @return True if the query completed successfully, False otherwise.
-static bool __execute_parameterized_query(const sqlite3* db, const char* sql_query, void* custom_state, int (*db_callback)(void*, sqlite3_stmt*), int (*query_callback)(sqlite3_stmt*, va_list, int), int arg_count, ...);
+static bool __execute_parameterized_query(db_connection* connection, __statement_id statement_id, void* custom_state, int (*db_callback)(void*, sqlite3_stmt*), int (*query_callback)(sqlite3_stmt*, va_list, int), int arg_count, ...);
+
+/// @brief Executes a cached statement once per item, committing "chunk_size" items per transaction.
+/// @param connection The connection to run the batch on.
+/// @param chunk_size How many items are committed per transaction. Zero or less means the whole batch.
+/// @param statement_id The query to execute.
+/// @param amount The amount of items in the batch.
+/// @param results Array that receives whether each item was applied. May be NULL.
+/// @param bind_callback The function that binds the parameters of the item at the specified index.
+/// @param arguments The arguments of the batch.
+/// @return How many items were applied.
+static int __execute_batch(db_connection* connection, const int chunk_size, __statement_id statement_id, const int amount, bool* results,
+    int (*bind_callback)(sqlite3_stmt*, const __batch_arguments*, int), const __batch_arguments* arguments);
+
+/// @brief Executes a batch operation on the writer connection of the database.
+/// @param db The database.
+/// @param statement_id The query to execute.
+/// @param amount The amount of items in the batch.
+/// @param results Array that receives whether each item was applied. May be NULL.
+/// @param bind_callback The function that binds the parameters of the item at the specified index.
+/// @param arguments The arguments of the batch.
+/// @return How many items were applied.
+static int __execute_writer_batch(const db_handle* db, __statement_id statement_id, const int amount, bool* results,
+    int (*bind_callback)(sqlite3_stmt*, const __batch_arguments*, int), const __batch_arguments* arguments);
+
+/// @brief Copies a write into the queue of the background writer, starting the writer if needed.
+/// @param db The database.
+/// @param statement_id The query of the write.
+/// @param id The ID of the task or zero for inserts.
+/// @param insert_number The number the trace gave an insert, or zero for other writes.
+/// @param task The content of the task or NULL for deletes.
+/// @param callback Called once the write is committed or has failed. May be NULL.
+/// @param custom_state The state passed into "callback".
+/// @return True if the write was queued, False otherwise.
+static bool __enqueue_write(const db_handle* db, __statement_id statement_id, const int id, const int64_t insert_number, const char* task,
+    void (*callback)(void*, const bool, const int), void* custom_state);
+
+/// @brief Entry point of the background writer. Commits every write waiting in the queue
+/// @brief in a single transaction until the handle is closed and the queue is empty.
+/// @param db db_handle* with the queue.
+/// @return NULL.
+static void* __run_write_thread(void* db);
+
+/// @brief Executes a group of queued writes in a single transaction on the writer connection.
+/// @param db The database.
+/// @param group The first write of the group. The writes are linked through "next".
+static void __execute_write_group(const db_handle* db, __queued_write* group);
+
+/// @brief Stops the background writer once every queued write has finished.
+/// @param db The database.
+static void __stop_write_thread(db_handle* db);
+
+/// @brief Binds the parameters of one item of "insert_tasks".
+/// @param stmt The compiled SQL statement.
+/// @param arguments The arguments of the batch.
+/// @param index The position of the item in the batch.
+/// @return Zero if the operation succeeded, non-zero otherwise.
+static int __bind_batch_insert(sqlite3_stmt* stmt, const __batch_arguments* arguments, int index);
+
+/// @brief Binds the parameters of one item of "delete_tasks".
+/// @param stmt The compiled SQL statement.
+/// @param arguments The arguments of the batch.
+/// @param index The position of the item in the batch.
+/// @return Zero if the operation succeeded, non-zero otherwise.
+static int __bind_batch_id(sqlite3_stmt* stmt, const __batch_arguments* arguments, int index);
+
+/// @brief Binds the parameters of one item of "update_tasks".
+/// @param stmt The compiled SQL statement.
+/// @param arguments The arguments of the batch.
+/// @param index The position of the item in the batch.
+/// @return Zero if the operation succeeded, non-zero otherwise.
+static int __bind_batch_update(sqlite3_stmt* stmt, const __batch_arguments* arguments, int index);
+
+/// @brief Binds the parameters of one item of "restore_tasks".
+/// @param stmt The compiled SQL statement.
+/// @param arguments The arguments of the batch.
+/// @param index The position of the item in the batch.
+/// @return Zero if the operation succeeded, non-zero otherwise.
+static int __bind_batch_restore(sqlite3_stmt* stmt, const __batch_arguments* arguments, int index);
 
 /// @brief Adds query parameters for "insert_task".
 /// @param stmt The compiled SQL statement.
@@ -38,6 +895,13 @@ static bool __execute_parameterized_query(const sqlite3* db, const char* sql_que
 /// @return Zero if the operation succeeded, non-zero otherwise.
 static int __prepare_insert_query(sqlite3_stmt* stmt, va_list args, int arg_count);
 
+/// @brief Adds query parameters for the size of a zero-filled task and its creation time.
+/// @param stmt The compiled SQL statement.
+/// @param args The arguments to be added to the query.
+/// @param arg_count The amount of arguments to be added.
+/// @return Zero if the operation succeeded, non-zero otherwise.
+static int __prepare_streamed_insert_query(sqlite3_stmt* stmt, va_list args, int arg_count);
+
 /// @brief Adds a query parameters for a single int.
 /// @param stmt The compiled SQL statement.
 /// @param args The arguments to be added to the query.
@@ -60,13 +924,90 @@ static int __prepare_task_and_id_query(sqlite3_stmt* stmt, va_list args, int arg
 /// @return Zero if the operation succeeded, non-zero otherwise.
 static int __callback_count_tasks(void* custom_state, int column_amount, char** column_contents, char** column_names);
 
-/// @brief Callback that returns the result of a "SELECT tasks" query.
-/// @param custom_state db_tasks* to write the query result to.
-/// @param column_amount The amount of columns returned in the query.
-/// @param column_contents An array of strings with the content of all columns in a single row.
-/// @param column_names An array of strings with the name of all columns in a single row.
+
+/// @brief Appends a task to the specified arena, growing it if needed.
+/// @param arena The arena.
+/// @param id The ID of the task.
+/// @param task The content of the task.
+/// @param length The length of the task, without the null terminator.
+/// @return True if the task was appended, False if there was not enough memory.
+static bool __tasks_arena_append(__tasks_arena* arena, const int id, const char* task, const int length);
+
+/// @brief Reads all rows of a statement that returns "(id, task)" pairs into a "db_tasks" object.
+/// @param connection The connection the statement belongs to.
+/// @param stmt The compiled SQL statement.
+/// @return The tasks, which are empty if no rows were returned or an error occurred.
+static db_tasks __read_db_tasks(db_connection* connection, sqlite3_stmt* stmt);
+
+/// @brief Reads one page of tasks through a keyset query, which costs the same no matter how deep the page is.
+/// @param db The database.
+/// @param statement_id The page query, which takes a boundary ID and a limit.
+/// @param boundary_id The ID the page starts after or ends before.
+/// @param limit The maximum amount of tasks in the page.
+/// @return The tasks of the page, ordered by ID.
+static db_tasks __read_page(const db_handle* db, __statement_id statement_id, const int boundary_id, const int limit);
+
+/// @brief Lends a task to a visitor, from the cache or from a reader. Same as "with_task()", without recording the call.
+/// @param db The database.
+/// @param id The ID of the task.
+/// @param visitor The function that receives the ID, content and length of the task.
+/// @param custom_state Pointer to an object that's being passed into the visitor.
+/// @return True if the task was found, False otherwise.
+static bool __with_task(const db_handle* db, const int id, int (*visitor)(void*, const int, const char*, const int), void* custom_state);
+
+/// @brief Opens a cursor over every task. Same as "db_tasks_open()", without recording the call.
+/// @param db The database.
+/// @return The cursor.
+static db_tasks_cursor __open_cursor(const db_handle* db);
+
+/// @brief Appends a public call to the trace, if one is being recorded.
+/// @param db The database.
+/// @param operation The call.
+/// @param id The ID the call used or created.
+/// @param size The length of the text the call used, or its limit. Ignored if "text" isn't NULL.
+/// @param text The text the call used, which is only measured if a trace is being recorded, or NULL.
+static void __trace_call(const db_handle* db, const db_trace_operation operation, const int64_t id, const int64_t size, const char* text);
+
+/// @brief Appends a batch call to the trace, if one is being recorded.
+/// @param db The database.
+/// @param operation The call.
+/// @param ids The IDs of the batch or NULL if it doesn't take IDs.
+/// @param tasks The contents of the batch or NULL if it doesn't take contents.
+/// @param amount The amount of operations in the batch.
+static void __trace_batch_call(const db_handle* db, const db_trace_operation operation, const int* ids, const char** tasks, const int amount);
+
+/// @brief Runs a cached "(id, task)" query and lends every row to a visitor, without copying the tasks.
+/// @param connection The connection to run the query on.
+/// @param statement_id The query, which takes an ID and optionally a limit.
+/// @param id The ID to bind.
+/// @param limit The limit to bind, if the query takes one. Zero or less means no limit.
+/// @param visitor The function that receives each row. Returning non-zero stops the iteration.
+/// @param custom_state Pointer to an object that's being passed into the visitor.
+/// @return How many rows were visited or -1 if an error occurred.
+static int __visit_tasks(db_connection* connection, __statement_id statement_id, const int id, const int limit,
+    int (*visitor)(void*, const int, const char*, const int), void* custom_state);
+
+/// @brief Removes the specified tasks from the task cache of the database, if it has one.
+/// @param db The database.
+/// @param ids The IDs of the tasks.
+/// @param amount The amount of IDs.
+static void __invalidate_cached_tasks(const db_handle* db, const int* ids, const int amount);
+
+/// @brief Visitor that caches a task, then passes it on to another visitor.
+/// @param custom_state __caching_visitor_state* with the cache and the visitor.
+/// @param id The ID of the task.
+/// @param task The content of the task.
+/// @param length The length of the task, without the null terminator.
+/// @return The code returned by the wrapped visitor.
+static int __visitor_cache_task(void* custom_state, const int id, const char* task, const int length);
+
+/// @brief Visitor that copies a task into a "db_task" object.
+/// @param custom_state db_task* to write the task to.
+/// @param id The ID of the task.
+/// @param task The content of the task.
+/// @param length The length of the task, without the null terminator.
 /// @return Zero if the operation succeeded, non-zero otherwise.
-static int __callback_select_tasks(void* custom_state, int column_amount, char** column_contents, char** column_names);
+static int __visitor_copy_task(void* custom_state, const int id, const char* task, const int length);
 
 /// @brief Callback that returns the result of a parameterized "SELECT COUNT(*) tasks" query.
 /// @param custom_state int* to write the query result to.
@@ -74,19 +1015,14 @@ static int __callback_select_tasks(void* custom_state, int column_amount, char**
 /// @return Zero if the operation succeeded, non-zero otherwise.
 static int __parameterized_callback_count_tasks(void* custom_state, sqlite3_stmt* stmt);
 
-/// @brief Callback that returns the result of a parameterized "SELECT tasks" query.
-/// @param custom_state db_task* to write the query result to.
-/// @param stmt The compiled SQL statement.
-/// @return Zero if the operation succeeded, non-zero otherwise.
-static int __parameterized_callback_read_task(void* custom_state, sqlite3_stmt* stmt);
 
 /* Public Functions */
 
-const sqlite3* get_db()
+const db_handle* get_db()
 {
     const char* current_dir = get_executable_directory();
     const char* db_location = str_append(current_dir, DIRECTORY_SEPARATOR "todoc.db");
-    const sqlite3* db = create_sqlite_db(db_location);
+    const db_handle* db = create_sqlite_db(db_location);
 
     // Cleanup
     free((char*)current_dir);
@@ -95,274 +1031,2538 @@ const sqlite3* get_db()
     return db;
 }
 
-const sqlite3* create_sqlite_db(const char* db_location)
+const db_handle* create_sqlite_db(const char* db_location)
+{
+    const long processor_amount = sysconf(_SC_NPROCESSORS_ONLN);
+    return create_sqlite_db_pool(db_location, max(2, (processor_amount > 0) ? (int)processor_amount : 0));
+}
+
+const db_handle* create_sqlite_db_pool(const char* db_location, const int reader_capacity)
 {
-    if (!file_exists(db_location) || is_file_empty(db_location))
+    db_handle* db = calloc(1, sizeof(db_handle));
+    db_connection* readers = calloc(max(1, reader_capacity), sizeof(db_connection));
+
+    if (db == NULL || readers == NULL)
     {
-        if (!create_empty_file(db_location) && !__initialize_database(db_location))
-            return NULL;
+        free(db);
+        free(readers);
+
+        return NULL;
     }
 
-    sqlite3* db;
-    const int db_code = sqlite3_open(db_location, &db);
+    db->readers = readers;
+    db->reader_capacity = max(1, reader_capacity);
+    db->compression_threshold = __default_compression_threshold;
+    db->busy_policy = __default_busy_policy;
+    db->location = (char*)str_append(db_location, "");
+
+    pthread_mutex_init(&db->writer_lock, NULL);
+    pthread_mutex_init(&db->readers_lock, NULL);
+    pthread_cond_init(&db->reader_released, NULL);
+    pthread_mutex_init(&db->write_queue_lock, NULL);
+    pthread_cond_init(&db->write_queued, NULL);
+    pthread_cond_init(&db->writes_finished, NULL);
+
+    // Each connection is only used by one thread at a time, so SQLite's own locking is not needed.
+    const bool is_open = __open_connection(&db->writer, db_location, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE | SQLITE_OPEN_NOMUTEX, &db->busy_policy)
+        && __execute_query(&db->writer, "PRAGMA journal_mode = WAL;", NULL, NULL)
+        && __initialize_database(&db->writer);
+
+    if (!is_open)
+    {
+        fprintf(stderr, "Could not open database at \"%s\"" NEWLINE, db_location);
+        close_sqlite_db(db);
 
-    return (db_code == SQLITE_OK) ? db : NULL;
-}
+        return NULL;
+    }
 
-int count_tasks(const sqlite3* db)
-{
-    int task_amount = 0;
-    return (__execute_query(db, "SELECT COUNT(*) FROM tasks;", __callback_count_tasks, &task_amount))
-        ? task_amount
-        : -1;
+    return db;
 }
 
-bool task_exists(const sqlite3* db, int id)
+int get_reader_capacity(const db_handle* db)
 {
-    int task_exists = 0;
-    return (__execute_parameterized_query(db, "SELECT 1 FROM tasks WHERE id = ? LIMIT 1;", &task_exists, __parameterized_callback_count_tasks, __prepare_id_query, 1, id))
-        && task_exists;
+    return db->reader_capacity;
 }
 
-db_task get_task(const sqlite3* db, int id)
+void close_sqlite_db(const db_handle* db)
 {
-    bool exists = task_exists(db, id);
+    if (db == NULL)
+        return;
 
-    db_task db_task = {
-        .length = 0,
-        .task = NULL
-    };
+    db_handle* handle = (db_handle*)db;
 
-    if (!exists)
-        return db_task;
+    // Queued writes were acknowledged, so they must reach the database before it's closed.
+    __stop_write_thread(handle);
+    stop_trace_recording(db);
 
-    const char* sql_query = "SELECT task FROM tasks WHERE id = ?;";
-    __execute_parameterized_query(db, sql_query, &db_task, __parameterized_callback_read_task, __prepare_id_query, 1, id);
+    for (int index = 0; index < handle->reader_amount; index++)
+        __close_connection(&handle->readers[index]);
 
-    return db_task;
+    __close_connection(&handle->writer);
+
+    pthread_cond_destroy(&handle->writes_finished);
+    pthread_cond_destroy(&handle->write_queued);
+    pthread_mutex_destroy(&handle->write_queue_lock);
+    pthread_cond_destroy(&handle->reader_released);
+    pthread_mutex_destroy(&handle->readers_lock);
+    pthread_mutex_destroy(&handle->writer_lock);
+
+    free_task_cache(handle->cache);
+    free(handle->readers);
+    free(handle->location);
+    free(handle);
 }
 
-db_tasks get_all_tasks(const sqlite3* db)
+int count_tasks(const db_handle* db)
 {
-    int task_amount = count_tasks(db);
+    __trace_call(db, DB_TRACE_COUNT_TASKS, 0, 0, NULL);
 
-    db_tasks db_tasks = {
-        .amount = task_amount,
-        .task_ids = (task_amount <= 0) ? NULL : calloc(task_amount, sizeof(int)),
-        .tasks = (task_amount <= 0) ? NULL : calloc(task_amount, sizeof(char*))
-    };
+    db_connection* reader = __acquire_reader(db);
 
-    if (task_amount <= 0)
-        return db_tasks;
+    if (reader == NULL)
+        return -1;
 
-    __execute_query(db, "SELECT id, task FROM tasks;", __callback_select_tasks, &db_tasks);
-    __select_tasks_current_index = 0;
+    // The counter is updated in the same transaction as the tasks, so it's always as consistent as the rows themselves.
+    sqlite3_stmt* stmt = __get_cached_statement(reader, __STMT_COUNT_TASKS);
+    const int task_amount = (stmt != NULL && __step_statement(reader, stmt) == SQLITE_ROW) ? sqlite3_column_int(stmt, 0) : -1;
 
-    return db_tasks;
+    if (stmt == NULL || task_amount < 0)
+        fprintf(stderr, "Could not count the tasks: %s" NEWLINE, sqlite3_errmsg(reader->sqlite));
+
+    sqlite3_reset(stmt);
+    __release_reader(db, reader);
+
+    return task_amount;
 }
 
-void free_db_tasks(db_tasks* db_tasks)
+bool get_task_id_bounds(const db_handle* db, int* first_id, int* last_id)
 {
-    if (db_tasks->amount == 0)
-        return;
+    __trace_call(db, DB_TRACE_GET_TASK_ID_BOUNDS, 0, 0, NULL);
 
-    for (int counter = 0; counter < db_tasks->amount; counter++)
-        free((char*)db_tasks->tasks[counter]);
+    db_connection* reader = __acquire_reader(db);
 
-    free((int*)db_tasks->task_ids);
-    free(db_tasks->tasks);
+    if (reader == NULL)
+        return false;
 
-    // Reset the amount
-    int* amount_ptr = (int*)&db_tasks->amount;
-    *amount_ptr = 0;
+    // Both aggregates are answered from the ends of the primary key. They're NULL when the table is empty, which reads as zero.
+    sqlite3_stmt* stmt = __get_cached_statement(reader, __STMT_SELECT_ID_BOUNDS);
+    const bool success = stmt != NULL && __step_statement(reader, stmt) == SQLITE_ROW;
+
+    if (!success)
+        fprintf(stderr, "Could not find the IDs of the tasks: %s" NEWLINE, sqlite3_errmsg(reader->sqlite));
 
-    // Reset the task IDs
-    db_tasks->task_ids = NULL;
+    *first_id = (success) ? sqlite3_column_int(stmt, 0) : 0;
+    *last_id = (success) ? sqlite3_column_int(stmt, 1) : 0;
 
-    // Reset the tasks
-    db_tasks->tasks = NULL;
+    sqlite3_reset(stmt);
+    __release_reader(db, reader);
+
+    return success;
 }
 
-void free_db_task(db_task* db_task)
+bool task_exists(const db_handle* db, int id)
 {
-    if (db_task->length == 0)
-        return;
-
-    free((char*)db_task->task);
+    __trace_call(db, DB_TRACE_TASK_EXISTS, id, 0, NULL);
 
-    // Reset the length
-    int* length_ptr = (int*)&db_task->length;
-    *length_ptr = 0;
+    db_connection* reader = __acquire_reader(db);
 
-    // Reset the task.
-    db_task->task = NULL;
-}
+    if (reader == NULL)
+        return false;
 
-bool insert_task(const sqlite3* db, const char* task)
-{
-    const char* sql_query = "INSERT INTO tasks (task, created_at) VALUES (?, ?);";
-    return __execute_parameterized_query(db, sql_query, NULL, NULL, __prepare_insert_query, 2, task, get_current_time());
-}
+    int task_exists = 0;
+    const bool success = __execute_parameterized_query(reader, __STMT_TASK_EXISTS, &task_exists, __parameterized_callback_count_tasks, __prepare_id_query, 1, id);
 
-bool delete_task(const sqlite3* db, int id)
-{
-    const char* sql_query = "DELETE FROM tasks WHERE id = ?;";
-    return __execute_parameterized_query(db, sql_query, NULL, NULL, __prepare_id_query, 1, id);
-}
+    __release_reader(db, reader);
 
-bool update_task(const sqlite3* db, int id, const char* new_task)
-{
-    const char* sql_query = "UPDATE tasks SET task = ? WHERE id = ?;";
-    return __execute_parameterized_query(db, sql_query, NULL, NULL, __prepare_task_and_id_query, 2, new_task, id);
+    return success && task_exists;
 }
 
-/* Private Functions */
-
-static bool __initialize_database(const char *db_location)
+db_task get_task(const db_handle* db, int id)
 {
-    sqlite3* db;
-    const int command_code = sqlite3_open(db_location, &db);
-
-    if (command_code != SQLITE_OK)
-    {
-        fprintf(stderr, "Could not initialize database at \"%s\"" NEWLINE "Error: %s" NEWLINE, db_location, sqlite3_errmsg(db));
-        sqlite3_close(db);
+    db_task db_task = {
+        .length = 0,
+        .task = NULL
+    };
 
-        return false;
-    }
+    __trace_call(db, DB_TRACE_GET_TASK, id, 0, NULL);
 
-    const char* sql_query =
-        "CREATE TABLE tasks (               \
-            id INTEGER PRIMARY KEY,         \
-            task TEXT NOT NULL,             \
-            created_at INTEGER NOT NULL     \
-        );";
+    // A missing task simply produces no row, so there's no need to check if it exists first.
+    __with_task(db, id, __visitor_copy_task, &db_task);
 
-    bool query_success = __execute_query(db, sql_query, NULL, NULL);
+    return db_task;
+}
 
-    sqlite3_close(db);
+bool with_task(const db_handle* db, const int id, int (*visitor)(void*, const int, const char*, const int), void* custom_state)
+{
+    __trace_call(db, DB_TRACE_WITH_TASK, id, 0, NULL);
 
-    return query_success;
+    return __with_task(db, id, visitor, custom_state);
 }
 
-static bool __execute_query(const sqlite3* db, const char* sql_query, int (*callback)(void*, int, char**, char**), void* custom_state)
+int for_each_task(const db_handle* db, const int after_id, const int limit, int (*visitor)(void*, const int, const char*, const int), void* custom_state)
 {
-    char* err_msg = NULL;
-    const int command_code = sqlite3_exec((sqlite3*)db, sql_query, callback, custom_state, &err_msg);
+    __trace_call(db, DB_TRACE_FOR_EACH_TASK, after_id, limit, NULL);
 
-    if (command_code == SQLITE_OK)
-        return true;
+    db_connection* reader = __acquire_reader(db);
 
-    fprintf(stderr, "SQLite query error: %s" NEWLINE, err_msg);
-    sqlite3_free(err_msg);
+    if (reader == NULL)
+        return -1;
 
-    return false;
+    const int visited_amount = __visit_tasks(reader, __STMT_SELECT_PAGE_AFTER, after_id, limit, visitor, custom_state);
+
+    __release_reader(db, reader);
+
+    return visited_amount;
 }
 
-static bool __execute_parameterized_query(const sqlite3* db, const char* sql_query, void* custom_state, int (*read_callback)(void*, sqlite3_stmt*),
-    int (*query_callback)(sqlite3_stmt*, va_list, int), int arg_count, ...)
+int read_task_part(const db_handle* db, const int after_id, const long offset, char* buffer, const int capacity, int* id, long* length)
 {
-    sqlite3_stmt* stmt = NULL;
-    va_list args;
+    __trace_call(db, DB_TRACE_READ_TASK_PART, after_id, capacity, NULL);
 
-    va_start(args, arg_count);
-
-    int db_code = sqlite3_prepare_v2((sqlite3*)db, sql_query, -1, &stmt, NULL)  // Prepare the database for a parameterized query.
-        || query_callback(stmt, args, arg_count);                               // Add the arguments.
+    db_connection* reader = __acquire_reader(db);
+    sqlite3_stmt* stmt = (reader == NULL) ? NULL : __get_cached_statement(reader, __STMT_SELECT_NEXT_TASK_TYPE);
+    sqlite3_blob* blob = NULL;
+    int part_length = -1;
 
-    va_end(args);
+    // The statement stays on its row until the blob is read, so both see the same version of the task.
+    const bool is_found = stmt != NULL && offset >= 0 && capacity >= 0
+        && sqlite3_bind_int(stmt, 1, after_id) == SQLITE_OK
+        && __step_statement(reader, stmt) == SQLITE_ROW;
 
-    if (db_code != SQLITE_OK)
+    if (is_found)
     {
-        fprintf(stderr, "Query parametization failed: %s" NEWLINE, sqlite3_errmsg((sqlite3*)db));
-        return false;
+        *id = sqlite3_column_int(stmt, 0);
+
+        if (sqlite3_blob_open(reader->sqlite, "main", "tasks", "task", *id, 0, &blob) == SQLITE_OK)
+            part_length = __read_blob_part(reader, blob, sqlite3_column_int(stmt, 1), offset, buffer, capacity, length);
+        else
+            fprintf(stderr, "Could not read the task with ID %d: %s" NEWLINE, *id, sqlite3_errmsg(reader->sqlite));
     }
 
-    // Execute the query.
-    if (read_callback == NULL)
+    // Cleanup
+    sqlite3_blob_close(blob);
+
+    if (stmt != NULL)
     {
-        do
-        {
-            db_code = sqlite3_step(stmt);
-        } while (db_code == SQLITE_ROW);
+        sqlite3_reset(stmt);
+        sqlite3_clear_bindings(stmt);
     }
-    else
-    {
-        db_code = sqlite3_step(stmt);
-        while (db_code == SQLITE_ROW)
-        {
-            int callback_code = read_callback(custom_state, stmt);
-            
-            if (callback_code != 0)
-            {
-                sqlite3_finalize(stmt);
-                fprintf(stderr, "Read callback returned error %d" NEWLINE, callback_code);
 
-                return false;
-            }
+    if (reader != NULL)
+        __release_reader(db, reader);
 
-            db_code = sqlite3_step(stmt);
-        }
-    }
+    return part_length;
+}
+
+int find_previous_page(const db_handle* db, const int first_id, const int limit)
+{
+    __trace_call(db, DB_TRACE_FIND_PREVIOUS_PAGE, first_id, limit, NULL);
 
-    // Clean up
-    sqlite3_finalize(stmt);
+    db_connection* reader = __acquire_reader(db);
+    sqlite3_stmt* stmt = (reader == NULL) ? NULL : __get_cached_statement(reader, __STMT_SELECT_PREVIOUS_PAGE);
+    int after_id = -1;
 
-    if (db_code != SQLITE_DONE)
+    const bool is_bound = stmt != NULL && limit > 0
+        && sqlite3_bind_int(stmt, 1, first_id) == SQLITE_OK    // Add the 'id' the page must end before.
+        && sqlite3_bind_int(stmt, 2, limit) == SQLITE_OK;      // Add the limit.
+
+    // The aggregate is NULL when there are no tasks before "first_id".
+    if (is_bound && __step_statement(reader, stmt) == SQLITE_ROW && sqlite3_column_type(stmt, 0) != SQLITE_NULL)
+        after_id = sqlite3_column_int(stmt, 0);
+
+    // Cleanup
+    if (stmt != NULL)
     {
-        fprintf(stderr, "SQLite query error: %s" NEWLINE, sqlite3_errmsg((sqlite3*)db));
-        return false;
+        sqlite3_reset(stmt);
+        sqlite3_clear_bindings(stmt);
     }
 
-    return true;
-}
+    if (reader != NULL)
+        __release_reader(db, reader);
 
-static int __prepare_insert_query(sqlite3_stmt* stmt, va_list args, int arg_count)
-{
-    UNUSED(arg_count);
-    return sqlite3_bind_text(stmt, 1, va_arg(args, char*), -1, SQLITE_STATIC)   // Add 'task'.
-        || sqlite3_bind_int64(stmt, 2, va_arg(args, time_t));                   // Add 'created_at'.
+    return after_id;
 }
 
-static int __prepare_id_query(sqlite3_stmt* stmt, va_list args, int arg_count)
+db_tasks get_all_tasks(const db_handle* db)
 {
-    UNUSED(arg_count);
-    return sqlite3_bind_int(stmt, 1, va_arg(args, int));    // Add 'id'.
+    __trace_call(db, DB_TRACE_GET_ALL_TASKS, 0, 0, NULL);
+
+    db_tasks_cursor cursor = __open_cursor(db);
+    db_tasks db_tasks = __read_db_tasks(cursor.connection, cursor.stmt);
+
+    db_tasks_close(&cursor);
+
+    return db_tasks;
 }
 
-static int __prepare_task_and_id_query(sqlite3_stmt* stmt, va_list args, int arg_count)
+db_tasks get_tasks_page(const db_handle* db, const int after_id, const int limit)
 {
-    UNUSED(arg_count);
-    return sqlite3_bind_text(stmt, 1, va_arg(args, char*), -1, SQLITE_STATIC)   // Add 'new_task'.
-        || sqlite3_bind_int(stmt, 2, va_arg(args, int));                        // Add 'id'.
-}
+    __trace_call(db, DB_TRACE_GET_TASKS_PAGE, after_id, limit, NULL);
 
-/* Private Functions - Callbacks */
+    return __read_page(db, __STMT_SELECT_PAGE_AFTER, after_id, limit);
+}
 
-static int __callback_count_tasks(void* custom_state, int column_amount, char** column_contents, char** column_names)
+db_tasks get_tasks_page_before(const db_handle* db, const int before_id, const int limit)
 {
-    UNUSED(column_amount, column_names);
+    __trace_call(db, DB_TRACE_GET_TASKS_PAGE_BEFORE, before_id, limit, NULL);
 
-    *((int*)custom_state) = atoi(column_contents[0]);
-    return 0;
+    return __read_page(db, __STMT_SELECT_PAGE_BEFORE, before_id, limit);
 }
 
-static int __callback_select_tasks(void* custom_state, int column_amount, char** column_contents, char** column_names)
+db_tasks get_tasks_between(const db_handle* db, const time_t from, const time_t to)
 {
-    UNUSED(column_amount, column_names);
-
-    db_tasks* db_tasks = custom_state;
+    __trace_call(db, DB_TRACE_GET_TASKS_BETWEEN, from, to - from, NULL);
 
-    // Set the array of ids.
-    ((int*)db_tasks->task_ids)[__select_tasks_current_index] = atoi(column_contents[0]);
+    db_connection* reader = __acquire_reader(db);
+    sqlite3_stmt* stmt = (reader == NULL) ? NULL : __get_cached_statement(reader, __STMT_SELECT_TASKS_BETWEEN);
 
-    // Set the array of strings.
-    const int task_length = strlen(column_contents[1]) + 1;
-    char* content_copy = malloc(task_length);
-    db_tasks->tasks[__select_tasks_current_index++] = content_copy;
+    const bool is_bound = stmt != NULL
+        && sqlite3_bind_int64(stmt, 1, from) == SQLITE_OK   // Add 'from'.
+        && sqlite3_bind_int64(stmt, 2, to) == SQLITE_OK;    // Add 'to'.
 
-    strcpy(content_copy, column_contents[1]);
+    db_tasks db_tasks = __read_db_tasks(reader, (is_bound) ? stmt : NULL);
 
+    // Cleanup
+    if (stmt != NULL)
+    {
+        sqlite3_reset(stmt);
+        sqlite3_clear_bindings(stmt);
+    }
+
+    if (reader != NULL)
+        __release_reader(db, reader);
+
+    return db_tasks;
+}
+
+db_tasks search_tasks(const db_handle* db, const char* query, const int limit)
+{
+    __trace_call(db, DB_TRACE_SEARCH_TASKS, limit, 0, query);
+
+    char* match_query = __build_match_query(query);
+    db_connection* reader = (match_query == NULL) ? NULL : __acquire_reader(db);
+    sqlite3_stmt* stmt = (reader == NULL) ? NULL : __get_cached_statement(reader, __STMT_SEARCH_TASKS);
+
+    const bool is_bound = stmt != NULL
+        && sqlite3_bind_text(stmt, 1, match_query, -1, SQLITE_STATIC) == SQLITE_OK   // Add the query.
+        && sqlite3_bind_int(stmt, 2, (limit > 0) ? limit : -1) == SQLITE_OK;        // Add the limit. Negative means no limit.
+
+    db_tasks db_tasks = __read_db_tasks(reader, (is_bound) ? stmt : NULL);
+
+    // Cleanup
+    if (stmt != NULL)
+    {
+        sqlite3_reset(stmt);
+        sqlite3_clear_bindings(stmt);
+    }
+
+    if (reader != NULL)
+        __release_reader(db, reader);
+
+    free(match_query);
+
+    return db_tasks;
+}
+
+const char* db_tasks_get(const db_tasks* db_tasks, const int index)
+{
+    return db_tasks->arena + db_tasks->entries[index].offset;
+}
+
+db_tasks_cursor db_tasks_open(const db_handle* db)
+{
+    __trace_call(db, DB_TRACE_OPEN_CURSOR, 0, 0, NULL);
+
+    return __open_cursor(db);
+}
+
+bool db_tasks_next(db_tasks_cursor* cursor)
+{
+    if (cursor->stmt == NULL)
+        return false;
+
+    const int db_code = __step_statement(cursor->connection, cursor->stmt);
+
+    if (db_code != SQLITE_ROW)
+    {
+        if (db_code != SQLITE_DONE)
+        {
+            fprintf(stderr, "SQLite query error: %s" NEWLINE, sqlite3_errmsg(sqlite3_db_handle(cursor->stmt)));
+            bool* failed_ptr = (bool*)&cursor->failed;
+            *failed_ptr = true;
+        }
+
+        cursor->task = NULL;
+        return false;
+    }
+
+    // Set the ID.
+    int* id_ptr = (int*)&cursor->id;
+    *id_ptr = sqlite3_column_int(cursor->stmt, 0);
+
+    // Set the creation time.
+    time_t* created_at_ptr = (time_t*)&cursor->created_at;
+    *created_at_ptr = sqlite3_column_int64(cursor->stmt, 2);
+
+    // Set the task and its length.
+    int* length_ptr = (int*)&cursor->length;
+    cursor->task = __read_task_column(cursor->connection, cursor->stmt, 1, length_ptr);
+
+    if (cursor->task == NULL)
+    {
+        fprintf(stderr, "Task of ID %d is corrupted" NEWLINE, cursor->id);
+        bool* failed_ptr = (bool*)&cursor->failed;
+        *failed_ptr = true;
+
+        return false;
+    }
+
+    return true;
+}
+
+void db_tasks_close(db_tasks_cursor* cursor)
+{
+    // The statement stays cached in its connection for the next cursor.
+    if (cursor->stmt != NULL)
+        sqlite3_reset(cursor->stmt);
+
+    if (cursor->connection != NULL)
+        __release_reader(cursor->db, cursor->connection);
+
+    cursor->stmt = NULL;
+    cursor->connection = NULL;
+    cursor->task = NULL;
+}
+
+void free_db_tasks(db_tasks* db_tasks)
+{
+    if (db_tasks->amount == 0)
+        return;
+
+    free((db_tasks_entry*)db_tasks->entries);
+    free((char*)db_tasks->arena);
+
+    // Reset the amount
+    int* amount_ptr = (int*)&db_tasks->amount;
+    *amount_ptr = 0;
+
+    // Reset the entries
+    db_tasks->entries = NULL;
+
+    // Reset the arena
+    db_tasks->arena = NULL;
+}
+
+void free_db_task(db_task* db_task)
+{
+    if (db_task->length == 0)
+        return;
+
+    free((char*)db_task->task);
+
+    // Reset the length
+    int* length_ptr = (int*)&db_task->length;
+    *length_ptr = 0;
+
+    // Reset the task.
+    db_task->task = NULL;
+}
+
+bool insert_task(const db_handle* db, const char* task)
+{
+    return add_task(db, task) > 0;
+}
+
+int add_task(const db_handle* db, const char* task)
+{
+    db_connection* writer = __acquire_writer(db);
+    const __encoded_task encoded_task = __encode_task(db, task);
+    const bool success = __execute_parameterized_query(writer, __STMT_INSERT_TASK, NULL, NULL, __prepare_insert_query, 2, &encoded_task, get_current_time());
+    const int id = (success) ? (int)sqlite3_last_insert_rowid(writer->sqlite) : -1;
+
+    // New tasks are usually read right after being written.
+    if (success && db->cache != NULL)
+        task_cache_store(db->cache, id, task, strlen(task));
+
+    __release_writer(db);
+
+    // Recorded once the ID is known, so a replay can match it to the ID its own insert gets.
+    __trace_call(db, DB_TRACE_ADD_TASK, id, 0, task);
+
+    return id;
+}
+
+int add_task_from_fd(const db_handle* db, const int fd)
+{
+    char* chunk = malloc(__stream_chunk_size + 1);
+    unsigned char* frame = malloc(__frame_header_length + lz_compress_bound(__stream_chunk_size));
+    size_t chunk_length = 0;
+    int id = -1, error_code = ENOMEM;
+
+    if (chunk != NULL && frame != NULL)
+        error_code = (__read_chunk(fd, chunk, __stream_chunk_size, &chunk_length)) ? EXIT_SUCCESS : EIO;
+
+    if (error_code == EXIT_SUCCESS && memchr(chunk, '\0', chunk_length) != NULL)
+        error_code = EILSEQ;
+    else if (error_code == EXIT_SUCCESS && chunk_length < __stream_chunk_size && __is_blank(chunk, chunk_length))
+        error_code = ENODATA;
+    else if (error_code == EXIT_SUCCESS && chunk_length < __stream_chunk_size)
+    {
+        // Tasks that fit in a single chunk are already in memory, so they take the usual path.
+        chunk[chunk_length] = '\0';
+        id = add_task(db, chunk);
+        error_code = (id < 0) ? EIO : EXIT_SUCCESS;
+    }
+    else if (error_code == EXIT_SUCCESS)
+        id = __add_streamed_task(db, fd, chunk, chunk_length, frame, &error_code);
+
+    free(chunk);
+    free(frame);
+
+    if (id < 0)
+        errno = error_code;
+
+    return id;
+}
+
+bool delete_task(const db_handle* db, int id)
+{
+    __trace_call(db, DB_TRACE_DELETE_TASK, id, 0, NULL);
+
+    db_connection* writer = __acquire_writer(db);
+    const bool success = __execute_parameterized_query(writer, __STMT_DELETE_TASK, NULL, NULL, __prepare_id_query, 1, id);
+
+    if (success && db->cache != NULL)
+        task_cache_remove(db->cache, id);
+
+    __release_writer(db);
+
+    return success;
+}
+
+bool update_task(const db_handle* db, int id, const char* new_task)
+{
+    __trace_call(db, DB_TRACE_UPDATE_TASK, id, 0, new_task);
+
+    db_connection* writer = __acquire_writer(db);
+    const __encoded_task encoded_task = __encode_task(db, new_task);
+    const bool success = __execute_parameterized_query(writer, __STMT_UPDATE_TASK, NULL, NULL, __prepare_task_and_id_query, 2, &encoded_task, id);
+
+    if (success && db->cache != NULL && sqlite3_changes(writer->sqlite) > 0)
+        task_cache_store(db->cache, id, new_task, strlen(new_task));
+
+    __release_writer(db);
+
+    return success;
+}
+
+bool set_task_cache_budget(const db_handle* db, const size_t byte_budget)
+{
+    db_handle* handle = (db_handle*)db;
+    task_cache* cache = NULL;
+
+    if (byte_budget > 0 && (cache = create_task_cache(byte_budget)) == NULL)
+        return false;
+
+    free_task_cache(handle->cache);
+    handle->cache = cache;
+
+    return true;
+}
+
+task_cache_stats get_task_cache_stats(const db_handle* db)
+{
+    if (db->cache != NULL)
+        return task_cache_get_stats(db->cache);
+
+    const task_cache_stats empty_stats = { 0 };
+    return empty_stats;
+}
+
+db_query_stats get_query_stats(const db_handle* db)
+{
+    db_handle* handle = (db_handle*)db;
+    db_query_stats stats = { 0 };
+
+    for (int kind = 0; kind < __QUERY_KIND_AMOUNT; kind++)
+        stats.queries[kind].name = __query_names[kind];
+
+    __sum_query_counters(&stats, &handle->writer);
+
+    // Readers are only ever added, so the ones counted here stay valid after unlocking.
+    pthread_mutex_lock(&handle->readers_lock);
+    const int reader_amount = handle->reader_amount;
+    pthread_mutex_unlock(&handle->readers_lock);
+
+    for (int index = 0; index < reader_amount; index++)
+        __sum_query_counters(&stats, &handle->readers[index]);
+
+    return stats;
+}
+
+bool save_query_stats(const db_handle* db, const char* stats_location)
+{
+    FILE* file = fopen(stats_location, "w");
+
+    if (file == NULL)
+    {
+        fprintf(stderr, "Could not open the statistics file: %s" NEWLINE, strerror(errno));
+        return false;
+    }
+
+    const db_query_stats stats = get_query_stats(db);
+    const task_cache_stats cache_stats = get_task_cache_stats(db);
+    bool is_first = true;
+
+    fputs("{\"queries\":[", file);
+
+    for (int kind = 0; kind < DB_QUERY_KIND_AMOUNT; kind++)
+    {
+        const db_query_counters* counters = &stats.queries[kind];
+
+        if (counters->calls == 0 && counters->prepares == 0)
+            continue;
+
+        fprintf(file, "%s{\"name\":\"%s\",\"calls\":%lu,\"rows\":%lu,\"bytes\":%lu,\"total_us\":%.1f,\"mean_us\":%.2f,"
+            "\"max_us\":%.1f,\"prepares\":%lu,\"prepare_us\":%.1f}",
+            (is_first) ? "" : ",", counters->name, counters->calls, counters->rows, counters->bytes,
+            counters->total_ns / 1000.0, (counters->calls == 0) ? 0.0 : counters->total_ns / 1000.0 / counters->calls,
+            counters->max_ns / 1000.0, counters->prepares, counters->prepare_ns / 1000.0);
+
+        is_first = false;
+    }
+
+    fprintf(file, "],\"task_cache\":{\"hits\":%lu,\"misses\":%lu,\"evictions\":%lu}}\n",
+        cache_stats.hits, cache_stats.misses, cache_stats.evictions);
+
+    const bool success = !ferror(file);
+
+    if (fclose(file) != 0 || !success)
+    {
+        fprintf(stderr, "Could not write the statistics file." NEWLINE);
+        return false;
+    }
+
+    return true;
+}
+
+void set_slow_query_threshold(const db_handle* db, const int threshold_ms)
+{
+    __atomic_store_n(&((db_handle*)db)->slow_query_ms, threshold_ms, __ATOMIC_RELAXED);
+}
+
+bool start_trace_recording(const db_handle* db, const char* trace_location)
+{
+    db_handle* handle = (db_handle*)db;
+    db_trace_recorder* no_recorder = NULL;
+
+    if (__atomic_load_n(&handle->trace_recorder, __ATOMIC_ACQUIRE) != NULL)
+        return false;
+
+    db_trace_recorder* recorder = create_trace_recorder(trace_location);
+
+    // Other threads may be calling the database, so the recorder is only published once it's complete, and only once.
+    if (recorder != NULL && !__atomic_compare_exchange_n(&handle->trace_recorder, &no_recorder, recorder, false, __ATOMIC_RELEASE, __ATOMIC_RELAXED))
+    {
+        close_trace_recorder(recorder);
+        return false;
+    }
+
+    return recorder != NULL;
+}
+
+bool stop_trace_recording(const db_handle* db)
+{
+    db_handle* handle = (db_handle*)db;
+    db_trace_recorder* recorder = __atomic_exchange_n(&handle->trace_recorder, NULL, __ATOMIC_ACQ_REL);
+
+    return close_trace_recorder(recorder);
+}
+
+void set_compression_threshold(const db_handle* db, const size_t threshold)
+{
+    ((db_handle*)db)->compression_threshold = threshold;
+}
+
+bool register_task_functions(sqlite3* sqlite)
+{
+    // "task_index_text()" isn't deterministic, since it depends on whether a streamed task is being inserted.
+    return sqlite3_create_function_v2(sqlite, "task_text", 1, SQLITE_UTF8 | SQLITE_DETERMINISTIC | SQLITE_INNOCUOUS,
+            NULL, __sql_task_text, NULL, NULL, NULL) == SQLITE_OK
+        && sqlite3_create_function_v2(sqlite, "task_index_text", 1, SQLITE_UTF8 | SQLITE_INNOCUOUS,
+            NULL, __sql_task_index_text, NULL, NULL, NULL) == SQLITE_OK;
+}
+
+void set_busy_policy(const db_handle* db, const db_busy_policy policy)
+{
+    ((db_handle*)db)->busy_policy = policy;
+}
+
+void set_batch_chunk_size(const db_handle* db, const int chunk_size)
+{
+    ((db_handle*)db)->batch_chunk_size = chunk_size;
+}
+
+int insert_tasks(const db_handle* db, const char** tasks, const int amount, bool* results)
+{
+    const __batch_arguments arguments = { .db = db, .ids = NULL, .tasks = tasks, .created_at = get_current_time() };
+
+    __trace_batch_call(db, DB_TRACE_INSERT_TASKS, NULL, tasks, amount);
+
+    return __execute_writer_batch(db, __STMT_INSERT_TASK, amount, results, __bind_batch_insert, &arguments);
+}
+
+int delete_tasks(const db_handle* db, const int* ids, const int amount, bool* results)
+{
+    const __batch_arguments arguments = { .db = db, .ids = ids, .tasks = NULL, .created_at = 0 };
+
+    __trace_batch_call(db, DB_TRACE_DELETE_TASKS, ids, NULL, amount);
+
+    const int applied_amount = __execute_writer_batch(db, __STMT_DELETE_TASK, amount, results, __bind_batch_id, &arguments);
+
+    __invalidate_cached_tasks(db, ids, amount);
+
+    return applied_amount;
+}
+
+int update_tasks(const db_handle* db, const int* ids, const char** new_tasks, const int amount, bool* results)
+{
+    const __batch_arguments arguments = { .db = db, .ids = ids, .tasks = new_tasks, .created_at = 0 };
+
+    __trace_batch_call(db, DB_TRACE_UPDATE_TASKS, ids, new_tasks, amount);
+
+    const int applied_amount = __execute_writer_batch(db, __STMT_UPDATE_TASK, amount, results, __bind_batch_update, &arguments);
+
+    __invalidate_cached_tasks(db, ids, amount);
+
+    return applied_amount;
+}
+
+int restore_tasks(const db_handle* db, const int* ids, const char** tasks, const time_t* created_at, const int amount, bool* results)
+{
+    const __batch_arguments arguments = { .db = db, .ids = ids, .tasks = tasks, .created_at = 0, .restored_created_at = created_at };
+
+    __trace_batch_call(db, DB_TRACE_RESTORE_TASKS, ids, tasks, amount);
+
+    const int applied_amount = __execute_writer_batch(db, __STMT_RESTORE_TASK, amount, results, __bind_batch_restore, &arguments);
+
+    __invalidate_cached_tasks(db, ids, amount);
+
+    return applied_amount;
+}
+
+bool insert_task_async(const db_handle* db, const char* task, void (*callback)(void*, const bool, const int), void* custom_state)
+{
+    // The ID is only known once the writer commits, so the trace pairs the call and its commit by number instead.
+    const int64_t insert_number = __atomic_add_fetch(&((db_handle*)db)->queued_insert_amount, 1, __ATOMIC_RELAXED);
+
+    __trace_call(db, DB_TRACE_INSERT_TASK_ASYNC, insert_number, 0, task);
+
+    return __enqueue_write(db, __STMT_INSERT_TASK, 0, insert_number, task, callback, custom_state);
+}
+
+bool delete_task_async(const db_handle* db, const int id, void (*callback)(void*, const bool, const int), void* custom_state)
+{
+    __trace_call(db, DB_TRACE_DELETE_TASK_ASYNC, id, 0, NULL);
+
+    return __enqueue_write(db, __STMT_DELETE_TASK, id, 0, NULL, callback, custom_state);
+}
+
+bool update_task_async(const db_handle* db, const int id, const char* new_task, void (*callback)(void*, const bool, const int), void* custom_state)
+{
+    __trace_call(db, DB_TRACE_UPDATE_TASK_ASYNC, id, 0, new_task);
+
+    return __enqueue_write(db, __STMT_UPDATE_TASK, id, 0, new_task, callback, custom_state);
+}
+
+bool flush_writes(const db_handle* db)
+{
+    db_handle* handle = (db_handle*)db;
+
+    __trace_call(db, DB_TRACE_FLUSH_WRITES, 0, 0, NULL);
+
+    pthread_mutex_lock(&handle->write_queue_lock);
+
+    while (handle->pending_write_amount > 0)
+        pthread_cond_wait(&handle->writes_finished, &handle->write_queue_lock);
+
+    const bool success = handle->failed_write_amount == 0;
+    handle->failed_write_amount = 0;
+
+    pthread_mutex_unlock(&handle->write_queue_lock);
+
+    return success;
+}
+
+bool backup_sqlite_db(const db_handle* db, const char* backup_location, const int pages_per_step, const int step_pause_ms,
+    int (*progress)(void*, const int, const int), void* custom_state)
+{
+    const char* temporary_location = str_append(backup_location, ".tmp");
+    const struct timespec step_pause = { .tv_sec = step_pause_ms / 1000, .tv_nsec = (step_pause_ms % 1000) * 1000000L };
+    db_connection destination = { 0 };
+    int status_code;
+
+    // A leftover from an interrupted backup would otherwise be opened as the destination.
+    remove(temporary_location);
+
+    // The copy only replaces the backup once it's complete, so it needs no journal. It's synced once at the end,
+    // outside the writer, instead of by the last step.
+    if (sqlite3_open_v2(temporary_location, &destination.sqlite, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE, NULL) != SQLITE_OK
+        || !__execute_query(&destination, "PRAGMA journal_mode = OFF; PRAGMA synchronous = OFF;", NULL, NULL))
+    {
+        fprintf(stderr, "Could not create the backup file: %s" NEWLINE, sqlite3_errmsg(destination.sqlite));
+        sqlite3_close(destination.sqlite);
+        free((char*)temporary_location);
+
+        return false;
+    }
+
+    // The writer is the source, so the backup picks up its writes between steps instead of restarting.
+    db_connection* writer = __acquire_writer(db);
+    sqlite3_backup* backup = sqlite3_backup_init(destination.sqlite, "main", writer->sqlite, "main");
+    __release_writer(db);
+
+    if (backup == NULL)
+        status_code = sqlite3_errcode(destination.sqlite);
+    else
+    {
+        do
+        {
+            __acquire_writer(db);
+            status_code = sqlite3_backup_step(backup, (pages_per_step > 0) ? pages_per_step : -1);
+            const int remaining_pages = sqlite3_backup_remaining(backup);
+            const int total_pages = sqlite3_backup_pagecount(backup);
+            __release_writer(db);
+
+            if (status_code != SQLITE_OK && status_code != SQLITE_DONE && status_code != SQLITE_BUSY && status_code != SQLITE_LOCKED)
+                break;
+
+            if (progress != NULL && progress(custom_state, total_pages - remaining_pages, total_pages) != 0)
+            {
+                status_code = SQLITE_INTERRUPT;
+                break;
+            }
+
+            // Give the writer and the readers room to run before copying the next pages.
+            if (status_code != SQLITE_DONE)
+                nanosleep(&step_pause, NULL);
+        } while (status_code != SQLITE_DONE);
+
+        // Finishing releases the source, so it must be serialized with the writer too.
+        __acquire_writer(db);
+        sqlite3_backup_finish(backup);
+        __release_writer(db);
+    }
+
+    if (status_code != SQLITE_DONE && status_code != SQLITE_INTERRUPT)
+        fprintf(stderr, "Could not back up the database: %s" NEWLINE, sqlite3_errstr(status_code));
+
+    const int file_descriptor = (sqlite3_close(destination.sqlite) == SQLITE_OK && status_code == SQLITE_DONE)
+        ? open(temporary_location, O_RDWR)
+        : -1;
+
+    bool success = file_descriptor >= 0 && fsync(file_descriptor) == 0;
+
+    if (file_descriptor >= 0 && close(file_descriptor) != 0)
+        success = false;
+
+    success = success && rename(temporary_location, backup_location) == 0;
+
+    if (!success)
+        remove(temporary_location);
+
+    free((char*)temporary_location);
+
+    return success;
+}
+
+/* Private Functions */
+
+static bool __initialize_database(db_connection* connection)
+{
+    int version = 0;
+
+    if (!__execute_query(connection, "PRAGMA user_version;", __callback_count_tasks, &version))
+        return false;
+
+    if (version > __schema_version)
+    {
+        fprintf(stderr, "The database has schema version %d, but this program only supports up to version %d." NEWLINE, version, __schema_version);
+        return false;
+    }
+
+    for (; version < __schema_version; version++)
+    {
+        if (!__apply_migration(connection, version))
+            return false;
+    }
+
+    return true;
+}
+
+static bool __apply_migration(db_connection* connection, const int version)
+{
+    char sql_query[64];
+    int current_version = 0;
+
+    // The version is checked again inside the transaction, in case another process migrated the database first.
+    bool success = __execute_query(connection, "BEGIN IMMEDIATE;", NULL, NULL)
+        && __execute_query(connection, "PRAGMA user_version;", __callback_count_tasks, &current_version);
+
+    if (success && current_version == version)
+    {
+        snprintf(sql_query, sizeof(sql_query), "PRAGMA user_version = %d;", version + 1);
+
+        success = __execute_query(connection, __migrations[version], NULL, NULL)
+            && __execute_query(connection, sql_query, NULL, NULL);
+    }
+
+    if (success && __execute_query(connection, "COMMIT;", NULL, NULL))
+        return true;
+
+    fprintf(stderr, "Could not migrate the database to schema version %d." NEWLINE, version + 1);
+
+    if (sqlite3_get_autocommit(connection->sqlite) == 0)
+        __execute_query(connection, "ROLLBACK;", NULL, NULL);
+
+    return false;
+}
+
+static char* __build_match_query(const char* query)
+{
+    if (query == NULL)
+        return NULL;
+
+    // Worst case: single-character words that each get a separator, two quotes and a wildcard.
+    const size_t query_length = strlen(query);
+    char* match_query = malloc(query_length * 4 + 5);
+    size_t position = 0;
+
+    if (match_query == NULL)
+        return NULL;
+
+    for (size_t index = 0; index < query_length;)
+    {
+        // Skip the whitespace between words.
+        while (index < query_length && strchr(" \t\r\n", query[index]) != NULL)
+            index++;
+
+        if (index == query_length)
+            break;
+
+        // Quote the word so FTS5 operators typed by the user are matched literally, then match it as a prefix.
+        if (position != 0)
+            match_query[position++] = ' ';
+
+        match_query[position++] = '"';
+
+        while (index < query_length && strchr(" \t\r\n", query[index]) == NULL)
+        {
+            if (query[index] == '"')
+                match_query[position++] = '"';
+
+            match_query[position++] = query[index++];
+        }
+
+        match_query[position++] = '"';
+        match_query[position++] = '*';
+    }
+
+    if (position == 0)
+    {
+        free(match_query);
+        return NULL;
+    }
+
+    match_query[position] = '\0';
+
+    return match_query;
+}
+
+static char* __reserve_scratch(db_connection* connection, const size_t capacity)
+{
+    if (capacity <= connection->scratch_capacity)
+        return connection->scratch;
+
+    size_t new_capacity = (connection->scratch_capacity == 0) ? 4096 : connection->scratch_capacity;
+
+    while (new_capacity < capacity)
+        new_capacity *= 2;
+
+    char* scratch = realloc(connection->scratch, new_capacity);
+
+    if (scratch == NULL)
+        return NULL;
+
+    connection->scratch = scratch;
+    connection->scratch_capacity = new_capacity;
+
+    return scratch;
+}
+
+static __encoded_task __encode_task(const db_handle* db, const char* task)
+{
+    const size_t task_length = strlen(task);
+    __encoded_task encoded_task = { .data = task, .length = (int)task_length, .is_compressed = false };
+
+    if (db->compression_threshold == 0 || task_length < db->compression_threshold || task_length > UINT32_MAX)
+        return encoded_task;
+
+    // Tasks longer than a chunk are compressed a chunk at a time, so part of them can be read without decompressing the rest.
+    const bool is_framed = task_length > __stream_chunk_size;
+    const size_t frame_amount = (task_length + __stream_chunk_size - 1) / __stream_chunk_size;
+    const size_t body_capacity = __compressed_header_length + ((is_framed)
+        ? frame_amount * (__frame_header_length + lz_compress_bound(__stream_chunk_size))
+        : lz_compress_bound(task_length));
+
+    db_connection* writer = &((db_handle*)db)->writer;
+    unsigned char* body = (unsigned char*)__reserve_scratch(writer, body_capacity);
+
+    if (body == NULL)
+        return encoded_task;
+
+    size_t body_length = __compressed_header_length;
+
+    if (!is_framed)
+        body_length += lz_compress(task, task_length, (char*)body + __compressed_header_length);
+
+    for (size_t position = 0; is_framed && position < task_length; position += __stream_chunk_size)
+    {
+        const size_t chunk_length = (task_length - position < __stream_chunk_size) ? task_length - position : __stream_chunk_size;
+        body_length += __encode_frame(task + position, chunk_length, body + body_length, true);
+    }
+
+    // Tasks that don't shrink are stored as they are, so reading them stays free.
+    if (body_length >= task_length)
+        return encoded_task;
+
+    body[0] = (is_framed) ? __codec_lz_framed : __codec_lz;
+    __write_uint32(body + 1, (uint32_t)task_length);
+
+    encoded_task.data = body;
+    encoded_task.length = (int)body_length;
+    encoded_task.is_compressed = true;
+
+    return encoded_task;
+}
+
+static int __bind_encoded_task(sqlite3_stmt* stmt, const int index, const __encoded_task* encoded_task)
+{
+    return (encoded_task->is_compressed)
+        ? sqlite3_bind_blob(stmt, index, encoded_task->data, encoded_task->length, SQLITE_STATIC)
+        : sqlite3_bind_text(stmt, index, encoded_task->data, encoded_task->length, SQLITE_STATIC);
+}
+
+static long __compressed_task_length(const unsigned char* body, const int body_length)
+{
+    if (body == NULL || body_length < __compressed_header_length || (body[0] != __codec_lz && body[0] != __codec_lz_framed))
+        return -1;
+
+    return (long)__read_uint32(body + 1);
+}
+
+static bool __decompress_task(const unsigned char* body, const int body_length, char* task, const long task_length)
+{
+    if (body[0] == __codec_lz)
+        return lz_decompress((const char*)body + __compressed_header_length, body_length - __compressed_header_length, task, task_length);
+
+    long position = __compressed_header_length, written_length = 0;
+
+    while (position < body_length)
+    {
+        if (body_length - position < __frame_header_length)
+            return false;
+
+        const long chunk_length = __read_uint32(body + position);
+        const long stored_length = __read_uint32(body + position + 4);
+        const unsigned char* data = body + position + __frame_header_length;
+
+        position += __frame_header_length + stored_length;
+
+        if (position > body_length || chunk_length > task_length - written_length)
+            return false;
+
+        if (stored_length == chunk_length)
+            memcpy(task + written_length, data, chunk_length);
+        else if (!lz_decompress((const char*)data, stored_length, task + written_length, chunk_length))
+            return false;
+
+        written_length += chunk_length;
+    }
+
+    return written_length == task_length;
+}
+
+static int __read_blob_part(db_connection* connection, sqlite3_blob* blob, const bool is_compressed, const long offset,
+    char* buffer, const int capacity, long* length)
+{
+    const int body_length = sqlite3_blob_bytes(blob);
+    unsigned char header[__compressed_header_length];
+
+    memset(header, 0, sizeof(header));
+
+    // Plain tasks are read straight from their bytes.
+    if (!is_compressed)
+    {
+        const int part_length = (offset >= body_length) ? 0 : (int)((body_length - offset < capacity) ? body_length - offset : capacity);
+        *length = body_length;
+
+        return (sqlite3_blob_read(blob, buffer, part_length, (int)offset) == SQLITE_OK) ? part_length : -1;
+    }
+
+    if (sqlite3_blob_read(blob, header, min(body_length, __compressed_header_length), 0) != SQLITE_OK)
+        return -1;
+
+    // A task that's being streamed in has no text yet.
+    if (header[0] == __codec_pending)
+    {
+        *length = 0;
+        return 0;
+    }
+
+    const long task_length = __compressed_task_length(header, body_length);
+
+    if (task_length < 0)
+        return -1;
+
+    *length = task_length;
+
+    // Bodies compressed in one piece are short, unless they were written before long tasks were framed.
+    if (header[0] == __codec_lz)
+    {
+        unsigned char* body = (unsigned char*)__reserve_scratch(connection, body_length + task_length);
+        const int part_length = (offset >= task_length) ? 0 : (int)((task_length - offset < capacity) ? task_length - offset : capacity);
+
+        if (body == NULL || sqlite3_blob_read(blob, body, body_length, 0) != SQLITE_OK
+            || !__decompress_task(body, body_length, (char*)body + body_length, task_length))
+            return -1;
+
+        memcpy(buffer, body + body_length + offset, part_length);
+
+        return part_length;
+    }
+
+    long position = __compressed_header_length, chunk_start = 0;
+    int part_length = 0;
+
+    while (part_length < capacity && offset + part_length < task_length && position < body_length)
+    {
+        unsigned char frame_header[__frame_header_length];
+
+        if (body_length - position < __frame_header_length || sqlite3_blob_read(blob, frame_header, __frame_header_length, (int)position) != SQLITE_OK)
+            return -1;
+
+        const long chunk_length = __read_uint32(frame_header);
+        const long stored_length = __read_uint32(frame_header + 4);
+        const long data_position = position + __frame_header_length;
+        const long skipped_length = offset + part_length - chunk_start;
+
+        position = data_position + stored_length;
+
+        if (position > body_length || chunk_length > task_length - chunk_start || stored_length > chunk_length)
+            return -1;
+
+        // Only the lengths of the frames before the part are read.
+        if (skipped_length < chunk_length)
+        {
+            const int copied_length = (int)((chunk_length - skipped_length < capacity - part_length) ? chunk_length - skipped_length : capacity - part_length);
+
+            if (stored_length == chunk_length)
+            {
+                if (sqlite3_blob_read(blob, buffer + part_length, copied_length, (int)(data_position + skipped_length)) != SQLITE_OK)
+                    return -1;
+            }
+            else
+            {
+                char* frame = __reserve_scratch(connection, stored_length + chunk_length);
+
+                if (frame == NULL || sqlite3_blob_read(blob, frame, (int)stored_length, (int)data_position) != SQLITE_OK
+                    || !lz_decompress(frame, stored_length, frame + stored_length, chunk_length))
+                    return -1;
+
+                memcpy(buffer + part_length, frame + stored_length + skipped_length, copied_length);
+            }
+
+            part_length += copied_length;
+        }
+
+        chunk_start += chunk_length;
+    }
+
+    return part_length;
+}
+
+static int __add_streamed_task(const db_handle* db, const int fd, char* chunk, size_t chunk_length, unsigned char* frame, int* error_code)
+{
+    struct stat file_status;
+    const off_t position = lseek(fd, 0, SEEK_CUR);
+    const bool is_file = fstat(fd, &file_status) == 0 && S_ISREG(file_status.st_mode) && position >= (off_t)chunk_length;
+    uint64_t task_length = 0;
+
+    // A file is encoded once just to measure its body, so its frames can go straight into a row of the right size.
+    // A pipe can only be read once, so its frames wait in a temporary file until the size of the body is known.
+    FILE* staging = (is_file) ? NULL : tmpfile();
+    __streamed_body body = { .staging = staging, .blob = NULL, .length = __compressed_header_length };
+    bool success = (is_file || staging != NULL) && __encode_stream(db, fd, chunk, chunk_length, frame, &body, &task_length);
+
+    if (success && is_file)
+    {
+        success = lseek(fd, position - (off_t)chunk_length, SEEK_SET) >= 0
+            && __read_chunk(fd, chunk, __stream_chunk_size, &chunk_length);
+    }
+
+    db_connection* writer = __acquire_writer(db);
+    sqlite3_blob* blob = NULL;
+    int id = -1;
+
+    const bool is_in_transaction = success && __execute_query(writer, "BEGIN IMMEDIATE;", NULL, NULL);
+
+    // The full-text index must not read the zero-filled task, or SQLite would build it in memory.
+    __is_inserting_streamed_task = true;
+
+    success = is_in_transaction && success
+        && __execute_parameterized_query(writer, __STMT_INSERT_STREAMED_TASK, NULL, NULL, __prepare_streamed_insert_query, 2, (int)body.length, get_current_time());
+
+    __is_inserting_streamed_task = false;
+
+    if (success)
+        id = (int)sqlite3_last_insert_rowid(writer->sqlite);
+
+    unsigned char header[__compressed_header_length];
+    header[0] = __codec_lz_framed;
+    __write_uint32(header + 1, (uint32_t)task_length);
+
+    success = success
+        && sqlite3_blob_open(writer->sqlite, "main", "tasks", "task", id, 1, &blob) == SQLITE_OK
+        && sqlite3_blob_write(blob, header, sizeof(header), 0) == SQLITE_OK;
+
+    // A file is encoded again, in case it changed since it was measured, and must come out the same size.
+    if (success && is_file)
+    {
+        const uint64_t measured_task_length = task_length, measured_body_length = body.length;
+
+        body = (__streamed_body){ .staging = NULL, .blob = blob, .length = __compressed_header_length };
+        task_length = 0;
+
+        success = __encode_stream(db, fd, chunk, chunk_length, frame, &body, &task_length)
+            && task_length == measured_task_length && body.length == measured_body_length;
+    }
+    else if (success)
+        success = __copy_staged_frames(staging, blob, chunk, __stream_chunk_size);
+
+    // Only the start of the task is indexed, which is read back from its first frame.
+    long indexed_task_length = 0;
+    const int part_length = (success) ? __read_blob_part(writer, blob, true, 0, chunk, __max_indexed_length, &indexed_task_length) : -1;
+    const __encoded_task indexed_text = { .data = chunk, .length = __get_indexed_length(chunk, part_length), .is_compressed = false };
+
+    if (blob != NULL)
+        success = sqlite3_blob_close(blob) == SQLITE_OK && success;
+
+    success = success && part_length >= 0
+        && __execute_parameterized_query(writer, __STMT_UNINDEX_STREAMED_TASK, NULL, NULL, __prepare_id_query, 1, id)
+        && __execute_parameterized_query(writer, __STMT_INDEX_STREAMED_TASK, NULL, NULL, __prepare_task_and_id_query, 2, &indexed_text, id)
+        && __execute_query(writer, "COMMIT;", NULL, NULL);
+
+    if (!success && is_in_transaction && sqlite3_get_autocommit(writer->sqlite) == 0)
+        __execute_query(writer, "ROLLBACK;", NULL, NULL);
+
+    __release_writer(db);
+
+    if (staging != NULL)
+        fclose(staging);
+
+    if (success)
+        __trace_call(db, DB_TRACE_ADD_TASK, id, task_length, NULL);
+    else
+        *error_code = (body.rejection_code != EXIT_SUCCESS) ? body.rejection_code : EIO;
+
+    return (success) ? id : -1;
+}
+
+static bool __read_chunk(const int fd, char* buffer, const size_t capacity, size_t* length)
+{
+    *length = 0;
+
+    while (*length < capacity)
+    {
+        const ssize_t result = read(fd, buffer + *length, capacity - *length);
+
+        if (result < 0 && errno == EINTR)
+            continue;
+
+        if (result < 0)
+            return false;
+
+        if (result == 0)
+            break;
+
+        *length += result;
+    }
+
+    return true;
+}
+
+static bool __encode_stream(const db_handle* db, const int fd, char* chunk, size_t chunk_length, unsigned char* frame,
+    __streamed_body* body, uint64_t* task_length)
+{
+    // Zero disables compression, and frames that aren't compressed are still framed, so the task can be read a part at a time.
+    const bool should_compress = db->compression_threshold != 0;
+
+    while (chunk_length > 0)
+    {
+        if (memchr(chunk, '\0', chunk_length) != NULL)
+        {
+            body->rejection_code = EILSEQ;
+            return false;
+        }
+
+        body->has_text = body->has_text || !__is_blank(chunk, chunk_length);
+
+        const size_t frame_length = __encode_frame(chunk, chunk_length, frame, should_compress);
+        *task_length += chunk_length;
+
+        if (*task_length > UINT32_MAX || body->length + frame_length > INT_MAX
+            || !__write_frame(body, frame, frame_length)
+            || !__read_chunk(fd, chunk, __stream_chunk_size, &chunk_length))
+            return false;
+    }
+
+    // However long it is, an input of nothing but line breaks is an empty note.
+    if (!body->has_text)
+        body->rejection_code = ENODATA;
+
+    return body->has_text;
+}
+
+static bool __write_frame(__streamed_body* body, const unsigned char* frame, const size_t frame_length)
+{
+    bool success = true;
+
+    if (body->blob != NULL)
+    {
+        success = body->length + frame_length <= (uint64_t)sqlite3_blob_bytes(body->blob)
+            && sqlite3_blob_write(body->blob, frame, (int)frame_length, (int)body->length) == SQLITE_OK;
+    }
+    else if (body->staging != NULL)
+        success = fwrite(frame, 1, frame_length, body->staging) == frame_length;
+
+    body->length += frame_length;
+
+    return success;
+}
+
+static bool __copy_staged_frames(FILE* staging, sqlite3_blob* blob, char* buffer, const size_t capacity)
+{
+    __streamed_body body = { .staging = NULL, .blob = blob, .length = __compressed_header_length };
+    bool success = fflush(staging) == 0 && fseek(staging, 0, SEEK_SET) == 0;
+    size_t read_length;
+
+    // The frames were written back to back, so they're copied without being told apart.
+    while (success && (read_length = fread(buffer, 1, capacity, staging)) > 0)
+        success = __write_frame(&body, (const unsigned char*)buffer, read_length);
+
+    return success && !ferror(staging) && body.length == (uint64_t)sqlite3_blob_bytes(blob);
+}
+
+static size_t __encode_frame(const char* chunk, const size_t chunk_length, unsigned char* frame, const bool should_compress)
+{
+    size_t stored_length = (should_compress) ? lz_compress(chunk, chunk_length, (char*)frame + __frame_header_length) : chunk_length;
+
+    // Chunks that don't shrink are stored as they are, so reading them is a copy.
+    if (stored_length >= chunk_length)
+    {
+        stored_length = chunk_length;
+        memcpy(frame + __frame_header_length, chunk, chunk_length);
+    }
+
+    __write_uint32(frame, (uint32_t)chunk_length);
+    __write_uint32(frame + 4, (uint32_t)stored_length);
+
+    return __frame_header_length + stored_length;
+}
+
+static int __get_indexed_length(const char* text, const int length)
+{
+    const int prefix_length = (length < __max_indexed_length) ? length : __max_indexed_length;
+    int start = prefix_length - 1;
+
+    // Only the prefix is looked at, so the result is the same whether the rest of the task was read or not.
+    // UTF-8 continuation bytes start with the bits 10, and a character has at most 4 bytes.
+    while (start > 0 && prefix_length - start < 4 && ((unsigned char)text[start] & 0xC0) == 0x80)
+        start--;
+
+    if (start < 0)
+        return 0;
+
+    const unsigned char lead = (unsigned char)text[start];
+    const int character_length = (lead >= 0xF0) ? 4 : (lead >= 0xE0) ? 3 : (lead >= 0xC0) ? 2 : 1;
+
+    return (start + character_length > prefix_length) ? start : prefix_length;
+}
+
+static bool __is_blank(const char* text, const size_t length)
+{
+    for (size_t index = 0; index < length; index++)
+    {
+        if (text[index] == '\0' || strchr(NEWLINE, text[index]) == NULL)
+            return false;
+    }
+
+    return true;
+}
+
+static void __write_uint32(unsigned char* bytes, const uint32_t value)
+{
+    for (int index = 0; index < 4; index++)
+        bytes[index] = (unsigned char)(value >> (8 * index));
+}
+
+static uint32_t __read_uint32(const unsigned char* bytes)
+{
+    uint32_t value = 0;
+
+    for (int index = 0; index < 4; index++)
+        value |= (uint32_t)bytes[index] << (8 * index);
+
+    return value;
+}
+
+static const char* __read_task_column(db_connection* connection, sqlite3_stmt* stmt, const int column, int* length)
+{
+    // Plain tasks are read straight from SQLite's row buffer.
+    // The text must be read before its length, so SQLite doesn't convert it twice.
+    if (sqlite3_column_type(stmt, column) != SQLITE_BLOB)
+    {
+        const char* task = (const char*)sqlite3_column_text(stmt, column);
+        *length = sqlite3_column_bytes(stmt, column);
+
+        return task;
+    }
+
+    const unsigned char* body = sqlite3_column_blob(stmt, column);
+    const int body_length = sqlite3_column_bytes(stmt, column);
+    const long task_length = __compressed_task_length(body, body_length);
+    char* task = (task_length < 0) ? NULL : __reserve_scratch(connection, task_length + 1);
+
+    *length = 0;
+
+    if (task == NULL || !__decompress_task(body, body_length, task, task_length))
+        return NULL;
+
+    task[task_length] = '\0';
+    *length = (int)task_length;
+
+    return task;
+}
+
+static void __sql_task_text(sqlite3_context* context, int argc, sqlite3_value** argv)
+{
+    UNUSED(argc);
+
+    if (sqlite3_value_type(argv[0]) != SQLITE_BLOB)
+    {
+        sqlite3_result_value(context, argv[0]);
+        return;
+    }
+
+    const unsigned char* body = sqlite3_value_blob(argv[0]);
+    const int body_length = sqlite3_value_bytes(argv[0]);
+
+    // A task that's being streamed in has no text yet.
+    if (body_length > 0 && body[0] == __codec_pending)
+    {
+        sqlite3_result_text(context, "", 0, SQLITE_STATIC);
+        return;
+    }
+
+    const long task_length = __compressed_task_length(body, body_length);
+    char* task = (task_length < 0) ? NULL : sqlite3_malloc64(task_length + 1);
+
+    if (task == NULL || !__decompress_task(body, body_length, task, task_length))
+    {
+        sqlite3_free(task);
+        sqlite3_result_error(context, "task_text(): the task is corrupted", -1);
+
+        return;
+    }
+
+    sqlite3_result_text(context, task, (int)task_length, sqlite3_free);
+}
+
+static void __sql_task_index_text(sqlite3_context* context, int argc, sqlite3_value** argv)
+{
+    UNUSED(argc);
+
+    // A zero-filled streamed task has no text yet, and reading it would build the whole body in memory.
+    if (__is_inserting_streamed_task)
+    {
+        sqlite3_result_text(context, "", 0, SQLITE_STATIC);
+        return;
+    }
+
+    if (sqlite3_value_type(argv[0]) != SQLITE_BLOB)
+    {
+        const char* task = (const char*)sqlite3_value_text(argv[0]);
+        sqlite3_result_text(context, task, __get_indexed_length(task, sqlite3_value_bytes(argv[0])), SQLITE_TRANSIENT);
+
+        return;
+    }
+
+    const unsigned char* body = sqlite3_value_blob(argv[0]);
+    const int body_length = sqlite3_value_bytes(argv[0]);
+
+    if (body_length > 0 && body[0] == __codec_pending)
+    {
+        sqlite3_result_text(context, "", 0, SQLITE_STATIC);
+        return;
+    }
+
+    const long task_length = __compressed_task_length(body, body_length);
+    long prefix_length = task_length;
+    long prefix_body_length = body_length;
+
+    // Framed tasks only decompress the frames that hold the indexed text.
+    if (task_length >= 0 && body[0] == __codec_lz_framed)
+    {
+        prefix_length = 0;
+        prefix_body_length = __compressed_header_length;
+
+        while (prefix_length < __max_indexed_length && body_length - prefix_body_length >= __frame_header_length)
+        {
+            prefix_length += __read_uint32(body + prefix_body_length);
+            prefix_body_length += __frame_header_length + __read_uint32(body + prefix_body_length + 4);
+        }
+
+        prefix_length = (prefix_body_length > body_length || prefix_length > task_length) ? -1 : prefix_length;
+    }
+
+    char* task = (prefix_length < 0) ? NULL : sqlite3_malloc64(prefix_length + 1);
+
+    if (task == NULL || !__decompress_task(body, (int)prefix_body_length, task, prefix_length))
+    {
+        sqlite3_free(task);
+        sqlite3_result_error(context, "task_index_text(): the task is corrupted", -1);
+
+        return;
+    }
+
+    sqlite3_result_text(context, task, __get_indexed_length(task, (int)prefix_length), sqlite3_free);
+}
+
+static int __busy_handler(void* connection, int attempt)
+{
+    db_connection* waiting_connection = connection;
+    const db_busy_policy* policy = waiting_connection->busy_policy;
+    const uint64_t now_ns = __get_time_ns();
+
+    if (attempt == 0)
+        waiting_connection->busy_since_ns = now_ns;
+
+    const uint64_t waited_ns = now_ns - waiting_connection->busy_since_ns;
+
+    if (policy->timeout_ms <= 0 || waited_ns >= (uint64_t)policy->timeout_ms * 1000000ull)
+        return 0;
+
+    // Double the backoff every retry, then sleep for a random part of it, so processes that
+    // collided once don't keep retrying in lockstep.
+    int backoff_us = max(1, policy->initial_backoff_us);
+
+    for (int retry = 0; retry < attempt && backoff_us <= policy->max_backoff_us / 2; retry++)
+        backoff_us *= 2;
+
+    backoff_us = min(backoff_us, max(1, policy->max_backoff_us));
+
+    const int sleep_us = backoff_us / 2 + rand_r(&waiting_connection->busy_seed) % (backoff_us / 2 + 1);
+    const struct timespec pause = { .tv_sec = sleep_us / 1000000, .tv_nsec = (sleep_us % 1000000) * 1000L };
+    nanosleep(&pause, NULL);
+
+    return 1;
+}
+
+static bool __open_connection(db_connection* connection, const char* db_location, const int flags, const db_busy_policy* busy_policy)
+{
+    const int db_code = sqlite3_open_v2(db_location, &connection->sqlite, flags, NULL);
+
+    connection->busy_policy = busy_policy;
+    connection->busy_seed = (unsigned int)(getpid() ^ time(NULL) ^ (uintptr_t)connection);
+
+    if (db_code == SQLITE_OK && register_task_functions(connection->sqlite)
+        && sqlite3_busy_handler(connection->sqlite, __busy_handler, connection) == SQLITE_OK)
+        return true;
+
+    fprintf(stderr, "Could not open a connection to \"%s\"" NEWLINE "Error: %s" NEWLINE, db_location, sqlite3_errmsg(connection->sqlite));
+    sqlite3_close(connection->sqlite);
+    connection->sqlite = NULL;
+
+    return false;
+}
+
+static void __close_connection(db_connection* connection)
+{
+    for (int index = 0; index < __STMT_AMOUNT; index++)
+    {
+        sqlite3_finalize(connection->statements[index]);
+        connection->statements[index] = NULL;
+    }
+
+    sqlite3_close(connection->sqlite);
+    connection->sqlite = NULL;
+
+    free(connection->scratch);
+    connection->scratch = NULL;
+    connection->scratch_capacity = 0;
+}
+
+static db_connection* __acquire_reader(const db_handle* db)
+{
+    db_handle* handle = (db_handle*)db;
+    db_connection* connection = NULL;
+
+    pthread_mutex_lock(&handle->readers_lock);
+
+    while (handle->idle_readers == NULL && handle->reader_amount == handle->reader_capacity)
+        pthread_cond_wait(&handle->reader_released, &handle->readers_lock);
+
+    if (handle->idle_readers != NULL)
+    {
+        connection = handle->idle_readers;
+        handle->idle_readers = connection->next_idle;
+    }
+    else if (__open_connection(&handle->readers[handle->reader_amount], handle->location, SQLITE_OPEN_READONLY | SQLITE_OPEN_NOMUTEX, &handle->busy_policy))
+    {
+        // Readers are only opened when every open reader is busy.
+        connection = &handle->readers[handle->reader_amount++];
+    }
+
+    pthread_mutex_unlock(&handle->readers_lock);
+
+    if (connection != NULL)
+        __update_slow_query_profiling(db, connection);
+
+    return connection;
+}
+
+static void __release_reader(const db_handle* db, db_connection* connection)
+{
+    db_handle* handle = (db_handle*)db;
+
+    pthread_mutex_lock(&handle->readers_lock);
+
+    connection->next_idle = handle->idle_readers;
+    handle->idle_readers = connection;
+
+    pthread_cond_signal(&handle->reader_released);
+    pthread_mutex_unlock(&handle->readers_lock);
+}
+
+static db_connection* __acquire_writer(const db_handle* db)
+{
+    db_handle* handle = (db_handle*)db;
+
+    pthread_mutex_lock(&handle->writer_lock);
+    __update_slow_query_profiling(db, &handle->writer);
+
+    return &handle->writer;
+}
+
+static void __release_writer(const db_handle* db)
+{
+    pthread_mutex_unlock(&((db_handle*)db)->writer_lock);
+}
+
+static bool __execute_query(db_connection* connection, const char* sql_query, int (*callback)(void*, int, char**, char**), void* custom_state)
+{
+    __query_counters* counters = &connection->query_counters[__classify_query(sql_query)];
+    __counted_query_state counted_state = { .counters = counters, .callback = callback, .custom_state = custom_state };
+    char* err_msg = NULL;
+
+    const uint64_t start_ns = __get_time_ns();
+    const int command_code = sqlite3_exec(connection->sqlite, sql_query, __callback_count_row, &counted_state, &err_msg);
+    const uint64_t elapsed_ns = __get_time_ns() - start_ns;
+
+    __add_to_counter(&counters->calls, 1);
+    __add_to_counter(&counters->total_ns, elapsed_ns);
+    __raise_counter(&counters->max_ns, elapsed_ns);
+
+    if (command_code == SQLITE_OK)
+        return true;
+
+    fprintf(stderr, "SQLite query error: %s" NEWLINE, err_msg);
+    sqlite3_free(err_msg);
+
+    return false;
+}
+
+static int __callback_count_row(void* custom_state, int column_amount, char** column_contents, char** column_names)
+{
+    __counted_query_state* counted_state = custom_state;
+    uint64_t row_size = 0;
+
+    for (int column = 0; column < column_amount; column++)
+        row_size += (column_contents[column] == NULL) ? 0 : strlen(column_contents[column]);
+
+    __add_to_counter(&counted_state->counters->rows, 1);
+    __add_to_counter(&counted_state->counters->bytes, row_size);
+
+    return (counted_state->callback == NULL)
+        ? 0
+        : counted_state->callback(counted_state->custom_state, column_amount, column_contents, column_names);
+}
+
+static int __step_statement(db_connection* connection, sqlite3_stmt* stmt)
+{
+    __query_counters* counters = __get_statement_counters(connection, stmt);
+
+    // A statement that isn't mid-run starts a new run on this step.
+    if (!sqlite3_stmt_busy(stmt))
+    {
+        __add_to_counter(&counters->calls, 1);
+        counters->running_ns = 0;
+    }
+
+    const uint64_t start_ns = __get_time_ns();
+    const int db_code = sqlite3_step(stmt);
+    const uint64_t elapsed_ns = __get_time_ns() - start_ns;
+
+    counters->running_ns += elapsed_ns;
+    __add_to_counter(&counters->total_ns, elapsed_ns);
+    __raise_counter(&counters->max_ns, counters->running_ns);
+
+    if (db_code == SQLITE_ROW)
+    {
+        __add_to_counter(&counters->rows, 1);
+        __add_to_counter(&counters->bytes, __get_row_size(stmt));
+    }
+
+    return db_code;
+}
+
+static __query_counters* __get_statement_counters(db_connection* connection, const sqlite3_stmt* stmt)
+{
+    for (int statement_id = 0; statement_id < __STMT_AMOUNT; statement_id++)
+    {
+        if (connection->statements[statement_id] == stmt)
+            return &connection->query_counters[statement_id];
+    }
+
+    return &connection->query_counters[__QUERY_OTHER];
+}
+
+static uint64_t __get_row_size(sqlite3_stmt* stmt)
+{
+    const int column_amount = sqlite3_data_count(stmt);
+    uint64_t row_size = 0;
+
+    for (int column = 0; column < column_amount; column++)
+    {
+        const int column_type = sqlite3_column_type(stmt, column);
+
+        if (column_type == SQLITE_TEXT || column_type == SQLITE_BLOB)
+            row_size += sqlite3_column_bytes(stmt, column);
+        else if (column_type != SQLITE_NULL)
+            row_size += 8;
+    }
+
+    return row_size;
+}
+
+static __query_kind __classify_query(const char* sql_query)
+{
+    if (sqlite3_strnicmp(sql_query, "BEGIN", 5) == 0)
+        return __QUERY_BEGIN;
+
+    if (sqlite3_strnicmp(sql_query, "COMMIT", 6) == 0)
+        return __QUERY_COMMIT;
+
+    if (sqlite3_strnicmp(sql_query, "ROLLBACK", 8) == 0)
+        return __QUERY_ROLLBACK;
+
+    return __QUERY_OTHER;
+}
+
+static void __add_to_counter(uint64_t* counter, const uint64_t amount)
+{
+    // Only the thread using the connection writes, so a plain add is enough. The store is atomic for the readers.
+    __atomic_store_n(counter, *counter + amount, __ATOMIC_RELAXED);
+}
+
+static void __raise_counter(uint64_t* counter, const uint64_t value)
+{
+    if (value > *counter)
+        __atomic_store_n(counter, value, __ATOMIC_RELAXED);
+}
+
+static uint64_t __get_time_ns()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (uint64_t)now.tv_sec * 1000000000ull + (uint64_t)now.tv_nsec;
+}
+
+static void __update_slow_query_profiling(const db_handle* db, db_connection* connection)
+{
+    const int threshold_ms = __atomic_load_n(&db->slow_query_ms, __ATOMIC_RELAXED);
+
+    if (threshold_ms == connection->slow_query_ms || (threshold_ms <= 0 && connection->slow_query_ms <= 0))
+        return;
+
+    if (threshold_ms > 0)
+        sqlite3_trace_v2(connection->sqlite, SQLITE_TRACE_PROFILE, __trace_slow_query, connection);
+    else
+        sqlite3_trace_v2(connection->sqlite, 0, NULL, NULL);
+
+    connection->slow_query_ms = threshold_ms;
+}
+
+static int __trace_slow_query(unsigned int event, void* connection, void* stmt, void* elapsed_ns)
+{
+    UNUSED(event);
+
+    const db_connection* profiled_connection = connection;
+    const uint64_t elapsed = *(const uint64_t*)elapsed_ns;
+
+    // The statement text has "?" in place of the parameters, so no task content ends up in the log.
+    if (elapsed >= (uint64_t)profiled_connection->slow_query_ms * 1000000ull)
+        fprintf(stderr, "Slow query (%.1f ms): %s" NEWLINE, elapsed / 1000000.0, sqlite3_sql((sqlite3_stmt*)stmt));
+
+    return 0;
+}
+
+static void __sum_query_counters(db_query_stats* stats, const db_connection* connection)
+{
+    for (int kind = 0; kind < __QUERY_KIND_AMOUNT; kind++)
+    {
+        const __query_counters* counters = &connection->query_counters[kind];
+        db_query_counters* summed_counters = &stats->queries[kind];
+        const uint64_t max_ns = __atomic_load_n(&counters->max_ns, __ATOMIC_RELAXED);
+
+        summed_counters->calls += __atomic_load_n(&counters->calls, __ATOMIC_RELAXED);
+        summed_counters->rows += __atomic_load_n(&counters->rows, __ATOMIC_RELAXED);
+        summed_counters->bytes += __atomic_load_n(&counters->bytes, __ATOMIC_RELAXED);
+        summed_counters->total_ns += __atomic_load_n(&counters->total_ns, __ATOMIC_RELAXED);
+        summed_counters->max_ns = (max_ns > summed_counters->max_ns) ? max_ns : summed_counters->max_ns;
+        summed_counters->prepares += __atomic_load_n(&counters->prepares, __ATOMIC_RELAXED);
+        summed_counters->prepare_ns += __atomic_load_n(&counters->prepare_ns, __ATOMIC_RELAXED);
+    }
+}
+
+static sqlite3_stmt* __get_cached_statement(db_connection* connection, __statement_id statement_id)
+{
+    if (connection->statements[statement_id] == NULL)
+    {
+        const uint64_t start_ns = __get_time_ns();
+
+        // Persistent statements are kept out of SQLite's lookaside memory, since they live as long as the connection.
+        sqlite3_prepare_v3(connection->sqlite, __statement_queries[statement_id], -1, SQLITE_PREPARE_PERSISTENT, &connection->statements[statement_id], NULL);
+
+        __add_to_counter(&connection->query_counters[statement_id].prepares, 1);
+        __add_to_counter(&connection->query_counters[statement_id].prepare_ns, __get_time_ns() - start_ns);
+    }
+
+    return connection->statements[statement_id];
+}
+
+static bool __execute_parameterized_query(db_connection* connection, __statement_id statement_id, void* custom_state, int (*read_callback)(void*, sqlite3_stmt*),
+    int (*query_callback)(sqlite3_stmt*, va_list, int), int arg_count, ...)
+{
+    sqlite3* db = connection->sqlite;
+    sqlite3_stmt* stmt = __get_cached_statement(connection, statement_id);
+
+    if (stmt == NULL)
+    {
+        fprintf(stderr, "Query compilation failed: %s" NEWLINE, sqlite3_errmsg((sqlite3*)db));
+        return false;
+    }
+
+    va_list args;
+    va_start(args, arg_count);
+
+    int db_code = query_callback(stmt, args, arg_count);  // Add the arguments.
+
+    va_end(args);
+
+    if (db_code != SQLITE_OK)
+    {
+        fprintf(stderr, "Query parametization failed: %s" NEWLINE, sqlite3_errmsg((sqlite3*)db));
+        sqlite3_clear_bindings(stmt);
+
+        return false;
+    }
+
+    // Execute the query.
+    if (read_callback == NULL)
+    {
+        do
+        {
+            db_code = __step_statement(connection, stmt);
+        } while (db_code == SQLITE_ROW);
+    }
+    else
+    {
+        db_code = __step_statement(connection, stmt);
+        while (db_code == SQLITE_ROW)
+        {
+            int callback_code = read_callback(custom_state, stmt);
+
+            if (callback_code != 0)
+            {
+                sqlite3_reset(stmt);
+                sqlite3_clear_bindings(stmt);
+                fprintf(stderr, "Read callback returned error %d" NEWLINE, callback_code);
+
+                return false;
+            }
+
+            db_code = __step_statement(connection, stmt);
+        }
+    }
+
+    if (db_code != SQLITE_DONE)
+        fprintf(stderr, "SQLite query error: %s" NEWLINE, sqlite3_errmsg((sqlite3*)db));
+
+    // Return the statement to the cache.
+    sqlite3_reset(stmt);
+    sqlite3_clear_bindings(stmt);
+
+    return db_code == SQLITE_DONE;
+}
+
+static int __execute_batch(db_connection* connection, const int chunk_size, __statement_id statement_id, const int amount, bool* results,
+    int (*bind_callback)(sqlite3_stmt*, const __batch_arguments*, int), const __batch_arguments* arguments)
+{
+    sqlite3* db = connection->sqlite;
+    sqlite3_stmt* stmt = __get_cached_statement(connection, statement_id);
+    int applied_amount = 0;
+
+    if (stmt == NULL)
+    {
+        fprintf(stderr, "Query compilation failed: %s" NEWLINE, sqlite3_errmsg((sqlite3*)db));
+
+        if (results != NULL)
+            memset(results, false, amount * sizeof(bool));
+
+        return 0;
+    }
+
+    for (int chunk_start = 0; chunk_start < amount;)
+    {
+        const int chunk_end = (chunk_size <= 0) ? amount : min(amount, chunk_start + chunk_size);
+        int chunk_applied_amount = 0;
+        bool chunk_failed = !__execute_query(connection, "BEGIN IMMEDIATE;", NULL, NULL);
+
+        for (int index = chunk_start; index < chunk_end && !chunk_failed; index++)
+        {
+            int db_code = bind_callback(stmt, arguments, index);
+
+            if (db_code == SQLITE_OK)
+                db_code = __step_statement(connection, stmt);
+
+            // Inserts always add a row, updates and deletes only count if the ID exists.
+            const bool applied = db_code == SQLITE_DONE
+                && (statement_id == __STMT_INSERT_TASK || sqlite3_changes((sqlite3*)db) > 0);
+
+            // A constraint error only affects this item: SQLite undoes the statement and keeps the transaction.
+            if (db_code != SQLITE_DONE && db_code != SQLITE_CONSTRAINT)
+            {
+                fprintf(stderr, "SQLite query error: %s" NEWLINE, sqlite3_errmsg((sqlite3*)db));
+                chunk_failed = true;
+            }
+
+            sqlite3_reset(stmt);
+            sqlite3_clear_bindings(stmt);
+
+            chunk_applied_amount += applied;
+
+            if (results != NULL)
+                results[index] = applied;
+        }
+
+        if (!chunk_failed && __execute_query(connection, "COMMIT;", NULL, NULL))
+            applied_amount += chunk_applied_amount;
+        else
+        {
+            // Nothing in this chunk was written, so none of its items succeeded.
+            if (sqlite3_get_autocommit((sqlite3*)db) == 0)
+                __execute_query(connection, "ROLLBACK;", NULL, NULL);
+
+            if (results != NULL)
+                memset(results + chunk_start, false, (chunk_end - chunk_start) * sizeof(bool));
+        }
+
+        chunk_start = chunk_end;
+    }
+
+    return applied_amount;
+}
+
+static int __execute_writer_batch(const db_handle* db, __statement_id statement_id, const int amount, bool* results,
+    int (*bind_callback)(sqlite3_stmt*, const __batch_arguments*, int), const __batch_arguments* arguments)
+{
+    db_connection* writer = __acquire_writer(db);
+    const int applied_amount = __execute_batch(writer, db->batch_chunk_size, statement_id, amount, results, bind_callback, arguments);
+
+    __release_writer(db);
+
+    return applied_amount;
+}
+
+static void __invalidate_cached_tasks(const db_handle* db, const int* ids, const int amount)
+{
+    if (db->cache == NULL)
+        return;
+
+    // "results" may be NULL, so every ID is dropped instead of only the applied ones.
+    for (int index = 0; index < amount; index++)
+        task_cache_remove(db->cache, ids[index]);
+}
+
+static bool __enqueue_write(const db_handle* db, __statement_id statement_id, const int id, const int64_t insert_number, const char* task,
+    void (*callback)(void*, const bool, const int), void* custom_state)
+{
+    db_handle* handle = (db_handle*)db;
+    const size_t task_length = (task == NULL) ? 0 : strlen(task);
+    __queued_write* write = malloc(sizeof(__queued_write) + task_length + 1);
+
+    if (write == NULL)
+        return false;
+
+    write->statement_id = statement_id;
+    write->id = id;
+    write->insert_number = insert_number;
+    write->applied = false;
+    write->created_at = get_current_time();
+    write->callback = callback;
+    write->custom_state = custom_state;
+    write->next = NULL;
+    memcpy(write->task, (task == NULL) ? "" : task, task_length + 1);
+
+    pthread_mutex_lock(&handle->write_queue_lock);
+
+    if (!handle->is_write_thread_running)
+        handle->is_write_thread_running = pthread_create(&handle->write_thread, NULL, __run_write_thread, handle) == 0;
+
+    if (!handle->is_write_thread_running || handle->is_closing)
+    {
+        pthread_mutex_unlock(&handle->write_queue_lock);
+        free(write);
+
+        return false;
+    }
+
+    if (handle->write_queue_tail == NULL)
+        handle->write_queue_head = write;
+    else
+        handle->write_queue_tail->next = write;
+
+    handle->write_queue_tail = write;
+    handle->pending_write_amount++;
+
+    pthread_cond_signal(&handle->write_queued);
+    pthread_mutex_unlock(&handle->write_queue_lock);
+
+    return true;
+}
+
+static void* __run_write_thread(void* db)
+{
+    db_handle* handle = db;
+
+    pthread_mutex_lock(&handle->write_queue_lock);
+
+    while (true)
+    {
+        while (handle->write_queue_head == NULL && !handle->is_closing)
+            pthread_cond_wait(&handle->write_queued, &handle->write_queue_lock);
+
+        if (handle->write_queue_head == NULL)
+            break;
+
+        // Take every write that piled up while the previous group was being committed.
+        __queued_write* group = handle->write_queue_head;
+        __queued_write* group_tail = group;
+        int group_size = 1;
+
+        while (group_tail->next != NULL && group_size < __max_write_group_size)
+        {
+            group_tail = group_tail->next;
+            group_size++;
+        }
+
+        handle->write_queue_head = group_tail->next;
+        group_tail->next = NULL;
+
+        if (handle->write_queue_head == NULL)
+            handle->write_queue_tail = NULL;
+
+        pthread_mutex_unlock(&handle->write_queue_lock);
+
+        __execute_write_group(handle, group);
+
+        // Report the results outside of the lock, so callbacks can queue more writes.
+        int failed_amount = 0;
+
+        while (group != NULL)
+        {
+            __queued_write* next_write = group->next;
+            failed_amount += !group->applied;
+
+            if (group->callback != NULL)
+                group->callback(group->custom_state, group->applied, group->id);
+
+            free(group);
+            group = next_write;
+        }
+
+        pthread_mutex_lock(&handle->write_queue_lock);
+
+        handle->failed_write_amount += failed_amount;
+        handle->pending_write_amount -= group_size;
+
+        if (handle->pending_write_amount == 0)
+            pthread_cond_broadcast(&handle->writes_finished);
+    }
+
+    pthread_mutex_unlock(&handle->write_queue_lock);
+
+    return NULL;
+}
+
+static void __execute_write_group(const db_handle* db, __queued_write* group)
+{
+    db_connection* writer = __acquire_writer(db);
+    sqlite3* sqlite = writer->sqlite;
+    bool group_failed = !__execute_query(writer, "BEGIN IMMEDIATE;", NULL, NULL);
+
+    for (__queued_write* write = group; write != NULL && !group_failed; write = write->next)
+    {
+        sqlite3_stmt* stmt = __get_cached_statement(writer, write->statement_id);
+
+        if (stmt == NULL)
+        {
+            fprintf(stderr, "Query compilation failed: %s" NEWLINE, sqlite3_errmsg(sqlite));
+            group_failed = true;
+
+            break;
+        }
+
+        int db_code;
+
+        if (write->statement_id == __STMT_INSERT_TASK)
+        {
+            const __encoded_task encoded_task = __encode_task(db, write->task);
+            db_code = __bind_encoded_task(stmt, 1, &encoded_task)                  // Add 'task'.
+                || sqlite3_bind_int64(stmt, 2, write->created_at);                  // Add 'created_at'.
+        }
+        else if (write->statement_id == __STMT_UPDATE_TASK)
+        {
+            const __encoded_task encoded_task = __encode_task(db, write->task);
+            db_code = __bind_encoded_task(stmt, 1, &encoded_task)                  // Add 'new_task'.
+                || sqlite3_bind_int(stmt, 2, write->id);                            // Add 'id'.
+        }
+        else
+            db_code = sqlite3_bind_int(stmt, 1, write->id);                         // Add 'id'.
+
+        if (db_code == SQLITE_OK)
+            db_code = __step_statement(writer, stmt);
+
+        // Inserts always add a row, updates and deletes only count if the ID exists.
+        write->applied = db_code == SQLITE_DONE
+            && (write->statement_id == __STMT_INSERT_TASK || sqlite3_changes(sqlite) > 0);
+
+        if (write->applied && write->statement_id == __STMT_INSERT_TASK)
+            write->id = (int)sqlite3_last_insert_rowid(sqlite);
+
+        // A constraint error only affects this write: SQLite undoes the statement and keeps the transaction.
+        if (db_code != SQLITE_DONE && db_code != SQLITE_CONSTRAINT)
+        {
+            fprintf(stderr, "SQLite query error: %s" NEWLINE, sqlite3_errmsg(sqlite));
+            group_failed = true;
+        }
+
+        sqlite3_reset(stmt);
+        sqlite3_clear_bindings(stmt);
+    }
+
+    if (!group_failed)
+        group_failed = !__execute_query(writer, "COMMIT;", NULL, NULL);
+
+    if (group_failed)
+    {
+        // Nothing in this group was written, so none of its writes succeeded.
+        if (sqlite3_get_autocommit(sqlite) == 0)
+            __execute_query(writer, "ROLLBACK;", NULL, NULL);
+
+        for (__queued_write* write = group; write != NULL; write = write->next)
+            write->applied = false;
+    }
+
+    // The IDs of committed inserts are traced, so a replay can find the task each later call refers to.
+    for (__queued_write* write = group; write != NULL; write = write->next)
+    {
+        if (write->applied && write->statement_id == __STMT_INSERT_TASK)
+            __trace_call(db, DB_TRACE_ASYNC_INSERT_COMMITTED, write->id, write->insert_number, NULL);
+    }
+
+    // The cache is only updated after the commit, so readers never see a write that could still be rolled back.
+    for (__queued_write* write = group; write != NULL && db->cache != NULL; write = write->next)
+    {
+        if (!write->applied)
+            continue;
+
+        if (write->statement_id == __STMT_DELETE_TASK)
+            task_cache_remove(db->cache, write->id);
+        else
+            task_cache_store(db->cache, write->id, write->task, strlen(write->task));
+    }
+
+    __release_writer(db);
+}
+
+static void __stop_write_thread(db_handle* db)
+{
+    pthread_mutex_lock(&db->write_queue_lock);
+
+    const bool is_running = db->is_write_thread_running;
+    db->is_closing = true;
+
+    pthread_cond_signal(&db->write_queued);
+    pthread_mutex_unlock(&db->write_queue_lock);
+
+    // The writer drains the queue before it stops.
+    if (is_running)
+        pthread_join(db->write_thread, NULL);
+}
+
+static int __bind_batch_insert(sqlite3_stmt* stmt, const __batch_arguments* arguments, int index)
+{
+    const __encoded_task encoded_task = __encode_task(arguments->db, arguments->tasks[index]);
+
+    return __bind_encoded_task(stmt, 1, &encoded_task)                             // Add 'task'.
+        || sqlite3_bind_int64(stmt, 2, arguments->created_at);                      // Add 'created_at'.
+}
+
+static int __bind_batch_id(sqlite3_stmt* stmt, const __batch_arguments* arguments, int index)
+{
+    return sqlite3_bind_int(stmt, 1, arguments->ids[index]);   // Add 'id'.
+}
+
+static int __bind_batch_update(sqlite3_stmt* stmt, const __batch_arguments* arguments, int index)
+{
+    const __encoded_task encoded_task = __encode_task(arguments->db, arguments->tasks[index]);
+
+    return __bind_encoded_task(stmt, 1, &encoded_task)                             // Add 'new_task'.
+        || sqlite3_bind_int(stmt, 2, arguments->ids[index]);                        // Add 'id'.
+}
+
+static int __bind_batch_restore(sqlite3_stmt* stmt, const __batch_arguments* arguments, int index)
+{
+    const __encoded_task encoded_task = __encode_task(arguments->db, arguments->tasks[index]);
+
+    return sqlite3_bind_int(stmt, 1, arguments->ids[index])                        // Add 'id'.
+        || __bind_encoded_task(stmt, 2, &encoded_task)                              // Add 'task'.
+        || sqlite3_bind_int64(stmt, 3, arguments->restored_created_at[index]);     // Add 'created_at'.
+}
+
+static int __prepare_insert_query(sqlite3_stmt* stmt, va_list args, int arg_count)
+{
+    UNUSED(arg_count);
+    return __bind_encoded_task(stmt, 1, va_arg(args, const __encoded_task*))    // Add 'task'.
+        || sqlite3_bind_int64(stmt, 2, va_arg(args, time_t));                   // Add 'created_at'.
+}
+
+static int __prepare_streamed_insert_query(sqlite3_stmt* stmt, va_list args, int arg_count)
+{
+    UNUSED(arg_count);
+    return sqlite3_bind_int(stmt, 1, va_arg(args, int))    // Add the size of 'task'.
+        || sqlite3_bind_int64(stmt, 2, va_arg(args, time_t));  // Add 'created_at'.
+}
+
+static int __prepare_id_query(sqlite3_stmt* stmt, va_list args, int arg_count)
+{
+    UNUSED(arg_count);
+    return sqlite3_bind_int(stmt, 1, va_arg(args, int));    // Add 'id'.
+}
+
+static int __prepare_task_and_id_query(sqlite3_stmt* stmt, va_list args, int arg_count)
+{
+    UNUSED(arg_count);
+    return __bind_encoded_task(stmt, 1, va_arg(args, const __encoded_task*))    // Add 'new_task'.
+        || sqlite3_bind_int(stmt, 2, va_arg(args, int));                        // Add 'id'.
+}
+
+static bool __tasks_arena_append(__tasks_arena* arena, const int id, const char* task, const int length)
+{
+    if (arena->amount == arena->entry_capacity)
+    {
+        const int new_capacity = (arena->entry_capacity == 0) ? 64 : arena->entry_capacity * 2;
+        db_tasks_entry* new_entries = realloc(arena->entries, new_capacity * sizeof(db_tasks_entry));
+
+        if (new_entries == NULL)
+            return false;
+
+        arena->entries = new_entries;
+        arena->entry_capacity = new_capacity;
+    }
+
+    const size_t required_length = arena->strings_length + length + 1;
+
+    if (required_length > arena->strings_capacity)
+    {
+        size_t new_capacity = (arena->strings_capacity == 0) ? 4096 : arena->strings_capacity;
+
+        while (new_capacity < required_length)
+            new_capacity *= 2;
+
+        char* new_strings = realloc(arena->strings, new_capacity);
+
+        if (new_strings == NULL)
+            return false;
+
+        arena->strings = new_strings;
+        arena->strings_capacity = new_capacity;
+    }
+
+    db_tasks_entry* entry = &arena->entries[arena->amount++];
+    entry->id = id;
+    entry->length = length;
+    entry->offset = arena->strings_length;
+
+    memcpy(arena->strings + arena->strings_length, task, length);
+    arena->strings[arena->strings_length + length] = '\0';
+    arena->strings_length = required_length;
+
+    return true;
+}
+
+static db_tasks __read_db_tasks(db_connection* connection, sqlite3_stmt* stmt)
+{
+    __tasks_arena arena = { 0 };
+    int db_code = (stmt == NULL) ? SQLITE_MISUSE : __step_statement(connection, stmt);
+
+    while (db_code == SQLITE_ROW)
+    {
+        int length = 0;
+        const int id = sqlite3_column_int(stmt, 0);
+        const char* task = __read_task_column(connection, stmt, 1, &length);
+
+        if (task == NULL)
+        {
+            db_code = SQLITE_CORRUPT;
+            break;
+        }
+
+        if (!__tasks_arena_append(&arena, id, task, length))
+        {
+            db_code = SQLITE_NOMEM;
+            break;
+        }
+
+        db_code = __step_statement(connection, stmt);
+    }
+
+    if (db_code != SQLITE_DONE)
+    {
+        if (stmt != NULL)
+            fprintf(stderr, "Could not read the tasks: %s" NEWLINE, sqlite3_errstr(db_code));
+
+        free(arena.entries);
+        free(arena.strings);
+        arena.amount = 0;
+    }
+
+    db_tasks db_tasks = {
+        .amount = arena.amount,
+        .entries = (arena.amount == 0) ? NULL : arena.entries,
+        .arena = (arena.amount == 0) ? NULL : arena.strings
+    };
+
+    return db_tasks;
+}
+
+static db_tasks __read_page(const db_handle* db, __statement_id statement_id, const int boundary_id, const int limit)
+{
+    db_connection* reader = __acquire_reader(db);
+    sqlite3_stmt* stmt = (reader == NULL) ? NULL : __get_cached_statement(reader, statement_id);
+
+    const bool is_bound = stmt != NULL && limit > 0
+        && sqlite3_bind_int(stmt, 1, boundary_id) == SQLITE_OK  // Add the boundary 'id'.
+        && sqlite3_bind_int(stmt, 2, limit) == SQLITE_OK;       // Add the limit.
+
+    db_tasks db_tasks = __read_db_tasks(reader, (is_bound) ? stmt : NULL);
+
+    // Cleanup
+    if (stmt != NULL)
+    {
+        sqlite3_reset(stmt);
+        sqlite3_clear_bindings(stmt);
+    }
+
+    if (reader != NULL)
+        __release_reader(db, reader);
+
+    // Pages before an ID are read backwards, so flip them to ascending order.
+    if (statement_id == __STMT_SELECT_PAGE_BEFORE)
+    {
+        db_tasks_entry* entries = (db_tasks_entry*)db_tasks.entries;
+
+        for (int left = 0, right = db_tasks.amount - 1; left < right; left++, right--)
+        {
+            const db_tasks_entry temp = entries[left];
+            entries[left] = entries[right];
+            entries[right] = temp;
+        }
+    }
+
+    return db_tasks;
+}
+
+static bool __with_task(const db_handle* db, const int id, int (*visitor)(void*, const int, const char*, const int), void* custom_state)
+{
+    task_cache* cache = db->cache;
+
+    if (cache != NULL && task_cache_visit(cache, id, visitor, custom_state))
+        return true;
+
+    db_connection* reader = __acquire_reader(db);
+
+    if (reader == NULL)
+        return false;
+
+    int visited_amount;
+
+    if (cache == NULL)
+        visited_amount = __visit_tasks(reader, __STMT_SELECT_TASK, id, 0, visitor, custom_state);
+    else
+    {
+        // The generation is read before the task, so a write that lands in between keeps the stale copy out of the cache.
+        __caching_visitor_state caching_state = {
+            .cache = cache,
+            .generation = task_cache_generation(cache),
+            .visitor = visitor,
+            .custom_state = custom_state
+        };
+
+        visited_amount = __visit_tasks(reader, __STMT_SELECT_TASK, id, 0, __visitor_cache_task, &caching_state);
+    }
+
+    __release_reader(db, reader);
+
+    return visited_amount > 0;
+}
+
+static db_tasks_cursor __open_cursor(const db_handle* db)
+{
+    db_tasks_cursor cursor = {
+        .id = 0,
+        .length = 0,
+        .task = NULL,
+        .created_at = 0,
+        .failed = false,
+        .stmt = NULL,
+        .db = db,
+        .connection = __acquire_reader(db)
+    };
+
+    bool* failed_ptr = (bool*)&cursor.failed;
+
+    if (cursor.connection == NULL)
+    {
+        *failed_ptr = true;
+        return cursor;
+    }
+
+    cursor.stmt = __get_cached_statement(cursor.connection, __STMT_SELECT_ALL_TASKS);
+
+    if (cursor.stmt == NULL)
+    {
+        fprintf(stderr, "Could not open the task cursor: %s" NEWLINE, sqlite3_errmsg(cursor.connection->sqlite));
+        *failed_ptr = true;
+    }
+
+    return cursor;
+}
+
+static void __trace_call(const db_handle* db, const db_trace_operation operation, const int64_t id, const int64_t size, const char* text)
+{
+    db_trace_recorder* recorder = __atomic_load_n(&db->trace_recorder, __ATOMIC_ACQUIRE);
+
+    if (recorder != NULL)
+        trace_record(recorder, operation, id, (text != NULL) ? (int64_t)strlen(text) : size);
+}
+
+static void __trace_batch_call(const db_handle* db, const db_trace_operation operation, const int* ids, const char** tasks, const int amount)
+{
+    db_trace_recorder* recorder = __atomic_load_n(&db->trace_recorder, __ATOMIC_ACQUIRE);
+
+    if (recorder != NULL)
+        trace_record_batch(recorder, operation, ids, tasks, amount);
+}
+
+static int __visit_tasks(db_connection* connection, __statement_id statement_id, const int id, const int limit,
+    int (*visitor)(void*, const int, const char*, const int), void* custom_state)
+{
+    sqlite3_stmt* stmt = __get_cached_statement(connection, statement_id);
+
+    if (stmt == NULL)
+    {
+        fprintf(stderr, "Query compilation failed: %s" NEWLINE, sqlite3_errmsg(connection->sqlite));
+        return -1;
+    }
+
+    int db_code = sqlite3_bind_int(stmt, 1, id);    // Add 'id'.
+
+    if (db_code == SQLITE_OK && sqlite3_bind_parameter_count(stmt) > 1)
+        db_code = sqlite3_bind_int(stmt, 2, (limit > 0) ? limit : -1);     // Add the limit. Negative means no limit.
+
+    int visited_amount = 0;
+
+    if (db_code == SQLITE_OK)
+        db_code = __step_statement(connection, stmt);
+
+    while (db_code == SQLITE_ROW)
+    {
+        int length = 0;
+        const char* task = __read_task_column(connection, stmt, 1, &length);
+
+        if (task == NULL)
+        {
+            db_code = SQLITE_CORRUPT;
+            break;
+        }
+
+        visited_amount++;
+
+        // The visitor reads straight from SQLite's row buffer, which is only valid until the next step.
+        if (visitor(custom_state, sqlite3_column_int(stmt, 0), task, length) != 0)
+        {
+            db_code = SQLITE_DONE;
+            break;
+        }
+
+        db_code = __step_statement(connection, stmt);
+    }
+
+    if (db_code != SQLITE_DONE)
+    {
+        fprintf(stderr, "SQLite query error: %s" NEWLINE, sqlite3_errmsg(connection->sqlite));
+        visited_amount = -1;
+    }
+
+    // Return the statement to the cache.
+    sqlite3_reset(stmt);
+    sqlite3_clear_bindings(stmt);
+
+    return visited_amount;
+}
+
+/* Private Functions - Callbacks */
+
+static int __callback_count_tasks(void* custom_state, int column_amount, char** column_contents, char** column_names)
+{
+    UNUSED(column_amount, column_names);
+
+    *((int*)custom_state) = atoi(column_contents[0]);
     return 0;
 }
 
@@ -372,21 +3572,33 @@ static int __parameterized_callback_count_tasks(void* custom_state, sqlite3_stmt
     return 0;
 }
 
-static int __parameterized_callback_read_task(void* custom_state, sqlite3_stmt* stmt)
+static int __visitor_cache_task(void* custom_state, const int id, const char* task, const int length)
+{
+    __caching_visitor_state* caching_state = custom_state;
+
+    task_cache_fill(caching_state->cache, id, task, length, caching_state->generation);
+
+    return caching_state->visitor(caching_state->custom_state, id, task, length);
+}
+
+static int __visitor_copy_task(void* custom_state, const int id, const char* task, const int length)
 {
+    UNUSED(id);
+
     db_task* db_task = custom_state;
-    const char* task = (const char*)sqlite3_column_text(stmt, 0);
-    const int task_length = strlen(task) + 1;
-    char* content_copy = malloc(task_length);
+    char* content_copy = malloc(length + 1);
 
-    // Set the task's length.
-    int* amount_ptr = (int*)&db_task->length;
-    *amount_ptr = task_length;
+    if (content_copy == NULL)
+        return SQLITE_NOMEM;
+
+    memcpy(content_copy, task, length + 1);
+
+    // Set the task's length, which includes the null terminator.
+    int* length_ptr = (int*)&db_task->length;
+    *length_ptr = length + 1;
 
     // Set the task.
     db_task->task = content_copy;
 
-    strcpy(content_copy, task);
-
     return 0;
 }
\ No newline at end of file
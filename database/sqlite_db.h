@@ -3,7 +3,32 @@
 
     #include <sqlite3.h>
     #include <stddef.h>
+    #include <stdint.h>
+    #include <pthread.h>
     #include "../utilities/utilities.h"
+    #include "./task_cache.h"
+
+    /// @brief A single connection to the database.
+    /// @attention Only used internally by the database layer.
+    typedef struct db_connection db_connection;
+
+    /// @brief Opaque handle to a database. It owns one writer connection in WAL mode
+    /// @brief and a pool of read-only connections, so it can be shared between threads.
+    /// @attention Must be manually closed with "close_sqlite_db()"!
+    typedef struct db_handle db_handle;
+
+    /// @brief Locates one task inside the string arena of a "db_tasks" object.
+    typedef struct db_tasks_entry
+    {
+        /// @brief The ID of the task.
+        int id;
+
+        /// @brief The length of the task, without the null terminator.
+        int length;
+
+        /// @brief The position of the first character of the task in the string arena.
+        size_t offset;
+    } db_tasks_entry;
 
     /// @brief Object that contains all tasks from the database.
     /// @attention Must be manually deallocated with "free_db_tasks()"!
@@ -12,11 +37,12 @@
         /// @brief The amount of tasks stored in this object.
         const int amount;
 
-        /// @brief An array of integers that contains all task IDs or NULL if there aren't any.
-        const int* task_ids;
+        /// @brief An array with the location of every task or NULL if there aren't any.
+        const db_tasks_entry* entries;
 
-        /// @brief An array of strings that contains all tasks or NULL if there aren't any.
-        const char** tasks;
+        /// @brief The null-terminated contents of all tasks stored back to back, or NULL if there aren't any.
+        /// @attention Use "db_tasks_get()" to get an individual task.
+        const char* arena;
     } db_tasks;
 
     /// @brief Object that contains one task from the database.
@@ -30,37 +56,239 @@
         const char* task;
     } db_task;
 
+    /// @brief How a connection waits for a lock held by another process before giving up with SQLITE_BUSY.
+    /// @brief Each retry sleeps for a random time between half and all of the current backoff, which doubles every retry.
+    typedef struct db_busy_policy
+    {
+        /// @brief How long to keep retrying, in milliseconds. Zero or less fails right away.
+        int timeout_ms;
+
+        /// @brief The backoff of the first retry, in microseconds.
+        int initial_backoff_us;
+
+        /// @brief The longest backoff, in microseconds.
+        int max_backoff_us;
+    } db_busy_policy;
+
+    /// @brief The amount of kinds of queries the statistics tell apart: one per prepared statement, plus
+    /// @brief "BEGIN", "COMMIT", "ROLLBACK" and every other statement run without being prepared.
+    #define DB_QUERY_KIND_AMOUNT 22
+
+    /// @brief Counters of one kind of query, summed over every connection of a handle.
+    typedef struct db_query_counters
+    {
+        /// @brief A short name for the query, like "select task" or "commit".
+        const char* name;
+
+        /// @brief How many times the query ran.
+        unsigned long calls;
+
+        /// @brief How many rows the query returned.
+        unsigned long rows;
+
+        /// @brief How many bytes the returned rows had, as stored. Numbers count as 8 bytes.
+        unsigned long bytes;
+
+        /// @brief How long every run took, in nanoseconds. "COMMIT" includes the time spent syncing the file.
+        uint64_t total_ns;
+
+        /// @brief How long the slowest run took, in nanoseconds.
+        uint64_t max_ns;
+
+        /// @brief How many times the query was compiled.
+        unsigned long prepares;
+
+        /// @brief How long compiling took, in nanoseconds.
+        uint64_t prepare_ns;
+    } db_query_counters;
+
+    /// @brief Counters of every kind of query of a handle.
+    typedef struct db_query_stats
+    {
+        /// @brief The counters of each kind of query.
+        db_query_counters queries[DB_QUERY_KIND_AMOUNT];
+    } db_query_stats;
+
+    /// @brief Cursor that streams the tasks of the database one row at a time.
+    /// @attention Must be manually closed with "db_tasks_close()"!
+    typedef struct db_tasks_cursor
+    {
+        /// @brief The ID of the current task.
+        const int id;
+
+        /// @brief The length of the current task, without the null terminator.
+        const int length;
+
+        /// @brief The current task. Only valid until the next call to "db_tasks_next()" or "db_tasks_close()".
+        const char* task;
+
+        /// @brief When the current task was created.
+        const time_t created_at;
+
+        /// @brief Whether the cursor stopped because of an error instead of reaching the last task.
+        const bool failed;
+
+        /// @brief The compiled statement that produces the rows or NULL if the cursor is closed.
+        sqlite3_stmt* stmt;
+
+        /// @brief The database the cursor reads from.
+        const db_handle* db;
+
+        /// @brief The pooled connection held by the cursor until it's closed.
+        db_connection* connection;
+    } db_tasks_cursor;
+
     /// @brief Gets the database of this program.
     /// @return The database or NULL if the database could not be created or read.
-    extern const sqlite3* get_db();
+    extern const db_handle* get_db();
+
+    /// @brief Creates and opens a SQLite database at the specified location, with one reader per processor.
+    /// @param db_location The absolute path to the database file.
+    /// @return The database or NULL if the file could not be created or is not a valid SQLite database.
+    extern const db_handle* create_sqlite_db(const char* db_location);
 
     /// @brief Creates and opens a SQLite database at the specified location.
     /// @param db_location The absolute path to the database file.
+    /// @param reader_capacity The maximum amount of read-only connections. They are opened on demand.
+    /// @attention A thread that holds a cursor must not wait on another reader when the pool has a single connection.
     /// @return The database or NULL if the file could not be created or is not a valid SQLite database.
-    extern const sqlite3* create_sqlite_db(const char* db_location);
+    extern const db_handle* create_sqlite_db_pool(const char* db_location, const int reader_capacity);
+
+    /// @brief Gets how many read-only connections the database may open.
+    /// @param db The database.
+    /// @return The maximum amount of read-only connections.
+    extern int get_reader_capacity(const db_handle* db);
+
+    /// @brief Finalizes all cached statements of the specified database and closes all of its connections.
+    /// @attention No other thread may be using the database.
+    /// @param db The database.
+    extern void close_sqlite_db(const db_handle* db);
 
     /// @brief Gets the task with the specified ID from the database.
     /// @param db The database.
     /// @param id The ID of the task.
     /// @return The requested task, or NULL if it's not found.
-    extern db_task get_task(const sqlite3* db, const int id);
+    extern db_task get_task(const db_handle* db, const int id);
+
+    /// @brief Lends the task with the specified ID to a visitor, without copying it.
+    /// @param db The database.
+    /// @param id The ID of the task.
+    /// @param visitor The function that receives the ID, content and length of the task. The content
+    /// @param visitor points into SQLite's row buffer or the task cache and is only valid until the visitor returns.
+    /// @param visitor The visitor must not use the database handle.
+    /// @param custom_state Pointer to an object that's being passed into the visitor.
+    /// @return True if the task was found, False otherwise.
+    extern bool with_task(const db_handle* db, const int id, int (*visitor)(void*, const int, const char*, const int), void* custom_state);
+
+    /// @brief Lends the tasks that come after the specified ID to a visitor, one at a time and without copying them.
+    /// @attention The visitor must not use the database when the reader pool has a single connection.
+    /// @param db The database.
+    /// @param after_id Only tasks with a higher ID are visited. Zero visits from the first task.
+    /// @param limit The maximum amount of tasks to visit. Zero or less visits all of them.
+    /// @param visitor The function that receives the ID, content and length of each task, ordered by ID. The content
+    /// @param visitor is only valid until the visitor returns. Returning non-zero stops the iteration.
+    /// @param custom_state Pointer to an object that's being passed into the visitor.
+    /// @return How many tasks were visited or -1 if an error occurred.
+    extern int for_each_task(const db_handle* db, const int after_id, const int limit, int (*visitor)(void*, const int, const char*, const int), void* custom_state);
+
+    /// @brief Reads part of the first task after the specified ID with incremental blob I/O, without loading the rest of it.
+    /// @brief Tasks compressed a chunk at a time only have the chunks that overlap the part decompressed.
+    /// @param db The database.
+    /// @param after_id The task is the first one with a higher ID. To read more of a task, pass its ID minus one.
+    /// @param offset The byte of the task the part starts at.
+    /// @param buffer Receives the part. It's not null-terminated.
+    /// @param capacity The maximum size of the part.
+    /// @param id Receives the ID of the task.
+    /// @param length Receives the length of the whole task.
+    /// @return The size of the part, which is zero past the end of the task, or -1 if there's no task after the ID or an error occurred.
+    extern int read_task_part(const db_handle* db, const int after_id, const long offset, char* buffer, const int capacity, int* id, long* length);
+
+    /// @brief Finds where the page that ends right before the specified ID starts.
+    /// @param db The database.
+    /// @param first_id The ID of the first task of the current page.
+    /// @param limit The amount of tasks per page.
+    /// @return The "after_id" of the previous page or -1 if there are no tasks before "first_id".
+    extern int find_previous_page(const db_handle* db, const int first_id, const int limit);
 
     /// @brief Gets all tasks in the database.
     /// @attention Must be manually deallocated!
     /// @param db The database.
     /// @return An object that contains all tasks from the database.
-    extern db_tasks get_all_tasks(const sqlite3* db);
+    extern db_tasks get_all_tasks(const db_handle* db);
+
+    /// @brief Gets the tasks that come after the specified ID.
+    /// @attention Must be manually deallocated with "free_db_tasks()"!
+    /// @param db The database.
+    /// @param after_id The ID of the last task of the previous page, or zero to get the first page.
+    /// @param limit The maximum amount of tasks in the page.
+    /// @return The tasks of the page, ordered by ID.
+    extern db_tasks get_tasks_page(const db_handle* db, const int after_id, const int limit);
 
-    /// @brief Counts how many tasks are stored.
+    /// @brief Gets the tasks that come right before the specified ID.
+    /// @attention Must be manually deallocated with "free_db_tasks()"!
     /// @param db The database.
-    /// @return The amount of tasks in the database.
-    extern int count_tasks(const sqlite3* db);
+    /// @param before_id The ID of the first task of the next page.
+    /// @param limit The maximum amount of tasks in the page.
+    /// @return The tasks of the page, ordered by ID.
+    extern db_tasks get_tasks_page_before(const db_handle* db, const int before_id, const int limit);
+
+    /// @brief The statement "get_tasks_between()" prepares, bound to the start and the end of the range.
+    #define DB_TASKS_BETWEEN_QUERY "SELECT id, task FROM tasks WHERE created_at >= ? AND created_at < ? ORDER BY created_at, id;"
+
+    /// @brief Gets the tasks created within the specified time range, through the index on their creation time.
+    /// @attention Must be manually deallocated with "free_db_tasks()"!
+    /// @param db The database.
+    /// @param from The start of the range, inclusive.
+    /// @param to The end of the range, exclusive.
+    /// @return The tasks of the range, oldest first.
+    extern db_tasks get_tasks_between(const db_handle* db, const time_t from, const time_t to);
+
+    /// @brief Searches the content of all tasks through the full-text index.
+    /// @attention Must be manually deallocated with "free_db_tasks()"!
+    /// @param db The database.
+    /// @param query The words to look for. A task must contain every word, each one matched as a prefix, in its first 256 KiB.
+    /// @param limit The maximum amount of results. Zero or less means no limit.
+    /// @return The matching tasks, best match first (BM25). Each task is a snippet with the matches between square brackets.
+    extern db_tasks search_tasks(const db_handle* db, const char* query, const int limit);
+
+    /// @brief Gets the task at the specified position of a "db_tasks" object.
+    /// @param db_tasks The tasks.
+    /// @param index The position of the task, between zero and "db_tasks->amount - 1".
+    /// @return The task. It's owned by the db_tasks object.
+    extern const char* db_tasks_get(const db_tasks* db_tasks, const int index);
+
+    /// @brief Opens a cursor over all tasks in the database, ordered by ID.
+    /// @attention Must be manually closed with "db_tasks_close()"!
+    /// @param db The database.
+    /// @return The cursor. Its first row is read by "db_tasks_next()".
+    extern db_tasks_cursor db_tasks_open(const db_handle* db);
+
+    /// @brief Moves the cursor to the next task.
+    /// @param cursor The cursor.
+    /// @return True if the cursor now points to a task, False if there are no more tasks or an error occurred.
+    extern bool db_tasks_next(db_tasks_cursor* cursor);
+
+    /// @brief Releases the resources used by the specified cursor.
+    /// @param cursor The cursor to be closed.
+    extern void db_tasks_close(db_tasks_cursor* cursor);
+
+    /// @brief Counts how many tasks are stored, in constant time.
+    /// @param db The database.
+    /// @return The amount of tasks in the database or -1 if an error occurred.
+    extern int count_tasks(const db_handle* db);
+
+    /// @brief Finds the lowest and the highest ID in use, in logarithmic time.
+    /// @param db The database.
+    /// @param first_id Receives the lowest ID, or zero if there are no tasks.
+    /// @param last_id Receives the highest ID, or zero if there are no tasks.
+    /// @return True if the IDs were found, False if an error occurred.
+    extern bool get_task_id_bounds(const db_handle* db, int* first_id, int* last_id);
 
     /// @brief Checks if a task with the specified ID exists in the database.
     /// @param db The database.
     /// @param id The ID of the task.
     /// @return True if the task exists, False otherwise.
-    extern bool task_exists(const sqlite3* db, const int id);
+    extern bool task_exists(const db_handle* db, const int id);
 
     /// @brief Deallocates the memory used by the specified db_task.
     /// @param db_task The db_task to deallocate memory from.
@@ -74,18 +302,191 @@
     /// @param db The database.
     /// @param task The task to be added.
     /// @return True if the task was successfully written to the database, False otherwise.
-    extern bool insert_task(const sqlite3* db, const char* task);
+    extern bool insert_task(const db_handle* db, const char* task);
+
+    /// @brief Adds the specified task to the database and gets the ID it was given.
+    /// @param db The database.
+    /// @param task The task to be added.
+    /// @return The ID of the new task or -1 if it could not be written to the database.
+    extern int add_task(const db_handle* db, const char* task);
+
+    /// @brief Adds a task read from a file descriptor until the input ends, holding no more than a fixed-size chunk of it in memory.
+    /// @brief Tasks larger than a chunk are compressed a chunk at a time and written into their row with incremental blob I/O.
+    /// @brief Files are read twice, to measure the task before writing it, while the frames of a pipe are staged in a temporary file.
+    /// @brief The input is read before the writer is taken, so other writes go on while it's being produced.
+    /// @attention Only the first 256 KiB of the task are added to the full-text index.
+    /// @param db The database.
+    /// @param fd The file descriptor to read from, such as stdin or an open file. The content is stored as is.
+    /// @return The ID of the new task or -1 with "errno" set to ENODATA if the input is empty or only has line breaks, EILSEQ if it contains null characters, or EIO or ENOMEM if it could not be read or written to the database.
+    extern int add_task_from_fd(const db_handle* db, const int fd);
 
     /// @brief Removes the task with the specified ID from the database.
     /// @param db The database.
     /// @param id The ID of the task to be removed.
     /// @return True if the task was successfully removed from the database, False otherwise.
-    extern bool delete_task(const sqlite3* db, const int id);
+    extern bool delete_task(const db_handle* db, const int id);
 
     /// @brief Updates the task with the specified ID in the database.
     /// @param db The database.
     /// @param id The ID of the task.
     /// @param new_task The new content of the task.
     /// @return True if the task was successfully updated, False otherwise.
-    extern bool update_task(const sqlite3* db, const int id, const char* new_task);
+    extern bool update_task(const db_handle* db, const int id, const char* new_task);
+
+    /// @brief Puts a least-recently-used cache of tasks in front of "get_task()" and "with_task()".
+    /// @brief Writes made through this handle update or invalidate the cached tasks.
+    /// @attention Must be called before the handle is shared between threads.
+    /// @param db The database.
+    /// @param byte_budget The maximum amount of memory the cache may use. Zero removes the cache (default).
+    /// @return True if the cache was set, False if there was not enough memory.
+    extern bool set_task_cache_budget(const db_handle* db, const size_t byte_budget);
+
+    /// @brief Gets the hit and miss counters of the task cache.
+    /// @param db The database.
+    /// @return The counters, all zero if the handle has no cache.
+    extern task_cache_stats get_task_cache_stats(const db_handle* db);
+
+    /// @brief Gets how often each kind of query ran, how many rows and bytes it returned and how long it took.
+    /// @brief The counters are always on: they're updated without locks by the thread using each connection.
+    /// @param db The database.
+    /// @return The counters, summed over every connection.
+    extern db_query_stats get_query_stats(const db_handle* db);
+
+    /// @brief Writes the query counters and the task cache counters to a file as JSON.
+    /// @param db The database.
+    /// @param stats_location The path of the file. It's replaced if it exists.
+    /// @return True if the file was written, False otherwise.
+    extern bool save_query_stats(const db_handle* db, const char* stats_location);
+
+    /// @brief Profiles every statement with "sqlite3_trace_v2()" and writes the ones slower than a threshold to stderr,
+    /// @brief without their parameters. Each connection picks the threshold up the next time it's used.
+    /// @param db The database.
+    /// @param threshold_ms The threshold, in milliseconds. Zero or less stops profiling (default).
+    extern void set_slow_query_threshold(const db_handle* db, const int threshold_ms);
+
+    /// @brief Starts recording every public call of the database to a binary trace file (see "trace.h"), with its
+    /// @brief operation, ID, text length and time. The text of the tasks is never recorded. Other threads may be using
+    /// @brief the database, and their calls are recorded from the moment the trace starts.
+    /// @param db The database.
+    /// @param trace_location The path of the trace file. It's replaced if it exists.
+    /// @return True if the recording started, False if the file could not be created or a trace is already being recorded.
+    extern bool start_trace_recording(const db_handle* db, const char* trace_location);
+
+    /// @brief Stops recording the trace and closes its file. Closing the database stops it too.
+    /// @attention Must not be called while other threads are using the database.
+    /// @param db The database.
+    /// @return True if every call was written to the trace, False otherwise.
+    extern bool stop_trace_recording(const db_handle* db);
+
+    /// @brief Sets how long a task must be to be stored compressed. Callers always see the plain text.
+    /// @param db The database.
+    /// @param threshold The minimum length, in bytes. Zero disables compression. Defaults to 4 KiB.
+    extern void set_compression_threshold(const db_handle* db, const size_t threshold);
+
+    /// @brief Registers the SQL functions the schema relies on, like "task_text()", which returns the plain text
+    /// @brief of a task whether it's stored compressed or not, and "task_index_text()", which returns the part of it that's indexed.
+    /// @attention Connections that weren't opened by this database layer must call this before writing to the tasks table.
+    /// @param sqlite The SQLite connection.
+    /// @return True if the functions were registered, False otherwise.
+    extern bool register_task_functions(sqlite3* sqlite);
+
+    /// @brief Sets how the connections of the database wait for other processes that hold the lock they need.
+    /// @brief Defaults to retrying for 5 seconds, with backoffs from 100 microseconds to 20 milliseconds.
+    /// @attention Must be called before the handle is shared between threads.
+    /// @param db The database.
+    /// @param policy The policy.
+    extern void set_busy_policy(const db_handle* db, const db_busy_policy policy);
+
+    /// @brief Sets how many operations a batch function commits per transaction.
+    /// @param db The database.
+    /// @param chunk_size The amount of operations per transaction. Zero or less commits the whole batch at once (default).
+    extern void set_batch_chunk_size(const db_handle* db, const int chunk_size);
+
+    /// @brief Adds the specified tasks to the database in as few transactions as the batch chunk size allows.
+    /// @param db The database.
+    /// @param tasks The tasks to be added.
+    /// @param amount The amount of tasks.
+    /// @param results Array of "amount" elements that receives whether each task was written. May be NULL.
+    /// @attention Each chunk is atomic: if a chunk can't be committed, none of its tasks are written.
+    /// @return How many tasks were written to the database.
+    extern int insert_tasks(const db_handle* db, const char** tasks, const int amount, bool* results);
+
+    /// @brief Removes the tasks with the specified IDs from the database in as few transactions as the batch chunk size allows.
+    /// @param db The database.
+    /// @param ids The IDs of the tasks to be removed.
+    /// @param amount The amount of IDs.
+    /// @param results Array of "amount" elements that receives whether each task was removed. May be NULL.
+    /// @attention Each chunk is atomic: if a chunk can't be committed, none of its tasks are removed.
+    /// @return How many tasks were removed from the database.
+    extern int delete_tasks(const db_handle* db, const int* ids, const int amount, bool* results);
+
+    /// @brief Updates the tasks with the specified IDs in as few transactions as the batch chunk size allows.
+    /// @param db The database.
+    /// @param ids The IDs of the tasks.
+    /// @param new_tasks The new content of each task.
+    /// @param amount The amount of tasks.
+    /// @param results Array of "amount" elements that receives whether each task was updated. May be NULL.
+    /// @attention Each chunk is atomic: if a chunk can't be committed, none of its tasks are updated.
+    /// @return How many tasks were updated.
+    extern int update_tasks(const db_handle* db, const int* ids, const char** new_tasks, const int amount, bool* results);
+
+    /// @brief Writes tasks with the specified IDs and creation times in as few transactions as the batch chunk size allows,
+    /// @brief replacing the tasks that already have those IDs. Used to restore tasks exported from another database.
+    /// @param db The database.
+    /// @param ids The IDs of the tasks.
+    /// @param tasks The content of each task.
+    /// @param created_at The creation time of each task.
+    /// @param amount The amount of tasks.
+    /// @param results Array of "amount" elements that receives whether each task was written. May be NULL.
+    /// @attention Each chunk is atomic: if a chunk can't be committed, none of its tasks are written.
+    /// @return How many tasks were written to the database.
+    extern int restore_tasks(const db_handle* db, const int* ids, const char** tasks, const time_t* created_at, const int amount, bool* results);
+
+    /// @brief Queues a task to be added to the database by the background writer, which commits
+    /// @brief every write that is waiting in the queue in a single transaction.
+    /// @attention Queued writes are only visible to readers once committed. Use "flush_writes()" to wait for them.
+    /// @param db The database.
+    /// @param task The task to be added. It is copied, so it can be freed right away.
+    /// @param callback Called from the writer thread once the write is committed or has failed, with
+    /// @param callback "custom_state", whether it succeeded and the ID of the task. May be NULL.
+    /// @param custom_state Pointer to an object that's being passed into the callback.
+    /// @return True if the task was queued, False otherwise.
+    extern bool insert_task_async(const db_handle* db, const char* task, void (*callback)(void*, const bool, const int), void* custom_state);
+
+    /// @brief Queues the removal of a task from the database. See "insert_task_async()".
+    /// @param db The database.
+    /// @param id The ID of the task to be removed.
+    /// @param callback Called from the writer thread once the write is committed or has failed. May be NULL.
+    /// @param custom_state Pointer to an object that's being passed into the callback.
+    /// @return True if the removal was queued, False otherwise.
+    extern bool delete_task_async(const db_handle* db, const int id, void (*callback)(void*, const bool, const int), void* custom_state);
+
+    /// @brief Queues an update to a task. See "insert_task_async()".
+    /// @param db The database.
+    /// @param id The ID of the task.
+    /// @param new_task The new content of the task. It is copied, so it can be freed right away.
+    /// @param callback Called from the writer thread once the write is committed or has failed. May be NULL.
+    /// @param custom_state Pointer to an object that's being passed into the callback.
+    /// @return True if the update was queued, False otherwise.
+    extern bool update_task_async(const db_handle* db, const int id, const char* new_task, void (*callback)(void*, const bool, const int), void* custom_state);
+
+    /// @brief Waits until every queued write has been committed or has failed.
+    /// @attention Must not be called from a write callback.
+    /// @param db The database.
+    /// @return True if every queued write since the previous flush succeeded, False otherwise.
+    extern bool flush_writes(const db_handle* db);
+
+    /// @brief Copies the database to a file while it stays in use, a few pages at a time.
+    /// @brief The writer is only held while a step copies its pages, so writes and reads keep going between steps.
+    /// @brief The copy is written to a temporary file that only replaces the backup once it's complete and consistent.
+    /// @param db The database.
+    /// @param backup_location The path of the backup file. It's replaced if it exists.
+    /// @param pages_per_step How many pages each step copies. Zero or less copies everything in one step.
+    /// @param step_pause_ms How long to wait between steps, in milliseconds.
+    /// @param progress Called after each step with the amount of copied pages and the total amount of pages.
+    /// @param progress Returning non-zero cancels the backup. May be NULL.
+    /// @param custom_state Pointer to an object that's being passed into the progress callback.
+    /// @return True if the backup was completed, False if it failed or was cancelled.
+    extern bool backup_sqlite_db(const db_handle* db, const char* backup_location, const int pages_per_step, const int step_pause_ms,
+        int (*progress)(void*, const int, const int), void* custom_state);
 #endif // SQLITEDB_H
\ No newline at end of file
@@ -0,0 +1,362 @@
+#include "./task_cache.h"
+
+/* Private Types */
+
+/// @brief A cached task.
+typedef struct __task_cache_entry
+{
+    /// @brief The ID of the task.
+    int id;
+
+    /// @brief The length of the task, without the null terminator.
+    int length;
+
+    /// @brief The null-terminated content of the task.
+    char* task;
+
+    /// @brief The next entry in the same hash bucket.
+    struct __task_cache_entry* next_in_bucket;
+
+    /// @brief The entry that was used right after this one, or NULL if this is the most recently used.
+    struct __task_cache_entry* newer;
+
+    /// @brief The entry that was used right before this one, or NULL if this is the least recently used.
+    struct __task_cache_entry* older;
+} __task_cache_entry;
+
+struct task_cache
+{
+    /// @brief Hash table of entries keyed by task ID. Its size is always a power of two.
+    __task_cache_entry** buckets;
+
+    /// @brief The amount of buckets.
+    int bucket_amount;
+
+    /// @brief The most recently used entry.
+    __task_cache_entry* newest;
+
+    /// @brief The least recently used entry, which is the first to be evicted.
+    __task_cache_entry* oldest;
+
+    /// @brief Incremented whenever a task is written or removed.
+    unsigned long generation;
+
+    /// @brief The usage counters.
+    task_cache_stats stats;
+
+    /// @brief Serializes access to the cache.
+    pthread_mutex_t lock;
+};
+
+/* Private Variables */
+
+/// @brief The amount of buckets of a new cache.
+static const int __initial_bucket_amount = 64;
+
+/* Function Prototyping */
+
+/// @brief Gets the bucket a task ID belongs to.
+/// @param cache The cache.
+/// @param id The ID of the task.
+/// @return Pointer to the head of the bucket.
+static __task_cache_entry** __get_bucket(const task_cache* cache, const int id);
+
+/// @brief Finds the entry of a task.
+/// @param cache The cache.
+/// @param id The ID of the task.
+/// @return The entry or NULL if the task is not cached.
+static __task_cache_entry* __find_entry(const task_cache* cache, const int id);
+
+/// @brief Gets how many bytes an entry counts against the byte budget.
+/// @param length The length of the task, without the null terminator.
+/// @return The amount of bytes.
+static size_t __entry_size(const int length);
+
+/// @brief Moves an entry to the front of the usage list.
+/// @param cache The cache.
+/// @param entry The entry, which may or may not be in the usage list already.
+static void __mark_as_newest(task_cache* cache, __task_cache_entry* entry);
+
+/// @brief Takes an entry out of the usage list and its bucket, and deallocates it.
+/// @param cache The cache.
+/// @param entry The entry.
+static void __remove_entry(task_cache* cache, __task_cache_entry* entry);
+
+/// @brief Doubles the amount of buckets, so chains stay short.
+/// @param cache The cache.
+static void __grow_buckets(task_cache* cache);
+
+/// @brief Adds a task to the cache or replaces its content, evicting the least recently used tasks until it fits.
+/// @param cache The locked cache.
+/// @param id The ID of the task.
+/// @param task The content of the task.
+/// @param length The length of the task, without the null terminator.
+static void __put_entry(task_cache* cache, const int id, const char* task, const int length);
+
+/* Public Functions */
+
+task_cache* create_task_cache(const size_t byte_budget)
+{
+    task_cache* cache = calloc(1, sizeof(task_cache));
+    __task_cache_entry** buckets = calloc(__initial_bucket_amount, sizeof(__task_cache_entry*));
+
+    if (cache == NULL || buckets == NULL)
+    {
+        free(cache);
+        free(buckets);
+
+        return NULL;
+    }
+
+    cache->buckets = buckets;
+    cache->bucket_amount = __initial_bucket_amount;
+    cache->stats.byte_budget = byte_budget;
+    pthread_mutex_init(&cache->lock, NULL);
+
+    return cache;
+}
+
+void free_task_cache(task_cache* cache)
+{
+    if (cache == NULL)
+        return;
+
+    while (cache->oldest != NULL)
+        __remove_entry(cache, cache->oldest);
+
+    pthread_mutex_destroy(&cache->lock);
+    free(cache->buckets);
+    free(cache);
+}
+
+bool task_cache_visit(task_cache* cache, const int id, int (*visitor)(void*, const int, const char*, const int), void* custom_state)
+{
+    pthread_mutex_lock(&cache->lock);
+
+    __task_cache_entry* entry = __find_entry(cache, id);
+
+    if (entry == NULL)
+        cache->stats.misses++;
+    else
+    {
+        cache->stats.hits++;
+        __mark_as_newest(cache, entry);
+        visitor(custom_state, entry->id, entry->task, entry->length);
+    }
+
+    pthread_mutex_unlock(&cache->lock);
+
+    return entry != NULL;
+}
+
+unsigned long task_cache_generation(task_cache* cache)
+{
+    pthread_mutex_lock(&cache->lock);
+    const unsigned long generation = cache->generation;
+    pthread_mutex_unlock(&cache->lock);
+
+    return generation;
+}
+
+void task_cache_fill(task_cache* cache, const int id, const char* task, const int length, const unsigned long generation)
+{
+    pthread_mutex_lock(&cache->lock);
+
+    // A write that happened while the task was being read may have made the read stale.
+    if (generation == cache->generation)
+        __put_entry(cache, id, task, length);
+
+    pthread_mutex_unlock(&cache->lock);
+}
+
+void task_cache_store(task_cache* cache, const int id, const char* task, const int length)
+{
+    pthread_mutex_lock(&cache->lock);
+
+    cache->generation++;
+    __put_entry(cache, id, task, length);
+
+    pthread_mutex_unlock(&cache->lock);
+}
+
+void task_cache_remove(task_cache* cache, const int id)
+{
+    pthread_mutex_lock(&cache->lock);
+
+    cache->generation++;
+
+    __task_cache_entry* entry = __find_entry(cache, id);
+
+    if (entry != NULL)
+        __remove_entry(cache, entry);
+
+    pthread_mutex_unlock(&cache->lock);
+}
+
+task_cache_stats task_cache_get_stats(task_cache* cache)
+{
+    pthread_mutex_lock(&cache->lock);
+    const task_cache_stats stats = cache->stats;
+    pthread_mutex_unlock(&cache->lock);
+
+    return stats;
+}
+
+/* Private Functions */
+
+static __task_cache_entry** __get_bucket(const task_cache* cache, const int id)
+{
+    // Fibonacci hashing spreads sequential IDs over the whole table.
+    const unsigned int hash = (unsigned int)id * 2654435769u;
+    return &cache->buckets[hash & (unsigned int)(cache->bucket_amount - 1)];
+}
+
+static __task_cache_entry* __find_entry(const task_cache* cache, const int id)
+{
+    __task_cache_entry* entry = *__get_bucket(cache, id);
+
+    while (entry != NULL && entry->id != id)
+        entry = entry->next_in_bucket;
+
+    return entry;
+}
+
+static size_t __entry_size(const int length)
+{
+    return sizeof(__task_cache_entry) + length + 1;
+}
+
+static void __mark_as_newest(task_cache* cache, __task_cache_entry* entry)
+{
+    if (cache->newest == entry)
+        return;
+
+    // Unlink the entry, if it's linked.
+    if (entry->older != NULL)
+        entry->older->newer = entry->newer;
+
+    if (entry->newer != NULL)
+        entry->newer->older = entry->older;
+
+    if (cache->oldest == entry)
+        cache->oldest = entry->newer;
+
+    // Put it in the front.
+    entry->older = cache->newest;
+    entry->newer = NULL;
+
+    if (cache->newest != NULL)
+        cache->newest->newer = entry;
+
+    cache->newest = entry;
+
+    if (cache->oldest == NULL)
+        cache->oldest = entry;
+}
+
+static void __remove_entry(task_cache* cache, __task_cache_entry* entry)
+{
+    __task_cache_entry** link = __get_bucket(cache, entry->id);
+
+    while (*link != entry)
+        link = &(*link)->next_in_bucket;
+
+    *link = entry->next_in_bucket;
+
+    if (entry->older != NULL)
+        entry->older->newer = entry->newer;
+    else
+        cache->oldest = entry->newer;
+
+    if (entry->newer != NULL)
+        entry->newer->older = entry->older;
+    else
+        cache->newest = entry->older;
+
+    cache->stats.used_bytes -= __entry_size(entry->length);
+    cache->stats.entry_amount--;
+
+    free(entry->task);
+    free(entry);
+}
+
+static void __grow_buckets(task_cache* cache)
+{
+    const int old_bucket_amount = cache->bucket_amount;
+    __task_cache_entry** old_buckets = cache->buckets;
+    __task_cache_entry** new_buckets = calloc(old_bucket_amount * 2, sizeof(__task_cache_entry*));
+
+    // Longer chains are slower, but still correct.
+    if (new_buckets == NULL)
+        return;
+
+    cache->buckets = new_buckets;
+    cache->bucket_amount = old_bucket_amount * 2;
+
+    for (int index = 0; index < old_bucket_amount; index++)
+    {
+        __task_cache_entry* entry = old_buckets[index];
+
+        while (entry != NULL)
+        {
+            __task_cache_entry* next_entry = entry->next_in_bucket;
+            __task_cache_entry** bucket = __get_bucket(cache, entry->id);
+
+            entry->next_in_bucket = *bucket;
+            *bucket = entry;
+            entry = next_entry;
+        }
+    }
+
+    free(old_buckets);
+}
+
+static void __put_entry(task_cache* cache, const int id, const char* task, const int length)
+{
+    __task_cache_entry* entry = __find_entry(cache, id);
+
+    // Drop the old version first, so it doesn't count against the budget.
+    if (entry != NULL)
+        __remove_entry(cache, entry);
+
+    const size_t entry_size = __entry_size(length);
+
+    if (entry_size > cache->stats.byte_budget)
+        return;
+
+    while (cache->stats.used_bytes + entry_size > cache->stats.byte_budget)
+    {
+        __remove_entry(cache, cache->oldest);
+        cache->stats.evictions++;
+    }
+
+    entry = calloc(1, sizeof(__task_cache_entry));
+    char* task_copy = malloc(length + 1);
+
+    if (entry == NULL || task_copy == NULL)
+    {
+        free(entry);
+        free(task_copy);
+
+        return;
+    }
+
+    memcpy(task_copy, task, length);
+    task_copy[length] = '\0';
+
+    entry->id = id;
+    entry->length = length;
+    entry->task = task_copy;
+
+    if (cache->stats.entry_amount >= cache->bucket_amount)
+        __grow_buckets(cache);
+
+    __task_cache_entry** bucket = __get_bucket(cache, id);
+    entry->next_in_bucket = *bucket;
+    *bucket = entry;
+
+    __mark_as_newest(cache, entry);
+
+    cache->stats.used_bytes += entry_size;
+    cache->stats.entry_amount++;
+}
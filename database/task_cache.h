@@ -0,0 +1,81 @@
+#ifndef TASKCACHE_H // Only include this header file if it hasn't been included in the calling file already
+    #define TASKCACHE_H
+
+    #include <stddef.h>
+    #include <pthread.h>
+    #include "../utilities/utilities.h"
+
+    /// @brief Bounded least-recently-used cache of task contents, keyed by task ID.
+    /// @attention Must be manually deallocated with "free_task_cache()"!
+    typedef struct task_cache task_cache;
+
+    /// @brief Counters that describe how a task cache is being used.
+    typedef struct task_cache_stats
+    {
+        /// @brief How many lookups found the task in the cache.
+        unsigned long hits;
+
+        /// @brief How many lookups had to go to the database.
+        unsigned long misses;
+
+        /// @brief How many tasks were evicted to stay within the byte budget.
+        unsigned long evictions;
+
+        /// @brief How many tasks are in the cache.
+        int entry_amount;
+
+        /// @brief How many bytes the cached tasks are using.
+        size_t used_bytes;
+
+        /// @brief The maximum amount of bytes the cached tasks may use.
+        size_t byte_budget;
+    } task_cache_stats;
+
+    /// @brief Creates an empty task cache.
+    /// @param byte_budget The maximum amount of bytes the cached tasks may use, bookkeeping included.
+    /// @return The cache or NULL if there was not enough memory.
+    extern task_cache* create_task_cache(const size_t byte_budget);
+
+    /// @brief Deallocates the memory used by the specified cache and all of its tasks.
+    /// @param cache The cache. May be NULL.
+    extern void free_task_cache(task_cache* cache);
+
+    /// @brief Lends a cached task to a visitor, marking it as the most recently used.
+    /// @attention The cache is locked while the visitor runs, so the visitor must not use the cache.
+    /// @param cache The cache.
+    /// @param id The ID of the task.
+    /// @param visitor The function that receives the ID, content and length of the task.
+    /// @param custom_state Pointer to an object that's being passed into the visitor.
+    /// @return True if the task was cached (a hit), False otherwise (a miss).
+    extern bool task_cache_visit(task_cache* cache, const int id, int (*visitor)(void*, const int, const char*, const int), void* custom_state);
+
+    /// @brief Gets the generation of the cache, which changes whenever a task is written or removed.
+    /// @param cache The cache.
+    /// @return The current generation.
+    extern unsigned long task_cache_generation(task_cache* cache);
+
+    /// @brief Caches a task read from the database, unless a write happened since the read started.
+    /// @param cache The cache.
+    /// @param id The ID of the task.
+    /// @param task The content of the task.
+    /// @param length The length of the task, without the null terminator.
+    /// @param generation The generation returned by "task_cache_generation()" before the task was read.
+    extern void task_cache_fill(task_cache* cache, const int id, const char* task, const int length, const unsigned long generation);
+
+    /// @brief Caches a task that was just written to the database, replacing any previous version.
+    /// @param cache The cache.
+    /// @param id The ID of the task.
+    /// @param task The content of the task.
+    /// @param length The length of the task, without the null terminator.
+    extern void task_cache_store(task_cache* cache, const int id, const char* task, const int length);
+
+    /// @brief Removes a task from the cache.
+    /// @param cache The cache.
+    /// @param id The ID of the task.
+    extern void task_cache_remove(task_cache* cache, const int id);
+
+    /// @brief Gets the usage counters of the cache.
+    /// @param cache The cache.
+    /// @return The counters.
+    extern task_cache_stats task_cache_get_stats(task_cache* cache);
+#endif // TASKCACHE_H
@@ -0,0 +1,338 @@
+#include <stdint.h>
+#include <pthread.h>
+#include "./trace.h"
+
+/* Private Types */
+
+/// @brief Appends the public calls of a database to a binary trace file.
+struct db_trace_recorder
+{
+    /// @brief The trace file.
+    FILE* file;
+
+    /// @brief Serializes the records, so their timestamps only ever increase.
+    pthread_mutex_t lock;
+
+    /// @brief When the recording started, in nanoseconds.
+    uint64_t started_at_ns;
+
+    /// @brief The timestamp of the last record, in microseconds since the recording started.
+    uint64_t last_timestamp_us;
+
+    /// @brief Whether every record so far was written.
+    bool is_healthy;
+};
+
+/// @brief Reads the records of a trace file one at a time.
+struct db_trace_reader
+{
+    /// @brief The trace file.
+    FILE* file;
+
+    /// @brief The timestamp of the last record read, in microseconds since the recording started.
+    uint64_t last_timestamp_us;
+
+    /// @brief Whether the reader stopped at a truncated or invalid record.
+    bool has_failed;
+};
+
+/* Private Variables */
+
+/// @brief The first bytes of every trace file.
+static const char __trace_magic[8] = { 'T', 'O', 'D', 'O', 'C', 'T', 'R', 'C' };
+
+/// @brief The size of the header of a trace file: the magic and the version.
+static const size_t __trace_header_length = 12;
+
+/// @brief The maximum size of an encoded record: the operation and three 64-bit variable-length integers.
+static const size_t __max_record_length = 1 + 3 * 10;
+
+/// @brief How many bytes the trace file buffers before writing them, so recording stays cheap.
+static const size_t __trace_buffer_size = 64 * 1024;
+
+/// @brief The name of each operation, indexed by "db_trace_operation".
+static const char* const __operation_names[DB_TRACE_OPERATION_AMOUNT] = {
+    [DB_TRACE_COUNT_TASKS] = "count_tasks",
+    [DB_TRACE_TASK_EXISTS] = "task_exists",
+    [DB_TRACE_GET_TASK] = "get_task",
+    [DB_TRACE_WITH_TASK] = "with_task",
+    [DB_TRACE_FOR_EACH_TASK] = "for_each_task",
+    [DB_TRACE_FIND_PREVIOUS_PAGE] = "find_previous_page",
+    [DB_TRACE_GET_ALL_TASKS] = "get_all_tasks",
+    [DB_TRACE_GET_TASKS_PAGE] = "get_tasks_page",
+    [DB_TRACE_GET_TASKS_PAGE_BEFORE] = "get_tasks_page_before",
+    [DB_TRACE_GET_TASKS_BETWEEN] = "get_tasks_between",
+    [DB_TRACE_SEARCH_TASKS] = "search_tasks",
+    [DB_TRACE_OPEN_CURSOR] = "db_tasks_open",
+    [DB_TRACE_ADD_TASK] = "add_task",
+    [DB_TRACE_DELETE_TASK] = "delete_task",
+    [DB_TRACE_UPDATE_TASK] = "update_task",
+    [DB_TRACE_INSERT_TASKS] = "insert_tasks",
+    [DB_TRACE_DELETE_TASKS] = "delete_tasks",
+    [DB_TRACE_UPDATE_TASKS] = "update_tasks",
+    [DB_TRACE_RESTORE_TASKS] = "restore_tasks",
+    [DB_TRACE_INSERT_TASK_ASYNC] = "insert_task_async",
+    [DB_TRACE_DELETE_TASK_ASYNC] = "delete_task_async",
+    [DB_TRACE_UPDATE_TASK_ASYNC] = "update_task_async",
+    [DB_TRACE_FLUSH_WRITES] = "flush_writes",
+    [DB_TRACE_BATCH_ITEM] = "batch item",
+    [DB_TRACE_GET_TASK_ID_BOUNDS] = "get_task_id_bounds",
+    [DB_TRACE_READ_TASK_PART] = "read_task_part",
+    [DB_TRACE_ASYNC_INSERT_COMMITTED] = "async insert committed"
+};
+
+/* Function Prototyping */
+
+/// @brief Encodes a record and appends it to the trace file.
+/// @attention The lock of the recorder must be held.
+/// @param recorder The recorder.
+/// @param operation The call.
+/// @param id The ID the call used or created.
+/// @param size The length of the text the call used, or its limit.
+static void __write_record(db_trace_recorder* recorder, const db_trace_operation operation, const int64_t id, const int64_t size);
+
+/// @brief Writes an unsigned integer with 7 bits per byte, setting the high bit of every byte but the last.
+/// @param destination Where to write the integer. Must have room for 10 bytes.
+/// @param value The integer.
+/// @return How many bytes were written.
+static size_t __write_varint(unsigned char* destination, uint64_t value);
+
+/// @brief Reads an unsigned integer written by "__write_varint()".
+/// @param file The file to read from.
+/// @param value Receives the integer.
+/// @return True if the integer was read, False if the file ended or the integer is too long.
+static bool __read_varint(FILE* file, uint64_t* value);
+
+/// @brief Maps a signed integer to an unsigned one, so small negative values stay small.
+/// @param value The signed integer.
+/// @return The zigzag-encoded integer.
+static uint64_t __zigzag_encode(const int64_t value);
+
+/// @brief Reverses "__zigzag_encode()".
+/// @param value The zigzag-encoded integer.
+/// @return The signed integer.
+static int64_t __zigzag_decode(const uint64_t value);
+
+/// @brief Gets a monotonic timestamp.
+/// @return The current time in nanoseconds.
+static uint64_t __get_time_ns();
+
+/* Public Functions */
+
+db_trace_recorder* create_trace_recorder(const char* trace_location)
+{
+    db_trace_recorder* recorder = calloc(1, sizeof(db_trace_recorder));
+    FILE* file = (recorder == NULL) ? NULL : fopen(trace_location, "wb");
+    unsigned char header[__trace_header_length];
+
+    memcpy(header, __trace_magic, sizeof(__trace_magic));
+    header[8] = TRACE_FORMAT_VERSION & 0xFF;
+    header[9] = (TRACE_FORMAT_VERSION >> 8) & 0xFF;
+    header[10] = (TRACE_FORMAT_VERSION >> 16) & 0xFF;
+    header[11] = (TRACE_FORMAT_VERSION >> 24) & 0xFF;
+
+    if (file == NULL || setvbuf(file, NULL, _IOFBF, __trace_buffer_size) != 0
+        || fwrite(header, 1, sizeof(header), file) != sizeof(header))
+    {
+        if (file != NULL)
+            fclose(file);
+
+        free(recorder);
+
+        return NULL;
+    }
+
+    recorder->file = file;
+    recorder->started_at_ns = __get_time_ns();
+    recorder->is_healthy = true;
+    pthread_mutex_init(&recorder->lock, NULL);
+
+    return recorder;
+}
+
+void trace_record(db_trace_recorder* recorder, const db_trace_operation operation, const int64_t id, const int64_t size)
+{
+    pthread_mutex_lock(&recorder->lock);
+    __write_record(recorder, operation, id, size);
+    pthread_mutex_unlock(&recorder->lock);
+}
+
+void trace_record_batch(db_trace_recorder* recorder, const db_trace_operation operation, const int* ids, const char** tasks, const int amount)
+{
+    pthread_mutex_lock(&recorder->lock);
+
+    __write_record(recorder, operation, max(0, amount), 0);
+
+    for (int index = 0; index < amount; index++)
+    {
+        const int64_t id = (ids == NULL) ? 0 : ids[index];
+        const int64_t size = (tasks == NULL || tasks[index] == NULL) ? 0 : (int64_t)strlen(tasks[index]);
+
+        __write_record(recorder, DB_TRACE_BATCH_ITEM, id, size);
+    }
+
+    pthread_mutex_unlock(&recorder->lock);
+}
+
+bool close_trace_recorder(db_trace_recorder* recorder)
+{
+    if (recorder == NULL)
+        return true;
+
+    const bool success = fclose(recorder->file) == 0 && recorder->is_healthy;
+
+    pthread_mutex_destroy(&recorder->lock);
+    free(recorder);
+
+    return success;
+}
+
+db_trace_reader* open_trace_reader(const char* trace_location)
+{
+    FILE* file = fopen(trace_location, "rb");
+    unsigned char header[__trace_header_length];
+
+    if (file == NULL)
+        return NULL;
+
+    const bool is_valid = fread(header, 1, sizeof(header), file) == sizeof(header)
+        && memcmp(header, __trace_magic, sizeof(__trace_magic)) == 0
+        && (header[8] | header[9] << 8 | header[10] << 16 | (uint32_t)header[11] << 24) == TRACE_FORMAT_VERSION;
+
+    db_trace_reader* reader = (is_valid) ? calloc(1, sizeof(db_trace_reader)) : NULL;
+
+    if (reader == NULL)
+    {
+        fclose(file);
+        return NULL;
+    }
+
+    reader->file = file;
+
+    return reader;
+}
+
+bool trace_reader_next(db_trace_reader* reader, db_trace_record* record)
+{
+    if (reader->has_failed)
+        return false;
+
+    const int operation = fgetc(reader->file);
+    uint64_t elapsed_us, id, size;
+
+    if (operation == EOF)
+        return false;
+
+    if (operation <= 0 || operation >= DB_TRACE_OPERATION_AMOUNT
+        || !__read_varint(reader->file, &elapsed_us)
+        || !__read_varint(reader->file, &id)
+        || !__read_varint(reader->file, &size))
+    {
+        reader->has_failed = true;
+        return false;
+    }
+
+    reader->last_timestamp_us += elapsed_us;
+
+    record->operation = (db_trace_operation)operation;
+    record->timestamp_us = reader->last_timestamp_us;
+    record->id = __zigzag_decode(id);
+    record->size = __zigzag_decode(size);
+
+    return true;
+}
+
+bool trace_reader_failed(const db_trace_reader* reader)
+{
+    return reader->has_failed;
+}
+
+void close_trace_reader(db_trace_reader* reader)
+{
+    if (reader == NULL)
+        return;
+
+    fclose(reader->file);
+    free(reader);
+}
+
+const char* trace_operation_name(const db_trace_operation operation)
+{
+    return (operation > 0 && operation < DB_TRACE_OPERATION_AMOUNT)
+        ? __operation_names[operation]
+        : "unknown";
+}
+
+/* Private Functions */
+
+static void __write_record(db_trace_recorder* recorder, const db_trace_operation operation, const int64_t id, const int64_t size)
+{
+    unsigned char record[__max_record_length];
+    size_t length = 0;
+
+    // The clock is read inside the lock, so the gaps between records are never negative.
+    const uint64_t timestamp_us = (__get_time_ns() - recorder->started_at_ns) / 1000;
+
+    record[length++] = (unsigned char)operation;
+    length += __write_varint(record + length, timestamp_us - recorder->last_timestamp_us);
+    length += __write_varint(record + length, __zigzag_encode(id));
+    length += __write_varint(record + length, __zigzag_encode(size));
+
+    recorder->last_timestamp_us = timestamp_us;
+
+    if (fwrite(record, 1, length, recorder->file) != length)
+        recorder->is_healthy = false;
+}
+
+static size_t __write_varint(unsigned char* destination, uint64_t value)
+{
+    size_t length = 0;
+
+    while (value >= 0x80)
+    {
+        destination[length++] = (unsigned char)(value | 0x80);
+        value >>= 7;
+    }
+
+    destination[length++] = (unsigned char)value;
+
+    return length;
+}
+
+static bool __read_varint(FILE* file, uint64_t* value)
+{
+    *value = 0;
+
+    for (int shift = 0; shift < 64; shift += 7)
+    {
+        const int byte = fgetc(file);
+
+        if (byte == EOF)
+            return false;
+
+        *value |= (uint64_t)(byte & 0x7F) << shift;
+
+        if ((byte & 0x80) == 0)
+            return true;
+    }
+
+    return false;
+}
+
+static uint64_t __zigzag_encode(const int64_t value)
+{
+    return ((uint64_t)value << 1) ^ (uint64_t)(value >> 63);
+}
+
+static int64_t __zigzag_decode(const uint64_t value)
+{
+    return (int64_t)(value >> 1) ^ -(int64_t)(value & 1);
+}
+
+static uint64_t __get_time_ns()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (uint64_t)now.tv_sec * 1000000000ull + (uint64_t)now.tv_nsec;
+}
@@ -0,0 +1,134 @@
+#ifndef TRACE_H // Only include this header file if it hasn't been included in the calling file already
+    #define TRACE_H
+
+    #include <stdio.h>
+    #include <stdint.h>
+    #include <pthread.h>
+    #include "../utilities/utilities.h"
+
+    /// @brief The version of the trace format written by "create_trace_recorder()".
+    #define TRACE_FORMAT_VERSION 1
+
+    /// @brief The public calls of the database that are recorded in a trace.
+    /// @attention Values are stored in trace files, so they must never be changed or reused. Add new ones at the end.
+    typedef enum db_trace_operation
+    {
+        DB_TRACE_COUNT_TASKS = 1,
+        DB_TRACE_TASK_EXISTS = 2,
+        DB_TRACE_GET_TASK = 3,
+        DB_TRACE_WITH_TASK = 4,
+        DB_TRACE_FOR_EACH_TASK = 5,
+        DB_TRACE_FIND_PREVIOUS_PAGE = 6,
+        DB_TRACE_GET_ALL_TASKS = 7,
+        DB_TRACE_GET_TASKS_PAGE = 8,
+        DB_TRACE_GET_TASKS_PAGE_BEFORE = 9,
+        DB_TRACE_GET_TASKS_BETWEEN = 10,
+        DB_TRACE_SEARCH_TASKS = 11,
+        DB_TRACE_OPEN_CURSOR = 12,
+        DB_TRACE_ADD_TASK = 13,
+        DB_TRACE_DELETE_TASK = 14,
+        DB_TRACE_UPDATE_TASK = 15,
+        DB_TRACE_INSERT_TASKS = 16,
+        DB_TRACE_DELETE_TASKS = 17,
+        DB_TRACE_UPDATE_TASKS = 18,
+        DB_TRACE_RESTORE_TASKS = 19,
+        DB_TRACE_INSERT_TASK_ASYNC = 20,
+        DB_TRACE_DELETE_TASK_ASYNC = 21,
+        DB_TRACE_UPDATE_TASK_ASYNC = 22,
+        DB_TRACE_FLUSH_WRITES = 23,
+
+        /// @brief One item of the batch recorded right before it. Never passed to "trace_record()".
+        DB_TRACE_BATCH_ITEM = 24,
+
+        DB_TRACE_GET_TASK_ID_BOUNDS = 25,
+        DB_TRACE_READ_TASK_PART = 26,
+
+        /// @brief The background writer committed an insert of "insert_task_async()". Not a call, so it's never replayed,
+        /// @brief but it gives the ID of the task, which later calls use.
+        DB_TRACE_ASYNC_INSERT_COMMITTED = 27,
+
+        /// @brief The amount of operations, plus one. Must be the last entry.
+        DB_TRACE_OPERATION_AMOUNT
+    } db_trace_operation;
+
+    /// @brief A single call read from a trace.
+    typedef struct db_trace_record
+    {
+        /// @brief The call.
+        db_trace_operation operation;
+
+        /// @brief When the call was made, in microseconds since the recording started.
+        uint64_t timestamp_us;
+
+        /// @brief The ID the call used or created. For batches, the amount of items that follow.
+        /// @brief For "get_tasks_between()", the start of the range. For "insert_task_async()", the number of the insert.
+        int64_t id;
+
+        /// @brief The length of the text the call wrote or searched for. For reads of several tasks, the limit.
+        /// @brief For "read_task_part()", the size of the buffer.
+        /// @brief For "get_tasks_between()", the length of the range in seconds.
+        /// @brief For the commit of an async insert, the number of the insert.
+        int64_t size;
+    } db_trace_record;
+
+    /// @brief Appends the public calls of a database to a binary trace file. Only sizes are kept, never the text of a task.
+    /// @brief The file has an 8-byte magic and a 4-byte little-endian version, followed by one record per call:
+    /// @brief the operation as a byte, then the time since the previous record in microseconds, the ID and the size
+    /// @brief as variable-length integers. The ID and the size are zigzag-encoded, so small negative values stay short.
+    /// @attention Must be manually closed with "close_trace_recorder()"!
+    typedef struct db_trace_recorder db_trace_recorder;
+
+    /// @brief Reads the records of a trace file one at a time.
+    /// @attention Must be manually closed with "close_trace_reader()"!
+    typedef struct db_trace_reader db_trace_reader;
+
+    /// @brief Creates a trace file and starts the recording clock.
+    /// @param trace_location The path of the trace file. It's replaced if it exists.
+    /// @return The recorder or NULL if the file could not be created.
+    extern db_trace_recorder* create_trace_recorder(const char* trace_location);
+
+    /// @brief Appends a call to the trace. Safe to call from several threads at once.
+    /// @param recorder The recorder.
+    /// @param operation The call.
+    /// @param id The ID the call used or created.
+    /// @param size The length of the text the call used, or its limit.
+    extern void trace_record(db_trace_recorder* recorder, const db_trace_operation operation, const int64_t id, const int64_t size);
+
+    /// @brief Appends a batch call to the trace, followed by one item per task, so no other call is recorded in between.
+    /// @param recorder The recorder.
+    /// @param operation The batch call.
+    /// @param ids The ID of each task or NULL if the call creates them.
+    /// @param tasks The text of each task or NULL if the call has none.
+    /// @param amount The amount of tasks.
+    extern void trace_record_batch(db_trace_recorder* recorder, const db_trace_operation operation, const int* ids, const char** tasks, const int amount);
+
+    /// @brief Writes the buffered records and closes the trace file.
+    /// @param recorder The recorder. May be NULL.
+    /// @return True if every record was written, False otherwise.
+    extern bool close_trace_recorder(db_trace_recorder* recorder);
+
+    /// @brief Opens a trace file, after checking its magic and version.
+    /// @param trace_location The path of the trace file.
+    /// @return The reader or NULL if the file could not be read or is not a valid trace.
+    extern db_trace_reader* open_trace_reader(const char* trace_location);
+
+    /// @brief Reads the next record of a trace.
+    /// @param reader The reader.
+    /// @param record Receives the record.
+    /// @return True if a record was read, False at the end of the trace or if the rest of it is invalid.
+    extern bool trace_reader_next(db_trace_reader* reader, db_trace_record* record);
+
+    /// @brief Tells if the reader stopped because the trace is truncated or invalid, instead of at its end.
+    /// @param reader The reader.
+    /// @return True if the trace is invalid, False otherwise.
+    extern bool trace_reader_failed(const db_trace_reader* reader);
+
+    /// @brief Closes a trace file.
+    /// @param reader The reader. May be NULL.
+    extern void close_trace_reader(db_trace_reader* reader);
+
+    /// @brief Gets the name of the public call an operation records, like "get_task".
+    /// @param operation The operation.
+    /// @return The name or "unknown" if the operation isn't valid.
+    extern const char* trace_operation_name(const db_trace_operation operation);
+#endif // TRACE_H
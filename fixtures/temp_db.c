@@ -0,0 +1,58 @@
+#include "./temp_db.h"
+
+/* Public Functions */
+
+const char* temp_db_create_path()
+{
+    char template[] = "/tmp/todoc_XXXXXX";
+    const int file_descriptor = mkstemp(template);
+
+    if (file_descriptor == -1)
+    {
+        fprintf(stderr, "Could not create a temporary database file." NEWLINE);
+        return NULL;
+    }
+
+    close(file_descriptor);
+
+    return str_append(template, "");
+}
+
+void temp_db_remove(const char* db_location)
+{
+    if (db_location == NULL)
+        return;
+
+    // SQLite may leave journal files behind.
+    const char* suffixes[] = { "-journal", "-wal", "-shm" };
+
+    for (size_t index = 0; index < sizeof(suffixes) / sizeof(suffixes[0]); index++)
+    {
+        const char* side_file = str_append(db_location, suffixes[index]);
+        unlink(side_file);
+        free((char*)side_file);
+    }
+
+    unlink(db_location);
+    free((char*)db_location);
+}
+
+bool temp_db_open_raw(const char* db_location, sqlite3** raw_db)
+{
+    // The triggers of the tasks table call SQL functions of the database layer.
+    return sqlite3_open(db_location, raw_db) == SQLITE_OK
+        && register_task_functions(*raw_db);
+}
+
+int temp_db_query_int(sqlite3* raw_db, const char* sql_query)
+{
+    sqlite3_stmt* stmt = NULL;
+    int result = -1;
+
+    if (sqlite3_prepare_v2(raw_db, sql_query, -1, &stmt, NULL) == SQLITE_OK && sqlite3_step(stmt) == SQLITE_ROW)
+        result = sqlite3_column_int(stmt, 0);
+
+    sqlite3_finalize(stmt);
+
+    return result;
+}
@@ -0,0 +1,28 @@
+#ifndef TEMP_DB_H // Only include this header file if it hasn't been included in the calling file already
+    #define TEMP_DB_H
+
+    #include "../database/sqlite_db.h"
+    #include "../utilities/utilities.h"
+
+    /// @brief Creates an empty database file in the temporary directory, for the tests and the benchmarks.
+    /// @attention Must be manually deallocated and removed with "temp_db_remove()"!
+    /// @return The absolute path to the database file or NULL if it could not be created.
+    extern const char* temp_db_create_path();
+
+    /// @brief Deletes the specified database file, with the journal files SQLite may leave behind, and deallocates its path.
+    /// @param db_location The path returned by "temp_db_create_path()". May be NULL.
+    extern void temp_db_remove(const char* db_location);
+
+    /// @brief Opens a plain SQLite connection to a database created by the database layer.
+    /// @attention Must be manually closed with "sqlite3_close()"!
+    /// @param db_location The path to the database file.
+    /// @param raw_db Receives the connection.
+    /// @return True if the connection is ready, False otherwise.
+    extern bool temp_db_open_raw(const char* db_location, sqlite3** raw_db);
+
+    /// @brief Runs a query that returns a single integer.
+    /// @param raw_db A plain SQLite connection to the database.
+    /// @param sql_query The query.
+    /// @return The first column of the first row or -1 if the query failed or returned no rows.
+    extern int temp_db_query_int(sqlite3* raw_db, const char* sql_query);
+#endif // TEMP_DB_H
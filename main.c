@@ -1,8 +1,11 @@
 #include "./core/core.h"
+#include "./core/cli.h"
 
 /// @brief The entry point of the application.
+/// @param argc The amount of command-line arguments.
+/// @param argv The command-line arguments. Without any, the interactive menu is opened.
 /// @return The exit code of the application.
-int main()
+int main(int argc, char** argv)
 {
-    return app_loop();
-}
\ No newline at end of file
+    return (argc > 1) ? run_command(argc, argv) : app_loop(NULL);
+}
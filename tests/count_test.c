@@ -0,0 +1,240 @@
+#include <signal.h>
+#include <sys/wait.h>
+#include "./test.h"
+
+/* Private Variables */
+
+/// @brief How many tasks the database starts with.
+static const int __initial_amount = 200;
+
+/// @brief How many tasks each transaction of a killed writer adds.
+static const int __batch_amount = 50;
+
+/// @brief How many writers are killed at a random point of their work.
+static const int __kill_rounds = 8;
+
+/// @brief The longest a writer runs before it's killed, in microseconds.
+static const int __max_kill_delay_us = 30000;
+
+/* Function Prototyping */
+
+/// @brief Opens the database through the database layer and checks that the counter matches the table.
+/// @param db_location The path to the database file.
+/// @param expected_amount The amount of tasks the database must have or -1 if it's not known.
+/// @return True if the counter matches, False otherwise.
+static bool __check_counter(const char* db_location, const int expected_amount);
+
+/// @brief Starts a child process that runs a writer, and waits until it's ready to be killed.
+/// @param db_location The path to the database file.
+/// @param writer The function the child runs. It must write a byte to its argument once it's ready, and never return.
+/// @return The ID of the child process or -1 if it could not be started.
+static pid_t __start_writer(const char* db_location, void (*writer)(const char*, const int));
+
+/// @brief Kills a child process and waits for it.
+/// @param pid The ID of the child process.
+/// @return True if the child was killed, False if it exited on its own.
+static bool __kill_writer(const pid_t pid);
+
+/// @brief Writer that leaves a transaction with inserts and deletes open until it's killed.
+/// @param db_location The path to the database file.
+/// @param ready_fd The pipe to signal once the transaction is open.
+static void __write_open_transaction(const char* db_location, const int ready_fd);
+
+/// @brief Writer that commits batches of inserts and deletes through the database layer until it's killed.
+/// @param db_location The path to the database file.
+/// @param ready_fd The pipe to signal once the first batch is committed.
+static void __write_batches(const char* db_location, const int ready_fd);
+
+/* Public Functions */
+
+/// @brief Checks that the trigger-maintained counter of "count_tasks()" matches "SELECT COUNT(*)" after
+/// @brief rolled back transactions and after writers are killed in the middle of their work.
+/// @return The exit code of the test.
+int main()
+{
+    const char* db_location = temp_db_create_path();
+    const db_handle* db = (db_location == NULL) ? NULL : create_sqlite_db(db_location);
+    const char** tasks = calloc(__initial_amount, sizeof(char*));
+    sqlite3* raw_db = NULL;
+
+    if (!TEST_ASSERT(db != NULL && tasks != NULL))
+    {
+        close_sqlite_db(db);
+        free(tasks);
+        temp_db_remove(db_location);
+
+        return test_finish("count");
+    }
+
+    for (int index = 0; index < __initial_amount; index++)
+        tasks[index] = "Task written before any crash.";
+
+    TEST_ASSERT(insert_tasks(db, tasks, __initial_amount, NULL) == __initial_amount);
+    TEST_ASSERT(count_tasks(db) == __initial_amount);
+
+    // A rolled back transaction with inserts and deletes leaves the counter where it was.
+    if (TEST_ASSERT(temp_db_open_raw(db_location, &raw_db)))
+    {
+        TEST_ASSERT(sqlite3_exec(raw_db,
+            "BEGIN;"
+            "INSERT INTO tasks (task, created_at) VALUES ('rolled back', 0), ('rolled back', 0), ('rolled back', 0);"
+            "DELETE FROM tasks WHERE id IN (1, 2);"
+            "ROLLBACK;", NULL, NULL, NULL) == SQLITE_OK);
+    }
+
+    sqlite3_close(raw_db);
+    TEST_ASSERT(count_tasks(db) == __initial_amount);
+
+    // Children must not inherit the threads of an open handle.
+    close_sqlite_db(db);
+    free(tasks);
+
+    TEST_ASSERT(__check_counter(db_location, __initial_amount));
+
+    // A writer killed while its transaction is open loses all of it, counter included.
+    const pid_t pid = __start_writer(db_location, __write_open_transaction);
+
+    if (TEST_ASSERT(pid > 0))
+        TEST_ASSERT(__kill_writer(pid));
+
+    TEST_ASSERT(__check_counter(db_location, __initial_amount));
+
+    // Writers killed at random points, including in the middle of a commit.
+    srand((unsigned int)getpid());
+
+    for (int round = 0; round < __kill_rounds; round++)
+    {
+        const pid_t batch_pid = __start_writer(db_location, __write_batches);
+
+        if (!TEST_ASSERT(batch_pid > 0))
+            break;
+
+        usleep(rand() % __max_kill_delay_us);
+        TEST_ASSERT(__kill_writer(batch_pid));
+        TEST_ASSERT(__check_counter(db_location, -1));
+    }
+
+    temp_db_remove(db_location);
+
+    return test_finish("count");
+}
+
+/* Private Functions */
+
+static bool __check_counter(const char* db_location, const int expected_amount)
+{
+    const db_handle* db = create_sqlite_db(db_location);
+    sqlite3* raw_db = NULL;
+
+    if (db == NULL || !temp_db_open_raw(db_location, &raw_db))
+    {
+        sqlite3_close(raw_db);
+        close_sqlite_db(db);
+
+        return false;
+    }
+
+    const int counted_amount = count_tasks(db);
+    const int row_amount = temp_db_query_int(raw_db, "SELECT COUNT(*) FROM tasks;");
+    const bool matches = counted_amount >= 0 && counted_amount == row_amount
+        && (expected_amount < 0 || counted_amount == expected_amount);
+
+    if (!matches)
+        fprintf(stderr, "count_tasks() returned %d, but the table has %d rows." NEWLINE, counted_amount, row_amount);
+
+    sqlite3_close(raw_db);
+    close_sqlite_db(db);
+
+    return matches;
+}
+
+static pid_t __start_writer(const char* db_location, void (*writer)(const char*, const int))
+{
+    int ready_pipe[2];
+    char ready_byte;
+
+    if (pipe(ready_pipe) != 0)
+        return -1;
+
+    const pid_t pid = fork();
+
+    if (pid == 0)
+    {
+        close(ready_pipe[0]);
+        writer(db_location, ready_pipe[1]);
+        _exit(EXIT_FAILURE);
+    }
+
+    close(ready_pipe[1]);
+
+    // The child only writes once it's ready, and the pipe closes without a byte if it fails before that.
+    const bool is_ready = pid > 0 && read(ready_pipe[0], &ready_byte, 1) == 1;
+
+    close(ready_pipe[0]);
+
+    if (pid > 0 && !is_ready)
+    {
+        __kill_writer(pid);
+        return -1;
+    }
+
+    return pid;
+}
+
+static bool __kill_writer(const pid_t pid)
+{
+    int status = 0;
+
+    kill(pid, SIGKILL);
+
+    return waitpid(pid, &status, 0) == pid && WIFSIGNALED(status);
+}
+
+static void __write_open_transaction(const char* db_location, const int ready_fd)
+{
+    sqlite3* raw_db = NULL;
+
+    const bool is_open = temp_db_open_raw(db_location, &raw_db)
+        && sqlite3_exec(raw_db,
+            "BEGIN IMMEDIATE;"
+            "WITH RECURSIVE counter(value) AS (SELECT 1 UNION ALL SELECT value + 1 FROM counter WHERE value < 100)"
+            "INSERT INTO tasks (task, created_at) SELECT 'never committed', value FROM counter;"
+            "DELETE FROM tasks WHERE id <= 50;", NULL, NULL, NULL) == SQLITE_OK;
+
+    if (is_open && write(ready_fd, "", 1) == 1)
+        pause();
+}
+
+static void __write_batches(const char* db_location, const int ready_fd)
+{
+    const db_handle* db = create_sqlite_db(db_location);
+    sqlite3* raw_db = NULL;
+    const bool is_open = db != NULL && temp_db_open_raw(db_location, &raw_db);
+    const char* tasks[__batch_amount];
+    int ids[__batch_amount / 2];
+    bool is_ready = false;
+
+    for (int index = 0; index < __batch_amount; index++)
+        tasks[index] = "Task written by a writer that gets killed.";
+
+    while (is_open)
+    {
+        if (insert_tasks(db, tasks, __batch_amount, NULL) != __batch_amount)
+            return;
+
+        // The new tasks end at the highest ID.
+        const int last_id = temp_db_query_int(raw_db, "SELECT MAX(id) FROM tasks;");
+
+        if (last_id < __batch_amount)
+            return;
+
+        // Remove half of the new tasks, so the counter goes both ways.
+        for (int index = 0; index < __batch_amount / 2; index++)
+            ids[index] = last_id - index * 2;
+
+        delete_tasks(db, ids, __batch_amount / 2, NULL);
+
+        if (!is_ready)
+            is_ready = write(ready_fd, "", 1) == 1;
+    }
+}
@@ -0,0 +1,185 @@
+#include "./test.h"
+#include "../database/export.h"
+
+/* Private Variables */
+
+/// @brief The tasks of the small export, with the characters each format has to escape.
+static const char* const __tasks[] = { "Plain note.", "A note that is deleted.", "Say \"hi\", then\nleave.", "Tab\there\x01" };
+
+/// @brief The amount of tasks of the small export.
+static const int __task_amount = sizeof(__tasks) / sizeof(__tasks[0]);
+
+/// @brief The ID of the task that is deleted, leaving a gap in the IDs.
+static const int __deleted_id = 2;
+
+/// @brief The small export as Markdown.
+static const char __expected_markdown[] = "## Note 1\n\nPlain note.\n\n## Note 3\n\nSay \"hi\", then\nleave.\n\n## Note 4\n\nTab\there\x01\n\n";
+
+/// @brief The small export as JSON Lines.
+static const char __expected_jsonl[] = "{\"id\":1,\"task\":\"Plain note.\"}\n{\"id\":3,\"task\":\"Say \\\"hi\\\", then\\nleave.\"}\n"
+    "{\"id\":4,\"task\":\"Tab\\there\\u0001\"}\n";
+
+/// @brief The small export as CSV.
+static const char __expected_csv[] = "id,task\r\n1,\"Plain note.\"\r\n3,\"Say \"\"hi\"\", then\nleave.\"\r\n4,\"Tab\there\x01\"\r\n";
+
+/// @brief How many tasks the large export writes, so that a single range holds more than its 1 MiB buffer.
+static const int __large_task_amount = 2500;
+
+/// @brief The length of each task of the large export.
+static const int __large_task_length = 4000;
+
+/* Function Prototyping */
+
+/// @brief Checks that exporting the database writes the expected file.
+/// @param db The database.
+/// @param export_location The path of the file.
+/// @param format The format of the file.
+/// @param thread_amount How many worker threads export the tasks.
+/// @param expected_amount How many tasks must be exported.
+/// @param expected_content The expected content of the file.
+/// @param expected_length The length of "expected_content".
+/// @return True if the export succeeded and wrote exactly the expected content, False otherwise.
+static bool __check_export(const db_handle* db, const char* export_location, const db_export_format format, const int thread_amount,
+    const int expected_amount, const char* expected_content, const size_t expected_length);
+
+/// @brief Reads a whole file into memory.
+/// @param file_location The path of the file.
+/// @param length Receives the size of the file.
+/// @return The content of the file, which must be freed, or NULL if it could not be read.
+static char* __read_file(const char* file_location, size_t* length);
+
+/// @brief Adds the tasks of the large export, each filled with a character that depends on its position.
+/// @param db The database.
+/// @return True if every task was added, False otherwise.
+static bool __add_large_tasks(const db_handle* db);
+
+/* Public Functions */
+
+/// @brief Checks that the text export escapes each format, skips deleted IDs, handles an empty database,
+/// @brief and writes the same file whatever the amount of threads, even when ranges outgrow their buffer.
+/// @return The exit code of the test.
+int main()
+{
+    const char* db_location = temp_db_create_path();
+    const char* export_location = (db_location == NULL) ? NULL : str_append(db_location, ".export");
+    const db_handle* db = (export_location == NULL) ? NULL : create_sqlite_db_pool(db_location, 4);
+
+    if (!TEST_ASSERT(db != NULL))
+    {
+        free((char*)export_location);
+        temp_db_remove(db_location);
+
+        return test_finish("export");
+    }
+
+    // An empty database still writes the header of the CSV file.
+    TEST_ASSERT(__check_export(db, export_location, DB_EXPORT_CSV, 2, 0, "id,task\r\n", 9));
+    TEST_ASSERT(__check_export(db, export_location, DB_EXPORT_JSONL, 2, 0, "", 0));
+
+    for (int index = 0; index < __task_amount; index++)
+        TEST_ASSERT(add_task(db, __tasks[index]) == index + 1);
+
+    TEST_ASSERT(delete_task(db, __deleted_id));
+
+    for (int thread_amount = 1; thread_amount <= 4; thread_amount += 3)
+    {
+        TEST_ASSERT(__check_export(db, export_location, DB_EXPORT_MARKDOWN, thread_amount, __task_amount - 1,
+            __expected_markdown, sizeof(__expected_markdown) - 1));
+        TEST_ASSERT(__check_export(db, export_location, DB_EXPORT_JSONL, thread_amount, __task_amount - 1,
+            __expected_jsonl, sizeof(__expected_jsonl) - 1));
+        TEST_ASSERT(__check_export(db, export_location, DB_EXPORT_CSV, thread_amount, __task_amount - 1,
+            __expected_csv, sizeof(__expected_csv) - 1));
+    }
+
+    // With one thread, each of its ranges holds more text than it may buffer, so workers write while they read.
+    size_t single_length = 0;
+    char* single_content = NULL;
+
+    TEST_ASSERT(__add_large_tasks(db));
+    TEST_ASSERT(export_tasks(db, export_location, DB_EXPORT_JSONL, 1) == __large_task_amount + __task_amount - 1);
+
+    if (TEST_ASSERT((single_content = __read_file(export_location, &single_length)) != NULL))
+    {
+        TEST_ASSERT(single_length > (size_t)__large_task_amount * __large_task_length);
+        TEST_ASSERT(__check_export(db, export_location, DB_EXPORT_JSONL, 4, __large_task_amount + __task_amount - 1,
+            single_content, single_length));
+    }
+
+    // A thread amount above the readers of the pool is capped instead of waiting for a reader forever.
+    TEST_ASSERT(__check_export(db, export_location, DB_EXPORT_JSONL, 32, __large_task_amount + __task_amount - 1,
+        single_content, single_length));
+
+    free(single_content);
+    close_sqlite_db(db);
+    remove(export_location);
+    free((char*)export_location);
+    temp_db_remove(db_location);
+
+    return test_finish("export");
+}
+
+/* Private Functions */
+
+static bool __check_export(const db_handle* db, const char* export_location, const db_export_format format, const int thread_amount,
+    const int expected_amount, const char* expected_content, const size_t expected_length)
+{
+    size_t length = 0;
+
+    if (expected_content == NULL || export_tasks(db, export_location, format, thread_amount) != expected_amount)
+        return false;
+
+    char* content = __read_file(export_location, &length);
+    const bool is_expected = content != NULL && length == expected_length && memcmp(content, expected_content, length) == 0;
+
+    free(content);
+
+    return is_expected;
+}
+
+static char* __read_file(const char* file_location, size_t* length)
+{
+    FILE* file = fopen(file_location, "rb");
+    char* content = NULL;
+
+    if (file == NULL)
+        return NULL;
+
+    if (fseek(file, 0, SEEK_END) == 0)
+    {
+        const long size = ftell(file);
+
+        if (size >= 0 && fseek(file, 0, SEEK_SET) == 0 && (content = malloc(size + 1)) != NULL)
+        {
+            *length = fread(content, 1, size, file);
+            content[*length] = '\0';
+        }
+    }
+
+    fclose(file);
+
+    return content;
+}
+
+static bool __add_large_tasks(const db_handle* db)
+{
+    const char** tasks = malloc(__large_task_amount * sizeof(*tasks));
+    char* text = malloc((size_t)__large_task_amount * (__large_task_length + 1));
+    bool success = tasks != NULL && text != NULL;
+
+    for (int index = 0; success && index < __large_task_amount; index++)
+    {
+        char* task = text + (size_t)index * (__large_task_length + 1);
+
+        memset(task, 'a' + index % 26, __large_task_length);
+        task[__large_task_length] = '\0';
+        tasks[index] = task;
+    }
+
+    if (success)
+        success = insert_tasks(db, tasks, __large_task_amount, NULL) == __large_task_amount;
+
+    free(tasks);
+    free(text);
+
+    return success;
+}
@@ -0,0 +1,144 @@
+#include <sys/wait.h>
+#include "./test.h"
+
+/* Private Variables */
+
+/// @brief The length of the task compressed in one piece.
+static const int __short_length = 10 * 1024;
+
+/// @brief The length of the tasks compressed a chunk at a time, which spans several chunks.
+static const int __long_length = 1024 * 1024 + 12345;
+
+/// @brief The sizes of the parts read from each task, including ones that don't line up with the chunks.
+static const int __part_sizes[] = { 1, 7, 4096, 65536, 300000 };
+
+/* Function Prototyping */
+
+/// @brief Fills a buffer with text that compresses well but isn't the same everywhere, so misplaced parts are noticed.
+/// @param text Receives the text and a null terminator.
+/// @param length The length of the text.
+static void __fill_text(char* text, const int length);
+
+/// @brief Checks that reading a task a part at a time gives back exactly the task.
+/// @param db The database.
+/// @param id The ID of the task.
+/// @param expected_task The content of the task.
+/// @param expected_length The length of the task.
+/// @return True if every part matched, False otherwise.
+static bool __check_parts(const db_handle* db, const int id, const char* expected_task, const long expected_length);
+
+/* Public Functions */
+
+/// @brief Checks that "read_task_part()" reads the right bytes of plain tasks, tasks compressed in one piece,
+/// @brief and tasks compressed a chunk at a time, whether they were added whole or streamed in.
+/// @return The exit code of the test.
+int main()
+{
+    const char* db_location = temp_db_create_path();
+    const db_handle* db = (db_location == NULL) ? NULL : create_sqlite_db(db_location);
+    char* long_task = malloc(__long_length + 1);
+    char* short_task = malloc(__short_length + 1);
+    int pipe_fds[2] = { -1, -1 };
+
+    if (!TEST_ASSERT(db != NULL && long_task != NULL && short_task != NULL))
+    {
+        close_sqlite_db(db);
+        free(long_task);
+        free(short_task);
+        temp_db_remove(db_location);
+
+        return test_finish("part");
+    }
+
+    __fill_text(long_task, __long_length);
+    __fill_text(short_task, __short_length);
+
+    const int plain_id = add_task(db, "A plain task, stored as it is.");
+    const int short_id = add_task(db, short_task);
+    const int long_id = add_task(db, long_task);
+    int streamed_id = -1;
+
+    // The streamed task is written to a pipe by a child, since it's larger than the pipe's buffer.
+    if (TEST_ASSERT(pipe(pipe_fds) == 0))
+    {
+        const pid_t pid = fork();
+
+        if (pid == 0)
+        {
+            close(pipe_fds[0]);
+            _exit((write(pipe_fds[1], long_task, __long_length) == __long_length) ? EXIT_SUCCESS : EXIT_FAILURE);
+        }
+
+        close(pipe_fds[1]);
+        streamed_id = add_task_from_fd(db, pipe_fds[0]);
+        close(pipe_fds[0]);
+
+        int status = 0;
+        TEST_ASSERT(pid > 0 && waitpid(pid, &status, 0) == pid && WIFEXITED(status) && WEXITSTATUS(status) == EXIT_SUCCESS);
+    }
+
+    TEST_ASSERT(plain_id > 0 && short_id > 0 && long_id > 0 && streamed_id > 0);
+
+    TEST_ASSERT(__check_parts(db, plain_id, "A plain task, stored as it is.", 30));
+    TEST_ASSERT(__check_parts(db, short_id, short_task, __short_length));
+    TEST_ASSERT(__check_parts(db, long_id, long_task, __long_length));
+    TEST_ASSERT(__check_parts(db, streamed_id, long_task, __long_length));
+
+    // Parts of the first task after an ID, past the end of a task, and after the last task.
+    char part[16];
+    int id = 0;
+    long length = 0;
+
+    TEST_ASSERT(read_task_part(db, 0, 2, part, sizeof(part), &id, &length) == (int)sizeof(part));
+    TEST_ASSERT(id == plain_id && length == 30 && memcmp(part, "plain task, stor", sizeof(part)) == 0);
+    TEST_ASSERT(read_task_part(db, plain_id - 1, 30, part, sizeof(part), &id, &length) == 0);
+    TEST_ASSERT(read_task_part(db, streamed_id, 0, part, sizeof(part), &id, &length) == -1);
+
+    close_sqlite_db(db);
+    free(long_task);
+    free(short_task);
+    temp_db_remove(db_location);
+
+    return test_finish("part");
+}
+
+/* Private Functions */
+
+static void __fill_text(char* text, const int length)
+{
+    for (int position = 0; position < length; position++)
+        text[position] = (position % 61 == 60) ? '\n' : (char)('a' + (position / 61) % 26);
+
+    text[length] = '\0';
+}
+
+static bool __check_parts(const db_handle* db, const int id, const char* expected_task, const long expected_length)
+{
+    const int largest_size = __part_sizes[sizeof(__part_sizes) / sizeof(__part_sizes[0]) - 1];
+    char* part = malloc(largest_size);
+    bool matches = part != NULL;
+
+    for (size_t index = 0; matches && index < sizeof(__part_sizes) / sizeof(__part_sizes[0]); index++)
+    {
+        // The smallest parts are only read around the ends of the chunks, so the test stays fast.
+        const long step = (__part_sizes[index] < 4096) ? 256 * 1024 - 3 : __part_sizes[index];
+
+        for (long offset = 0; matches && offset < expected_length; offset += step)
+        {
+            int part_id = 0;
+            long length = 0;
+            const long expected_part_length = (expected_length - offset < __part_sizes[index]) ? expected_length - offset : __part_sizes[index];
+            const int part_length = read_task_part(db, id - 1, offset, part, __part_sizes[index], &part_id, &length);
+
+            matches = part_id == id && length == expected_length && part_length == expected_part_length
+                && memcmp(part, expected_task + offset, part_length) == 0;
+
+            if (!matches)
+                fprintf(stderr, "Task %d: part of %d bytes at %ld read %d bytes." NEWLINE, id, __part_sizes[index], offset, part_length);
+        }
+    }
+
+    free(part);
+
+    return matches;
+}
@@ -0,0 +1,218 @@
+#include <stdatomic.h>
+#include "./test.h"
+
+/* Private Types */
+
+/// @brief The state shared by the writer and the reader threads.
+typedef struct __stress_state
+{
+    /// @brief The database.
+    const db_handle* db;
+
+    /// @brief The ID of the last task the writer committed, or zero before the first one.
+    atomic_int last_committed_id;
+
+    /// @brief Set when the writer is done.
+    atomic_bool is_writer_done;
+
+    /// @brief How many reads saw a committed task missing or with the wrong text.
+    atomic_int inconsistent_amount;
+
+    /// @brief How many times a reader saw the amount of tasks go down while the writer only adds them.
+    atomic_int shrink_amount;
+
+    /// @brief How many reads all reader threads completed.
+    atomic_long read_amount;
+} __stress_state;
+
+/// @brief The results of the queued writes.
+typedef struct __async_results
+{
+    /// @brief How many queued writes succeeded.
+    atomic_int succeeded_amount;
+
+    /// @brief How many queued writes failed.
+    atomic_int failed_amount;
+} __async_results;
+
+/* Private Variables */
+
+/// @brief How many readers share the pool.
+static const int __reader_amount = 4;
+
+/// @brief How many tasks the writer adds one at a time.
+static const int __insert_amount = 1000;
+
+/// @brief How many tasks are queued on the background writer.
+static const int __async_amount = 500;
+
+/* Function Prototyping */
+
+/// @brief Adds tasks one at a time and publishes the ID of each one once it's committed.
+/// @param custom_state The "__stress_state".
+/// @return NULL.
+static void* __writer_thread(void* custom_state);
+
+/// @brief Reads committed tasks and counts them until the writer is done, checking what it sees.
+/// @param custom_state The "__stress_state".
+/// @return NULL.
+static void* __reader_thread(void* custom_state);
+
+/// @brief Formats the text of the task the writer adds at a position.
+/// @param text Receives the text.
+/// @param size The size of "text".
+/// @param position The position of the task.
+static void __format_task(char* text, const size_t size, const int position);
+
+/// @brief Callback of the queued writes that counts their results.
+/// @param custom_state The "__async_results".
+/// @param success Whether the write was committed.
+/// @param id The ID of the task.
+static void __count_result(void* custom_state, const bool success, const int id);
+
+/* Public Functions */
+
+/// @brief Runs one writer and several readers against a pooled handle, then checks that no write was lost
+/// @brief and that every reader saw each task as soon as its write returned.
+/// @return The exit code of the test.
+int main()
+{
+    const char* db_location = temp_db_create_path();
+    __stress_state state = { .db = (db_location == NULL) ? NULL : create_sqlite_db_pool(db_location, __reader_amount) };
+    __async_results results;
+    pthread_t writer, readers[__reader_amount];
+    sqlite3* raw_db = NULL;
+
+    if (!TEST_ASSERT(state.db != NULL))
+    {
+        temp_db_remove(db_location);
+        return test_finish("pool");
+    }
+
+    atomic_init(&state.last_committed_id, 0);
+    atomic_init(&state.is_writer_done, false);
+    atomic_init(&state.inconsistent_amount, 0);
+    atomic_init(&state.shrink_amount, 0);
+    atomic_init(&state.read_amount, 0);
+    atomic_init(&results.succeeded_amount, 0);
+    atomic_init(&results.failed_amount, 0);
+
+    // Synchronous writes, read back from every pooled connection while they happen.
+    TEST_ASSERT(pthread_create(&writer, NULL, __writer_thread, &state) == 0);
+
+    for (int index = 0; index < __reader_amount; index++)
+        TEST_ASSERT(pthread_create(&readers[index], NULL, __reader_thread, &state) == 0);
+
+    pthread_join(writer, NULL);
+
+    for (int index = 0; index < __reader_amount; index++)
+        pthread_join(readers[index], NULL);
+
+    TEST_ASSERT(atomic_load(&state.last_committed_id) == __insert_amount);
+    TEST_ASSERT(atomic_load(&state.inconsistent_amount) == 0);
+    TEST_ASSERT(atomic_load(&state.shrink_amount) == 0);
+    TEST_ASSERT(atomic_load(&state.read_amount) > 0);
+
+    // Writes queued on the background writer, then a flush: none may be lost.
+    for (int position = 0; position < __async_amount; position++)
+        TEST_ASSERT(insert_task_async(state.db, "Queued task.", __count_result, &results));
+
+    TEST_ASSERT(flush_writes(state.db));
+    TEST_ASSERT(atomic_load(&results.succeeded_amount) == __async_amount);
+    TEST_ASSERT(atomic_load(&results.failed_amount) == 0);
+
+    // Remove every other synchronous task.
+    int deleted_amount = 0;
+
+    for (int id = 1; id <= __insert_amount; id += 2)
+        deleted_amount += TEST_ASSERT(delete_task(state.db, id));
+
+    const int expected_amount = __insert_amount + __async_amount - deleted_amount;
+
+    TEST_ASSERT(count_tasks(state.db) == expected_amount);
+
+    // A plain connection, outside the pool, must agree with the handle.
+    if (TEST_ASSERT(temp_db_open_raw(db_location, &raw_db)))
+        TEST_ASSERT(temp_db_query_int(raw_db, "SELECT COUNT(*) FROM tasks;") == expected_amount);
+
+    sqlite3_close(raw_db);
+    close_sqlite_db(state.db);
+    temp_db_remove(db_location);
+
+    return test_finish("pool");
+}
+
+/* Private Functions */
+
+static void* __writer_thread(void* custom_state)
+{
+    __stress_state* state = custom_state;
+    char task[64];
+
+    for (int position = 1; position <= __insert_amount; position++)
+    {
+        __format_task(task, sizeof(task), position);
+
+        if (!TEST_ASSERT(insert_task(state->db, task)))
+            break;
+
+        // The table starts empty, so each task gets the ID of its position.
+        atomic_store(&state->last_committed_id, position);
+    }
+
+    atomic_store(&state->is_writer_done, true);
+
+    return NULL;
+}
+
+static void* __reader_thread(void* custom_state)
+{
+    __stress_state* state = custom_state;
+    unsigned int seed = (unsigned int)(uintptr_t)pthread_self();
+    int last_count = 0;
+    long read_amount = 0;
+    char expected_task[64];
+
+    while (!atomic_load(&state->is_writer_done))
+    {
+        // Every task committed before the read started must be visible, on whichever connection serves it.
+        const int last_id = atomic_load(&state->last_committed_id);
+        const int count = count_tasks(state->db);
+
+        if (count < max(last_id, last_count))
+            atomic_fetch_add(&state->shrink_amount, 1);
+
+        last_count = max(count, last_count);
+
+        if (last_id == 0)
+            continue;
+
+        const int id = 1 + (int)(rand_r(&seed) % (unsigned int)last_id);
+        db_task db_task = get_task(state->db, id);
+
+        __format_task(expected_task, sizeof(expected_task), id);
+
+        if (db_task.task == NULL || strcmp(db_task.task, expected_task) != 0)
+            atomic_fetch_add(&state->inconsistent_amount, 1);
+
+        free_db_task(&db_task);
+        read_amount++;
+    }
+
+    atomic_fetch_add(&state->read_amount, read_amount);
+
+    return NULL;
+}
+
+static void __format_task(char* text, const size_t size, const int position)
+{
+    snprintf(text, size, "Task number %d, written while readers are running.", position);
+}
+
+static void __count_result(void* custom_state, const bool success, const int id)
+{
+    UNUSED(id);
+
+    __async_results* results = custom_state;
+    atomic_fetch_add((success) ? &results->succeeded_amount : &results->failed_amount, 1);
+}
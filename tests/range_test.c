@@ -0,0 +1,102 @@
+#include "./test.h"
+
+/* Function Prototyping */
+
+/// @brief Checks that the range query is answered through the index on the creation time.
+/// @param raw_db A plain connection to the database.
+static void __check_query_plan(sqlite3* raw_db);
+
+/// @brief Checks the IDs "get_tasks_between()" returns for a range, in order.
+/// @param db The database.
+/// @param from The start of the range.
+/// @param to The end of the range.
+/// @param expected_ids The IDs the range must return, in order.
+/// @param expected_amount The amount of IDs.
+/// @return True if the range returned exactly those IDs, False otherwise.
+static bool __check_range(const db_handle* db, const time_t from, const time_t to, const int* expected_ids, const int expected_amount);
+
+/* Public Functions */
+
+/// @brief Checks that "get_tasks_between()" uses the "tasks_created_at" index and respects the ends of its range.
+/// @return The exit code of the test.
+int main()
+{
+    const char* db_location = temp_db_create_path();
+    const db_handle* db = (db_location == NULL) ? NULL : create_sqlite_db(db_location);
+    sqlite3* raw_db = NULL;
+
+    // Creation times out of ID order, with a tie, so the order of the results is checked too.
+    const bool is_ready = TEST_ASSERT(db != NULL)
+        && TEST_ASSERT(temp_db_open_raw(db_location, &raw_db))
+        && TEST_ASSERT(sqlite3_exec(raw_db,
+            "INSERT INTO tasks (id, task, created_at) VALUES"
+            " (1, 'first', 1000), (2, 'second', 2000), (3, 'third', 2000), (4, 'fourth', 3000), (5, 'fifth', 1500);",
+            NULL, NULL, NULL) == SQLITE_OK);
+
+    if (is_ready)
+    {
+        __check_query_plan(raw_db);
+
+        // The start is inclusive and the end is exclusive.
+        TEST_ASSERT(__check_range(db, 1000, 3000, (const int[]){ 1, 5, 2, 3 }, 4));
+        TEST_ASSERT(__check_range(db, 1000, 3001, (const int[]){ 1, 5, 2, 3, 4 }, 5));
+        TEST_ASSERT(__check_range(db, 1001, 2000, (const int[]){ 5 }, 1));
+        TEST_ASSERT(__check_range(db, 2000, 2001, (const int[]){ 2, 3 }, 2));
+        TEST_ASSERT(__check_range(db, 3000, 3001, (const int[]){ 4 }, 1));
+
+        // Empty ranges, ranges without tasks and reversed ranges return nothing instead of failing.
+        TEST_ASSERT(__check_range(db, 2000, 2000, NULL, 0));
+        TEST_ASSERT(__check_range(db, 0, 1000, NULL, 0));
+        TEST_ASSERT(__check_range(db, 3001, 5000, NULL, 0));
+        TEST_ASSERT(__check_range(db, 3000, 1000, NULL, 0));
+    }
+
+    sqlite3_close(raw_db);
+    close_sqlite_db(db);
+    temp_db_remove(db_location);
+
+    return test_finish("range");
+}
+
+/* Private Functions */
+
+static void __check_query_plan(sqlite3* raw_db)
+{
+    // The plan is checked for the very statement the database layer prepares.
+    const char* plan_query = "EXPLAIN QUERY PLAN " DB_TASKS_BETWEEN_QUERY;
+    sqlite3_stmt* stmt = NULL;
+    bool uses_index = false, sorts = false;
+
+    if (TEST_ASSERT(sqlite3_prepare_v2(raw_db, plan_query, -1, &stmt, NULL) == SQLITE_OK))
+    {
+        while (sqlite3_step(stmt) == SQLITE_ROW)
+        {
+            const char* detail = (const char*)sqlite3_column_text(stmt, 3);
+
+            uses_index = uses_index || strstr(detail, "USING INDEX tasks_created_at") != NULL;
+            sorts = sorts || strstr(detail, "USE TEMP B-TREE") != NULL;
+        }
+    }
+
+    // The index already orders the rows, so they must not be sorted again.
+    TEST_ASSERT(uses_index);
+    TEST_ASSERT(!sorts);
+
+    sqlite3_finalize(stmt);
+}
+
+static bool __check_range(const db_handle* db, const time_t from, const time_t to, const int* expected_ids, const int expected_amount)
+{
+    db_tasks db_tasks = get_tasks_between(db, from, to);
+    bool matches = db_tasks.amount == expected_amount;
+
+    for (int index = 0; matches && index < expected_amount; index++)
+        matches = db_tasks.entries[index].id == expected_ids[index];
+
+    if (!matches)
+        fprintf(stderr, "Range [%lld, %lld) returned %d tasks." NEWLINE, (long long)from, (long long)to, db_tasks.amount);
+
+    free_db_tasks(&db_tasks);
+
+    return matches;
+}
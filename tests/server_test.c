@@ -0,0 +1,194 @@
+#include <errno.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include "./test.h"
+#include "../core/server.h"
+
+/* Private Variables */
+
+/// @brief How long the server may take to start listening, in milliseconds.
+static const int __startup_timeout_ms = 5000;
+
+/// @brief The note the client adds through the server.
+static const char __served_task[] = "A note added through the socket.";
+
+/* Function Prototyping */
+
+/// @brief Leaves a socket file behind that nothing listens on, like a server that crashed.
+/// @param address The address of the socket.
+/// @return True if the socket file was left behind, False otherwise.
+static bool __leave_stale_socket(const struct sockaddr_un* address);
+
+/// @brief Connects to the server, retrying until it listens or the startup timeout passes.
+/// @param address The address of the socket.
+/// @return The connected socket or -1 if the server never accepted the connection.
+static int __connect_to_server(const struct sockaddr_un* address);
+
+/// @brief Sends a request and reads its response.
+/// @param fd The connected socket.
+/// @param operation The operation of the request.
+/// @param payload The payload of the request or NULL.
+/// @param payload_length The size of the payload.
+/// @param response Receives the status and the payload of the response.
+/// @param capacity The size of "response".
+/// @return The size of the response or -1 if it could not be exchanged or doesn't fit.
+static int __exchange(const int fd, const unsigned char operation, const void* payload, const uint32_t payload_length,
+    unsigned char* response, const uint32_t capacity);
+
+/// @brief Sends or receives exactly the specified amount of bytes.
+/// @param fd The connected socket.
+/// @param buffer The bytes to send or the buffer that receives them.
+/// @param length The amount of bytes.
+/// @param is_sending Whether the bytes are sent, as opposed to received.
+/// @return True if every byte was transferred, False otherwise.
+static bool __transfer(const int fd, void* buffer, const size_t length, const bool is_sending);
+
+/* Public Functions */
+
+/// @brief Checks that the server replaces a stale socket but not a live one, answers requests,
+/// @brief and exits cleanly on SIGTERM with its writes committed and its socket removed.
+/// @return The exit code of the test.
+int main()
+{
+    const char* db_location = temp_db_create_path();
+    const char* socket_location = (db_location == NULL) ? NULL : str_append(db_location, ".sock");
+    struct sockaddr_un address = { .sun_family = AF_UNIX };
+
+    if (socket_location != NULL && strlen(socket_location) < sizeof(address.sun_path))
+        strcpy(address.sun_path, socket_location);
+
+    if (!TEST_ASSERT(address.sun_path[0] != '\0') || !TEST_ASSERT(__leave_stale_socket(&address)))
+    {
+        free((char*)socket_location);
+        temp_db_remove(db_location);
+
+        return test_finish("server");
+    }
+
+    // The server runs in its own process, so SIGTERM only stops it and not the test.
+    const pid_t pid = fork();
+
+    if (pid == 0)
+    {
+        const db_handle* served_db = create_sqlite_db(db_location);
+        const int exit_code = (served_db == NULL) ? EXIT_FAILURE : serve_socket(served_db, socket_location);
+
+        close_sqlite_db(served_db);
+        _exit(exit_code);
+    }
+
+    const int fd = (pid > 0) ? __connect_to_server(&address) : -1;
+    unsigned char response[16];
+    int status = 0;
+
+    TEST_ASSERT(fd >= 0);
+    TEST_ASSERT(__exchange(fd, SERVER_OP_PING, NULL, 0, response, sizeof(response)) == 1 && response[0] == SERVER_STATUS_OK);
+    TEST_ASSERT(__exchange(fd, SERVER_OP_ADD_TASK, __served_task, sizeof(__served_task) - 1, response, sizeof(response)) == 5
+        && response[0] == SERVER_STATUS_OK && response[1] == 1);
+
+    // A second server must leave the socket of the live one alone.
+    const db_handle* db = create_sqlite_db(db_location);
+
+    TEST_ASSERT(db != NULL && serve_socket(db, socket_location) == EADDRINUSE);
+    TEST_ASSERT(__exchange(fd, SERVER_OP_PING, NULL, 0, response, sizeof(response)) == 1 && response[0] == SERVER_STATUS_OK);
+
+    if (fd >= 0)
+        close(fd);
+
+    if (pid > 0)
+        kill(pid, SIGTERM);
+
+    TEST_ASSERT(pid > 0 && waitpid(pid, &status, 0) == pid && WIFEXITED(status) && WEXITSTATUS(status) == EXIT_SUCCESS);
+    TEST_ASSERT(access(socket_location, F_OK) != 0);
+    TEST_ASSERT(count_tasks(db) == 1);
+
+    close_sqlite_db(db);
+    unlink(socket_location);
+    free((char*)socket_location);
+    temp_db_remove(db_location);
+
+    return test_finish("server");
+}
+
+/* Private Functions */
+
+static bool __leave_stale_socket(const struct sockaddr_un* address)
+{
+    const int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    const bool is_bound = fd >= 0 && bind(fd, (const struct sockaddr*)address, sizeof(*address)) == 0;
+
+    // Closing the socket without unlinking it leaves a file that refuses connections.
+    if (fd >= 0)
+        close(fd);
+
+    return is_bound;
+}
+
+static int __connect_to_server(const struct sockaddr_un* address)
+{
+    for (int waited_ms = 0; waited_ms < __startup_timeout_ms; waited_ms += 10)
+    {
+        const int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+
+        if (fd >= 0 && connect(fd, (const struct sockaddr*)address, sizeof(*address)) == 0)
+            return fd;
+
+        if (fd >= 0)
+            close(fd);
+
+        usleep(10 * 1000);
+    }
+
+    return -1;
+}
+
+static int __exchange(const int fd, const unsigned char operation, const void* payload, const uint32_t payload_length,
+    unsigned char* response, const uint32_t capacity)
+{
+    unsigned char header[SERVER_LENGTH_SIZE + 1];
+    const uint32_t length = payload_length + 1;
+
+    for (int index = 0; index < SERVER_LENGTH_SIZE; index++)
+        header[index] = (unsigned char)(length >> (8 * index));
+
+    header[SERVER_LENGTH_SIZE] = operation;
+
+    if (fd < 0 || !__transfer(fd, header, sizeof(header), true) || !__transfer(fd, (void*)payload, payload_length, true)
+        || !__transfer(fd, header, SERVER_LENGTH_SIZE, false))
+        return -1;
+
+    uint32_t response_length = 0;
+
+    for (int index = 0; index < SERVER_LENGTH_SIZE; index++)
+        response_length |= (uint32_t)header[index] << (8 * index);
+
+    if (response_length > capacity || !__transfer(fd, response, response_length, false))
+        return -1;
+
+    return (int)response_length;
+}
+
+static bool __transfer(const int fd, void* buffer, const size_t length, const bool is_sending)
+{
+    size_t transferred_length = 0;
+
+    while (transferred_length < length)
+    {
+        const ssize_t result = (is_sending)
+            ? send(fd, (char*)buffer + transferred_length, length - transferred_length, MSG_NOSIGNAL)
+            : recv(fd, (char*)buffer + transferred_length, length - transferred_length, 0);
+
+        if (result < 0 && errno == EINTR)
+            continue;
+
+        if (result <= 0)
+            return false;
+
+        transferred_length += result;
+    }
+
+    return true;
+}
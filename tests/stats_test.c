@@ -0,0 +1,148 @@
+#include "./test.h"
+
+/* Private Variables */
+
+/// @brief The tasks the test adds, of different lengths.
+static const char* const __tasks[] = { "A short note.", "A somewhat longer note, to count more bytes.", "Another note." };
+
+/// @brief The amount of tasks the test adds.
+static const int __task_amount = sizeof(__tasks) / sizeof(__tasks[0]);
+
+/* Function Prototyping */
+
+/// @brief Finds the counters of a kind of query by its name.
+/// @param stats The statistics.
+/// @param name The name of the query.
+/// @return The counters or NULL if no query has that name.
+static const db_query_counters* __find_counters(const db_query_stats* stats, const char* name);
+
+/// @brief Checks that every kind of query has a name, and that no two kinds share one.
+/// @param stats The statistics.
+/// @return True if the names are set and unique, False otherwise.
+static bool __check_names(const db_query_stats* stats);
+
+/// @brief Checks that the statistics file holds the counters of a query as JSON.
+/// @param stats_location The path of the file.
+/// @param name The name of the query.
+/// @return True if the file starts the list of queries and has one with that name, False otherwise.
+static bool __check_stats_file(const char* stats_location, const char* name);
+
+/* Public Functions */
+
+/// @brief Checks that the query statistics count the calls, rows and bytes of each kind of query, and can be saved as JSON.
+/// @return The exit code of the test.
+int main()
+{
+    const char* db_location = temp_db_create_path();
+    const char* stats_location = (db_location == NULL) ? NULL : str_append(db_location, ".json");
+    const db_handle* db = (stats_location == NULL) ? NULL : create_sqlite_db(db_location);
+
+    if (!TEST_ASSERT(db != NULL))
+    {
+        free((char*)stats_location);
+        temp_db_remove(db_location);
+
+        return test_finish("stats");
+    }
+
+    // Opening the database already ran queries, so only the differences are checked.
+    const db_query_stats before = get_query_stats(db);
+    long task_bytes = 0;
+
+    for (int index = 0; index < __task_amount; index++)
+    {
+        TEST_ASSERT(add_task(db, __tasks[index]) > 0);
+        task_bytes += strlen(__tasks[index]);
+    }
+
+    TEST_ASSERT(count_tasks(db) == __task_amount);
+    TEST_ASSERT(count_tasks(db) == __task_amount);
+
+    db_tasks all_tasks = get_all_tasks(db);
+
+    TEST_ASSERT(all_tasks.amount == __task_amount);
+    free_db_tasks(&all_tasks);
+
+    const db_query_stats after = get_query_stats(db);
+    const db_query_counters* inserts_before = __find_counters(&before, "insert task");
+    const db_query_counters* inserts_after = __find_counters(&after, "insert task");
+    const db_query_counters* counts_before = __find_counters(&before, "count tasks");
+    const db_query_counters* counts_after = __find_counters(&after, "count tasks");
+    const db_query_counters* listings_before = __find_counters(&before, "select all tasks");
+    const db_query_counters* listings_after = __find_counters(&after, "select all tasks");
+
+    TEST_ASSERT(__check_names(&after));
+
+    if (TEST_ASSERT(inserts_before != NULL && inserts_after != NULL))
+    {
+        TEST_ASSERT(inserts_after->calls - inserts_before->calls == (unsigned long)__task_amount);
+        TEST_ASSERT(inserts_after->total_ns > inserts_before->total_ns && inserts_after->max_ns <= inserts_after->total_ns);
+        TEST_ASSERT(inserts_after->prepares >= 1);
+    }
+
+    if (TEST_ASSERT(counts_before != NULL && counts_after != NULL))
+    {
+        TEST_ASSERT(counts_after->calls - counts_before->calls == 2);
+        TEST_ASSERT(counts_after->rows - counts_before->rows == 2);
+    }
+
+    // The rows of the listing hold the text of every task, along with the ID and the creation time.
+    if (TEST_ASSERT(listings_before != NULL && listings_after != NULL))
+    {
+        TEST_ASSERT(listings_after->calls - listings_before->calls == 1);
+        TEST_ASSERT(listings_after->rows - listings_before->rows == (unsigned long)__task_amount);
+        TEST_ASSERT(listings_after->bytes - listings_before->bytes >= (unsigned long)task_bytes);
+    }
+
+    TEST_ASSERT(save_query_stats(db, stats_location));
+    TEST_ASSERT(__check_stats_file(stats_location, "insert task"));
+
+    close_sqlite_db(db);
+    remove(stats_location);
+    free((char*)stats_location);
+    temp_db_remove(db_location);
+
+    return test_finish("stats");
+}
+
+/* Private Functions */
+
+static const db_query_counters* __find_counters(const db_query_stats* stats, const char* name)
+{
+    for (int kind = 0; kind < DB_QUERY_KIND_AMOUNT; kind++)
+    {
+        if (stats->queries[kind].name != NULL && strcmp(stats->queries[kind].name, name) == 0)
+            return &stats->queries[kind];
+    }
+
+    return NULL;
+}
+
+static bool __check_names(const db_query_stats* stats)
+{
+    for (int kind = 0; kind < DB_QUERY_KIND_AMOUNT; kind++)
+    {
+        if (stats->queries[kind].name == NULL || __find_counters(stats, stats->queries[kind].name) != &stats->queries[kind])
+            return false;
+    }
+
+    return true;
+}
+
+static bool __check_stats_file(const char* stats_location, const char* name)
+{
+    FILE* file = fopen(stats_location, "r");
+    char content[8192];
+    char expected_name[64];
+
+    if (file == NULL)
+        return false;
+
+    const size_t length = fread(content, 1, sizeof(content) - 1, file);
+    content[length] = '\0';
+    fclose(file);
+
+    snprintf(expected_name, sizeof(expected_name), "{\"name\":\"%s\",", name);
+
+    return strncmp(content, "{\"queries\":[", 12) == 0 && strstr(content, expected_name) != NULL;
+}
@@ -0,0 +1,385 @@
+#include <errno.h>
+#include <stdatomic.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include "./test.h"
+
+/* Private Types */
+
+/// @brief A task streamed from a pipe by another thread.
+typedef struct __pipe_stream
+{
+    /// @brief The database.
+    const db_handle* db;
+
+    /// @brief The end of the pipe the task is read from.
+    int fd;
+
+    /// @brief The ID of the task or -1 if it could not be added.
+    int id;
+} __pipe_stream;
+
+/// @brief A write made while a task is being streamed.
+typedef struct __concurrent_write
+{
+    /// @brief The database.
+    const db_handle* db;
+
+    /// @brief The ID of the added task or -1 if it could not be added.
+    int id;
+
+    /// @brief Whether the write returned.
+    atomic_bool is_done;
+} __concurrent_write;
+
+/* Private Variables */
+
+/// @brief The length of each streamed task, many times larger than the memory a stream may use.
+static const long __task_length = 64L * 1024 * 1024;
+
+/// @brief How much the peak memory of the process may grow while a task is streamed in, in KiB.
+static const long __max_rss_growth_kib = 12 * 1024;
+
+/// @brief The size of the buffer the input is written with.
+static const int __write_buffer_size = 64 * 1024;
+
+/// @brief How long a write may wait while a pipe is still being read, in milliseconds.
+static const int __concurrent_write_timeout_ms = 5000;
+
+/// @brief The offsets the tasks are checked at, spread over the chunks and including their ends.
+static const long __checked_offsets[] = { 0, 262143, 262144, 5000000, 33554431, 64L * 1024 * 1024 - 100 };
+
+/* Function Prototyping */
+
+/// @brief Gets a byte of a task that compresses well.
+/// @param position The position of the byte.
+/// @return The byte.
+static char __compressible_byte(const long position);
+
+/// @brief Gets a byte of a task that doesn't compress, so its frames are stored as they are.
+/// @param position The position of the byte.
+/// @return The byte.
+static char __incompressible_byte(const long position);
+
+/// @brief Writes part of a task to a file descriptor, a buffer at a time.
+/// @param fd The file descriptor.
+/// @param get_byte Gets each byte of the task.
+/// @param from The position of the first byte written.
+/// @param to The position after the last byte written.
+/// @return True if the part was written, False otherwise.
+static bool __write_task(const int fd, char (*get_byte)(const long), const long from, const long to);
+
+/// @brief Streams a task from a pipe fed by a child process, which pauses halfway so another write can be made in between.
+/// @param db The database.
+/// @param get_byte Gets each byte of the task.
+/// @return The ID of the task or -1 if it could not be added.
+static int __stream_from_pipe(const db_handle* db, char (*get_byte)(const long));
+
+/// @brief Thread that streams a task from a pipe.
+/// @param custom_state The "__pipe_stream" of the task.
+/// @return NULL.
+static void* __pipe_stream_thread(void* custom_state);
+
+/// @brief Thread that adds a small task.
+/// @param custom_state The "__concurrent_write" of the task.
+/// @return NULL.
+static void* __concurrent_write_thread(void* custom_state);
+
+/// @brief Waits for a write made while a pipe is still being read, without waiting for the pipe to end.
+/// @param concurrent_write The write.
+/// @return True if the write returned in time, False otherwise.
+static bool __wait_for_write(__concurrent_write* concurrent_write);
+
+/// @brief Streams a task from a temporary file.
+/// @param db The database.
+/// @param get_byte Gets each byte of the task.
+/// @return The ID of the task or -1 if it could not be added.
+static int __stream_from_file(const db_handle* db, char (*get_byte)(const long));
+
+/// @brief Checks that an input is rejected for the specified reason, without adding a task.
+/// @param db The database.
+/// @param input The input.
+/// @param length The length of the input.
+/// @param expected_error_code The value "errno" must be set to.
+/// @return True if the input was rejected for that reason, False otherwise.
+static bool __check_rejected(const db_handle* db, const char* input, const size_t length, const int expected_error_code);
+
+/// @brief Gets the peak memory of the process.
+/// @return The peak resident set size, in KiB.
+static long __get_peak_rss_kib();
+
+/// @brief Checks that parts of a task read back as they were streamed.
+/// @param db The database.
+/// @param id The ID of the task.
+/// @param get_byte Gets each byte of the task.
+/// @return True if every part matched, False otherwise.
+static bool __check_task(const db_handle* db, const int id, char (*get_byte)(const long));
+
+/* Public Functions */
+
+/// @brief Checks that "add_task_from_fd()" streams large tasks from pipes and files without holding them in memory
+/// @brief or the writer while the input is read, that they read back intact, and that they're searchable and can be removed.
+/// @return The exit code of the test.
+int main()
+{
+    const char* db_location = temp_db_create_path();
+    const db_handle* db = (db_location == NULL) ? NULL : create_sqlite_db(db_location);
+
+    if (!TEST_ASSERT(db != NULL))
+    {
+        temp_db_remove(db_location);
+        return test_finish("stream");
+    }
+
+    // The database is opened and written to first, so only the streams count towards the growth of the peak.
+    TEST_ASSERT(add_task(db, "A note added before the large ones.") > 0);
+
+    const long initial_rss_kib = __get_peak_rss_kib();
+    const int piped_id = __stream_from_pipe(db, __incompressible_byte);
+    const long piped_rss_kib = __get_peak_rss_kib();
+    const int file_id = __stream_from_file(db, __compressible_byte);
+    const long file_rss_kib = __get_peak_rss_kib();
+
+    if (!TEST_ASSERT(piped_rss_kib - initial_rss_kib < __max_rss_growth_kib && file_rss_kib - initial_rss_kib < __max_rss_growth_kib))
+        fprintf(stderr, "The peak memory grew by %ld KiB from a pipe and %ld KiB in total." NEWLINE, piped_rss_kib - initial_rss_kib, file_rss_kib - initial_rss_kib);
+
+    TEST_ASSERT(piped_id > 0 && file_id > 0);
+    TEST_ASSERT(__check_task(db, piped_id, __incompressible_byte));
+    TEST_ASSERT(__check_task(db, file_id, __compressible_byte));
+    TEST_ASSERT(count_tasks(db) == 4);
+
+    // The start of a streamed task is searchable.
+    db_tasks found_tasks = search_tasks(db, "bbbbbbbbbb", 10);
+
+    TEST_ASSERT(found_tasks.amount == 1 && found_tasks.entries[0].id == file_id);
+    free_db_tasks(&found_tasks);
+
+    TEST_ASSERT(delete_task(db, piped_id) && delete_task(db, file_id));
+    TEST_ASSERT(count_tasks(db) == 2);
+
+    db_tasks remaining_tasks = search_tasks(db, "bbbbbbbbbb", 10);
+
+    TEST_ASSERT(remaining_tasks.amount == 0);
+    free_db_tasks(&remaining_tasks);
+
+    // Inputs of nothing but line breaks are empty notes, even ones too large for a single chunk.
+    char* line_breaks = malloc(__task_length / 64);
+
+    if (TEST_ASSERT(line_breaks != NULL))
+    {
+        memset(line_breaks, '\n', __task_length / 64);
+
+        TEST_ASSERT(__check_rejected(db, "", 0, ENODATA));
+        TEST_ASSERT(__check_rejected(db, line_breaks, 3, ENODATA));
+        TEST_ASSERT(__check_rejected(db, line_breaks, __task_length / 64, ENODATA));
+
+        line_breaks[__task_length / 64 - 1] = '\0';
+
+        TEST_ASSERT(__check_rejected(db, "a\0b", 3, EILSEQ));
+        TEST_ASSERT(__check_rejected(db, line_breaks, __task_length / 64, EILSEQ));
+    }
+
+    free(line_breaks);
+    TEST_ASSERT(count_tasks(db) == 2);
+
+    close_sqlite_db(db);
+    temp_db_remove(db_location);
+
+    return test_finish("stream");
+}
+
+/* Private Functions */
+
+static char __compressible_byte(const long position)
+{
+    return (position % 61 == 60) ? '\n' : (char)('a' + (position / 61) % 26);
+}
+
+static char __incompressible_byte(const long position)
+{
+    uint64_t value = (uint64_t)position * 0x9E3779B97F4A7C15ull;
+
+    value ^= value >> 29;
+    value *= 0xBF58476D1CE4E5B9ull;
+    value ^= value >> 32;
+
+    return (char)('!' + value % 94);
+}
+
+static bool __write_task(const int fd, char (*get_byte)(const long), const long from, const long to)
+{
+    char buffer[__write_buffer_size];
+
+    for (long position = from; position < to; position += __write_buffer_size)
+    {
+        const int length = (to - position < __write_buffer_size) ? (int)(to - position) : __write_buffer_size;
+
+        for (int index = 0; index < length; index++)
+            buffer[index] = get_byte(position + index);
+
+        if (write(fd, buffer, length) != length)
+            return false;
+    }
+
+    return true;
+}
+
+static int __stream_from_pipe(const db_handle* db, char (*get_byte)(const long))
+{
+    int pipe_fds[2], pause_fds[2], resume_fds[2];
+
+    if (!TEST_ASSERT(pipe(pipe_fds) == 0 && pipe(pause_fds) == 0 && pipe(resume_fds) == 0))
+        return -1;
+
+    // The child's memory isn't counted in the peak of this process.
+    const pid_t pid = fork();
+
+    if (pid == 0)
+    {
+        char signal = 0;
+
+        close(pipe_fds[0]);
+        close(pause_fds[0]);
+        close(resume_fds[1]);
+
+        const bool success = __write_task(pipe_fds[1], get_byte, 0, __task_length / 2)
+            && write(pause_fds[1], &signal, 1) == 1 && read(resume_fds[0], &signal, 1) == 1
+            && __write_task(pipe_fds[1], get_byte, __task_length / 2, __task_length);
+
+        _exit((success) ? EXIT_SUCCESS : EXIT_FAILURE);
+    }
+
+    close(pipe_fds[1]);
+    close(pause_fds[1]);
+    close(resume_fds[0]);
+
+    __pipe_stream stream = { .db = db, .fd = pipe_fds[0], .id = -1 };
+    __concurrent_write concurrent_write = { .db = db, .id = -1, .is_done = false };
+    pthread_t stream_thread, write_thread;
+    const bool is_streaming = pid > 0 && TEST_ASSERT(pthread_create(&stream_thread, NULL, __pipe_stream_thread, &stream) == 0);
+    bool is_writing = false;
+    char signal = 0;
+    int status = 0;
+
+    // Half of the task was already read when the child pauses, so the stream is well under way.
+    if (is_streaming && TEST_ASSERT(read(pause_fds[0], &signal, 1) == 1))
+    {
+        is_writing = TEST_ASSERT(pthread_create(&write_thread, NULL, __concurrent_write_thread, &concurrent_write) == 0);
+        TEST_ASSERT(is_writing && __wait_for_write(&concurrent_write));
+    }
+
+    // A write that's still waiting finishes once the stream lets go of the writer, after the child is resumed.
+    TEST_ASSERT(pid <= 0 || write(resume_fds[1], &signal, 1) == 1);
+
+    if (is_writing)
+        pthread_join(write_thread, NULL);
+
+    if (is_streaming)
+        pthread_join(stream_thread, NULL);
+
+    TEST_ASSERT(concurrent_write.id > 0);
+
+    close(pipe_fds[0]);
+    close(pause_fds[0]);
+    close(resume_fds[1]);
+    TEST_ASSERT(pid > 0 && waitpid(pid, &status, 0) == pid && WIFEXITED(status) && WEXITSTATUS(status) == EXIT_SUCCESS);
+
+    return stream.id;
+}
+
+static void* __pipe_stream_thread(void* custom_state)
+{
+    __pipe_stream* stream = custom_state;
+    stream->id = add_task_from_fd(stream->db, stream->fd);
+
+    return NULL;
+}
+
+static void* __concurrent_write_thread(void* custom_state)
+{
+    __concurrent_write* concurrent_write = custom_state;
+    concurrent_write->id = add_task(concurrent_write->db, "A note added while a large one streams in.");
+    atomic_store(&concurrent_write->is_done, true);
+
+    return NULL;
+}
+
+static bool __wait_for_write(__concurrent_write* concurrent_write)
+{
+    // The write runs in its own thread, so a stream that holds the writer fails the check instead of hanging the test.
+    for (int waited_ms = 0; !atomic_load(&concurrent_write->is_done) && waited_ms < __concurrent_write_timeout_ms; waited_ms++)
+        nanosleep(&(struct timespec){ .tv_sec = 0, .tv_nsec = 1000000 }, NULL);
+
+    return atomic_load(&concurrent_write->is_done);
+}
+
+static int __stream_from_file(const db_handle* db, char (*get_byte)(const long))
+{
+    char file_location[] = "/tmp/todoc_stream_XXXXXX";
+    const int fd = mkstemp(file_location);
+
+    if (!TEST_ASSERT(fd != -1))
+        return -1;
+
+    unlink(file_location);
+
+    const int id = (TEST_ASSERT(__write_task(fd, get_byte, 0, __task_length)) && TEST_ASSERT(lseek(fd, 0, SEEK_SET) == 0))
+        ? add_task_from_fd(db, fd)
+        : -1;
+
+    close(fd);
+
+    return id;
+}
+
+static bool __check_rejected(const db_handle* db, const char* input, const size_t length, const int expected_error_code)
+{
+    char file_location[] = "/tmp/todoc_stream_XXXXXX";
+    const int fd = mkstemp(file_location);
+
+    if (fd == -1)
+        return false;
+
+    unlink(file_location);
+
+    const bool is_written = write(fd, input, length) == (ssize_t)length && lseek(fd, 0, SEEK_SET) == 0;
+
+    errno = 0;
+
+    const bool is_rejected = is_written && add_task_from_fd(db, fd) == -1 && errno == expected_error_code;
+
+    close(fd);
+
+    return is_rejected;
+}
+
+static long __get_peak_rss_kib()
+{
+    struct rusage usage;
+
+    return (getrusage(RUSAGE_SELF, &usage) == 0) ? usage.ru_maxrss : -1;
+}
+
+static bool __check_task(const db_handle* db, const int id, char (*get_byte)(const long))
+{
+    char part[4096];
+    bool matches = true;
+
+    for (size_t index = 0; matches && index < sizeof(__checked_offsets) / sizeof(__checked_offsets[0]); index++)
+    {
+        int part_id = 0;
+        long length = 0;
+        const int part_length = read_task_part(db, id - 1, __checked_offsets[index], part, sizeof(part), &part_id, &length);
+        const int expected_length = (__task_length - __checked_offsets[index] < (long)sizeof(part)) ? (int)(__task_length - __checked_offsets[index]) : (int)sizeof(part);
+
+        matches = part_id == id && length == __task_length && part_length == expected_length;
+
+        for (int position = 0; matches && position < part_length; position++)
+            matches = part[position] == get_byte(__checked_offsets[index] + position);
+
+        if (!matches)
+            fprintf(stderr, "Task %d: part at %ld read %d bytes." NEWLINE, id, __checked_offsets[index], part_length);
+    }
+
+    return matches;
+}
@@ -0,0 +1,35 @@
+#include <stdatomic.h>
+#include "./test.h"
+
+/* Private Variables */
+
+/// @brief How many checks of the test failed. Atomic, since tests check from several threads.
+static atomic_int __failed_amount = 0;
+
+/// @brief How many checks the test ran.
+static atomic_int __check_amount = 0;
+
+/* Public Functions */
+
+bool test_check(const bool condition, const char* expression, const char* file, const int line)
+{
+    atomic_fetch_add(&__check_amount, 1);
+
+    if (!condition)
+    {
+        atomic_fetch_add(&__failed_amount, 1);
+        fprintf(stderr, "%s:%d: check failed: %s" NEWLINE, file, line, expression);
+    }
+
+    return condition;
+}
+
+int test_finish(const char* name)
+{
+    if (atomic_load(&__failed_amount) == 0)
+        printf("PASS %s (%d checks)" NEWLINE, name, atomic_load(&__check_amount));
+    else
+        printf("FAIL %s (%d of %d checks failed)" NEWLINE, name, atomic_load(&__failed_amount), atomic_load(&__check_amount));
+
+    return (atomic_load(&__failed_amount) == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
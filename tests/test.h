@@ -0,0 +1,26 @@
+#ifndef TEST_H // Only include this header file if it hasn't been included in the calling file already
+    #define TEST_H
+
+    #include <stdint.h>
+    #include "../database/sqlite_db.h"
+    #include "../fixtures/temp_db.h"
+    #include "../utilities/utilities.h"
+
+    /// @brief Checks a condition and reports it with its location if it's false, without stopping the test.
+    /// @param condition The condition that must hold.
+    /// @return The condition.
+    #define TEST_ASSERT(condition) test_check((condition), #condition, __FILE__, __LINE__)
+
+    /// @brief Records the result of a check. Use "TEST_ASSERT()" instead.
+    /// @param condition The result of the check.
+    /// @param expression The text of the check.
+    /// @param file The file of the check.
+    /// @param line The line of the check.
+    /// @return The result of the check.
+    extern bool test_check(const bool condition, const char* expression, const char* file, const int line);
+
+    /// @brief Prints whether every check of the test passed.
+    /// @param name The name of the test.
+    /// @return The exit code of the test.
+    extern int test_finish(const char* name);
+#endif // TEST_H
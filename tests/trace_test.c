@@ -0,0 +1,132 @@
+#include "./test.h"
+#include "../core/replay.h"
+
+/* Private Variables */
+
+/// @brief How many tasks the recorded database starts with.
+static const int __recorded_amount = 5;
+
+/// @brief How many tasks the replayed database starts with, so the replay gives its tasks other IDs than the recording.
+static const int __replayed_amount = 10;
+
+/* Function Prototyping */
+
+/// @brief Callback of "insert_task_async()" that keeps the ID the task was given.
+/// @param custom_state The int* that receives the ID, or -1 if the task was not added.
+/// @param success Whether the task was added.
+/// @param id The ID of the task.
+static void __callback_keep_id(void* custom_state, const bool success, const int id);
+
+/// @brief Adds tasks to a database.
+/// @param db The database.
+/// @param amount The amount of tasks.
+/// @return True if every task was added, False otherwise.
+static bool __add_tasks(const db_handle* db, const int amount);
+
+/// @brief Checks that the trace pairs an async insert with its commit, which carries the ID the task was given.
+/// @param trace_location The path of the trace file.
+/// @param expected_id The ID the insert was given.
+/// @return True if the commit was recorded after the insert, with the same number and that ID, False otherwise.
+static bool __check_async_commit(const char* trace_location, const int expected_id);
+
+/* Public Functions */
+
+/// @brief Checks that calls without a text can be recorded, and that a replay finds the tasks that were added through
+/// @brief the background writer, whose IDs are only known once they're committed.
+/// @return The exit code of the test.
+int main()
+{
+    const char* recorded_location = temp_db_create_path();
+    const char* replayed_location = temp_db_create_path();
+    const char* trace_location = (recorded_location == NULL) ? NULL : str_append(recorded_location, ".trace");
+    const db_handle* recorded_db = (trace_location == NULL) ? NULL : create_sqlite_db(recorded_location);
+    const db_handle* replayed_db = (replayed_location == NULL) ? NULL : create_sqlite_db(replayed_location);
+
+    if (!TEST_ASSERT(recorded_db != NULL && replayed_db != NULL) || !TEST_ASSERT(__add_tasks(recorded_db, __recorded_amount))
+        || !TEST_ASSERT(start_trace_recording(recorded_db, trace_location)))
+    {
+        close_sqlite_db(recorded_db);
+        close_sqlite_db(replayed_db);
+        free((char*)trace_location);
+        temp_db_remove(recorded_location);
+        temp_db_remove(replayed_location);
+
+        return test_finish("trace");
+    }
+
+    // Calls without a text are recorded with a length of zero instead of crashing the recorder.
+    db_tasks found_tasks = search_tasks(recorded_db, NULL, 5);
+
+    free_db_tasks(&found_tasks);
+
+    // The update has no task to change, so the flush reports it as failed.
+    TEST_ASSERT(update_task_async(recorded_db, __recorded_amount + 100, NULL, NULL, NULL));
+    TEST_ASSERT(!flush_writes(recorded_db));
+
+    // The recorded program only learns the ID from the callback, then keeps using it.
+    int async_id = 0;
+
+    TEST_ASSERT(insert_task_async(recorded_db, "A note added in the background.", __callback_keep_id, &async_id));
+    TEST_ASSERT(flush_writes(recorded_db));
+    TEST_ASSERT(async_id == __recorded_amount + 1);
+    TEST_ASSERT(update_task(recorded_db, async_id, "The same note, changed."));
+    TEST_ASSERT(delete_task(recorded_db, async_id));
+    TEST_ASSERT(stop_trace_recording(recorded_db));
+    TEST_ASSERT(__check_async_commit(trace_location, async_id));
+
+    // The replay gives the note another ID, so the delete only leaves the other notes alone if the ID was mapped.
+    TEST_ASSERT(__add_tasks(replayed_db, __replayed_amount));
+    TEST_ASSERT(replay_trace(replayed_db, trace_location, false) == EXIT_SUCCESS);
+    TEST_ASSERT(count_tasks(replayed_db) == __replayed_amount);
+
+    for (int id = 1; id <= __replayed_amount; id++)
+        TEST_ASSERT(task_exists(replayed_db, id));
+
+    TEST_ASSERT(!task_exists(replayed_db, __replayed_amount + 1));
+
+    close_sqlite_db(recorded_db);
+    close_sqlite_db(replayed_db);
+    remove(trace_location);
+    free((char*)trace_location);
+    temp_db_remove(recorded_location);
+    temp_db_remove(replayed_location);
+
+    return test_finish("trace");
+}
+
+/* Private Functions */
+
+static void __callback_keep_id(void* custom_state, const bool success, const int id)
+{
+    *(int*)custom_state = (success) ? id : -1;
+}
+
+static bool __add_tasks(const db_handle* db, const int amount)
+{
+    bool success = true;
+
+    for (int index = 0; success && index < amount; index++)
+        success = add_task(db, "A note that was there before the trace.") > 0;
+
+    return success;
+}
+
+static bool __check_async_commit(const char* trace_location, const int expected_id)
+{
+    db_trace_reader* reader = open_trace_reader(trace_location);
+    db_trace_record record;
+    int64_t insert_number = 0;
+    bool is_committed = false;
+
+    while (reader != NULL && !is_committed && trace_reader_next(reader, &record))
+    {
+        if (record.operation == DB_TRACE_INSERT_TASK_ASYNC)
+            insert_number = record.id;
+        else if (record.operation == DB_TRACE_ASYNC_INSERT_COMMITTED)
+            is_committed = insert_number > 0 && record.size == insert_number && record.id == expected_id;
+    }
+
+    close_trace_reader(reader);
+
+    return is_committed;
+}
@@ -109,11 +109,6 @@ time_t get_current_time()
     return 0;
 }
 
-int clear_console()
-{
-    return system("clear");
-}
-
 void swap(int* x, int* y)
 {
     int temp = *y;
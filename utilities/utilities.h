@@ -66,10 +66,6 @@
     /// @return The Unix time in seconds.
     extern time_t get_current_time();
 
-    /// @brief Clears the console.
-    /// @return The exit code of the clear command.
-    extern int clear_console();
-
     /// @brief Swaps the values of two variables with each other.
     /// @param x The first variable.
     /// @param y The second variable.